@@ -49,6 +49,42 @@
   inline void operator delete[](void *, void *) {            \
   }
 
+// This variant of the above macro additionally counts the memory for the
+// objects against the indicated MemoryHook::MemoryTag.  It relies on the
+// sized form of operator delete, so it should only be used in classes with a
+// virtual destructor, in order that the size of the most-derived object is
+// passed.
+
+#define ALLOC_MEMORY_TAG(tag)                                \
+  inline void *operator new(size_t size) RETURNS_ALIGNED(MEMORY_HOOK_ALIGNMENT) { \
+    memory_hook->inc_tag_usage(tag, size);                   \
+    return PANDA_MALLOC_SINGLE(size);                        \
+  }                                                          \
+  inline void *operator new(size_t size, void *ptr) {        \
+    (void) size;                                             \
+    return ptr;                                              \
+  }                                                          \
+  inline void operator delete(void *ptr, size_t size) {      \
+    memory_hook->dec_tag_usage(tag, size);                   \
+    PANDA_FREE_SINGLE(ptr);                                  \
+  }                                                          \
+  inline void operator delete(void *, void *) {              \
+  }                                                          \
+  inline void *operator new[](size_t size) RETURNS_ALIGNED(MEMORY_HOOK_ALIGNMENT) { \
+    memory_hook->inc_tag_usage(tag, size);                   \
+    return PANDA_MALLOC_ARRAY(size);                         \
+  }                                                          \
+  inline void *operator new[](size_t size, void *ptr) {      \
+    (void) size;                                             \
+    return ptr;                                              \
+  }                                                          \
+  inline void operator delete[](void *ptr, size_t size) {    \
+    memory_hook->dec_tag_usage(tag, size);                   \
+    PANDA_FREE_ARRAY(ptr);                                   \
+  }                                                          \
+  inline void operator delete[](void *, void *) {            \
+  }
+
 /**
  * This class is intended to be the base class of all objects in Panda that
  * might be allocated and deleted via the new and delete operators.  It
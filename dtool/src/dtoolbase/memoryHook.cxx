@@ -211,6 +211,12 @@ MemoryHook() {
   _requested_heap_size = 0;
   _total_mmap_size = 0;
   _max_heap_size = ~(size_t)0;
+
+  for (int i = 0; i < (int)MT_limit; ++i) {
+    _tag_usage[i] = 0;
+    _tag_num_allocs[i] = 0;
+    _tag_num_frees[i] = 0;
+  }
 }
 
 /**
@@ -225,6 +231,12 @@ MemoryHook(const MemoryHook &copy) :
   _max_heap_size(copy._max_heap_size),
   _page_size(copy._page_size) {
 
+  for (int i = 0; i < (int)MT_limit; ++i) {
+    _tag_usage[i] = copy._tag_usage[i];
+    _tag_num_allocs[i] = copy._tag_num_allocs[i];
+    _tag_num_frees[i] = copy._tag_num_frees[i];
+  }
+
   copy._lock.lock();
   _deleted_chains = copy._deleted_chains;
   copy._lock.unlock();
@@ -644,3 +656,32 @@ overflow_heap_size() {
   _max_heap_size = ~(size_t)0;
 #endif  // DO_MEMORY_USAGE
 }
+
+/**
+ * Returns a human-readable name for the indicated MemoryTag, suitable for
+ * use as a PStats collector name.
+ */
+const char *MemoryHook::
+get_tag_name(MemoryTag tag) {
+  switch (tag) {
+  case MT_none:
+    return "None";
+  case MT_geometry:
+    return "Geometry";
+  case MT_texture:
+    return "Textures";
+  case MT_animation:
+    return "Animation";
+  case MT_collision:
+    return "Collision";
+  case MT_network:
+    return "Networking";
+  case MT_python:
+    return "Python objects";
+  case MT_dna:
+    return "DNA";
+  case MT_limit:
+    break;
+  }
+  return "Invalid";
+}
@@ -36,6 +36,22 @@ class DeletedBufferChain;
  */
 class EXPCL_DTOOL_DTOOLBASE MemoryHook {
 public:
+  // The subsystems for which allocations are counted, independently of
+  // DO_MEMORY_USAGE.  See inc_tag_usage().
+  enum MemoryTag {
+    MT_none = -1,
+    MT_geometry,
+    MT_texture,
+    MT_animation,
+    MT_collision,
+    MT_network,
+    MT_python,
+    MT_dna,
+
+    MT_limit  // Not a real value, just a placeholder for the maximum
+              // enum value.
+  };
+
   MemoryHook();
   MemoryHook(const MemoryHook &copy);
   virtual ~MemoryHook();
@@ -69,12 +85,23 @@ public:
 
   INLINE static size_t get_ptr_size(void *ptr);
 
+  INLINE void inc_tag_usage(MemoryTag tag, size_t size);
+  INLINE void dec_tag_usage(MemoryTag tag, size_t size);
+  INLINE size_t get_tag_usage(MemoryTag tag) const;
+  INLINE size_t get_tag_num_allocs(MemoryTag tag) const;
+  INLINE size_t get_tag_num_frees(MemoryTag tag) const;
+  static const char *get_tag_name(MemoryTag tag);
+
 protected:
   TVOLATILE AtomicAdjust::Integer _total_heap_single_size;
   TVOLATILE AtomicAdjust::Integer _total_heap_array_size;
   TVOLATILE AtomicAdjust::Integer _requested_heap_size;
   TVOLATILE AtomicAdjust::Integer _total_mmap_size;
 
+  TVOLATILE AtomicAdjust::Integer _tag_usage[MT_limit];
+  TVOLATILE AtomicAdjust::Integer _tag_num_allocs[MT_limit];
+  TVOLATILE AtomicAdjust::Integer _tag_num_frees[MT_limit];
+
   // If the allocated heap size crosses this threshold, we call
   // overflow_heap_size().
   size_t _max_heap_size;
@@ -15,6 +15,12 @@
 #include "typeRegistryNode.h"
 #include "atomicAdjust.h"
 
+// The memory tag assigned to each type, stored as tag + 1 so that the
+// zero-initialized table means "untagged".  Types with an index beyond the
+// end of the table cannot be tagged.
+static const int max_tagged_types = 8192;
+static signed char _memory_tags[max_tagged_types];
+
 /**
  * Returns the total allocated memory used by objects of this type, for the
  * indicated memory class.  This is only updated if track-memory-usage is set
@@ -153,6 +159,35 @@ deallocate_array(void *ptr) {
   PANDA_FREE_ARRAY(ptr);
 }
 
+/**
+ * Returns the MemoryHook::MemoryTag that has been assigned to this type with
+ * set_memory_tag(), or MT_none if the type is not tagged.
+ */
+MemoryHook::MemoryTag TypeHandle::
+get_memory_tag() const {
+  if (_index <= 0 || _index >= max_tagged_types) {
+    return MemoryHook::MT_none;
+  }
+  return (MemoryHook::MemoryTag)(_memory_tags[_index] - 1);
+}
+
+/**
+ * Assigns this type to the indicated subsystem for the purposes of memory
+ * accounting.  Arrays allocated with a pallocator_array for this type (for
+ * instance, the data of a PointerToArray created with this type handle) will
+ * subsequently be counted against the indicated tag in the MemoryHook.
+ *
+ * This should be called once, at static init time, before any such arrays
+ * have been allocated; otherwise the counts will not balance.
+ */
+void TypeHandle::
+set_memory_tag(MemoryHook::MemoryTag tag) {
+  if (_index <= 0 || _index >= max_tagged_types) {
+    return;
+  }
+  _memory_tags[_index] = (signed char)(tag + 1);
+}
+
 #ifdef HAVE_PYTHON
 /**
  * Returns the internal void pointer that is stored for interrogate's benefit.
@@ -15,6 +15,7 @@
 #define TYPEHANDLE_H
 
 #include "dtoolbase.h"
+#include "memoryHook.h"
 
 #include <set>
 
@@ -146,6 +147,9 @@ public:
   void *reallocate_array(void *ptr, size_t size) RETURNS_ALIGNED(MEMORY_HOOK_ALIGNMENT);
   void deallocate_array(void *ptr);
 
+  MemoryHook::MemoryTag get_memory_tag() const;
+  void set_memory_tag(MemoryHook::MemoryTag tag);
+
   constexpr static TypeHandle from_index(int index) { return TypeHandle(index); }
 
 private:
@@ -16,6 +16,7 @@
 #include "pnotify.h"
 #include "vector_uchar.h"
 #include "register_type.h"
+#include "memoryHook.h"
 
 #if defined(HAVE_PYTHON) && !defined(CPPPARSER)
 
@@ -95,6 +96,7 @@ struct Dtool_PyTypedObject {
 static PyObject *Dtool_new_##CLASS_NAME(PyTypeObject *type, PyObject *args, PyObject *kwds) {\
   (void) args; (void) kwds;\
   PyObject *self = type->tp_alloc(type, 0);\
+  memory_hook->inc_tag_usage(MemoryHook::MT_python, type->tp_basicsize);\
   ((Dtool_PyInstDef *)self)->_signature = PY_PANDA_SIGNATURE;\
   ((Dtool_PyInstDef *)self)->_My_Type = &Dtool_##CLASS_NAME;\
   return self;\
@@ -110,6 +112,7 @@ static PyObject *Dtool_new_##CLASS_NAME(PyTypeObject *type, PyObject *args, PyOb
 #ifdef NDEBUG
 #define Define_Dtool_FreeInstance_Private(CLASS_NAME,CNAME)\
 static void Dtool_FreeInstance_##CLASS_NAME(PyObject *self) {\
+  memory_hook->dec_tag_usage(MemoryHook::MT_python, Py_TYPE(self)->tp_basicsize);\
   Py_TYPE(self)->tp_free(self);\
 }
 #else // NDEBUG
@@ -121,6 +124,7 @@ static void Dtool_FreeInstance_##CLASS_NAME(PyObject *self) {\
            << " which interrogate cannot delete.\n"; \
     }\
   }\
+  memory_hook->dec_tag_usage(MemoryHook::MT_python, Py_TYPE(self)->tp_basicsize);\
   Py_TYPE(self)->tp_free(self);\
 }
 #endif  // NDEBUG
@@ -132,6 +136,7 @@ static void Dtool_FreeInstance_##CLASS_NAME(PyObject *self) {\
       delete (CNAME *)DtoolInstance_VOID_PTR(self);\
     }\
   }\
+  memory_hook->dec_tag_usage(MemoryHook::MT_python, Py_TYPE(self)->tp_basicsize);\
   Py_TYPE(self)->tp_free(self);\
 }
 
@@ -142,6 +147,7 @@ static void Dtool_FreeInstance_##CLASS_NAME(PyObject *self) {\
       unref_delete((CNAME *)DtoolInstance_VOID_PTR(self));\
     }\
   }\
+  memory_hook->dec_tag_usage(MemoryHook::MT_python, Py_TYPE(self)->tp_basicsize);\
   Py_TYPE(self)->tp_free(self);\
 }
 
@@ -152,6 +158,7 @@ static void Dtool_FreeInstance_##CLASS_NAME(PyObject *self) {\
       unref_delete((ReferenceCount *)(CNAME *)DtoolInstance_VOID_PTR(self));\
     }\
   }\
+  memory_hook->dec_tag_usage(MemoryHook::MT_python, Py_TYPE(self)->tp_basicsize);\
   Py_TYPE(self)->tp_free(self);\
 }
 
@@ -21,6 +21,9 @@
 #include "openalAudioSound.h"
 #include "virtualFileSystem.h"
 #include "movieAudio.h"
+#include "audioDecodeCache.h"
+#include "readAheadAudioCursor.h"
+#include "config_movies.h"
 #include "reMutexHolder.h"
 
 #include <algorithm>
@@ -374,13 +377,46 @@ should_load_audio(MovieAudioCursor *source, int mode) {
 }
 
 /**
- * Obtains a SoundData for the specified sound.
+ * If the specified sound is going to be loaded into memory, decodes its
+ * samples, by way of the AudioDecodeCache, and returns them, to be passed on
+ * to get_sound_data().  This is called without the lock held, so that
+ * threads loading different sounds can decode them at the same time.
+ * Returns NULL if the sound is not to be loaded into memory, or is already
+ * loaded.
+ */
+PT(PCMAudio) OpenALAudioManager::
+decode_sound_data(MovieAudio *movie, int mode) {
+  const Filename &path = movie->get_filename();
+  if (mode == SM_stream || path.empty()) {
+    return nullptr;
+  }
+
+  {
+    ReMutexHolder holder(_lock);
+    if (_sample_cache.find(path) != _sample_cache.end()) {
+      return nullptr;
+    }
+  }
+
+  PT(MovieAudioCursor) stream = movie->open();
+  if (stream == nullptr || !should_load_audio(stream, mode)) {
+    return nullptr;
+  }
+
+  // Even if the cache is too small to keep the samples, we hold on to them
+  // here, so that they are not decoded a second time.
+  return AudioDecodeCache::get_global_ptr()->decode(movie, stream);
+}
+
+/**
+ * Obtains a SoundData for the specified sound.  If pcm is not NULL, it holds
+ * the samples already decoded by decode_sound_data().
  *
  * When you are done with the SoundData, you need to decrement the client
  * count.
  */
 OpenALAudioManager::SoundData *OpenALAudioManager::
-get_sound_data(MovieAudio *movie, int mode) {
+get_sound_data(MovieAudio *movie, int mode, PCMAudio *pcm) {
   ReMutexHolder holder(_lock);
   const Filename &path = movie->get_filename();
 
@@ -408,7 +444,9 @@ get_sound_data(MovieAudio *movie, int mode) {
     }
   }
 
-  PT(MovieAudioCursor) stream = movie->open();
+  // If the samples were already decoded, read the format from those instead
+  // of opening the file a second time.
+  PT(MovieAudioCursor) stream = (pcm != nullptr) ? pcm->open() : movie->open();
   if (stream == nullptr) {
     audio_error("Cannot open file: "<<path);
     return nullptr;
@@ -444,13 +482,26 @@ get_sound_data(MovieAudio *movie, int mode) {
       return nullptr;
     }
     int channels = stream->audio_channels();
-    int samples = (int)(stream->length() * stream->audio_rate());
-    int16_t *data = new int16_t[samples * channels];
-    samples = stream->read_samples(samples, data);
-    alBufferData(sd->_sample,
-                 (channels>1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16,
-                 data, samples * channels * 2, stream->audio_rate());
-    delete[] data;
+
+    // The samples are usually already decoded by decode_sound_data().
+    PT(PCMAudio) decoded = pcm;
+    if (decoded == nullptr) {
+      decoded = AudioDecodeCache::get_global_ptr()->decode(movie, stream);
+    }
+    if (decoded != nullptr) {
+      alBufferData(sd->_sample,
+                   (channels>1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16,
+                   decoded->get_data(), (ALsizei)decoded->get_data_size(),
+                   decoded->get_audio_rate());
+    } else {
+      int samples = (int)(stream->length() * stream->audio_rate());
+      int16_t *data = new int16_t[samples * channels];
+      samples = stream->read_samples(samples, data);
+      alBufferData(sd->_sample,
+                   (channels>1) ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16,
+                   data, samples * channels * 2, stream->audio_rate());
+      delete[] data;
+    }
     int err = alGetError();
     if (err != AL_NO_ERROR) {
       audio_error("could not fill OpenAL buffer object with data");
@@ -460,7 +511,12 @@ get_sound_data(MovieAudio *movie, int mode) {
     _sample_cache.insert(SampleCache::value_type(path, sd));
   } else {
     audio_debug(path.get_basename() << ": loading as stream");
-    sd->_stream = stream;
+    if (audio_read_ahead > 0.0) {
+      // Decode ahead of the play position on the audio_decode task chain.
+      sd->_stream = new ReadAheadAudioCursor(stream, audio_read_ahead);
+    } else {
+      sd->_stream = stream;
+    }
   }
 
   return sd;
@@ -471,12 +527,14 @@ get_sound_data(MovieAudio *movie, int mode) {
  */
 PT(AudioSound) OpenALAudioManager::
 get_sound(MovieAudio *sound, bool positional, int mode) {
+  PT(PCMAudio) pcm = decode_sound_data(sound, mode);
+
   ReMutexHolder holder(_lock);
   if(!is_valid()) {
     return get_null_sound();
   }
   PT(OpenALAudioSound) oas =
-    new OpenALAudioSound(this, sound, positional, mode);
+    new OpenALAudioSound(this, sound, positional, mode, pcm);
 
   if(!oas->_manager) {
     // The sound cleaned itself up immediately. It pretty clearly didn't like
@@ -494,9 +552,11 @@ get_sound(MovieAudio *sound, bool positional, int mode) {
  */
 PT(AudioSound) OpenALAudioManager::
 get_sound(const Filename &file_name, bool positional, int mode) {
-  ReMutexHolder holder(_lock);
-  if(!is_valid()) {
-    return get_null_sound();
+  {
+    ReMutexHolder holder(_lock);
+    if(!is_valid()) {
+      return get_null_sound();
+    }
   }
 
   Filename path = file_name;
@@ -510,8 +570,16 @@ get_sound(const Filename &file_name, bool positional, int mode) {
 
   PT(MovieAudio) mva = MovieAudio::get(path);
 
+  // Do the expensive decoding before we take the lock.
+  PT(PCMAudio) pcm = decode_sound_data(mva, mode);
+
+  ReMutexHolder holder(_lock);
+  if(!is_valid()) {
+    return get_null_sound();
+  }
+
   PT(OpenALAudioSound) oas =
-    new OpenALAudioSound(this, mva, positional, mode);
+    new OpenALAudioSound(this, mva, positional, mode, pcm);
 
   if(!oas->_manager) {
     // The sound cleaned itself up immediately. It pretty clearly didn't like
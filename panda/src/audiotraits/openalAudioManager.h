@@ -20,6 +20,7 @@
 #include "pmap.h"
 #include "pset.h"
 #include "movieAudioCursor.h"
+#include "pcmAudio.h"
 #include "reMutex.h"
 
 // OSX uses the OpenAL framework
@@ -121,7 +122,9 @@ private:
   bool can_use_audio(MovieAudioCursor *source);
   bool should_load_audio(MovieAudioCursor *source, int mode);
 
-  SoundData *get_sound_data(MovieAudio *source, int mode);
+  PT(PCMAudio) decode_sound_data(MovieAudio *source, int mode);
+  SoundData *get_sound_data(MovieAudio *source, int mode,
+                            PCMAudio *pcm = nullptr);
 
   // Tell the manager that the sound dtor was called.
   void release_sound(OpenALAudioSound* audioSound);
@@ -36,7 +36,8 @@ OpenALAudioSound::
 OpenALAudioSound(OpenALAudioManager* manager,
                  MovieAudio *movie,
                  bool positional,
-                 int mode) :
+                 int mode,
+                 PCMAudio *pcm) :
   _movie(movie),
   _sd(nullptr),
   _playing_loops(0),
@@ -69,7 +70,7 @@ OpenALAudioSound(OpenALAudioManager* manager,
 
   ReMutexHolder holder(OpenALAudioManager::_lock);
 
-  if (!require_sound_data()) {
+  if (!require_sound_data(pcm)) {
     cleanup();
     return;
   }
@@ -103,7 +103,8 @@ private:
   OpenALAudioSound(OpenALAudioManager* manager,
                    MovieAudio *movie,
                    bool positional,
-                   int mode);
+                   int mode,
+                   PCMAudio *pcm = nullptr);
   INLINE void   set_calibrated_clock(double rtc, double t, double playrate);
   INLINE double get_calibrated_clock(double rtc) const;
   void          correct_calibrated_clock(double rtc, double t);
@@ -116,7 +117,7 @@ private:
   int  read_stream_data(int bytelen, unsigned char *data);
   void pull_used_buffers();
   void push_fresh_buffers();
-  INLINE bool require_sound_data();
+  INLINE bool require_sound_data(PCMAudio *pcm = nullptr);
   INLINE void release_sound_data(bool force);
 
   INLINE bool is_valid() const;
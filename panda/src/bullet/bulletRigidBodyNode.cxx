@@ -24,7 +24,10 @@ TypeHandle BulletRigidBodyNode::_type_handle;
  *
  */
 BulletRigidBodyNode::
-BulletRigidBodyNode(const char *name) : BulletBodyNode(name) {
+BulletRigidBodyNode(const char *name) :
+  BulletBodyNode(name),
+  _world(nullptr)
+{
   // Mass properties
   btScalar mass(0.0);
   btVector3 inertia(0, 0, 0);
@@ -52,7 +55,8 @@ BulletRigidBodyNode(const char *name) : BulletBodyNode(name) {
  */
 BulletRigidBodyNode::
 BulletRigidBodyNode(const BulletRigidBodyNode &copy) :
-  BulletBodyNode(copy)
+  BulletBodyNode(copy),
+  _world(nullptr)
 {
   LightMutexHolder holder(BulletWorld::get_global_lock());
 
@@ -357,6 +361,12 @@ do_transform_changed() {
   if (!_rigid->isActive()) {
     _rigid->activate(true);
   }
+
+  // If the world is being stepped on another thread, the result of that step
+  // must not overwrite the transform that was just set.
+  if (_world != nullptr) {
+    _world->do_forget_b2p(this);
+  }
 }
 
 /**
@@ -406,6 +416,30 @@ do_sync_b2p() {
   _motion.sync_b2p((PandaNode *)this);
 }
 
+/**
+ * If Bullet has moved the body since the last call, stores its new position
+ * and orientation and returns true.  This does not touch the scene graph, so
+ * it may be called from the thread that steps the simulation; the values are
+ * then passed to do_apply_b2p() in the main thread.
+ *
+ * Assumes the lock(bullet global lock) is held by the caller
+ */
+bool BulletRigidBodyNode::
+do_pick_b2p(LPoint3 &pos, LQuaternion &quat) {
+
+  return _motion.pick_b2p(pos, quat);
+}
+
+/**
+ * Moves the node to a position and orientation previously returned by
+ * do_pick_b2p().
+ */
+void BulletRigidBodyNode::
+do_apply_b2p(const LPoint3 &pos, const LQuaternion &quat) {
+
+  _motion.apply_b2p((PandaNode *)this, pos, quat);
+}
+
 /**
  *
  */
@@ -660,16 +694,38 @@ setWorldTransform(const btTransform &trans) {
 void BulletRigidBodyNode::MotionState::
 sync_b2p(PandaNode *node) {
 
-  if (!_dirty) return;
+  LPoint3 p;
+  LQuaternion q;
+  if (pick_b2p(p, q)) {
+    apply_b2p(node, p, q);
+  }
+}
+
+/**
+ *
+ */
+bool BulletRigidBodyNode::MotionState::
+pick_b2p(LPoint3 &pos, LQuaternion &quat) {
+
+  if (!_dirty) return false;
+
+  pos = btVector3_to_LPoint3(_trans.getOrigin());
+  quat = btQuat_to_LQuaternion(_trans.getRotation());
+  _dirty = false;
+  return true;
+}
+
+/**
+ *
+ */
+void BulletRigidBodyNode::MotionState::
+apply_b2p(PandaNode *node, const LPoint3 &pos, const LQuaternion &quat) {
 
   NodePath np = NodePath::any_path(node);
-  LPoint3 p = btVector3_to_LPoint3(_trans.getOrigin());
-  LQuaternion q = btQuat_to_LQuaternion(_trans.getRotation());
 
   _disabled = true;
-  np.set_pos_quat(NodePath(), p, q);
+  np.set_pos_quat(NodePath(), pos, quat);
   _disabled = false;
-  _dirty = false;
 }
 
 /**
@@ -24,6 +24,7 @@
 #include "collideMask.h"
 
 class BulletShape;
+class BulletWorld;
 
 /**
  *
@@ -111,6 +112,9 @@ public:
   void do_sync_p2b();
   void do_sync_b2p();
 
+  bool do_pick_b2p(LPoint3 &pos, LQuaternion &quat);
+  void do_apply_b2p(const LPoint3 &pos, const LQuaternion &quat);
+
 protected:
   virtual void parents_changed();
   virtual void transform_changed();
@@ -135,6 +139,8 @@ private:
     void set_net_transform(const TransformState *ts);
 
     void sync_b2p(PandaNode *node);
+    bool pick_b2p(LPoint3 &pos, LQuaternion &quat);
+    void apply_b2p(PandaNode *node, const LPoint3 &pos, const LQuaternion &quat);
     bool sync_disabled() const;
 
     bool pick_dirty_flag();
@@ -149,6 +155,13 @@ private:
   MotionState _motion;
   btRigidBody *_rigid;
 
+  // The world the body is attached to, if any.  It is set and cleared by the
+  // BulletWorld, so that a transform set while the world is being stepped
+  // asynchronously can discard the stale result of that step.
+  BulletWorld *_world;
+
+  friend class BulletWorld;
+
 public:
   static void register_with_read_factory();
   virtual void write_datagram(BamWriter *manager, Datagram &dg);
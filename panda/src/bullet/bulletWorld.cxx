@@ -23,6 +23,8 @@
 
 #include "collideMask.h"
 #include "lightMutexHolder.h"
+#include "asyncTaskManager.h"
+#include "pStatTimer.h"
 
 #define clamp(x, x_min, x_max) std::max(std::min(x, x_max), x_min)
 
@@ -37,6 +39,7 @@ PStatCollector BulletWorld::_pstat_physics("App:Bullet:DoPhysics");
 PStatCollector BulletWorld::_pstat_simulation("App:Bullet:DoPhysics:Simulation");
 PStatCollector BulletWorld::_pstat_p2b("App:Bullet:DoPhysics:SyncP2B");
 PStatCollector BulletWorld::_pstat_b2p("App:Bullet:DoPhysics:SyncB2P");
+PStatCollector BulletWorld::_pstat_wait("App:Bullet:DoPhysics:Wait");
 
 PT(CallbackObject) bullet_contact_added_callback;
 
@@ -127,6 +130,13 @@ BulletWorld() {
   _world->getDispatchInfo().m_useContinuous = true;  // default: true
   _world->getSolverInfo().m_splitImpulse = false;    // default: false
   _world->getSolverInfo().m_numIterations = bullet_solver_iterations;
+
+  // Asynchronous stepping
+  _async_step = bullet_async_step;
+  _step_dt = 0.0f;
+  _step_max_substeps = 1;
+  _step_stepsize = 1.0f / 60.0f;
+  _step_result = 0;
 }
 
 /**
@@ -220,6 +230,10 @@ get_gravity() const {
  */
 int BulletWorld::
 do_physics(PN_stdfloat dt, int max_substeps, PN_stdfloat stepsize) {
+  if (_async_step) {
+    return do_physics_async(dt, max_substeps, stepsize);
+  }
+
   LightMutexHolder holder(get_global_lock());
 
   bullet_contact_added_callback = _contact_added_callback_obj;
@@ -256,6 +270,246 @@ do_physics(PN_stdfloat dt, int max_substeps, PN_stdfloat stepsize) {
   return n;
 }
 
+/**
+ * Specifies whether the simulation is stepped on a worker thread.  When this
+ * is true, do_physics() starts the step for the current frame on the
+ * "bullet_step" task chain and returns immediately, so that the simulation
+ * runs while the frame is rendered.  The new transforms of the rigid bodies
+ * are applied to the scene graph at the start of the following call to
+ * do_physics(), which first waits for the step to finish.  The scene graph
+ * therefore always lags the simulation by one frame, and the value returned
+ * by do_physics() is the number of substeps taken by the previous step.
+ *
+ * While a step is running, any other call into Bullet will wait for it to
+ * finish.  If a tick, contact-added or filter callback is set, or if the
+ * platform does not support threads, the simulation is stepped synchronously
+ * as usual.
+ */
+void BulletWorld::
+set_async_step(bool async_step) {
+  if (!async_step) {
+    wait_step();
+  }
+  _async_step = async_step;
+}
+
+/**
+ * If a step is running on the worker thread, waits for it to finish and
+ * applies the new transforms of the rigid bodies to the scene graph.  This
+ * may be called before querying the scene graph for the latest results of
+ * an asynchronous step.  It does nothing if no step is running.
+ */
+void BulletWorld::
+wait_step() {
+  if (_step_task == nullptr) {
+    return;
+  }
+
+  do_wait_step();
+
+  LightMutexHolder holder(get_global_lock());
+  do_apply_b2p();
+  do_sync_b2p();
+}
+
+/**
+ * The implementation of do_physics() when asynchronous stepping is enabled.
+ */
+int BulletWorld::
+do_physics_async(PN_stdfloat dt, int max_substeps, PN_stdfloat stepsize) {
+  PStatTimer timer(_pstat_physics);
+
+  // Wait for the step that was started by the previous call.
+  _pstat_wait.start();
+  do_wait_step();
+  _pstat_wait.stop();
+
+  LightMutexHolder holder(get_global_lock());
+
+  // Publish the results of that step to the scene graph.
+  _pstat_b2p.start();
+  do_apply_b2p();
+  do_sync_b2p();
+  if (_debug) {
+    _debug->do_sync_b2p(_world);
+  }
+  _pstat_b2p.stop();
+  int n = _step_result;
+
+  if (!can_step_async()) {
+    // Do it synchronously after all.
+    bullet_contact_added_callback = _contact_added_callback_obj;
+
+    int num_substeps = clamp(int(dt / stepsize), 1, max_substeps);
+    _pstat_p2b.start();
+    do_sync_p2b(dt, num_substeps);
+    _pstat_p2b.stop();
+
+    _pstat_simulation.start();
+    n = _world->stepSimulation((btScalar)dt, max_substeps, (btScalar)stepsize);
+    _pstat_simulation.stop();
+
+    _pstat_b2p.start();
+    do_sync_b2p();
+    _info.m_sparsesdf.GarbageCollect(bullet_gc_lifetime);
+    _pstat_b2p.stop();
+
+    if (_debug) {
+      _debug->do_sync_b2p(_world);
+    }
+
+    bullet_contact_added_callback.clear();
+    return n;
+  }
+
+  // Synchronize Panda to Bullet, and start the next step.
+  _step_dt = dt;
+  _step_max_substeps = max_substeps;
+  _step_stepsize = stepsize;
+
+  int num_substeps = clamp(int(dt / stepsize), 1, max_substeps);
+  _pstat_p2b.start();
+  do_sync_p2b(dt, num_substeps);
+  _pstat_p2b.stop();
+
+  _step_task = new GenericAsyncTask("bullet_step", &st_step, this);
+  _step_task->set_task_chain(get_step_chain()->get_name());
+  AsyncTaskManager::get_global_ptr()->add(_step_task);
+
+  return n;
+}
+
+/**
+ * Returns true if the simulation may be stepped on the worker thread.  The
+ * user callbacks are not designed to be run from another thread, so we don't
+ * do this if any of them are set.
+ *
+ * Assumes the lock(bullet global lock) is held by the caller
+ */
+bool BulletWorld::
+can_step_async() const {
+
+  return Thread::is_threading_supported() &&
+         _tick_callback_obj == nullptr &&
+         _contact_added_callback_obj == nullptr &&
+         _filter_algorithm != FA_callback;
+}
+
+/**
+ * Steps the simulation with the parameters stored by do_physics_async(), and
+ * publishes the new transforms of the rigid bodies.  This is run on the
+ * worker thread.
+ */
+void BulletWorld::
+do_step() {
+  LightMutexHolder holder(get_global_lock());
+  Thread *current_thread = Thread::get_current_thread();
+
+  {
+    PStatTimer timer(_pstat_simulation, current_thread);
+    _step_result = _world->stepSimulation((btScalar)_step_dt, _step_max_substeps,
+                                          (btScalar)_step_stepsize);
+  }
+
+  do_publish_b2p();
+  _info.m_sparsesdf.GarbageCollect(bullet_gc_lifetime);
+}
+
+/**
+ * Waits for the step started by do_physics_async(), if any, to finish.  The
+ * lock must *not* be held by the caller.
+ */
+void BulletWorld::
+do_wait_step() {
+  if (_step_task != nullptr) {
+    _step_task->wait();
+    _step_task.clear();
+  }
+}
+
+/**
+ * Stores the transforms of all of the rigid bodies that were moved by the
+ * simulation in the back buffer.  This is run on the worker thread, and does
+ * not touch the scene graph.
+ *
+ * Assumes the lock(bullet global lock) is held by the caller
+ */
+void BulletWorld::
+do_publish_b2p() {
+
+  _b2p_back.clear();
+
+  B2PTransform entry;
+  for (BulletRigidBodyNode *body : _bodies) {
+    if (body->do_pick_b2p(entry._pos, entry._quat)) {
+      entry._body = body;
+      _b2p_back.push_back(entry);
+    }
+  }
+}
+
+/**
+ * Applies the transforms published by the most recent step to the scene
+ * graph.  The worker thread must not be running.
+ *
+ * Assumes the lock(bullet global lock) is held by the caller
+ */
+void BulletWorld::
+do_apply_b2p() {
+
+  _b2p_front.swap(_b2p_back);
+  _b2p_back.clear();
+
+  for (const B2PTransform &entry : _b2p_front) {
+    entry._body->do_apply_b2p(entry._pos, entry._quat);
+  }
+  _b2p_front.clear();
+}
+
+/**
+ * Removes any published transforms for the indicated rigid body, which is
+ * being removed from the world or has just been moved in the scene graph.
+ *
+ * Assumes the lock(bullet global lock) is held by the caller
+ */
+void BulletWorld::
+do_forget_b2p(BulletRigidBodyNode *node) {
+
+  for (B2PTransforms *buffer : { &_b2p_front, &_b2p_back }) {
+    B2PTransforms::iterator it = buffer->begin();
+    while (it != buffer->end()) {
+      if ((*it)._body == node) {
+        it = buffer->erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+/**
+ * The task callback that runs do_step() on the "bullet_step" task chain.
+ */
+AsyncTask::DoneStatus BulletWorld::
+st_step(GenericAsyncTask *task, void *data) {
+  ((BulletWorld *)data)->do_step();
+  return AsyncTask::DS_done;
+}
+
+/**
+ * Returns the task chain on which the simulation is stepped asynchronously,
+ * creating it if necessary.
+ */
+AsyncTaskChain *BulletWorld::
+get_step_chain() {
+  AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+  AsyncTaskChain *chain = task_mgr->make_task_chain("bullet_step");
+  if (chain->get_num_threads() < 1 && Thread::is_threading_supported()) {
+    chain->set_num_threads(1);
+  }
+  return chain;
+}
+
 /**
  * Assumes the lock(bullet global lock) is held by the caller
  */
@@ -504,6 +758,7 @@ do_attach_rigid_body(BulletRigidBodyNode *node) {
   if (found == _bodies.end()) {
     _bodies.push_back(node);
     _world->addRigidBody(ptr);
+    node->_world = this;
   }
   else {
     bullet_cat.warning() << "rigid body already attached" << endl;
@@ -530,6 +785,8 @@ do_remove_rigid_body(BulletRigidBodyNode *node) {
   else {
     _bodies.erase(found);
     _world->removeRigidBody(ptr);
+    do_forget_b2p(node);
+    node->_world = nullptr;
   }
 }
 
@@ -38,10 +38,13 @@
 #include "collideMask.h"
 #include "luse.h"
 #include "lightMutex.h"
+#include "genericAsyncTask.h"
+#include "pvector.h"
 
 class BulletPersistentManifold;
 class BulletShape;
 class BulletSoftBodyWorldInfo;
+class AsyncTaskChain;
 
 extern EXPCL_PANDABULLET PT(CallbackObject) bullet_contact_added_callback;
 
@@ -60,6 +63,10 @@ PUBLISHED:
 
   BLOCKING int do_physics(PN_stdfloat dt, int max_substeps=1, PN_stdfloat stepsize=1.0f/60.0f);
 
+  void set_async_step(bool async_step);
+  INLINE bool get_async_step() const;
+  BLOCKING void wait_step();
+
   BulletSoftBodyWorldInfo get_world_info();
 
   // Debug
@@ -160,6 +167,7 @@ PUBLISHED:
   };
 
   MAKE_PROPERTY(gravity, get_gravity, set_gravity);
+  MAKE_PROPERTY(async_step, get_async_step, set_async_step);
   MAKE_PROPERTY(world_info, get_world_info);
   MAKE_PROPERTY2(debug_node, has_debug_node, get_debug_node, set_debug_node, clear_debug_node);
   MAKE_SEQ_PROPERTY(ghosts, get_num_ghosts, get_ghost);
@@ -199,10 +207,21 @@ public:
 
   static LightMutex &get_global_lock();
 
+  void do_forget_b2p(BulletRigidBodyNode *node);
+
 private:
   void do_sync_p2b(PN_stdfloat dt, int num_substeps);
   void do_sync_b2p();
 
+  int do_physics_async(PN_stdfloat dt, int max_substeps, PN_stdfloat stepsize);
+  bool can_step_async() const;
+  void do_step();
+  void do_wait_step();
+  void do_publish_b2p();
+  void do_apply_b2p();
+  static AsyncTask::DoneStatus st_step(GenericAsyncTask *task, void *data);
+  static AsyncTaskChain *get_step_chain();
+
   void do_attach_ghost(BulletGhostNode *node);
   void do_remove_ghost(BulletGhostNode *node);
 
@@ -234,6 +253,7 @@ private:
   static PStatCollector _pstat_simulation;
   static PStatCollector _pstat_p2b;
   static PStatCollector _pstat_b2p;
+  static PStatCollector _pstat_wait;
 
   struct btFilterCallback1 : public btOverlapFilterCallback {
     virtual bool needBroadphaseCollision(
@@ -285,6 +305,27 @@ private:
   BulletVehicles _vehicles;
   BulletConstraints _constraints;
 
+  // For asynchronous stepping.  The worker thread publishes the new
+  // transforms of the rigid bodies into _b2p_back at the end of each step;
+  // the main thread swaps it with _b2p_front and applies them to the scene
+  // graph at the start of the next call to do_physics().
+  class B2PTransform {
+  public:
+    PT(BulletRigidBodyNode) _body;
+    LPoint3 _pos;
+    LQuaternion _quat;
+  };
+  typedef pvector<B2PTransform> B2PTransforms;
+
+  bool _async_step;
+  PT(AsyncTask) _step_task;
+  PN_stdfloat _step_dt;
+  int _step_max_substeps;
+  PN_stdfloat _step_stepsize;
+  int _step_result;
+  B2PTransforms _b2p_front;
+  B2PTransforms _b2p_back;
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
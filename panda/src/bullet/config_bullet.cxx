@@ -106,6 +106,14 @@ PRC_DESC("Specifies the number of iterations for the Bullet contact "
          "solver. This is the native Bullet property "
          "btContactSolverInfo::m_numIterations. Default value is 10."));
 
+ConfigVariableBool bullet_async_step
+("bullet-async-step", false,
+PRC_DESC("Specifies the initial value of BulletWorld::set_async_step() for "
+         "newly created worlds.  When this is true, each call to "
+         "do_physics() steps the simulation on a worker thread while the "
+         "frame is rendered, and the results are applied to the scene "
+         "graph one frame later.  Default value is FALSE."));
+
 ConfigVariableBool bullet_additional_damping
 ("bullet-additional-damping", false,
 PRC_DESC("Enables additional damping on eachrigid body, in order to reduce "
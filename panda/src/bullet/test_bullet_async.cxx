@@ -0,0 +1,117 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_bullet_async.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "config_bullet.h"
+#include "bulletWorld.h"
+#include "bulletRigidBodyNode.h"
+#include "bulletBoxShape.h"
+#include "bulletPlaneShape.h"
+#include "nodePath.h"
+
+#include "pnotify.h"
+#include <chrono>
+#include <stdlib.h>
+
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock Clock;
+
+static const int num_bodies = 1000;
+static const int num_frames = 300;
+
+/**
+ * Keeps the main thread busy for the indicated number of milliseconds, to
+ * stand in for the cull and draw work of a frame.
+ */
+static void
+render_frame(double ms) {
+  Clock::time_point end = Clock::now() +
+    std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(ms));
+  while (Clock::now() < end) {
+  }
+}
+
+/**
+ * Drops a grid of boxes onto a plane and runs it for num_frames frames,
+ * reporting how long the main thread was blocked in do_physics() and how
+ * long each frame took overall.
+ */
+static void
+run(bool async_step, double render_ms) {
+  PT(BulletWorld) world = new BulletWorld;
+  world->set_gravity(0.0f, 0.0f, -9.81f);
+  world->set_async_step(async_step);
+
+  NodePath render("render");
+
+  PT(BulletRigidBodyNode) ground = new BulletRigidBodyNode("ground");
+  ground->add_shape(new BulletPlaneShape(LVector3::up(), 0.0f));
+  render.attach_new_node(ground);
+  world->attach(ground);
+
+  PT(BulletBoxShape) shape = new BulletBoxShape(LVecBase3(0.5f, 0.5f, 0.5f));
+  for (int i = 0; i < num_bodies; ++i) {
+    PT(BulletRigidBodyNode) body = new BulletRigidBodyNode("box");
+    body->add_shape(shape);
+    body->set_mass(1.0f);
+    NodePath np = render.attach_new_node(body);
+    np.set_pos((i % 10) * 1.5f, ((i / 10) % 10) * 1.5f, 2.0f + (i / 100) * 1.5f);
+    world->attach(body);
+  }
+
+  std::chrono::duration<double, std::milli> blocked(0);
+  std::chrono::duration<double, std::milli> max_blocked(0);
+
+  Clock::time_point start = Clock::now();
+  for (int f = 0; f < num_frames; ++f) {
+    Clock::time_point frame_start = Clock::now();
+    world->do_physics(1.0f / 60.0f);
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - frame_start;
+    blocked += elapsed;
+    max_blocked = std::max(max_blocked, elapsed);
+
+    render_frame(render_ms);
+  }
+  world->wait_step();
+  std::chrono::duration<double, std::milli> total = Clock::now() - start;
+
+  cerr << (async_step ? "async: " : "sync:  ")
+       << blocked.count() / num_frames << " ms/frame in do_physics (max "
+       << max_blocked.count() << " ms), "
+       << total.count() / num_frames << " ms/frame, "
+       << num_frames * 1000.0 / total.count() << " frames/s\n";
+}
+
+/**
+ * Usage: test_bullet_async [render-ms]
+ */
+int
+main(int argc, char *argv[]) {
+  double render_ms = 5.0;
+  if (argc > 1) {
+    render_ms = atof(argv[1]);
+  }
+
+  init_libbullet();
+
+  cerr << num_bodies << " rigid bodies, " << num_frames << " frames, "
+       << render_ms << " ms of render work per frame\n";
+
+  run(false, render_ms);
+  run(true, render_ms);
+
+  cerr << "In async mode, the scene graph shows the results of the previous "
+          "step, so transforms lag the simulation by one frame.\n";
+  return 0;
+}
@@ -31,6 +31,9 @@ class FactoryParams;
  * AnimBundle.
  */
 class EXPCL_PANDA_CHAN AnimGroup : public TypedWritableReferenceCount, public Namable {
+public:
+  ALLOC_MEMORY_TAG(MemoryHook::MT_animation);
+
 protected:
   AnimGroup(const std::string &name = "");
   AnimGroup(AnimGroup *parent, const AnimGroup &copy);
@@ -126,6 +126,11 @@ ConfigureFn(config_chan) {
   // don't necessarily resolve very well across dynamic libraries.
   LMatrix4::init_type();
 
+  // The animation tables are allocated with the type handle of the channel
+  // that owns them; count them against the animation memory tag.
+  AnimChannelMatrixXfmTable::get_class_type().set_memory_tag(MemoryHook::MT_animation);
+  AnimChannelScalarTable::get_class_type().set_memory_tag(MemoryHook::MT_animation);
+
   // Registration of writeable object's creation functions with BamReader's
   // factory
   PartGroup::register_with_read_factory();
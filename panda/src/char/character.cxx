@@ -120,6 +120,17 @@ dupe_for_flatten() const {
   return new Character(*this, false);
 }
 
+/**
+ * Returns true if it is safe for share_subgraph() to share this node between
+ * all of the copies of a model.  A Character is never shared, nor is
+ * anything below it, since each copy needs its own joints, and its own
+ * copies of the Geoms that are animated by them.
+ */
+bool Character::
+safe_to_share() const {
+  return false;
+}
+
 /**
  * Collapses this node with the other node, if possible, and returns a pointer
  * to the combined node, or NULL if the two nodes cannot safely be combined.
@@ -46,6 +46,7 @@ PUBLISHED:
 public:
   virtual PandaNode *make_copy() const;
   virtual PandaNode *dupe_for_flatten() const;
+  virtual bool safe_to_share() const;
 
   virtual bool cull_callback(CullTraverser *trav, CullTraverserData &data);
 
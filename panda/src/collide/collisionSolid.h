@@ -44,6 +44,8 @@ class CullTraverserData;
  */
 class EXPCL_PANDA_COLLIDE CollisionSolid : public CopyOnWriteObject {
 public:
+  ALLOC_MEMORY_TAG(MemoryHook::MT_collision);
+
   CollisionSolid();
   CollisionSolid(const CollisionSolid &copy);
   virtual ~CollisionSolid();
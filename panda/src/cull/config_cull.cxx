@@ -16,6 +16,7 @@
 #include "cullBinBackToFront.h"
 #include "cullBinFixed.h"
 #include "cullBinFrontToBack.h"
+#include "cullBinStateHashed.h"
 #include "cullBinStateSorted.h"
 #include "cullBinUnsorted.h"
 
@@ -50,6 +51,7 @@ init_libcull() {
   CullBinBackToFront::init_type();
   CullBinFixed::init_type();
   CullBinFrontToBack::init_type();
+  CullBinStateHashed::init_type();
   CullBinStateSorted::init_type();
   CullBinUnsorted::init_type();
 
@@ -64,4 +66,6 @@ init_libcull() {
                                  CullBinFrontToBack::make_bin);
   bin_manager->register_bin_type(CullBinManager::BT_fixed,
                                  CullBinFixed::make_bin);
+  bin_manager->register_bin_type(CullBinManager::BT_state_hashed,
+                                 CullBinStateHashed::make_bin);
 }
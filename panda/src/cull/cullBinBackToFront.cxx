@@ -44,6 +44,16 @@ make_bin(const std::string &name, GraphicsStateGuardianBase *gsg,
   return new CullBinBackToFront(name, gsg, draw_region_pcollector);
 }
 
+/**
+ * Returns a newly-allocated CullBin object that contains a copy of just the
+ * subset of the data from this CullBin object that is worth keeping around
+ * for next frame.
+ */
+PT(CullBin) CullBinBackToFront::
+make_next() const {
+  return new CullBinBackToFront(*this);
+}
+
 /**
  * Adds a geom, along with its associated state, to the bin for rendering.
  */
@@ -29,6 +29,8 @@
  * be sorted from back to front.
  */
 class EXPCL_PANDA_CULL CullBinBackToFront : public CullBin {
+protected:
+  INLINE CullBinBackToFront(const CullBinBackToFront &copy);
 public:
   INLINE CullBinBackToFront(const std::string &name,
                             GraphicsStateGuardianBase *gsg,
@@ -39,6 +41,8 @@ public:
                            GraphicsStateGuardianBase *gsg,
                            const PStatCollector &draw_region_pcollector);
 
+  virtual PT(CullBin) make_next() const;
+
 
   virtual void add_object(CullableObject *object, Thread *current_thread);
   virtual void finish_cull(SceneSetup *scene_setup, Thread *current_thread);
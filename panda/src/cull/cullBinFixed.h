@@ -31,6 +31,8 @@
  * in scene-graph order (as with CullBinUnsorted).
  */
 class EXPCL_PANDA_CULL CullBinFixed : public CullBin {
+protected:
+  INLINE CullBinFixed(const CullBinFixed &copy);
 public:
   INLINE CullBinFixed(const std::string &name,
                       GraphicsStateGuardianBase *gsg,
@@ -41,6 +43,8 @@ public:
                            GraphicsStateGuardianBase *gsg,
                            const PStatCollector &draw_region_pcollector);
 
+  virtual PT(CullBin) make_next() const;
+
   virtual void add_object(CullableObject *object, Thread *current_thread);
   virtual void finish_cull(SceneSetup *scene_setup, Thread *current_thread);
   virtual void draw(bool force, Thread *current_thread);
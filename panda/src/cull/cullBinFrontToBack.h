@@ -30,6 +30,8 @@
  * hierarchical Z-buffer.
  */
 class EXPCL_PANDA_CULL CullBinFrontToBack : public CullBin {
+protected:
+  INLINE CullBinFrontToBack(const CullBinFrontToBack &copy);
 public:
   INLINE CullBinFrontToBack(const std::string &name,
                             GraphicsStateGuardianBase *gsg,
@@ -40,6 +42,8 @@ public:
                            GraphicsStateGuardianBase *gsg,
                            const PStatCollector &draw_region_pcollector);
 
+  virtual PT(CullBin) make_next() const;
+
   virtual void add_object(CullableObject *object, Thread *current_thread);
   virtual void finish_cull(SceneSetup *scene_setup, Thread *current_thread);
   virtual void draw(bool force, Thread *current_thread);
@@ -0,0 +1,220 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file cullBinStateHashed.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "cullBinStateHashed.h"
+#include "graphicsStateGuardianBase.h"
+#include "cullableObject.h"
+#include "cullHandler.h"
+#include "textureAttrib.h"
+#include "pStatTimer.h"
+#include "config_pgraph.h"
+
+#include <string.h>
+
+TypeHandle CullBinStateHashed::_type_handle;
+
+// The layout of the sort key, from the most significant bits down.
+static const int texture_shift = 48;
+static const int texture_max = 0xffff;
+static const int state_shift = 28;
+static const int state_max = 0xfffff;
+static const int format_shift = 16;
+static const int format_max = 0xfff;
+
+/**
+ *
+ */
+CullBinStateHashed::
+~CullBinStateHashed() {
+  Objects::iterator oi;
+  for (oi = _objects.begin(); oi != _objects.end(); ++oi) {
+    CullableObject *object = (*oi)._object;
+    delete object;
+  }
+}
+
+/**
+ * Factory constructor for passing to the CullBinManager.
+ */
+CullBin *CullBinStateHashed::
+make_bin(const std::string &name, GraphicsStateGuardianBase *gsg,
+         const PStatCollector &draw_region_pcollector) {
+  return new CullBinStateHashed(name, gsg, draw_region_pcollector);
+}
+
+/**
+ * Returns a newly-allocated CullBin object that contains a copy of just the
+ * subset of the data from this CullBin object that is worth keeping around
+ * for next frame.
+ */
+PT(CullBin) CullBinStateHashed::
+make_next() const {
+  return new CullBinStateHashed(*this);
+}
+
+/**
+ * Adds a geom, along with its associated state, to the bin for rendering.
+ */
+void CullBinStateHashed::
+add_object(CullableObject *object, Thread *current_thread) {
+  const RenderState *state = object->_state;
+  const GeomVertexFormat *format = nullptr;
+  if (object->_munged_data != nullptr) {
+    format = object->_munged_data->get_format();
+  }
+
+  uint64_t key = 0;
+  if (state != nullptr) {
+    key |= get_id(_texture_ids, state->get_attrib(TextureAttrib::get_class_slot()), texture_max) << texture_shift;
+    key |= get_id(_state_ids, state, state_max) << state_shift;
+  }
+  key |= get_id(_format_ids, format, format_max) << format_shift;
+  if (object->_geom != nullptr) {
+    key |= get_depth_bucket(object);
+  }
+
+  _objects.push_back(ObjectData(object, key));
+}
+
+/**
+ * Called after all the geoms have been added, this indicates that the cull
+ * process is finished for this frame and gives the bins a chance to do any
+ * post-processing (like sorting) before moving on to draw.
+ */
+void CullBinStateHashed::
+finish_cull(SceneSetup *, Thread *current_thread) {
+  PStatTimer timer(_cull_this_pcollector, current_thread);
+  radix_sort();
+
+  // We won't be adding any more objects.
+  _texture_ids.clear();
+  _state_ids.clear();
+  _format_ids.clear();
+}
+
+/**
+ * Draws all the geoms in the bin, in the appropriate order.
+ */
+void CullBinStateHashed::
+draw(bool force, Thread *current_thread) {
+  PStatTimer timer(_draw_this_pcollector, current_thread);
+
+  bool batch_instances = cull_batch_instances;
+  InstanceTransforms transforms;
+
+  Objects::const_iterator oi;
+  for (oi = _objects.begin(); oi != _objects.end(); ++oi) {
+    CullableObject *object = (*oi)._object;
+
+    if (object->_draw_callback == nullptr) {
+      nassertd(object->_geom != nullptr) continue;
+
+      if (batch_instances) {
+        // Gather up the objects that follow this one and differ from it only
+        // in their transform, and draw them all at once.
+        Objects::const_iterator oj = oi + 1;
+        while (oj != _objects.end() && (*oj)._object->is_instance_of(*object)) {
+          ++oj;
+        }
+        if (oj - oi > 1) {
+          transforms.clear();
+          for (; oi != oj; ++oi) {
+            transforms.push_back((*oi)._object->_internal_transform);
+          }
+          draw_instances(object, transforms, force, current_thread);
+          --oi;
+          continue;
+        }
+      }
+
+      _gsg->set_state_and_transform(object->_state, object->_internal_transform);
+
+      GeomPipelineReader geom_reader(object->_geom, current_thread);
+      GeomVertexDataPipelineReader data_reader(object->_munged_data, current_thread);
+      data_reader.check_array_readers();
+      geom_reader.draw(_gsg, &data_reader, force);
+    } else {
+      // It has a callback associated.
+      object->draw_callback(_gsg, force, current_thread);
+      // Now the callback has taken care of drawing.
+    }
+  }
+}
+
+/**
+ * Called by CullBin::make_result_graph() to add all the geoms to the special
+ * cull result scene graph.
+ */
+void CullBinStateHashed::
+fill_result_graph(CullBin::ResultGraphBuilder &builder) {
+  Objects::const_iterator oi;
+  for (oi = _objects.begin(); oi != _objects.end(); ++oi) {
+    CullableObject *object = (*oi)._object;
+    builder.add_object(object);
+  }
+}
+
+/**
+ * Puts the objects in order by key.  This is a least-significant-digit radix
+ * sort, a byte at a time, so it is stable; objects with the same key stay in
+ * scene graph order.  Bytes that are the same in every key are skipped, which
+ * is usually most of the upper bytes, since there are rarely many ids.
+ */
+void CullBinStateHashed::
+radix_sort() {
+  size_t num_objects = _objects.size();
+  if (num_objects < 2) {
+    return;
+  }
+
+  // Count the occurrences of each value of each byte, all in one pass.
+  static const int num_passes = 8;
+  size_t counts[num_passes][256];
+  memset(counts, 0, sizeof(counts));
+  for (const ObjectData &od : _objects) {
+    uint64_t key = od._key;
+    for (int p = 0; p < num_passes; ++p) {
+      ++counts[p][(key >> (p * 8)) & 0xff];
+    }
+  }
+
+  _sorted.resize(num_objects, ObjectData(nullptr, 0));
+  ObjectData *from = &_objects[0];
+  ObjectData *to = &_sorted[0];
+
+  for (int p = 0; p < num_passes; ++p) {
+    size_t *count = counts[p];
+    int shift = p * 8;
+    if (count[(from[0]._key >> shift) & 0xff] == num_objects) {
+      // All of the keys have the same value for this byte.
+      continue;
+    }
+
+    // Turn the counts into starting offsets.
+    size_t offset = 0;
+    for (int i = 0; i < 256; ++i) {
+      size_t c = count[i];
+      count[i] = offset;
+      offset += c;
+    }
+
+    for (size_t i = 0; i < num_objects; ++i) {
+      to[count[(from[i]._key >> shift) & 0xff]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+
+  if (from != &_objects[0]) {
+    _objects.swap(_sorted);
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file cullBinStateHashed.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef CULLBINSTATEHASHED_H
+#define CULLBINSTATEHASHED_H
+
+#include "pandabase.h"
+
+#include "cullBin.h"
+#include "cullableObject.h"
+#include "simpleHashMap.h"
+#include "pointerTo.h"
+#include "numeric_types.h"
+
+#include <algorithm>
+#include <string.h>
+
+/**
+ * A specific kind of CullBin that groups geometry by state, like
+ * CullBinStateSorted, but does it more cheaply.  As each object is added, its
+ * textures, state and vertex format are each given a small integer id, and
+ * these are packed together with its distance from the camera into a single
+ * 64-bit key.  The keys are then put in order with a radix sort, rather than
+ * by comparing the states themselves.
+ *
+ * Objects with the same textures are drawn together, then objects with the
+ * same state, then objects with the same vertex format, and these are drawn
+ * front-to-back.
+ */
+class EXPCL_PANDA_CULL CullBinStateHashed : public CullBin {
+protected:
+  INLINE CullBinStateHashed(const CullBinStateHashed &copy);
+public:
+  INLINE CullBinStateHashed(const std::string &name,
+                            GraphicsStateGuardianBase *gsg,
+                            const PStatCollector &draw_region_pcollector);
+  virtual ~CullBinStateHashed();
+
+  static CullBin *make_bin(const std::string &name,
+                           GraphicsStateGuardianBase *gsg,
+                           const PStatCollector &draw_region_pcollector);
+
+  virtual PT(CullBin) make_next() const;
+
+  virtual void add_object(CullableObject *object, Thread *current_thread);
+  virtual void finish_cull(SceneSetup *scene_setup, Thread *current_thread);
+  virtual void draw(bool force, Thread *current_thread);
+
+protected:
+  virtual void fill_result_graph(ResultGraphBuilder &builder);
+
+private:
+  typedef SimpleHashMap<const void *, int, pointer_hash> Ids;
+  INLINE static uint64_t get_id(Ids &ids, const void *ptr, int max_id);
+  INLINE uint64_t get_depth_bucket(const CullableObject *object) const;
+
+  void radix_sort();
+
+  class ObjectData {
+  public:
+    INLINE ObjectData(CullableObject *object, uint64_t key);
+
+    uint64_t _key;
+    CullableObject *_object;
+  };
+
+  typedef pvector<ObjectData> Objects;
+  Objects _objects;
+  Objects _sorted;
+
+  Ids _texture_ids;
+  Ids _state_ids;
+  Ids _format_ids;
+
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    CullBin::init_type();
+    register_type(_type_handle, "CullBinStateHashed",
+                  CullBin::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {init_type(); return get_class_type();}
+
+private:
+  static TypeHandle _type_handle;
+};
+
+#include "cullBinStateHashed.I"
+
+#endif
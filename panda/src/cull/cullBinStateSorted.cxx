@@ -16,6 +16,7 @@
 #include "cullableObject.h"
 #include "cullHandler.h"
 #include "pStatTimer.h"
+#include "config_pgraph.h"
 
 #include <algorithm>
 
@@ -43,12 +44,22 @@ make_bin(const std::string &name, GraphicsStateGuardianBase *gsg,
   return new CullBinStateSorted(name, gsg, draw_region_pcollector);
 }
 
+/**
+ * Returns a newly-allocated CullBin object that contains a copy of just the
+ * subset of the data from this CullBin object that is worth keeping around
+ * for next frame.
+ */
+PT(CullBin) CullBinStateSorted::
+make_next() const {
+  return new CullBinStateSorted(*this);
+}
+
 /**
  * Adds a geom, along with its associated state, to the bin for rendering.
  */
 void CullBinStateSorted::
 add_object(CullableObject *object, Thread *current_thread) {
-  _objects.push_back(ObjectData(object));
+  _objects.push_back(ObjectData(object, _batch_instances));
 }
 
 /**
@@ -70,6 +81,9 @@ void CullBinStateSorted::
 draw(bool force, Thread *current_thread) {
   PStatTimer timer(_draw_this_pcollector, current_thread);
 
+  bool batch_instances = _batch_instances;
+  InstanceTransforms transforms;
+
   Objects::const_iterator oi;
   for (oi = _objects.begin(); oi != _objects.end(); ++oi) {
     CullableObject *object = (*oi)._object;
@@ -77,6 +91,24 @@ draw(bool force, Thread *current_thread) {
     if (object->_draw_callback == nullptr) {
       nassertd(object->_geom != nullptr) continue;
 
+      if (batch_instances) {
+        // Gather up the objects that follow this one and differ from it only
+        // in their transform, and draw them all at once.
+        Objects::const_iterator oj = oi + 1;
+        while (oj != _objects.end() && (*oj)._object->is_instance_of(*object)) {
+          ++oj;
+        }
+        if (oj - oi > 1) {
+          transforms.clear();
+          for (; oi != oj; ++oi) {
+            transforms.push_back((*oi)._object->_internal_transform);
+          }
+          draw_instances(object, transforms, force, current_thread);
+          --oi;
+          continue;
+        }
+      }
+
       _gsg->set_state_and_transform(object->_state, object->_internal_transform);
 
       GeomPipelineReader geom_reader(object->_geom, current_thread);
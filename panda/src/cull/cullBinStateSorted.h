@@ -33,6 +33,8 @@
  * object appears behind another one.
  */
 class EXPCL_PANDA_CULL CullBinStateSorted : public CullBin {
+protected:
+  INLINE CullBinStateSorted(const CullBinStateSorted &copy);
 public:
   INLINE CullBinStateSorted(const std::string &name,
                             GraphicsStateGuardianBase *gsg,
@@ -43,6 +45,8 @@ public:
                            GraphicsStateGuardianBase *gsg,
                            const PStatCollector &draw_region_pcollector);
 
+  virtual PT(CullBin) make_next() const;
+
   virtual void add_object(CullableObject *object, Thread *current_thread);
   virtual void finish_cull(SceneSetup *scene_setup, Thread *current_thread);
   virtual void draw(bool force, Thread *current_thread);
@@ -53,15 +57,17 @@ protected:
 private:
   class ObjectData {
   public:
-    INLINE ObjectData(CullableObject *object);
+    INLINE ObjectData(CullableObject *object, bool batch_instances);
     INLINE bool operator < (const ObjectData &other) const;
 
     CullableObject *_object;
     const GeomVertexFormat *_format;
+    const Geom *_geom;
   };
 
   typedef pvector<ObjectData> Objects;
   Objects _objects;
+  bool _batch_instances;
 
 public:
   static TypeHandle get_class_type() {
@@ -15,6 +15,7 @@
 #include "cullHandler.h"
 #include "graphicsStateGuardianBase.h"
 #include "pStatTimer.h"
+#include "config_pgraph.h"
 
 
 TypeHandle CullBinUnsorted::_type_handle;
@@ -40,6 +41,16 @@ make_bin(const std::string &name, GraphicsStateGuardianBase *gsg,
   return new CullBinUnsorted(name, gsg, draw_region_pcollector);
 }
 
+/**
+ * Returns a newly-allocated CullBin object that contains a copy of just the
+ * subset of the data from this CullBin object that is worth keeping around
+ * for next frame.
+ */
+PT(CullBin) CullBinUnsorted::
+make_next() const {
+  return new CullBinUnsorted(*this);
+}
+
 /**
  * Adds a geom, along with its associated state, to the bin for rendering.
  */
@@ -55,6 +66,9 @@ void CullBinUnsorted::
 draw(bool force, Thread *current_thread) {
   PStatTimer timer(_draw_this_pcollector, current_thread);
 
+  bool batch_instances = cull_batch_instances;
+  InstanceTransforms transforms;
+
   Objects::iterator oi;
   for (oi = _objects.begin(); oi != _objects.end(); ++oi) {
     CullableObject *object = (*oi);
@@ -62,6 +76,24 @@ draw(bool force, Thread *current_thread) {
     if (object->_draw_callback == nullptr) {
       nassertd(object->_geom != nullptr) continue;
 
+      if (batch_instances) {
+        // Gather up the objects that follow this one and differ from it only
+        // in their transform, and draw them all at once.
+        Objects::iterator oj = oi + 1;
+        while (oj != _objects.end() && (*oj)->is_instance_of(*object)) {
+          ++oj;
+        }
+        if (oj - oi > 1) {
+          transforms.clear();
+          for (; oi != oj; ++oi) {
+            transforms.push_back((*oi)->_internal_transform);
+          }
+          draw_instances(object, transforms, force, current_thread);
+          --oi;
+          continue;
+        }
+      }
+
       _gsg->set_state_and_transform(object->_state, object->_internal_transform);
 
       GeomPipelineReader geom_reader(object->_geom, current_thread);
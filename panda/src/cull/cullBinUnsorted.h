@@ -25,6 +25,8 @@
  * will be in scene-graph order.
  */
 class EXPCL_PANDA_CULL CullBinUnsorted : public CullBin {
+protected:
+  INLINE CullBinUnsorted(const CullBinUnsorted &copy);
 public:
   INLINE CullBinUnsorted(const std::string &name,
                          GraphicsStateGuardianBase *gsg,
@@ -35,6 +37,8 @@ public:
                            GraphicsStateGuardianBase *gsg,
                            const PStatCollector &draw_region_pcollector);
 
+  virtual PT(CullBin) make_next() const;
+
   virtual void add_object(CullableObject *object, Thread *current_thread);
   virtual void draw(bool force, Thread *current_thread);
 
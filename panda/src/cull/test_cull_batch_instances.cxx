@@ -0,0 +1,170 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_cull_batch_instances.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "config_cull.h"
+#include "config_display.h"
+#include "config_pgraph.h"
+#include "cullBinStateSorted.h"
+#include "cullBinStateHashed.h"
+#include "cullBinUnsorted.h"
+#include "cullBinManager.h"
+#include "cullableObject.h"
+#include "graphicsStateGuardian.h"
+#include "geom.h"
+#include "geomTriangles.h"
+#include "geomVertexData.h"
+#include "geomVertexWriter.h"
+#include "colorAttrib.h"
+#include "renderState.h"
+#include "transformState.h"
+
+using std::cerr;
+
+static int num_failures = 0;
+
+#define CHECK(condition) \
+  if (!(condition)) { \
+    cerr << "FAILED: " #condition " (line " << __LINE__ << ")\n"; \
+    ++num_failures; \
+  }
+
+/**
+ * A GSG that draws nothing, but records the size of each batch that is handed
+ * to draw_instances().
+ */
+class BatchCountingGSG : public GraphicsStateGuardian {
+public:
+  BatchCountingGSG() :
+    GraphicsStateGuardian(CS_zup_right, nullptr, nullptr) {}
+
+  virtual void draw_instances(const GeomPipelineReader *geom_reader,
+                              const GeomVertexDataPipelineReader *data_reader,
+                              const RenderState *state,
+                              const TransformState * const *transforms,
+                              size_t num_instances, bool force) {
+    _batches.push_back(num_instances);
+  }
+
+  pvector<size_t> _batches;
+};
+
+/**
+ * Returns a Geom holding a single triangle around the origin.
+ */
+static PT(Geom)
+make_triangle() {
+  PT(GeomVertexData) vdata = new GeomVertexData
+    ("triangle", GeomVertexFormat::get_v3(), Geom::UH_static);
+  GeomVertexWriter vertex(vdata, InternalName::get_vertex());
+  vertex.add_data3(-1, 0, -1);
+  vertex.add_data3(1, 0, -1);
+  vertex.add_data3(0, 0, 1);
+
+  PT(GeomTriangles) prim = new GeomTriangles(Geom::UH_static);
+  prim->add_vertices(0, 1, 2);
+
+  PT(Geom) geom = new Geom(vdata);
+  geom->add_primitive(prim);
+  return geom;
+}
+
+/**
+ * Adds an object to the bin that draws the indicated Geom at the indicated
+ * distance from the camera.
+ */
+static void
+add_object(CullBin *bin, const Geom *geom, const RenderState *state,
+           PN_stdfloat y) {
+  CullableObject *object = new CullableObject
+    (geom, state, TransformState::make_pos(LVecBase3(0, y, 0)));
+  object->_munged_data = geom->get_vertex_data();
+  bin->add_object(object, Thread::get_current_thread());
+}
+
+/**
+ * Checks that a bin of the indicated type draws the same Geom, repeated with
+ * different transforms, as a single batch.
+ */
+static void
+test_repeated(CullBinManager::BinConstructor *make_bin) {
+  PT(BatchCountingGSG) gsg = new BatchCountingGSG;
+  PStatCollector collector("test");
+  PT(CullBin) bin = (*make_bin)("test", gsg, collector);
+
+  PT(Geom) geom = make_triangle();
+  CPT(RenderState) state = RenderState::make_empty();
+  for (int i = 0; i < 5; ++i) {
+    add_object(bin, geom, state, 10 + i * 7);
+  }
+  bin->finish_cull(nullptr, Thread::get_current_thread());
+  bin->draw(false, Thread::get_current_thread());
+
+  CHECK(gsg->_batches.size() == 1);
+  CHECK(!gsg->_batches.empty() && gsg->_batches[0] == 5);
+}
+
+/**
+ * Checks that the state-sorted bin brings the objects that draw the same Geom
+ * together, even if they were not added one after the other.
+ */
+static void
+test_interleaved() {
+  PT(BatchCountingGSG) gsg = new BatchCountingGSG;
+  PStatCollector collector("test");
+  PT(CullBin) bin = CullBinStateSorted::make_bin("test", gsg, collector);
+
+  PT(Geom) geom_a = make_triangle();
+  PT(Geom) geom_b = make_triangle();
+  CPT(RenderState) state = RenderState::make(ColorAttrib::make_flat(LColor(1, 0, 0, 1)));
+  for (int i = 0; i < 4; ++i) {
+    add_object(bin, geom_a, state, 10 + i);
+    add_object(bin, geom_b, state, 10 + i);
+  }
+  add_object(bin, geom_a, state, 20);
+
+  bin->finish_cull(nullptr, Thread::get_current_thread());
+  bin->draw(false, Thread::get_current_thread());
+
+  CHECK(gsg->_batches.size() == 2);
+  if (gsg->_batches.size() == 2) {
+    CHECK(gsg->_batches[0] + gsg->_batches[1] == 9);
+    CHECK(gsg->_batches[0] == 4 || gsg->_batches[0] == 5);
+  }
+}
+
+/**
+ * Usage: test_cull_batch_instances
+ */
+int
+main(int argc, char *argv[]) {
+  init_libcull();
+  init_libdisplay();
+
+  // This must be set before the bins are made, since the state-sorted bin
+  // decides then whether to sort by Geom.
+  cull_batch_instances.set_value(true);
+
+  test_repeated(&CullBinUnsorted::make_bin);
+  test_repeated(&CullBinStateSorted::make_bin);
+  test_repeated(&CullBinStateHashed::make_bin);
+  test_interleaved();
+
+  cull_batch_instances.clear_local_value();
+
+  if (num_failures != 0) {
+    cerr << num_failures << " checks failed.\n";
+    return 1;
+  }
+  cerr << "All checks passed.\n";
+  return 0;
+}
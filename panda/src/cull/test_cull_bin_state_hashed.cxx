@@ -0,0 +1,149 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_cull_bin_state_hashed.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "config_cull.h"
+#include "config_display.h"
+#include "cullBinStateHashed.h"
+#include "cullBinManager.h"
+#include "cullableObject.h"
+#include "graphicsStateGuardian.h"
+#include "geom.h"
+#include "geomTriangles.h"
+#include "geomVertexData.h"
+#include "geomVertexWriter.h"
+#include "colorAttrib.h"
+#include "renderState.h"
+#include "transformState.h"
+#include "load_prc_file.h"
+
+#include <sstream>
+
+using std::cerr;
+
+static int num_failures = 0;
+
+#define CHECK(condition) \
+  if (!(condition)) { \
+    cerr << "FAILED: " #condition " (line " << __LINE__ << ")\n"; \
+    ++num_failures; \
+  }
+
+/**
+ * Returns a Geom holding a single triangle around the origin.
+ */
+static PT(Geom)
+make_triangle() {
+  PT(GeomVertexData) vdata = new GeomVertexData
+    ("triangle", GeomVertexFormat::get_v3(), Geom::UH_static);
+  GeomVertexWriter vertex(vdata, InternalName::get_vertex());
+  vertex.add_data3(-1, 0, -1);
+  vertex.add_data3(1, 0, -1);
+  vertex.add_data3(0, 0, 1);
+
+  PT(GeomTriangles) prim = new GeomTriangles(Geom::UH_static);
+  prim->add_vertices(0, 1, 2);
+
+  PT(Geom) geom = new Geom(vdata);
+  geom->add_primitive(prim);
+  return geom;
+}
+
+/**
+ * Checks that a cull-bin line with the state_hashed type creates a bin of
+ * that type.  This must run before anything else touches the
+ * CullBinManager, since the config lines are only read when it is created.
+ */
+static void
+test_parse() {
+  load_prc_file_data("test_cull_bin_state_hashed",
+                     "cull-bin hashed_test 25 state_hashed\n");
+
+  CullBinManager *manager = CullBinManager::get_global_ptr();
+  int bin_index = manager->find_bin("hashed_test");
+  CHECK(bin_index != -1);
+  CHECK(manager->get_bin_type(bin_index) == CullBinManager::BT_state_hashed);
+  CHECK(manager->get_bin_sort(bin_index) == 25);
+
+  std::ostringstream strm;
+  strm << manager->get_bin_type(bin_index);
+  CHECK(strm.str() == "state_hashed");
+}
+
+/**
+ * Checks that objects added in mixed states come out grouped by state, in
+ * the order in which the states were first seen, and front-to-back within
+ * each state.
+ */
+static void
+test_grouping() {
+  PT(GraphicsStateGuardian) gsg =
+    new GraphicsStateGuardian(CS_zup_right, nullptr, nullptr);
+  PStatCollector collector("test");
+  PT(CullBin) bin = CullBinStateHashed::make_bin("test", gsg, collector);
+
+  CPT(RenderState) red = RenderState::make(ColorAttrib::make_flat(LColor(1, 0, 0, 1)));
+  CPT(RenderState) blue = RenderState::make(ColorAttrib::make_flat(LColor(0, 0, 1, 1)));
+
+  // The distance to each object is its Y coordinate.
+  static const struct {
+    bool red;
+    PN_stdfloat y;
+  } objects[] = {
+    {true, 30}, {false, 10}, {true, 5}, {false, 40}, {true, 20}, {false, 2},
+  };
+  static const int num_objects = sizeof(objects) / sizeof(objects[0]);
+
+  PT(Geom) geom = make_triangle();
+  for (int i = 0; i < num_objects; ++i) {
+    CullableObject *object = new CullableObject
+      (geom, objects[i].red ? red : blue,
+       TransformState::make_pos(LVecBase3(0, objects[i].y, 0)));
+    object->_munged_data = geom->get_vertex_data();
+    bin->add_object(object, Thread::get_current_thread());
+  }
+  bin->finish_cull(nullptr, Thread::get_current_thread());
+
+  // The result graph has one node per object, since each has its own
+  // transform, in the order in which they will be drawn.
+  PT(PandaNode) result = bin->make_result_graph();
+  CHECK(result->get_num_children() == num_objects);
+  if (result->get_num_children() != num_objects) {
+    return;
+  }
+
+  static const PN_stdfloat expected_y[] = {5, 20, 30, 2, 10, 40};
+  for (int i = 0; i < num_objects; ++i) {
+    PandaNode *child = result->get_child(i);
+    CHECK(child->get_state() == (i < 3 ? red : blue));
+    CHECK(child->get_transform()->get_pos()[1] == expected_y[i]);
+  }
+}
+
+/**
+ * Usage: test_cull_bin_state_hashed
+ */
+int
+main(int argc, char *argv[]) {
+  init_libcull();
+  init_libdisplay();
+
+  test_parse();
+  test_grouping();
+
+  if (num_failures != 0) {
+    cerr << num_failures << " checks failed.\n";
+    return 1;
+  }
+  cerr << "All checks passed.\n";
+  return 0;
+}
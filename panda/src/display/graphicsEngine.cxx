@@ -75,6 +75,7 @@ PStatCollector GraphicsEngine::_do_frame_pcollector("*:do_frame");
 PStatCollector GraphicsEngine::_yield_pcollector("App:Yield");
 PStatCollector GraphicsEngine::_cull_pcollector("Cull");
 PStatCollector GraphicsEngine::_cull_setup_pcollector("Cull:Setup");
+PStatCollector GraphicsEngine::_cull_bounds_pcollector("Cull:Bounds");
 PStatCollector GraphicsEngine::_cull_sort_pcollector("Cull:Sort");
 PStatCollector GraphicsEngine::_draw_pcollector("Draw");
 PStatCollector GraphicsEngine::_sync_pcollector("Draw:Sync");
@@ -855,6 +856,7 @@ render_frame() {
     CullTraverser::_nodes_pcollector.clear_level();
     CullTraverser::_geom_nodes_pcollector.clear_level();
     CullTraverser::_geoms_pcollector.clear_level();
+    CullArena::_bytes_pcollector.clear_level();
     GeomCacheManager::_geom_cache_active_pcollector.clear_level();
     GeomCacheManager::_geom_cache_record_pcollector.clear_level();
     GeomCacheManager::_geom_cache_erase_pcollector.clear_level();
@@ -1392,6 +1394,59 @@ set_window_sort(GraphicsOutput *window, int sort) {
   _windows_sorted = false;
 }
 
+/**
+ * Called at the start of the cull for a list of windows to bring the bounding
+ * volumes of all of the scenes to be rendered up-to-date in one bottom-up
+ * pass.  Nodes that have changed since the last frame have already marked
+ * themselves and their ancestors stale; this recomputes each stale subgraph
+ * once, before the traversal starts visiting it.
+ */
+void GraphicsEngine::
+update_scene_bounds(const GraphicsEngine::Windows &wlist,
+                    Thread *current_thread) {
+  if (!batch_bounds_update) {
+    return;
+  }
+
+  PStatTimer timer(_cull_bounds_pcollector, current_thread);
+
+  size_t wlist_size = wlist.size();
+  for (size_t wi = 0; wi < wlist_size; ++wi) {
+    GraphicsOutput *win = wlist[wi];
+    if (!win->is_active() || !win->get_gsg()->is_active()) {
+      continue;
+    }
+    int num_display_regions = win->get_num_active_display_regions();
+    for (int i = 0; i < num_display_regions; ++i) {
+      PT(DisplayRegion) dr = win->get_active_display_region(i);
+      if (dr == nullptr) {
+        continue;
+      }
+      NodePath camera = dr->get_camera(current_thread);
+      if (camera.is_empty()) {
+        continue;
+      }
+      Camera *camera_node;
+      DCAST_INTO_V(camera_node, camera.node());
+      if (!camera_node->is_active()) {
+        continue;
+      }
+
+      NodePath scene_root = camera_node->get_scene();
+      if (scene_root.is_empty()) {
+        scene_root = camera.get_top(current_thread);
+      }
+
+      // If several display regions share this scene, only the first one
+      // finds anything stale.
+      PandaNode *node = scene_root.node();
+      if (node->is_bounds_stale()) {
+        node->get_bounds(current_thread);
+      }
+    }
+  }
+}
+
 /**
  * This is called in the cull+draw thread by individual RenderThread objects
  * during the frame rendering.  It culls the geometry and immediately draws
@@ -1403,6 +1458,8 @@ cull_and_draw_together(GraphicsEngine::Windows wlist,
                        Thread *current_thread) {
   PStatTimer timer(_cull_pcollector, current_thread);
 
+  update_scene_bounds(wlist, current_thread);
+
   size_t wlist_size = wlist.size();
   for (size_t wi = 0; wi < wlist_size; ++wi) {
     GraphicsOutput *win = wlist[wi];
@@ -1522,6 +1579,8 @@ void GraphicsEngine::
 cull_to_bins(GraphicsEngine::Windows wlist, Thread *current_thread) {
   PStatTimer timer(_cull_pcollector, current_thread);
 
+  update_scene_bounds(wlist, current_thread);
+
   _singular_warning_last_frame = _singular_warning_this_frame;
   _singular_warning_this_frame = false;
 
@@ -1658,6 +1717,10 @@ cull_to_bins(GraphicsOutput *win, GraphicsStateGuardian *gsg,
              DisplayRegion *dr, SceneSetup *scene_setup,
              CullResult *cull_result, Thread *current_thread) {
 
+  // Objects generated by this traversal are allocated from the CullResult's
+  // arena, which is released wholesale once the result has been drawn.
+  CullArena::Scope arena_scope(cull_result->get_arena());
+
   BinCullHandler cull_handler(cull_result);
   CallbackObject *cbobj = dr->get_cull_callback();
   if (cbobj != nullptr) {
@@ -146,6 +146,7 @@ private:
 
   void set_window_sort(GraphicsOutput *window, int sort);
 
+  void update_scene_bounds(const Windows &wlist, Thread *current_thread);
   void cull_and_draw_together(Windows wlist, Thread *current_thread);
   void cull_and_draw_together(GraphicsOutput *win, DisplayRegion *dr,
                               Thread *current_thread);
@@ -364,6 +365,7 @@ private:
   static PStatCollector _yield_pcollector;
   static PStatCollector _cull_pcollector;
   static PStatCollector _cull_setup_pcollector;
+  static PStatCollector _cull_bounds_pcollector;
   static PStatCollector _cull_sort_pcollector;
   static PStatCollector _draw_pcollector;
   static PStatCollector _sync_pcollector;
@@ -87,6 +87,8 @@ PStatCollector GraphicsStateGuardian::_vertices_trifan_pcollector("Vertices:Tria
 PStatCollector GraphicsStateGuardian::_vertices_tri_pcollector("Vertices:Triangles");
 PStatCollector GraphicsStateGuardian::_vertices_patch_pcollector("Vertices:Patches");
 PStatCollector GraphicsStateGuardian::_vertices_other_pcollector("Vertices:Other");
+PStatCollector GraphicsStateGuardian::_instanced_objects_pcollector("Instanced objects");
+PStatCollector GraphicsStateGuardian::_instanced_draws_pcollector("Instanced draws");
 PStatCollector GraphicsStateGuardian::_state_pcollector("State changes");
 PStatCollector GraphicsStateGuardian::_transform_state_pcollector("State changes:Transforms");
 PStatCollector GraphicsStateGuardian::_texture_state_pcollector("State changes:Textures");
@@ -2528,6 +2530,28 @@ end_draw_primitives() {
   _data_reader = nullptr;
 }
 
+/**
+ * Draws the same Geom several times in the same state, once with each of the
+ * indicated transforms.  This is called by the cull bins when they find a run
+ * of objects that differ only in their transform, so that the state need
+ * only be set once.  The default implementation simply draws each instance in
+ * turn; a GSG may override this to do better.
+ */
+void GraphicsStateGuardian::
+draw_instances(const GeomPipelineReader *geom_reader,
+               const GeomVertexDataPipelineReader *data_reader,
+               const RenderState *state,
+               const TransformState * const *transforms,
+               size_t num_instances, bool force) {
+  _instanced_objects_pcollector.add_level(num_instances);
+  _instanced_draws_pcollector.add_level(num_instances);
+
+  for (size_t i = 0; i < num_instances; ++i) {
+    set_state_and_transform(state, transforms[i]);
+    geom_reader->draw(this, data_reader, force);
+  }
+}
+
 /**
  * Resets all internal state as if the gsg were newly created.
  */
@@ -2959,6 +2983,9 @@ init_frame_pstats() {
     _vertices_patch_pcollector.clear_level();
     _vertices_other_pcollector.clear_level();
 
+    _instanced_objects_pcollector.clear_level();
+    _instanced_draws_pcollector.clear_level();
+
     _state_pcollector.clear_level();
     _transform_state_pcollector.clear_level();
     _texture_state_pcollector.clear_level();
@@ -398,6 +398,12 @@ public:
                            bool force);
   virtual void end_draw_primitives();
 
+  virtual void draw_instances(const GeomPipelineReader *geom_reader,
+                              const GeomVertexDataPipelineReader *data_reader,
+                              const RenderState *state,
+                              const TransformState * const *transforms,
+                              size_t num_instances, bool force);
+
   INLINE bool reset_if_new();
   INLINE void mark_new();
   virtual void reset();
@@ -687,6 +693,8 @@ public:
   static PStatCollector _vertices_patch_pcollector;
   static PStatCollector _vertices_other_pcollector;
   static PStatCollector _vertices_indexed_tristrip_pcollector;
+  static PStatCollector _instanced_objects_pcollector;
+  static PStatCollector _instanced_draws_pcollector;
   static PStatCollector _state_pcollector;
   static PStatCollector _transform_state_pcollector;
   static PStatCollector _texture_state_pcollector;
@@ -194,6 +194,14 @@ ConfigVariableBool egg_implicit_alpha_binary
           "will automatically be downgraded to alpha type \"binary\" instead of "
           "whatever appears in the egg file."));
 
+ConfigVariableInt egg_load_threads
+("egg-load-threads", 0,
+ PRC_DESC("The number of worker threads that the egg loader may use to read "
+          "the texture images and to convert the polysets of a large egg "
+          "file to Geoms.  The resulting scene graph is the same as when "
+          "this is 0, in which case everything is done on the loading "
+          "thread."));
+
 ConfigureFn(config_egg2pg) {
   init_libegg2pg();
 }
@@ -96,6 +96,9 @@
 #include "uvScrollNode.h"
 #include "textureStagePool.h"
 #include "cmath.h"
+#include "genericAsyncTask.h"
+#include "asyncTaskManager.h"
+#include "lightMutexHolder.h"
 
 #include <ctype.h>
 #include <algorithm>
@@ -144,6 +147,8 @@ EggLoader() {
   _error = false;
   _dynamic_override = false;
   _dynamic_override_char_maker = nullptr;
+  _num_threads = 0;
+  _defer_polysets = false;
 }
 
 /**
@@ -156,6 +161,8 @@ EggLoader(const EggData *data) :
   _error = false;
   _dynamic_override = false;
   _dynamic_override_char_maker = nullptr;
+  _num_threads = 0;
+  _defer_polysets = false;
 }
 
 
@@ -172,7 +179,14 @@ build_graph() {
     return;
   }
 
-  // Now, load up all of the textures.
+  _num_threads = 0;
+  if (Thread::is_threading_supported()) {
+    _num_threads = max((int)egg_load_threads, 0);
+  }
+
+  // Now, load up all of the textures.  If we have worker threads, the images
+  // are read on them, several at once.
+  start_texture_reads();
   load_textures();
 
   // Clean up the vertices.
@@ -207,11 +221,18 @@ build_graph() {
   // Now build up the scene graph.
   _root = new ModelRoot(_data->get_egg_filename(), _data->get_egg_timestamp());
 
+  // If we have worker threads, the polysets are only set aside while we build
+  // the scene graph, and the static ones converted all at once afterwards.
+  _defer_polysets = (_num_threads > 0);
+
   EggGroupNode::const_iterator ci;
   for (ci = _data->begin(); ci != _data->end(); ++ci) {
     make_node(*ci, _root);
   }
 
+  _defer_polysets = false;
+  finish_polysets();
+
   reparent_decals();
   start_sequences();
 
@@ -322,11 +343,69 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
 
   // Generate an optimal vertex pool (or multiple vertex pools, if we have a
   // lot of vertex) for the polygons within just the bin.  Each EggVertexPool
-  // translates directly to an optimal GeomVertexData structure.
-  EggVertexPools vertex_pools;
-  egg_bin->rebuild_vertex_pools(vertex_pools, (unsigned int)egg_max_vertices,
+  // translates directly to an optimal GeomVertexData structure.  This moves
+  // the primitives out of vertex pools that may be shared with other bins, so
+  // it must be done here, on the loading thread.
+  PolysetJob job;
+  job._loader = this;
+  job._egg_bin = egg_bin;
+  job._first_prim = first_prim;
+  job._render_state = render_state;
+  job._is_dynamic = is_dynamic;
+  job._character_maker = character_maker;
+  job._built = false;
+  egg_bin->rebuild_vertex_pools(job._vertex_pools, (unsigned int)egg_max_vertices,
                                 false);
 
+  if (transform != nullptr) {
+    job._transform = (*transform);
+  } else {
+    job._transform = egg_bin->get_vertex_to_node();
+  }
+
+  if (_defer_polysets && character_maker == nullptr) {
+    // Everything from here on only involves the primitives of this bin, so
+    // it can be left for a worker thread.  We do create the GeomNode now,
+    // though, so that it takes the same place among its siblings that it
+    // would have otherwise; finish_polyset() removes it again if it turns
+    // out to have no Geoms.  A dynamic polyset is built right away, but is
+    // still added to the scene graph in its turn, so that its Geoms are
+    // added to a shared parent GeomNode in the same order as the others.
+    if (is_dynamic) {
+      build_polyset(job);
+      job._built = true;
+    }
+    if (parent->is_geom_node() && !render_state->_hidden) {
+      job._geom_node = DCAST(GeomNode, parent);
+    } else {
+      job._geom_node = new GeomNode(egg_bin->get_name());
+      job._reserved_parent = parent;
+      if (render_state->_hidden) {
+        parent->add_stashed(job._geom_node);
+      } else {
+        parent->add_child(job._geom_node);
+      }
+    }
+    _polyset_jobs.push_back(job);
+    return;
+  }
+
+  build_polyset(job);
+  finish_polyset(job, parent);
+}
+
+/**
+ * Does the work of make_polyset() that involves only the primitives of the
+ * bin: meshes them, and converts each of its vertex pools into a Geom.  The
+ * Geoms are stored in the job, to be added to the scene graph by
+ * finish_polyset().  For static polysets, this may be called on a worker
+ * thread.
+ */
+void EggLoader::
+build_polyset(PolysetJob &job) {
+  EggBin *egg_bin = job._egg_bin;
+  const EggRenderState *render_state = job._render_state;
+
   if (egg_mesh) {
     // If we're using the mesher, mesh now.
     egg_bin->mesh_triangles(render_state->_flat_shaded ? EggGroupNode::T_flat_shaded : 0);
@@ -344,13 +423,11 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
 
   // egg_bin->write(cerr, 0);
 
-  PT(GeomNode) geom_node;
-
   // Now iterate through each EggVertexPool.  Normally, there's only one, but
   // if we have a really big mesh, it might have been split into multiple
   // vertex pools (to keep each one within the egg_max_vertices constraint).
   EggVertexPools::iterator vpi;
-  for (vpi = vertex_pools.begin(); vpi != vertex_pools.end(); ++vpi) {
+  for (vpi = job._vertex_pools.begin(); vpi != job._vertex_pools.end(); ++vpi) {
     EggVertexPool *vertex_pool = (*vpi);
     vertex_pool->remove_unused_vertices();
     // vertex_pool->write(cerr, 0);
@@ -366,10 +443,10 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
     }
 
     PT(TransformBlendTable) blend_table;
-    if (is_dynamic) {
+    if (job._is_dynamic) {
       // Dynamic vertex pools will require a TransformBlendTable to indicate
       // how the vertices are to be animated.
-      blend_table = make_blend_table(vertex_pool, egg_bin, character_maker);
+      blend_table = make_blend_table(vertex_pool, egg_bin, job._character_maker);
 
       // Now that we've created the blend table, we can re-order the vertices
       // in the pool to efficiently group vertices together that will share
@@ -383,6 +460,7 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
     // of primitives that reference this vertex pool.
     UniquePrimitives unique_primitives;
     Primitives primitives;
+    EggGroupNode::const_iterator ci;
     for (ci = egg_bin->begin(); ci != egg_bin->end(); ++ci) {
       EggPrimitive *egg_prim;
       DCAST_INTO_V(egg_prim, (*ci));
@@ -393,17 +471,11 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
     }
 
     if (!primitives.empty()) {
-      LMatrix4d mat;
-      if (transform != nullptr) {
-        mat = (*transform);
-      } else {
-        mat = egg_bin->get_vertex_to_node();
-      }
-
       // Now convert this vertex pool to a GeomVertexData.
       PT(GeomVertexData) vertex_data =
-        make_vertex_data(render_state, vertex_pool, egg_bin, mat, blend_table,
-                         is_dynamic, character_maker, has_overall_color);
+        make_vertex_data(render_state, vertex_pool, egg_bin, job._transform,
+                         blend_table, job._is_dynamic, job._character_maker,
+                         has_overall_color);
       nassertv(vertex_data != nullptr);
 
       // And create a Geom to hold the primitives.
@@ -426,24 +498,6 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
         // vertex_data->write(cerr); geom->write(cerr);
         // render_state->_state->write(cerr, 0);
 
-      // Create a new GeomNode if we haven't already.
-      if (geom_node == nullptr) {
-        // Now, is our parent node a GeomNode, or just an ordinary PandaNode?
-        // If it's a GeomNode, we can add the new Geom directly to our parent;
-        // otherwise, we need to create a new node.
-        if (parent->is_geom_node() && !render_state->_hidden) {
-          geom_node = DCAST(GeomNode, parent);
-
-        } else {
-          geom_node = new GeomNode(egg_bin->get_name());
-          if (render_state->_hidden) {
-            parent->add_stashed(geom_node);
-          } else {
-            parent->add_child(geom_node);
-          }
-        }
-      }
-
       CPT(RenderState) geom_state = render_state->_state;
       if (has_overall_color) {
         if (!overall_color.almost_equal(LColor(1.0f, 1.0f, 1.0f, 1.0f))) {
@@ -453,19 +507,147 @@ make_polyset(EggBin *egg_bin, PandaNode *parent, const LMatrix4d *transform,
         geom_state = geom_state->add_attrib(ColorAttrib::make_vertex(), -1);
       }
 
-      geom_node->add_geom(geom, geom_state);
+      job._geoms.push_back(geom);
+      job._geom_states.push_back(geom_state);
+    }
+  }
+}
+
+/**
+ * Adds the Geoms made by build_polyset() to the scene graph, under the
+ * indicated parent.
+ */
+void EggLoader::
+finish_polyset(PolysetJob &job, PandaNode *parent) {
+  const EggRenderState *render_state = job._render_state;
+
+  if (job._geoms.empty()) {
+    if (job._reserved_parent != nullptr) {
+      // We made a GeomNode for nothing; take it out again.
+      if (render_state->_hidden) {
+        int stashed = parent->find_stashed(job._geom_node);
+        if (stashed >= 0) {
+          parent->remove_stashed(stashed);
+        }
+      } else {
+        parent->remove_child(job._geom_node);
+      }
+    }
+    return;
+  }
+
+  // Create a new GeomNode if we haven't already.
+  if (job._geom_node == nullptr) {
+    // Now, is our parent node a GeomNode, or just an ordinary PandaNode?  If
+    // it's a GeomNode, we can add the new Geom directly to our parent;
+    // otherwise, we need to create a new node.
+    if (parent->is_geom_node() && !render_state->_hidden) {
+      job._geom_node = DCAST(GeomNode, parent);
+
+    } else {
+      job._geom_node = new GeomNode(job._egg_bin->get_name());
+      if (render_state->_hidden) {
+        parent->add_stashed(job._geom_node);
+      } else {
+        parent->add_child(job._geom_node);
+      }
     }
   }
 
-  if (geom_node != nullptr && egg_show_normals) {
+  for (size_t i = 0; i < job._geoms.size(); ++i) {
+    job._geom_node->add_geom(job._geoms[i], job._geom_states[i]);
+  }
+
+  if (egg_show_normals) {
     // Create some more geometry to visualize each normal.
-    for (vpi = vertex_pools.begin(); vpi != vertex_pools.end(); ++vpi) {
+    EggVertexPools::iterator vpi;
+    for (vpi = job._vertex_pools.begin(); vpi != job._vertex_pools.end(); ++vpi) {
       EggVertexPool *vertex_pool = (*vpi);
-      show_normals(vertex_pool, geom_node);
+      show_normals(vertex_pool, job._geom_node);
     }
   }
 }
 
+/**
+ * Builds the polysets that were set aside by make_polyset() while the scene
+ * graph was being built, dividing them among the worker threads, and then
+ * adds them to the scene graph in the order in which they were set aside.
+ */
+void EggLoader::
+finish_polysets() {
+  if (_polyset_jobs.empty()) {
+    return;
+  }
+
+  size_t num_jobs = _polyset_jobs.size();
+  size_t num_batches = 1;
+  if (_num_threads > 0) {
+    // Several batches per thread, since polysets vary a great deal in size.
+    num_batches = min(num_jobs, (size_t)_num_threads * 4);
+  }
+
+  _polyset_batches.resize(num_batches);
+  for (size_t bi = 0; bi < num_batches; ++bi) {
+    PolysetBatch &batch = _polyset_batches[bi];
+    batch._loader = this;
+    batch._begin = num_jobs * bi / num_batches;
+    batch._end = num_jobs * (bi + 1) / num_batches;
+  }
+
+  if (num_batches == 1) {
+    st_build_polysets(nullptr, &_polyset_batches[0]);
+
+  } else {
+    AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+    PT(AsyncTaskChain) chain = task_mgr->make_task_chain("egg_loader");
+    if (chain->get_num_threads() < _num_threads) {
+      chain->set_num_threads(_num_threads);
+    }
+
+    pvector< PT(AsyncTask) > tasks;
+    for (size_t bi = 1; bi < num_batches; ++bi) {
+      PT(GenericAsyncTask) task =
+        new GenericAsyncTask("egg_polysets", &st_build_polysets, &_polyset_batches[bi]);
+      task->set_task_chain(chain->get_name());
+      task_mgr->add(task);
+      tasks.push_back(task);
+    }
+    st_build_polysets(nullptr, &_polyset_batches[0]);
+    for (size_t ti = 0; ti < tasks.size(); ++ti) {
+      tasks[ti]->wait();
+    }
+  }
+
+  PolysetJobs::iterator ji;
+  for (ji = _polyset_jobs.begin(); ji != _polyset_jobs.end(); ++ji) {
+    PolysetJob &job = (*ji);
+    PandaNode *parent = job._reserved_parent;
+    if (parent == nullptr) {
+      parent = job._geom_node;
+    }
+    finish_polyset(job, parent);
+  }
+
+  _polyset_jobs.clear();
+  _polyset_batches.clear();
+}
+
+/**
+ * The task function that builds one PolysetBatch.
+ */
+AsyncTask::DoneStatus EggLoader::
+st_build_polysets(GenericAsyncTask *, void *data) {
+  PolysetBatch *batch = (PolysetBatch *)data;
+  EggLoader *loader = batch->_loader;
+  for (size_t i = batch->_begin; i < batch->_end; ++i) {
+    PolysetJob &job = loader->_polyset_jobs[i];
+    if (!job._built) {
+      loader->build_polyset(job);
+    }
+  }
+  return AsyncTask::DS_done;
+}
+
 /**
  * Creates a TransformState object corresponding to the indicated
  * EggTransform.
@@ -848,11 +1030,73 @@ make_nurbs_surface(EggNurbsSurface *egg_surface, PandaNode *parent,
   parent->add_child(sheet);
 }
 
+/**
+ * Starts reading the images of all of the textures that are referenced, on
+ * the worker threads.  load_textures() waits for them to be read.  This does
+ * nothing if there are no worker threads.
+ */
+void EggLoader::
+start_texture_reads() {
+  _texture_reads.clear();
+  if (_num_threads == 0) {
+    return;
+  }
+
+  EggTextureCollection tc;
+  tc.find_used_textures(_data);
+  if (tc.size() < 2) {
+    return;
+  }
+
+  _texture_reads.resize(tc.size());
+  TextureReads::iterator ri = _texture_reads.begin();
+  EggTextureCollection::iterator ti;
+  for (ti = tc.begin(); ti != tc.end(); ++ti) {
+    (*ri)._egg_tex = (*ti);
+    ++ri;
+  }
+
+  AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+  PT(AsyncTaskChain) chain = task_mgr->make_task_chain("egg_loader");
+  if (chain->get_num_threads() < _num_threads) {
+    chain->set_num_threads(_num_threads);
+  }
+
+  for (ri = _texture_reads.begin(); ri != _texture_reads.end(); ++ri) {
+    PT(GenericAsyncTask) task =
+      new GenericAsyncTask("egg_texture", &st_read_texture, &(*ri));
+    task->set_task_chain(chain->get_name());
+    task_mgr->add(task);
+    _texture_tasks.push_back(task);
+  }
+}
+
+/**
+ * The task function that reads the image of one TextureRead.
+ */
+AsyncTask::DoneStatus EggLoader::
+st_read_texture(GenericAsyncTask *, void *data) {
+  TextureRead *read = (TextureRead *)data;
+  read->_tex = read_texture(read->_egg_tex, read->_wanted_alpha);
+  return AsyncTask::DS_done;
+}
+
 /**
  *
  */
 void EggLoader::
 load_textures() {
+  // Wait for any images that start_texture_reads() is reading.
+  pmap<const EggTexture *, const TextureRead *> reads;
+  for (size_t i = 0; i < _texture_tasks.size(); ++i) {
+    _texture_tasks[i]->wait();
+  }
+  _texture_tasks.clear();
+  TextureReads::const_iterator ri;
+  for (ri = _texture_reads.begin(); ri != _texture_reads.end(); ++ri) {
+    reads[(*ri)._egg_tex] = &(*ri);
+  }
+
   // First, collect all the textures that are referenced.
   EggTextureCollection tc;
   tc.find_used_textures(_data);
@@ -861,24 +1105,36 @@ load_textures() {
   for (ti = tc.begin(); ti != tc.end(); ++ti) {
     PT_EggTexture egg_tex = (*ti);
 
+    const TextureRead *read = nullptr;
+    pmap<const EggTexture *, const TextureRead *>::const_iterator rdi;
+    rdi = reads.find(egg_tex);
+    if (rdi != reads.end()) {
+      read = (*rdi).second;
+    }
+
     TextureDef def;
-    if (load_texture(def, egg_tex)) {
+    if (load_texture(def, egg_tex, read)) {
       // Now associate the pointers, so we'll be able to look up the Texture
       // pointer given an EggTexture pointer, later.
       _textures[egg_tex] = def;
     }
   }
+
+  _texture_reads.clear();
 }
 
 
 /**
- *
+ * Reads the image of the indicated texture from disk, or fetches it from the
+ * TexturePool, according to the properties specified in the egg file.  Sets
+ * wanted_alpha to true if the texture's alpha file, if any, is wanted.  This
+ * does not touch the EggLoader, so it may be called from a worker thread.
  */
-bool EggLoader::
-load_texture(TextureDef &def, EggTexture *egg_tex) {
+PT(Texture) EggLoader::
+read_texture(const EggTexture *egg_tex, bool &wanted_alpha) {
   // Check to see if we should reduce the number of channels in the texture.
   int wanted_channels = 0;
-  bool wanted_alpha = false;
+  wanted_alpha = false;
   switch (egg_tex->get_format()) {
   case EggTexture::F_red:
   case EggTexture::F_green:
@@ -918,16 +1174,6 @@ load_texture(TextureDef &def, EggTexture *egg_tex) {
     wanted_alpha = egg_tex->has_alpha_filename();
   }
 
-  // Since some properties of the textures are inferred from the texture files
-  // themselves (if the properties are not explicitly specified in the egg
-  // file), then we add the textures as dependents for the egg file.
-  if (_record != nullptr) {
-    _record->add_dependent_file(egg_tex->get_fullpath());
-    if (egg_tex->has_alpha_filename() && wanted_alpha) {
-      _record->add_dependent_file(egg_tex->get_alpha_fullpath());
-    }
-  }
-
   // By convention, the egg loader will preload the simple texture images.
   LoaderOptions options;
   if (egg_preload_simple_textures) {
@@ -993,6 +1239,35 @@ load_texture(TextureDef &def, EggTexture *egg_tex) {
     break;
   }
 
+
+  return tex;
+}
+
+/**
+ * Loads the indicated texture and sets up its TextureDef.  If read is not
+ * NULL, it holds the texture image already read by start_texture_reads().
+ */
+bool EggLoader::
+load_texture(TextureDef &def, EggTexture *egg_tex, const TextureRead *read) {
+  PT(Texture) tex;
+  bool wanted_alpha;
+  if (read != nullptr) {
+    tex = read->_tex;
+    wanted_alpha = read->_wanted_alpha;
+  } else {
+    tex = read_texture(egg_tex, wanted_alpha);
+  }
+
+  // Since some properties of the textures are inferred from the texture files
+  // themselves (if the properties are not explicitly specified in the egg
+  // file), then we add the textures as dependents for the egg file.
+  if (_record != nullptr) {
+    _record->add_dependent_file(egg_tex->get_fullpath());
+    if (egg_tex->has_alpha_filename() && wanted_alpha) {
+      _record->add_dependent_file(egg_tex->get_alpha_fullpath());
+    }
+  }
+
   if (tex == nullptr) {
     return false;
   }
@@ -2163,10 +2438,14 @@ make_vertex_data(const EggRenderState *render_state,
   vpt._bake_in_uvs = render_state->_bake_in_uvs;
   vpt._transform = transform;
 
-  VertexPoolData::iterator di;
-  di = _vertex_pool_data.find(vpt);
-  if (di != _vertex_pool_data.end()) {
-    return (*di).second;
+  {
+    // Polysets may be built on several threads at once.
+    LightMutexHolder holder(_vertex_pool_data_lock);
+    VertexPoolData::iterator di;
+    di = _vertex_pool_data.find(vpt);
+    if (di != _vertex_pool_data.end()) {
+      return (*di).second;
+    }
   }
 
   PT(GeomVertexArrayFormat) array_format = new GeomVertexArrayFormat;
@@ -2456,12 +2735,14 @@ make_vertex_data(const EggRenderState *render_state,
     }
   }
 
-  bool inserted = _vertex_pool_data.insert
-    (VertexPoolData::value_type(vpt, vertex_data)).second;
-  nassertr(inserted, vertex_data);
+  // Another thread may have built the same vertex data while we were working
+  // on it, in which case we use the one that got there first.
+  LightMutexHolder holder(_vertex_pool_data_lock);
+  std::pair<VertexPoolData::iterator, bool> result = _vertex_pool_data.insert
+    (VertexPoolData::value_type(vpt, vertex_data));
 
   Thread::consider_yield();
-  return vertex_data;
+  return (*result.first).second;
 }
 
 /**
@@ -37,6 +37,13 @@
 #include "geomVertexData.h"
 #include "geomPrimitive.h"
 #include "bamCacheRecord.h"
+#include "eggBin.h"
+#include "eggPrimitive.h"
+#include "geomNode.h"
+#include "geom.h"
+#include "renderState.h"
+#include "asyncTask.h"
+#include "lightMutex.h"
 
 class EggNode;
 class EggBin;
@@ -56,6 +63,7 @@ class OccluderNode;
 class PolylightNode;
 class EggRenderState;
 class CharacterMaker;
+class GenericAsyncTask;
 
 
 /**
@@ -95,6 +103,49 @@ private:
   // This structure is returned by setup_bucket().
   typedef pmap<CPT(InternalName), const EggTexture *> BakeInUVs;
 
+  // A polyset whose conversion to Geoms has been deferred by make_polyset(),
+  // so that it may be done on a worker thread.
+  class PolysetJob {
+  public:
+    EggLoader *_loader;
+    PT(EggBin) _egg_bin;
+    CPT(EggPrimitive) _first_prim;
+    const EggRenderState *_render_state;
+    LMatrix4d _transform;
+    bool _is_dynamic;
+    CharacterMaker *_character_maker;
+    EggVertexPools _vertex_pools;
+
+    // True if build_polyset() has already been called for this job.
+    bool _built;
+
+    // The GeomNode that receives the Geoms, and the parent it was added to
+    // in advance, if it was created for this polyset.
+    PT(GeomNode) _geom_node;
+    PT(PandaNode) _reserved_parent;
+
+    pvector< PT(Geom) > _geoms;
+    pvector< CPT(RenderState) > _geom_states;
+  };
+  typedef pvector<PolysetJob> PolysetJobs;
+
+  // A range of the PolysetJobs that is handed to a worker thread.
+  class PolysetBatch {
+  public:
+    EggLoader *_loader;
+    size_t _begin;
+    size_t _end;
+  };
+
+  // A texture image that is read on a worker thread by start_texture_reads().
+  class TextureRead {
+  public:
+    PT_EggTexture _egg_tex;
+    PT(Texture) _tex;
+    bool _wanted_alpha;
+  };
+  typedef pvector<TextureRead> TextureReads;
+
   // This is used by make_primitive().
   class PrimitiveUnifier {
   public:
@@ -107,6 +158,11 @@ private:
   typedef pmap<PrimitiveUnifier, PT(GeomPrimitive) > UniquePrimitives;
   typedef pvector< PT(GeomPrimitive) > Primitives;
 
+  void build_polyset(PolysetJob &job);
+  void finish_polyset(PolysetJob &job, PandaNode *parent);
+  void finish_polysets();
+  static AsyncTask::DoneStatus st_build_polysets(GenericAsyncTask *task, void *data);
+
   void show_normals(EggVertexPool *vertex_pool, GeomNode *geom_node);
 
   void make_nurbs_curve(EggNurbsCurve *egg_curve, PandaNode *parent,
@@ -116,8 +172,12 @@ private:
   void make_nurbs_surface(EggNurbsSurface *egg_surface, PandaNode *parent,
                           const LMatrix4d &mat);
 
+  void start_texture_reads();
+  static AsyncTask::DoneStatus st_read_texture(GenericAsyncTask *task, void *data);
   void load_textures();
-  bool load_texture(TextureDef &def, EggTexture *egg_tex);
+  bool load_texture(TextureDef &def, EggTexture *egg_tex,
+                    const TextureRead *read = nullptr);
+  static PT(Texture) read_texture(const EggTexture *egg_tex, bool &wanted_alpha);
   void apply_texture_attributes(Texture *tex, const EggTexture *egg_tex);
   Texture::CompressionMode convert_compression_mode(EggTexture::CompressionMode compression_mode) const;
   SamplerState::WrapMode convert_wrap_mode(EggTexture::WrapMode wrap_mode) const;
@@ -249,6 +309,15 @@ private:
   };
   typedef pmap<VertexPoolTransform, PT(GeomVertexData) > VertexPoolData;
   VertexPoolData _vertex_pool_data;
+  LightMutex _vertex_pool_data_lock;
+
+  // These support the conversion on worker threads; see egg-load-threads.
+  int _num_threads;
+  bool _defer_polysets;
+  PolysetJobs _polyset_jobs;
+  pvector<PolysetBatch> _polyset_batches;
+  TextureReads _texture_reads;
+  pvector< PT(AsyncTask) > _texture_tasks;
 
   typedef pmap<LMatrix4, CPT(TransformState) > TransformStates;
   TransformStates _transform_states;
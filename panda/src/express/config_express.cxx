@@ -122,6 +122,10 @@ init_libexpress() {
 
   init_system_type_handles();
 
+  // Datagram buffers are allocated with the Datagram type handle; count them
+  // against the networking memory tag.
+  Datagram::get_class_type().set_memory_tag(MemoryHook::MT_network);
+
 #ifdef HAVE_ZLIB
   {
     PandaSystem *ps = PandaSystem::get_global_ptr();
@@ -101,11 +101,11 @@ pad_bytes(size_t size) {
 
   if (_data == nullptr) {
     // Create a new array.
-    _data = PTA_uchar::empty_array(0);
+    _data = PTA_uchar::empty_array(0, get_class_type());
 
   } else if (_data.get_ref_count() != 1) {
     // Copy on write.
-    PTA_uchar new_data = PTA_uchar::empty_array(0);
+    PTA_uchar new_data = PTA_uchar::empty_array(0, get_class_type());
     new_data.v() = _data.v();
     _data = new_data;
   }
@@ -131,11 +131,11 @@ append_data(const void *data, size_t size) {
 
   if (_data == nullptr) {
     // Create a new array.
-    _data = PTA_uchar::empty_array(0);
+    _data = PTA_uchar::empty_array(0, get_class_type());
 
   } else if (_data.get_ref_count() != 1) {
     // Copy on write.
-    PTA_uchar new_data = PTA_uchar::empty_array(0);
+    PTA_uchar new_data = PTA_uchar::empty_array(0, get_class_type());
     new_data.v() = _data.v();
     _data = new_data;
   }
@@ -159,7 +159,7 @@ void Datagram::
 assign(const void *data, size_t size) {
   nassertv((int)size >= 0);
 
-  _data = PTA_uchar::empty_array(0);
+  _data = PTA_uchar::empty_array(0, get_class_type());
   _data.v().insert(_data.v().end(), (const unsigned char *)data,
                    (const unsigned char *)data + size);
 }
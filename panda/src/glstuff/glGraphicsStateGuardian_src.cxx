@@ -5786,6 +5786,68 @@ end_draw_primitives() {
   report_my_gl_errors();
 }
 
+/**
+ * Draws the same Geom several times in the same state, once with each of the
+ * indicated transforms.  The vertex arrays are only set up once; between the
+ * instances, only the modelview matrix (or the transform inputs of the
+ * current shader) is reloaded.
+ */
+void CLP(GraphicsStateGuardian)::
+draw_instances(const GeomPipelineReader *geom_reader,
+               const GeomVertexDataPipelineReader *data_reader,
+               const RenderState *state,
+               const TransformState * const *transforms,
+               size_t num_instances, bool force) {
+  set_state_and_transform(state, transforms[0]);
+
+  // Some things are tied to the transform in effect when the state is
+  // issued, or compiled into a display list along with the vertices; these
+  // have to be drawn one at a time.
+  bool separate = data_reader->is_vertex_transformed();
+  const TexGenAttrib *tex_gen;
+  if (state->get_attrib(tex_gen) && !tex_gen->is_empty()) {
+    separate = true;
+  }
+#if !defined(OPENGLES) && defined(SUPPORT_FIXED_FUNCTION)
+  if (has_fixed_function_pipeline() && display_lists &&
+      data_reader->get_usage_hint() == Geom::UH_static) {
+    separate = true;
+  }
+#endif
+  if (separate) {
+    GraphicsStateGuardian::draw_instances(geom_reader, data_reader, state,
+                                          transforms, num_instances, force);
+    return;
+  }
+
+  _instanced_objects_pcollector.add_level(num_instances);
+
+  if (!begin_draw_primitives(geom_reader, data_reader, force)) {
+    return;
+  }
+
+  // The vertex arrays are only set up once, but each instance is still drawn
+  // with its own draw call, since the transform can't be passed per instance
+  // without a shader that expects it.
+
+  for (size_t i = 0; i < num_instances; ++i) {
+    if (transforms[i] != _internal_transform) {
+      _transform_state_pcollector.add_level(1);
+      _internal_transform = transforms[i];
+      do_issue_transform();
+#ifndef OPENGLES_1
+      if (_current_shader_context != nullptr) {
+        _current_shader_context->set_state_and_transform(state, _internal_transform, _scene_setup->get_camera_transform(), _projection_mat);
+      }
+#endif
+    }
+    geom_reader->draw_primitives(this, data_reader, force);
+    _instanced_draws_pcollector.add_level(1);
+  }
+
+  end_draw_primitives();
+}
+
 #ifndef OPENGLES_1
 /**
  * Issues the given memory barriers, and clears the list of textures marked as
@@ -326,6 +326,12 @@ public:
                            bool force);
   virtual void end_draw_primitives();
 
+  virtual void draw_instances(const GeomPipelineReader *geom_reader,
+                              const GeomVertexDataPipelineReader *data_reader,
+                              const RenderState *state,
+                              const TransformState * const *transforms,
+                              size_t num_instances, bool force);
+
 #ifndef OPENGLES_1
   void issue_memory_barrier(GLbitfield barrier);
 #endif
@@ -606,6 +606,10 @@ ConfigureFn(config_gobj) {
   VertexTransform::init_type();
   VideoTexture::init_type();
 
+  // Texture images are allocated with the Texture type handle; count them
+  // against the texture memory tag.
+  Texture::get_class_type().set_memory_tag(MemoryHook::MT_texture);
+
   // Registration of writeable object's creation functions with BamReader's
   // factory
   Geom::register_with_read_factory();
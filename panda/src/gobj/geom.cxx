@@ -1854,21 +1854,36 @@ draw(GraphicsStateGuardianBase *gsg,
     all_ok = gsg->begin_draw_primitives(this, data_reader, force);
   }
   if (all_ok) {
-    Geom::Primitives::const_iterator pi;
-    for (pi = _cdata->_primitives.begin();
-         pi != _cdata->_primitives.end();
-         ++pi) {
-      GeomPrimitivePipelineReader reader((*pi).get_read_pointer(_current_thread), _current_thread);
-      if (reader.get_num_vertices() != 0) {
-        reader.check_minmax();
-        nassertr(reader.check_valid(data_reader), false);
-        if (!reader.draw(gsg, force)) {
-          all_ok = false;
-        }
-      }
-    }
+    all_ok = draw_primitives(gsg, data_reader, force);
     gsg->end_draw_primitives();
   }
 
   return all_ok;
 }
+
+/**
+ * Draws each of the primitives of the Geom.  This is the part of draw() that
+ * comes between begin_draw_primitives() and end_draw_primitives(); the GSG
+ * may call it more than once in between, to draw the same vertices several
+ * times with a different transform.
+ */
+bool GeomPipelineReader::
+draw_primitives(GraphicsStateGuardianBase *gsg,
+                const GeomVertexDataPipelineReader *data_reader,
+                bool force) const {
+  bool all_ok = true;
+  Geom::Primitives::const_iterator pi;
+  for (pi = _cdata->_primitives.begin();
+       pi != _cdata->_primitives.end();
+       ++pi) {
+    GeomPrimitivePipelineReader reader((*pi).get_read_pointer(_current_thread), _current_thread);
+    if (reader.get_num_vertices() != 0) {
+      reader.check_minmax();
+      nassertr(reader.check_valid(data_reader), false);
+      if (!reader.draw(gsg, force)) {
+        all_ok = false;
+      }
+    }
+  }
+  return all_ok;
+}
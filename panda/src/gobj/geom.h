@@ -434,6 +434,9 @@ public:
   bool draw(GraphicsStateGuardianBase *gsg,
             const GeomVertexDataPipelineReader *data_reader,
             bool force) const;
+  bool draw_primitives(GraphicsStateGuardianBase *gsg,
+                       const GeomVertexDataPipelineReader *data_reader,
+                       bool force) const;
 
 private:
   const Geom *_object;
@@ -30,6 +30,7 @@
 #include "ioPtaDatagramInt.h"
 #include "indent.h"
 #include "pStatTimer.h"
+#include "lmatrix_batch.h"
 
 using std::max;
 using std::min;
@@ -1625,6 +1626,45 @@ calc_tight_bounds(LPoint3 &min_point, LPoint3 &max_point,
         ++i;
       }
 
+      const GeomVertexColumn *column = reader.get_column();
+      if (i < cdata->_num_vertices &&
+          column->get_numeric_type() == NT_float32 &&
+          column->get_num_values() == 3 &&
+          IS_NEARLY_EQUAL(mat(0, 3), 0.0f) &&
+          IS_NEARLY_EQUAL(mat(1, 3), 0.0f) &&
+          IS_NEARLY_EQUAL(mat(2, 3), 0.0f) &&
+          IS_NEARLY_EQUAL(mat(3, 3), 1.0f)) {
+        // This is the common case of an affine transform applied to a table
+        // of LPoint3f's.  Rather than going through the reader one vertex at
+        // a time, transform the remaining vertices in batches.
+        size_t stride = reader.get_stride();
+        const unsigned char *datat = reader.get_array_handle()->get_read_pointer(true);
+        datat += column->get_start() + (cdata->_first_vertex + i) * stride;
+        LMatrix4f matf = LCAST(float, mat);
+
+        static const int batch_size = 64;
+        LPoint3f batch[batch_size];
+        while (i < cdata->_num_vertices) {
+          int count = min(batch_size, cdata->_num_vertices - i);
+          batch_xform_points(matf.get_data(), (const float *)datat,
+                             (float *)batch, count, stride, sizeof(LPoint3f));
+
+          for (int bi = 0; bi < count; ++bi) {
+            LPoint3 vertex(batch[bi][0], batch[bi][1], batch[bi][2]);
+
+            min_point.set(min(min_point[0], vertex[0]),
+                          min(min_point[1], vertex[1]),
+                          min(min_point[2], vertex[2]));
+            max_point.set(max(max_point[0], vertex[0]),
+                          max(max_point[1], vertex[1]),
+                          max(max_point[2], vertex[2]));
+            sq_center_dist = max(sq_center_dist, vertex.length_squared());
+          }
+          datat += count * stride;
+          i += count;
+        }
+      }
+
       for (; i < cdata->_num_vertices; ++i) {
         reader.set_row_unsafe(cdata->_first_vertex + i);
         LPoint3 vertex = mat.xform_point_general(reader.get_data3());
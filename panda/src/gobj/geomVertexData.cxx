@@ -21,6 +21,7 @@
 #include "bamWriter.h"
 #include "pset.h"
 #include "indent.h"
+#include "lmatrix_batch.h"
 
 using std::ostream;
 
@@ -1904,12 +1905,8 @@ do_transform_vector_column(const GeomVertexFormat *format, GeomVertexRewriter &d
 void GeomVertexData::
 table_xform_point3f(unsigned char *datat, size_t num_rows, size_t stride,
                     const LMatrix4f &matf) {
-  // We don't bother checking for the unaligned case here, because in practice
-  // it doesn't matter with a 3-component point.
-  for (size_t i = 0; i < num_rows; ++i) {
-    LPoint3f &vertex = *(LPoint3f *)(&datat[i * stride]);
-    vertex *= matf;
-  }
+  batch_xform_points(matf.get_data(), (const float *)datat, (float *)datat,
+                     num_rows, stride, stride);
 }
 
 /**
@@ -1919,11 +1916,13 @@ table_xform_point3f(unsigned char *datat, size_t num_rows, size_t stride,
 void GeomVertexData::
 table_xform_normal3f(unsigned char *datat, size_t num_rows, size_t stride,
                      const LMatrix4f &matf) {
+  batch_xform_vecs(matf.get_data(), (const float *)datat, (float *)datat,
+                   num_rows, stride, stride);
+
   // We don't bother checking for the unaligned case here, because in practice
   // it doesn't matter with a 3-component vector.
   for (size_t i = 0; i < num_rows; ++i) {
     LNormalf &vertex = *(LNormalf *)(&datat[i * stride]);
-    vertex *= matf;
     vertex.normalize();
   }
 }
@@ -1935,12 +1934,8 @@ table_xform_normal3f(unsigned char *datat, size_t num_rows, size_t stride,
 void GeomVertexData::
 table_xform_vector3f(unsigned char *datat, size_t num_rows, size_t stride,
                      const LMatrix4f &matf) {
-  // We don't bother checking for the unaligned case here, because in practice
-  // it doesn't matter with a 3-component vector.
-  for (size_t i = 0; i < num_rows; ++i) {
-    LVector3f &vertex = *(LVector3f *)(&datat[i * stride]);
-    vertex *= matf;
-  }
+  batch_xform_vecs(matf.get_data(), (const float *)datat, (float *)datat,
+                   num_rows, stride, stride);
 }
 
 /**
@@ -1950,27 +1945,9 @@ table_xform_vector3f(unsigned char *datat, size_t num_rows, size_t stride,
 void GeomVertexData::
 table_xform_vecbase4f(unsigned char *datat, size_t num_rows, size_t stride,
                       const LMatrix4f &matf) {
-#if defined(HAVE_EIGEN) && defined(LINMATH_ALIGN)
-  // Check if the table is unaligned.  If it is, we can't use the LVecBase4f
-  // object directly, which assumes 16-byte alignment.
-  if (((size_t)datat & 0xf) != 0 || (stride & 0xf) != 0) {
-    // Instead, we'll use low-level Eigen calls to multiply out the unaligned
-    // memory.
-    Eigen::Map<Eigen::Matrix<float, Eigen::Dynamic, 4, Eigen::RowMajor>, Eigen::Unaligned, Eigen::OuterStride<> > table((float *)datat, num_rows, 4, Eigen::OuterStride<>(stride / sizeof(float)));
-    for (size_t i = 0; i < num_rows; ++i) {
-      table.row(i) *= matf._m;
-    }
-    return;
-  }
-#endif  // HAVE_EIGEN
-
-  // If the table is properly aligned (or we don't require alignment), we can
-  // directly use the high-level LVecBase4f object, which will do the right
-  // thing.
-  for (size_t i = 0; i < num_rows; ++i) {
-    LVecBase4f &vertex = *(LVecBase4f *)(&datat[i * stride]);
-    vertex *= matf;
-  }
+  // The batch kernel makes no assumptions about the alignment of the table.
+  batch_xform(matf.get_data(), (const float *)datat, (float *)datat,
+              num_rows, stride, stride);
 }
 
 /**
@@ -1301,7 +1301,7 @@ new_simple_ram_image(int x_size, int y_size) {
 
   cdata->_simple_x_size = x_size;
   cdata->_simple_y_size = y_size;
-  cdata->_simple_ram_image._image = PTA_uchar::empty_array(expected_page_size);
+  cdata->_simple_ram_image._image = PTA_uchar::empty_array(expected_page_size, get_class_type());
   cdata->_simple_ram_image._page_size = expected_page_size;
   cdata->_simple_image_date_generated = (int32_t)time(nullptr);
   cdata->inc_simple_image_modified();
@@ -4050,7 +4050,7 @@ do_read_dds(CData *cdata, istream &in, const string &filename, bool header_only)
           // Now reassemble the pages into one big image.  Because this is a
           // Microsoft format, the images are stacked in reverse order; re-
           // reverse them.
-          PTA_uchar image = PTA_uchar::empty_array(page_size * z_size);
+          PTA_uchar image = PTA_uchar::empty_array(page_size * z_size, get_class_type());
           unsigned char *imagep = (unsigned char *)image.p();
           for (z = 0; z < z_size; ++z) {
             int fz = z_size - 1 - z;
@@ -4091,7 +4091,7 @@ do_read_dds(CData *cdata, istream &in, const string &filename, bool header_only)
         };
         for (n = 0; n < (int)header.num_levels; ++n) {
           size_t page_size = pages[0][n].size();
-          PTA_uchar image = PTA_uchar::empty_array(page_size * 6);
+          PTA_uchar image = PTA_uchar::empty_array(page_size * 6, get_class_type());
           unsigned char *imagep = (unsigned char *)image.p();
           for (z = 0; z < 6; ++z) {
             int fz = level_remap[z];
@@ -4129,7 +4129,7 @@ do_read_dds(CData *cdata, istream &in, const string &filename, bool header_only)
         // Now, for each level, reassemble the pages into one big image.
         for (n = 0; n < (int)header.num_levels; ++n) {
           size_t page_size = pages[0][n].size();
-          PTA_uchar image = PTA_uchar::empty_array(page_size * header.depth);
+          PTA_uchar image = PTA_uchar::empty_array(page_size * header.depth, get_class_type());
           unsigned char *imagep = (unsigned char *)image.p();
           for (z = 0; z < (int)header.depth; ++z) {
             nassertr(pages[z][n].size() == page_size, false);
@@ -4851,7 +4851,7 @@ do_read_ktx(CData *cdata, istream &in, const string &filename, bool header_only)
               << filename << " does not have proper row padding for mipmap "
                              "level " << n << "\n";
           }
-          image = PTA_uchar::empty_array(image_size);
+          image = PTA_uchar::empty_array(image_size, get_class_type());
           ktx.extract_bytes(image.p(), image_size);
 
         } else if (image_size != row_padded * num_rows) {
@@ -4863,7 +4863,7 @@ do_read_ktx(CData *cdata, istream &in, const string &filename, bool header_only)
 
         } else {
           // Read it row by row.
-          image = PTA_uchar::empty_array(row_size * num_rows);
+          image = PTA_uchar::empty_array(row_size * num_rows, get_class_type());
           uint32_t skip = row_padded - row_size;
           unsigned char *p = image.p();
           for (uint32_t row = 0; row < num_rows; ++row) {
@@ -4907,7 +4907,7 @@ do_read_ktx(CData *cdata, istream &in, const string &filename, bool header_only)
 
       } else {
         // Compressed image.  We'll trust that the file has the right size.
-        image = PTA_uchar::empty_array(image_size);
+        image = PTA_uchar::empty_array(image_size, get_class_type());
         ktx.extract_bytes(image.p(), image_size);
         do_set_ram_mipmap_image(cdata, (int)n, std::move(image), image_size / depth);
       }
@@ -5872,7 +5872,7 @@ do_compress_ram_image(CData *cdata, Texture::CompressionMode compression,
         y_size = (y_size + 3) & ~0x3;
 
         temp_image._page_size = x_size * y_size * cdata->_num_components;
-        temp_image._image = PTA_uchar::empty_array(temp_image._page_size * num_pages);
+        temp_image._image = PTA_uchar::empty_array(temp_image._page_size * num_pages, get_class_type());
 
         for (int z = 0; z < num_pages; ++z) {
           unsigned char *dest = temp_image._image.p() + z * temp_image._page_size;
@@ -5891,7 +5891,7 @@ do_compress_ram_image(CData *cdata, Texture::CompressionMode compression,
       // Create a new image to hold the compressed texture pages.
       RamImage &compressed_image = compressed_ram_images[n];
       compressed_image._page_size = (x_size * y_size * cdata->_num_components) >> 1;
-      compressed_image._image = PTA_uchar::empty_array(compressed_image._page_size * num_pages);
+      compressed_image._image = PTA_uchar::empty_array(compressed_image._page_size * num_pages, get_class_type());
 
       if (cdata->_num_components == 1) {
         do_compress_ram_image_bc4(*uncompressed_image, compressed_image,
@@ -5984,7 +5984,7 @@ do_uncompress_ram_image(CData *cdata) {
 
       RamImage &uncompressed_image = uncompressed_ram_images[n];
       uncompressed_image._page_size = do_get_expected_ram_mipmap_page_size(cdata, n);
-      uncompressed_image._image = PTA_uchar::empty_array(uncompressed_image._page_size * num_pages);
+      uncompressed_image._image = PTA_uchar::empty_array(uncompressed_image._page_size * num_pages, get_class_type());
 
       if (cdata->_num_components == 1) {
         do_uncompress_ram_image_bc4(compressed_image, uncompressed_image,
@@ -8220,7 +8220,7 @@ read_dds_level_bgr8(Texture *tex, CData *cdata, const DDSHeader &header, int n,
 
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * 3;
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     nassertr(p + row_bytes <= image.p() + size, PTA_uchar());
@@ -8241,7 +8241,7 @@ read_dds_level_rgb8(Texture *tex, CData *cdata, const DDSHeader &header, int n,
 
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * 3;
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     nassertr(p + row_bytes <= image.p() + size, PTA_uchar());
@@ -8271,7 +8271,7 @@ read_dds_level_abgr8(Texture *tex, CData *cdata, const DDSHeader &header, int n,
 
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * 4;
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     in.read((char *)p, row_bytes);
@@ -8306,7 +8306,7 @@ read_dds_level_rgba8(Texture *tex, CData *cdata, const DDSHeader &header, int n,
 
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * 4;
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     nassertr(p + row_bytes <= image.p() + size, PTA_uchar());
@@ -8327,7 +8327,7 @@ read_dds_level_abgr16(Texture *tex, CData *cdata, const DDSHeader &header, int n
 
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * 8;
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     in.read((char *)p, row_bytes);
@@ -8355,7 +8355,7 @@ read_dds_level_abgr32(Texture *tex, CData *cdata, const DDSHeader &header, int n
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * 16;
   nassertr(row_bytes * y_size == size, PTA_uchar());
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     in.read((char *)p, row_bytes);
@@ -8382,7 +8382,7 @@ read_dds_level_raw(Texture *tex, CData *cdata, const DDSHeader &header, int n, i
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * cdata->_num_components * cdata->_component_width;
   nassertr(row_bytes * y_size == size, PTA_uchar());
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     in.read((char *)p, row_bytes);
@@ -8453,7 +8453,7 @@ read_dds_level_generic_uncompressed(Texture *tex, CData *cdata, const DDSHeader
 
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * cdata->_num_components;
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     for (int x = 0; x < x_size; ++x) {
@@ -8540,7 +8540,7 @@ read_dds_level_luminance_uncompressed(Texture *tex, CData *cdata, const DDSHeade
 
   size_t size = tex->do_get_expected_ram_mipmap_page_size(cdata, n);
   size_t row_bytes = x_size * cdata->_num_components;
-  PTA_uchar image = PTA_uchar::empty_array(size);
+  PTA_uchar image = PTA_uchar::empty_array(size, get_class_type());
   for (int y = y_size - 1; y >= 0; --y) {
     unsigned char *p = image.p() + y * row_bytes;
     for (int x = 0; x < x_size; ++x) {
@@ -8596,7 +8596,7 @@ read_dds_level_bc1(Texture *tex, CData *cdata, const DDSHeader &header, int n, i
     }
   }
 
-  PTA_uchar image = PTA_uchar::empty_array(linear_size);
+  PTA_uchar image = PTA_uchar::empty_array(linear_size, get_class_type());
 
   if (y_size >= 4) {
     // We have to flip the image as we read it, because of DirectX's inverted
@@ -8666,7 +8666,7 @@ read_dds_level_bc2(Texture *tex, CData *cdata, const DDSHeader &header, int n, i
     }
   }
 
-  PTA_uchar image = PTA_uchar::empty_array(linear_size);
+  PTA_uchar image = PTA_uchar::empty_array(linear_size, get_class_type());
 
   if (y_size >= 4) {
     // We have to flip the image as we read it, because of DirectX's inverted
@@ -8752,7 +8752,7 @@ read_dds_level_bc3(Texture *tex, CData *cdata, const DDSHeader &header, int n, i
     }
   }
 
-  PTA_uchar image = PTA_uchar::empty_array(linear_size);
+  PTA_uchar image = PTA_uchar::empty_array(linear_size, get_class_type());
 
   if (y_size >= 4) {
     // We have to flip the image as we read it, because of DirectX's inverted
@@ -8853,7 +8853,7 @@ read_dds_level_bc4(Texture *tex, CData *cdata, const DDSHeader &header, int n, i
     }
   }
 
-  PTA_uchar image = PTA_uchar::empty_array(linear_size);
+  PTA_uchar image = PTA_uchar::empty_array(linear_size, get_class_type());
 
   if (y_size >= 4) {
     // We have to flip the image as we read it, because of DirectX's inverted
@@ -8933,7 +8933,7 @@ read_dds_level_bc5(Texture *tex, CData *cdata, const DDSHeader &header, int n, i
     }
   }
 
-  PTA_uchar image = PTA_uchar::empty_array(linear_size);
+  PTA_uchar image = PTA_uchar::empty_array(linear_size, get_class_type());
 
   if (y_size >= 4) {
     // We have to flip the image as we read it, because of DirectX's inverted
@@ -9677,7 +9677,7 @@ do_squish(CData *cdata, Texture::CompressionMode compression, int squish_flags)
     int cell_size = squish::GetStorageRequirements(4, 4, squish_flags);
 
     compressed_image._page_size = page_size;
-    compressed_image._image = PTA_uchar::empty_array(page_size * num_pages);
+    compressed_image._image = PTA_uchar::empty_array(page_size * num_pages, get_class_type());
     for (int z = 0; z < num_pages; ++z) {
       unsigned char *dest_page = compressed_image._image.p() + z * page_size;
       unsigned const char *source_page = cdata->_ram_images[n]._image.p() + z * cdata->_ram_images[n]._page_size;
@@ -9762,7 +9762,7 @@ do_unsquish(CData *cdata, int squish_flags) {
     int cell_size = squish::GetStorageRequirements(4, 4, squish_flags);
 
     uncompressed_image._page_size = do_get_expected_ram_mipmap_page_size(cdata, n);
-    uncompressed_image._image = PTA_uchar::empty_array(uncompressed_image._page_size * num_pages);
+    uncompressed_image._image = PTA_uchar::empty_array(uncompressed_image._page_size * num_pages, get_class_type());
     for (int z = 0; z < num_pages; ++z) {
       unsigned char *dest_page = uncompressed_image._image.p() + z * uncompressed_image._page_size;
       unsigned char *dest_page_end = dest_page + uncompressed_image._page_size;
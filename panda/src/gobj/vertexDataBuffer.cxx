@@ -27,12 +27,14 @@ operator = (const VertexDataBuffer &copy) {
 
   if (_resident_data != nullptr) {
     nassertv(_reserved_size != 0);
+    memory_hook->dec_tag_usage(MemoryHook::MT_geometry, _reserved_size);
     get_class_type().deallocate_array(_resident_data);
     _resident_data = nullptr;
   }
   if (copy._resident_data != nullptr && copy._size != 0) {
     // We only allocate _size bytes, not the full _reserved_size allocated by
     // the original copy.
+    memory_hook->inc_tag_usage(MemoryHook::MT_geometry, copy._size);
     _resident_data = (unsigned char *)get_class_type().allocate_array(copy._size);
     memcpy(_resident_data, copy._resident_data, copy._size);
   }
@@ -93,9 +95,12 @@ do_clean_realloc(size_t reserved_size) {
 
     if (_reserved_size == 0) {
       nassertv(_resident_data == nullptr);
+      memory_hook->inc_tag_usage(MemoryHook::MT_geometry, reserved_size);
       _resident_data = (unsigned char *)get_class_type().allocate_array(reserved_size);
     } else {
       nassertv(_resident_data != nullptr);
+      memory_hook->dec_tag_usage(MemoryHook::MT_geometry, _reserved_size);
+      memory_hook->inc_tag_usage(MemoryHook::MT_geometry, reserved_size);
       _resident_data = (unsigned char *)get_class_type().reallocate_array(_resident_data, reserved_size);
     }
     nassertv(_resident_data != nullptr);
@@ -125,6 +130,7 @@ do_unclean_realloc(size_t reserved_size) {
     if (_resident_data != nullptr) {
       nassertv(_reserved_size != 0);
 
+      memory_hook->dec_tag_usage(MemoryHook::MT_geometry, _reserved_size);
       get_class_type().deallocate_array(_resident_data);
       _resident_data = nullptr;
       _reserved_size = 0;
@@ -132,6 +138,7 @@ do_unclean_realloc(size_t reserved_size) {
 
     if (reserved_size != 0) {
       nassertv(_resident_data == nullptr);
+      memory_hook->inc_tag_usage(MemoryHook::MT_geometry, reserved_size);
       _resident_data = (unsigned char *)get_class_type().allocate_array(reserved_size);
     }
 
@@ -160,6 +167,7 @@ do_page_out(VertexDataBook &book) {
   if (_size == 0) {
     // It's an empty buffer.  Just deallocate it; don't bother to create a
     // block.
+    memory_hook->dec_tag_usage(MemoryHook::MT_geometry, _reserved_size);
     get_class_type().deallocate_array(_resident_data);
     _resident_data = nullptr;
     _reserved_size = 0;
@@ -173,6 +181,7 @@ do_page_out(VertexDataBook &book) {
     nassertv(pointer != nullptr);
     memcpy(pointer, _resident_data, _size);
 
+    memory_hook->dec_tag_usage(MemoryHook::MT_geometry, _reserved_size);
     get_class_type().deallocate_array(_resident_data);
     _resident_data = nullptr;
 
@@ -197,6 +206,7 @@ do_page_in() {
   nassertv(_block != nullptr);
   nassertv(_reserved_size == _size);
 
+  memory_hook->inc_tag_usage(MemoryHook::MT_geometry, _size);
   _resident_data = (unsigned char *)get_class_type().allocate_array(_size);
   nassertv(_resident_data != nullptr);
 
@@ -106,6 +106,34 @@ ConfigVariableDouble ae_undershift_factor_32
           "maximum pixel shift when applying a displacement map, in a 32-bit project file.  This is used "
           "to control PfmVizzer::make_displacement()."));
 
+ConfigVariableBool rigid_body_combiner_direct
+("rigid-body-combiner-direct", true,
+ PRC_DESC("Set this true to have the RigidBodyCombiner transform the vertices "
+          "of its moving children itself, updating only the vertices whose "
+          "transform has changed since the last frame, rather than leaving "
+          "it to the general vertex animation code, which recomputes every "
+          "vertex every frame."));
+
+ConfigVariableInt rigid_body_combiner_num_threads
+("rigid-body-combiner-num-threads", 0,
+ PRC_DESC("The number of worker threads that a RigidBodyCombiner may use to "
+          "transform its vertices, when rigid-body-combiner-direct is true.  "
+          "If this is 0, the vertices are transformed on the cull thread."));
+
+ConfigVariableInt geomipterrain_num_threads
+("geomipterrain-num-threads", 0,
+ PRC_DESC("The default number of worker threads that a GeoMipTerrain uses to "
+          "generate its blocks and to compute ambient occlusion.  If this is "
+          "0, all of the work is done on the calling thread."));
+
+ConfigVariableBool geomipterrain_async_update
+("geomipterrain-async-update", false,
+ PRC_DESC("The default value of GeoMipTerrain::set_async_update().  Set this "
+          "true to have GeoMipTerrain::update() regenerate the blocks whose "
+          "level of detail has changed in the background, and swap them into "
+          "the scene graph on a later call to update() once they are all "
+          "ready."));
+
 /**
  * Initializes the library.  This must be called at least once before any of
  * the functions or classes in this library can be used.  Normally it will be
@@ -44,6 +44,11 @@ extern ConfigVariableInt pfm_vis_max_indices;
 extern ConfigVariableDouble ae_undershift_factor_16;
 extern ConfigVariableDouble ae_undershift_factor_32;
 
+extern ConfigVariableBool rigid_body_combiner_direct;
+extern ConfigVariableInt rigid_body_combiner_num_threads;
+extern ConfigVariableInt geomipterrain_num_threads;
+extern ConfigVariableBool geomipterrain_async_update;
+
 extern EXPCL_PANDA_GRUTIL void init_libgrutil();
 
 #endif
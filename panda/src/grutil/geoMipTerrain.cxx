@@ -28,6 +28,13 @@
 #include "sceneGraphReducer.h"
 
 #include "collideMask.h"
+#include "genericAsyncTask.h"
+#include "asyncTaskManager.h"
+
+#if defined(__SSE2__) || (_M_IX86_FP >= 2) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define GEOMIPTERRAIN_SSE2
+#endif
 
 using std::max;
 using std::min;
@@ -43,15 +50,48 @@ static ConfigVariableBool geomipterrain_incorrect_normals
 TypeHandle GeoMipTerrain::_type_handle;
 
 /**
- * Generates a chunk of terrain based on the level specified.  As arguments it
- * takes the x and y coords of the mipmap to be generated, and the level of
- * detail.  T-Junctions for neighbor-mipmaps with different levels are also
- * taken into account.
+ * The state shared by the jobs of calc_ambient_occlusion().  The heights and
+ * the horizontally blurred heights are kept as rows of floats, in the same
+ * order as the pixels of the heightfield.
+ */
+class GeoMipTerrain::AOData {
+public:
+  int _xsize;
+  int _ysize;
+  int _radius;
+  pvector<float> _kernel;
+  pvector<float> _heights;
+  pvector<float> _blurred;
+  PN_stdfloat _contrast;
+  PN_stdfloat _brightness;
+};
+
+/**
+ * A band of rows of one of the passes of calc_ambient_occlusion().
+ */
+class GeoMipTerrain::AOJob {
+public:
+  GeoMipTerrain *_terrain;
+  AOData *_data;
+  int _pass;
+  int _begin;
+  int _end;
+};
+
+/**
+ * Generates a chunk of terrain based on the levels specified.  As arguments
+ * it takes the x and y coords of the mipmap to be generated, and the levels
+ * of detail of it and its neighbors, as computed by calc_block_levels().
+ * T-Junctions for neighbor-mipmaps with different levels are also taken into
+ * account.
+ *
+ * This only reads the heightfield and the color map, so it may be called on
+ * several threads at once.
  */
 PT(GeomNode) GeoMipTerrain::
 generate_block(unsigned short mx,
                unsigned short my,
-               unsigned short level) {
+               const BlockLevels &levels) {
 
   nassertr(mx < (_xsize - 1) / _block_size, nullptr);
   nassertr(my < (_ysize - 1) / _block_size, nullptr);
@@ -88,22 +128,15 @@ generate_block(unsigned short mx,
   GeomVertexWriter nwriter (vdata, InternalName::get_normal());
   PT(GeomTriangles) prim = new GeomTriangles(Geom::UH_stream);
 
-  if (_bruteforce) {
-    // LOD Level when rendering bruteforce is always 0 (no lod) Unless a
-    // minlevel is set- this is handled later.
-    level = 0;
-  }
-
   // Do some calculations with the level
-  level = min(max(_min_level, level), _max_level);
-  unsigned short reallevel = level;
-  level = int(pow(2.0, int(level)));
+  unsigned short reallevel = levels._level;
+  unsigned short level = int(pow(2.0, int(reallevel)));
 
   // Neighbor levels and junctions
-  unsigned short lnlevel = get_neighbor_level(mx, my, -1,  0);
-  unsigned short rnlevel = get_neighbor_level(mx, my,  1,  0);
-  unsigned short bnlevel = get_neighbor_level(mx, my,  0, -1);
-  unsigned short tnlevel = get_neighbor_level(mx, my,  0,  1);
+  unsigned short lnlevel = levels._left;
+  unsigned short rnlevel = levels._right;
+  unsigned short bnlevel = levels._bottom;
+  unsigned short tnlevel = levels._top;
   bool ljunction = (lnlevel != reallevel);
   bool rjunction = (rnlevel != reallevel);
   bool bjunction = (bnlevel != reallevel);
@@ -264,11 +297,30 @@ generate_block(unsigned short mx,
   PT(GeomNode) node = new GeomNode(sname.str());
   node->add_geom(geom);
   node->set_bounds_type(BoundingVolume::BT_box);
-  _old_levels.at(mx).at(my) = reallevel;
 
   return node;
 }
 
+/**
+ * Works out the levels of detail with which the indicated block should be
+ * generated at the indicated level, taking the levels of its neighbors from
+ * _levels.
+ */
+void GeoMipTerrain::
+calc_block_levels(unsigned short mx, unsigned short my,
+                  unsigned short level, BlockLevels &levels) {
+  if (_bruteforce) {
+    // LOD Level when rendering bruteforce is always 0 (no lod) Unless a
+    // minlevel is set.
+    level = 0;
+  }
+  levels._level = min(max(_min_level, level), _max_level);
+  levels._left = get_neighbor_level(mx, my, -1,  0);
+  levels._right = get_neighbor_level(mx, my,  1,  0);
+  levels._bottom = get_neighbor_level(mx, my,  0, -1);
+  levels._top = get_neighbor_level(mx, my,  0,  1);
+}
+
 /**
  * Fetches the elevation at (x, y), where the input coordinate is specified in
  * pixels.  This ignores the current LOD level and instead provides an
@@ -366,26 +418,88 @@ make_slope_image() {
  * color map, so that it will be written to the vertex colors.  Any existing
  * color map will be discarded.  You need to call this before generating the
  * geometry.
+ *
+ * The rows of the heightfield are divided among the threads specified by
+ * set_num_threads().
  */
 void GeoMipTerrain::
 calc_ambient_occlusion(PN_stdfloat radius, PN_stdfloat contrast, PN_stdfloat brightness) {
+  wait_for_blocks();
+
   _color_map = PNMImage(_xsize, _ysize);
   _color_map.make_grayscale();
   _color_map.set_maxval(_heightfield.get_maxval());
-
-  for (unsigned int x = 0; x < _xsize; ++x) {
-    for (unsigned int y = 0; y < _ysize; ++y) {
-      _color_map.set_xel(x, _ysize - y - 1, get_pixel_value(x, y));
-    }
+  if (_xsize == 0 || _ysize == 0) {
+    _has_color_map = true;
+    return;
   }
 
   // We use the cheap old method of subtracting a blurred version of the
-  // heightmap from the heightmap, and using that as lightmap.
-  _color_map.gaussian_filter(radius);
+  // heightmap from the heightmap, and using that as lightmap.  The blur is a
+  // gaussian of the same width that PNMImage::gaussian_filter() uses for this
+  // radius, cut off at three sigma, done as a horizontal pass and then a
+  // vertical pass.  It is sampled at whole pixels in floating point, rather
+  // than through PNMImage's fixed-point resampling filter, so the result
+  // differs slightly from what gaussian_filter() would give.
+  AOData data;
+  data._xsize = _xsize;
+  data._ysize = _ysize;
+  data._contrast = contrast;
+  data._brightness = brightness;
 
-  for (unsigned int x = 0; x < _xsize; ++x) {
-    for (unsigned int y = 0; y < _ysize; ++y) {
-      _color_map.set_xel(x, y, (get_pixel_value(x, _ysize - y - 1) - _color_map.get_gray(x, y)) * contrast + brightness);
+  float sigma = radius / 2;
+  if (sigma > 0) {
+    data._radius = (int)cceil(3.0f * sigma);
+    data._radius = min(data._radius, (int)max(_xsize, _ysize) - 1);
+  } else {
+    data._radius = 0;
+  }
+  data._kernel.resize(data._radius + 1);
+  for (int i = 0; i <= data._radius; ++i) {
+    data._kernel[i] = (sigma > 0) ? exp(-(i * i) / (2 * sigma * sigma)) : 1.0f;
+  }
+  data._heights.resize((size_t)_xsize * _ysize);
+  data._blurred.resize((size_t)_xsize * _ysize);
+
+  int num_jobs = 1;
+  if (_num_threads > 0 && Thread::is_threading_supported()) {
+    num_jobs = max(min(_num_threads + 1, (int)_ysize / 16), 1);
+  }
+
+  pvector<AOJob> jobs(num_jobs);
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int ji = 0; ji < num_jobs; ++ji) {
+      AOJob &job = jobs[ji];
+      job._terrain = this;
+      job._data = &data;
+      job._pass = pass;
+      job._begin = (int)((size_t)_ysize * ji / num_jobs);
+      job._end = (int)((size_t)_ysize * (ji + 1) / num_jobs);
+    }
+
+    if (num_jobs == 1) {
+      st_ao_job(nullptr, &jobs[0]);
+      continue;
+    }
+
+    // The vertical pass needs all of the rows of the horizontal pass, so we
+    // wait for each pass to finish before starting the next.
+    AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+    PT(AsyncTaskChain) chain = task_mgr->make_task_chain("geomipterrain");
+    if (chain->get_num_threads() < _num_threads) {
+      chain->set_num_threads(_num_threads);
+    }
+    pvector< PT(AsyncTask) > tasks;
+    for (int ji = 1; ji < num_jobs; ++ji) {
+      PT(GenericAsyncTask) task =
+        new GenericAsyncTask("geomipterrain_ao", &st_ao_job, &jobs[ji]);
+      task->set_task_chain(chain->get_name());
+      task_mgr->add(task);
+      tasks.push_back(task);
+    }
+    st_ao_job(nullptr, &jobs[0]);
+    for (size_t ti = 0; ti < tasks.size(); ++ti) {
+      tasks[ti]->wait();
     }
   }
 
@@ -403,6 +517,10 @@ generate() {
     grutil_cat.error() << "No valid heightfield image has been set!\n";
     return;
   }
+  // Any blocks still being regenerated by update() are out of date now.
+  wait_for_blocks();
+  _block_jobs.clear();
+
   calc_levels();
   _root.node()->remove_all_children();
   _blocks.clear();
@@ -411,18 +529,34 @@ generate() {
   _root_flattened = false;
   for (unsigned int mx = 0; mx < (_xsize - 1) / _block_size; mx++) {
     _old_levels[mx].resize(int((_ysize - 1) / _block_size));
+    for (unsigned int my = 0; my < (_ysize - 1) / _block_size; my++) {
+      unsigned short level = _bruteforce ? 0 : _levels[mx][my];
+      _old_levels[mx][my] = min(max(_min_level, level), _max_level);
+
+      BlockJob job;
+      job._terrain = this;
+      job._mx = mx;
+      job._my = my;
+      _block_jobs.push_back(job);
+    }
+  }
+
+  // Generate all of the blocks, on several threads if we may.
+  start_blocks(false);
+
+  BlockJobs::const_iterator ji = _block_jobs.begin();
+  for (unsigned int mx = 0; mx < (_xsize - 1) / _block_size; mx++) {
     pvector<NodePath> tvector; // Create temporary row
     for (unsigned int my = 0; my < (_ysize - 1) / _block_size; my++) {
-      if (_bruteforce) {
-        tvector.push_back(_root.attach_new_node(generate_block(mx, my, 0)));
-      } else {
-        tvector.push_back(_root.attach_new_node(generate_block(mx, my, _levels[mx][my])));
-      }
+      tvector.push_back(_root.attach_new_node((*ji)._node));
       tvector[my].set_pos((mx + 0.5) * _block_size, (my + 0.5) * _block_size, 0);
+      ++ji;
     }
     _blocks.push_back(tvector); // Push the new row of NodePaths into the 2d vect
     tvector.clear();
   }
+  _block_jobs.clear();
+
   auto_flatten();
   _is_dirty = false;
 }
@@ -434,6 +568,10 @@ generate() {
  * updated at all.  If there is no terrain yet, it generates the entire
  * terrain.  This call un-flattens the terrain, so make sure you have set
  * auto-flatten if you want to keep your terrain flattened.
+ *
+ * If set_async_update() is true, the mipmaps are regenerated in the
+ * background instead, and this returns true on the later call that swaps
+ * them into the scene graph.
  */
 bool GeoMipTerrain::
 update() {
@@ -445,55 +583,67 @@ update() {
     generate();
     return true;
   } else if (!_bruteforce) {
-    calc_levels();
-    if (root_flattened()) {
-      _root.node()->remove_all_children();
-      unsigned int xsize = _blocks.size();
-      for (unsigned int tx = 0; tx < xsize; tx++) {
-        unsigned int ysize = _blocks[tx].size();
-        for (unsigned int ty = 0;ty < ysize; ty++) {
-          _blocks[tx][ty].reparent_to(_root);
-        }
+    bool returnVal = false;
+    if (!_block_jobs.empty()) {
+      // The blocks from a previous update are still being generated.  Keep
+      // showing the old ones until all of the new ones are ready.
+      if (!blocks_ready()) {
+        return false;
       }
-      _root_flattened = false;
+      swap_blocks();
+      returnVal = true;
     }
-    bool returnVal = false;
+
+    calc_levels();
+    _block_job_index.assign(((_xsize - 1) / _block_size) * ((_ysize - 1) / _block_size), -1);
     for (unsigned int mx = 0; mx < (_xsize - 1) / _block_size; mx++) {
       for (unsigned int my = 0; my < (_ysize - 1) / _block_size; my++) {
         bool isUpd (update_block(mx, my));
         if (isUpd && mx > 0 && _old_levels[mx - 1][my] == _levels[mx - 1][my]) {
-          if (update_block(mx - 1, my, -1, true)) {
-            returnVal = true;
-          }
+          update_block(mx - 1, my, -1, true);
         }
         if (isUpd && mx < (_ysize - 1)/_block_size - 1
                   && _old_levels[mx + 1][my] == _levels[mx + 1][my]) {
-          if (update_block(mx + 1, my, -1, true)) {
-            returnVal = true;
-          }
+          update_block(mx + 1, my, -1, true);
         }
         if (isUpd && my > 0 && _old_levels[mx][my - 1] == _levels[mx][my - 1]) {
-          if (update_block(mx, my - 1, -1, true)) {
-            returnVal = true;
-          }
+          update_block(mx, my - 1, -1, true);
         }
         if (isUpd && my < (_ysize - 1)/_block_size - 1
                   && _old_levels[mx][my + 1] == _levels[mx][my + 1]) {
-          if (update_block(mx, my + 1, -1, true)) {
-            returnVal = true;
-          }
-        }
-        if (isUpd) {
-          returnVal = true;
+          update_block(mx, my + 1, -1, true);
         }
       }
     }
-    auto_flatten();
+
+    if (!_block_jobs.empty()) {
+      bool async = _async_update && Thread::is_threading_supported();
+      start_blocks(async);
+      if (!async) {
+        swap_blocks();
+        returnVal = true;
+      }
+    }
+    if (returnVal) {
+      auto_flatten();
+    }
     return returnVal;
   }
   return false;
 }
 
+/**
+ * If there are blocks being regenerated in the background, waits for them to
+ * be ready and swaps them into the scene graph.  See set_async_update().
+ */
+void GeoMipTerrain::
+finish_update() {
+  if (!_block_jobs.empty()) {
+    swap_blocks();
+    auto_flatten();
+  }
+}
+
 /**
  * Normally, the root's children are the terrain blocks.  However, if we call
  * flatten_strong on the root, then the root will contain unpredictable stuff.
@@ -583,7 +733,8 @@ calc_levels() {
 
 /**
  * Checks whether the specified mipmap at (mx,my) needs to be updated, if so,
- * it regenerates the mipmap.  Returns a true when it has generated a mipmap.
+ * it queues the mipmap to be regenerated by start_blocks().  Returns a true
+ * when it has queued a mipmap.
  * Returns false when the mipmap is already at the desired level, or when
  * there is no terrain to update.  Note: This does not affect neighboring
  * blocks, so does NOT fix t-junctions.  You will have to fix that by forced
@@ -603,13 +754,277 @@ update_block(unsigned short mx, unsigned short my,
   }
   level = min(max(_min_level, (unsigned short) level), _max_level);
   if (forced || _old_levels[mx][my] != level) { // If the level has changed...
-    // Replaces the chunk with a regenerated one.
-    generate_block(mx, my, level)->replace_node(_blocks[mx][my].node());
+    _old_levels[mx][my] = level;
+
+    // A block that is updated more than once is only generated once.
+    int &index = _block_job_index[mx * ((_ysize - 1) / _block_size) + my];
+    if (index < 0) {
+      index = (int)_block_jobs.size();
+      BlockJob job;
+      job._terrain = this;
+      job._mx = mx;
+      job._my = my;
+      _block_jobs.push_back(job);
+    }
     return true;
   }
   return false;
 }
 
+/**
+ * Generates the blocks that have been queued in _block_jobs, dividing them
+ * among the threads specified by set_num_threads().  If async is false, this
+ * waits until they are all done; otherwise it returns right away, and
+ * blocks_ready() reports when they are.
+ */
+void GeoMipTerrain::
+start_blocks(bool async) {
+  // The levels are worked out up front, since _levels may be recomputed
+  // while the blocks are being generated.
+  BlockJobs::iterator ji;
+  for (ji = _block_jobs.begin(); ji != _block_jobs.end(); ++ji) {
+    BlockJob &job = (*ji);
+    calc_block_levels(job._mx, job._my, _old_levels[job._mx][job._my], job._levels);
+  }
+
+  int num_threads = async ? max(_num_threads, 1) : _num_threads;
+  if (num_threads == 0 || !Thread::is_threading_supported() ||
+      (!async && _block_jobs.size() < 2)) {
+    for (ji = _block_jobs.begin(); ji != _block_jobs.end(); ++ji) {
+      (*ji)._node = generate_block((*ji)._mx, (*ji)._my, (*ji)._levels);
+    }
+    return;
+  }
+
+  AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+  PT(AsyncTaskChain) chain = task_mgr->make_task_chain("geomipterrain");
+  if (chain->get_num_threads() < num_threads) {
+    chain->set_num_threads(num_threads);
+  }
+
+  // If we are going to wait for them anyway, the calling thread generates
+  // the first block itself.
+  size_t first = async ? 0 : 1;
+  for (size_t i = first; i < _block_jobs.size(); ++i) {
+    PT(GenericAsyncTask) task =
+      new GenericAsyncTask("geomipterrain_block", &st_build_block, &_block_jobs[i]);
+    task->set_task_chain(chain->get_name());
+    task_mgr->add(task);
+    _block_tasks.push_back(task);
+  }
+
+  if (!async) {
+    st_build_block(nullptr, &_block_jobs[0]);
+    wait_for_blocks();
+  }
+}
+
+/**
+ * Returns true if all of the blocks started by start_blocks() have been
+ * generated.
+ */
+bool GeoMipTerrain::
+blocks_ready() const {
+  pvector< PT(AsyncTask) >::const_iterator ti;
+  for (ti = _block_tasks.begin(); ti != _block_tasks.end(); ++ti) {
+    if (!(*ti)->done()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Waits for all of the blocks started by start_blocks() to be generated.
+ * This must be called before anything that the blocks are generated from is
+ * modified.
+ */
+void GeoMipTerrain::
+wait_for_blocks() {
+  pvector< PT(AsyncTask) >::iterator ti;
+  for (ti = _block_tasks.begin(); ti != _block_tasks.end(); ++ti) {
+    (*ti)->wait();
+  }
+  _block_tasks.clear();
+}
+
+/**
+ * Replaces the blocks in the scene graph with the ones that have been
+ * generated by start_blocks(), waiting for them first if necessary.
+ */
+void GeoMipTerrain::
+swap_blocks() {
+  wait_for_blocks();
+  if (root_flattened()) {
+    unflatten();
+  }
+
+  BlockJobs::iterator ji;
+  for (ji = _block_jobs.begin(); ji != _block_jobs.end(); ++ji) {
+    BlockJob &job = (*ji);
+    if (job._node != nullptr) {
+      // Replaces the chunk with the regenerated one.
+      job._node->replace_node(_blocks[job._mx][job._my].node());
+    }
+  }
+  _block_jobs.clear();
+}
+
+/**
+ * Puts the terrain blocks back under the root, after it has been flattened.
+ */
+void GeoMipTerrain::
+unflatten() {
+  _root.node()->remove_all_children();
+  unsigned int xsize = _blocks.size();
+  for (unsigned int tx = 0; tx < xsize; tx++) {
+    unsigned int ysize = _blocks[tx].size();
+    for (unsigned int ty = 0;ty < ysize; ty++) {
+      _blocks[tx][ty].reparent_to(_root);
+    }
+  }
+  _root_flattened = false;
+}
+
+/**
+ * The task function that generates one queued block.
+ */
+AsyncTask::DoneStatus GeoMipTerrain::
+st_build_block(GenericAsyncTask *, void *data) {
+  BlockJob *job = (BlockJob *)data;
+  job->_node = job->_terrain->generate_block(job->_mx, job->_my, job->_levels);
+  return AsyncTask::DS_done;
+}
+
+/**
+ * Reads the indicated rows of the heightfield for calc_ambient_occlusion(),
+ * and blurs them horizontally.
+ */
+void GeoMipTerrain::
+ao_blur_rows(AOData &data, int begin, int end) {
+  int xsize = data._xsize;
+  int radius = data._radius;
+  const float *kernel = &data._kernel[0];
+
+  // The sum of the weights of a window that lies entirely within the row.
+  float total = kernel[0];
+  for (int i = 1; i <= radius; ++i) {
+    total += 2 * kernel[i];
+  }
+  float inv_total = 1.0f / total;
+
+  for (int y = begin; y < end; ++y) {
+    float *heights = &data._heights[(size_t)y * xsize];
+    float *blurred = &data._blurred[(size_t)y * xsize];
+    for (int x = 0; x < xsize; ++x) {
+      heights[x] = (float)get_pixel_value(x, y);
+    }
+
+    int x = 0;
+    while (x < xsize) {
+#ifdef GEOMIPTERRAIN_SSE2
+      if (x >= radius && x + 4 + radius <= xsize) {
+        // Four pixels whose windows lie entirely within the row.
+        __m128 sum = _mm_mul_ps(_mm_set1_ps(kernel[0]), _mm_loadu_ps(heights + x));
+        for (int i = 1; i <= radius; ++i) {
+          __m128 pair = _mm_add_ps(_mm_loadu_ps(heights + x - i),
+                                   _mm_loadu_ps(heights + x + i));
+          sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(kernel[i]), pair));
+        }
+        _mm_storeu_ps(blurred + x, _mm_mul_ps(sum, _mm_set1_ps(inv_total)));
+        x += 4;
+        continue;
+      }
+#endif
+      // The window is clipped at the edges of the row, so the weights that
+      // remain are renormalized.
+      int left = max(x - radius, 0);
+      int right = min(x + radius, xsize - 1);
+      float sum = 0.0f;
+      float weight = 0.0f;
+      for (int sx = left; sx <= right; ++sx) {
+        float k = kernel[abs(sx - x)];
+        sum += k * heights[sx];
+        weight += k;
+      }
+      blurred[x] = sum / weight;
+      ++x;
+    }
+  }
+}
+
+/**
+ * Blurs the indicated rows vertically for calc_ambient_occlusion(), and
+ * stores the difference from the original heights in the color map.
+ */
+void GeoMipTerrain::
+ao_combine_rows(AOData &data, int begin, int end) {
+  int xsize = data._xsize;
+  int ysize = data._ysize;
+  int radius = data._radius;
+  const float *kernel = &data._kernel[0];
+  float contrast = data._contrast;
+  float brightness = data._brightness;
+
+  pvector<float> row(xsize);
+  float *out = &row[0];
+
+  for (int y = begin; y < end; ++y) {
+    int top = max(y - radius, 0);
+    int bottom = min(y + radius, ysize - 1);
+    float weight = 0.0f;
+    for (int sy = top; sy <= bottom; ++sy) {
+      weight += kernel[abs(sy - y)];
+    }
+    float inv_weight = 1.0f / weight;
+
+    const float *heights = &data._heights[(size_t)y * xsize];
+    int x = 0;
+
+#ifdef GEOMIPTERRAIN_SSE2
+    __m128 inv_weight4 = _mm_set1_ps(inv_weight);
+    __m128 contrast4 = _mm_set1_ps(contrast);
+    __m128 brightness4 = _mm_set1_ps(brightness);
+    for (; x + 4 <= xsize; x += 4) {
+      __m128 sum = _mm_setzero_ps();
+      for (int sy = top; sy <= bottom; ++sy) {
+        __m128 k = _mm_set1_ps(kernel[abs(sy - y)]);
+        sum = _mm_add_ps(sum, _mm_mul_ps(k, _mm_loadu_ps(&data._blurred[(size_t)sy * xsize + x])));
+      }
+      __m128 diff = _mm_sub_ps(_mm_loadu_ps(heights + x), _mm_mul_ps(sum, inv_weight4));
+      _mm_storeu_ps(out + x, _mm_add_ps(_mm_mul_ps(diff, contrast4), brightness4));
+    }
+#endif
+
+    for (; x < xsize; ++x) {
+      float sum = 0.0f;
+      for (int sy = top; sy <= bottom; ++sy) {
+        sum += kernel[abs(sy - y)] * data._blurred[(size_t)sy * xsize + x];
+      }
+      out[x] = (heights[x] - sum * inv_weight) * contrast + brightness;
+    }
+
+    // The color map is upside down with respect to the heightfield.
+    for (x = 0; x < xsize; ++x) {
+      _color_map.set_xel(x, ysize - y - 1, out[x]);
+    }
+  }
+}
+
+/**
+ * The task function that runs one AOJob.
+ */
+AsyncTask::DoneStatus GeoMipTerrain::
+st_ao_job(GenericAsyncTask *, void *data) {
+  AOJob *job = (AOJob *)data;
+  if (job->_pass == 0) {
+    job->_terrain->ao_blur_rows(*job->_data, job->_begin, job->_end);
+  } else {
+    job->_terrain->ao_combine_rows(*job->_data, job->_begin, job->_end);
+  }
+  return AsyncTask::DS_done;
+}
+
 /**
  * Loads the specified heightmap image file into the heightfield.  Returns
  * true if succeeded, or false if an error has occured.  If the heightmap is
@@ -617,6 +1032,8 @@ update_block(unsigned short mx, unsigned short my,
  */
 bool GeoMipTerrain::
 set_heightfield(const Filename &filename, PNMFileType *ftype) {
+  wait_for_blocks();
+
   // First, we need to load the header to determine the size and format.
   PNMImageHeader imgheader;
   if (imgheader.read_header(filename, ftype)) {
@@ -24,6 +24,10 @@
 #include "nodePath.h"
 
 #include "texture.h"
+#include "asyncTask.h"
+#include "vector_int.h"
+
+class GenericAsyncTask;
 
 /**
  * GeoMipTerrain, meaning Panda3D GeoMipMapping, can convert a heightfield
@@ -38,10 +42,10 @@ PUBLISHED:
   INLINE explicit GeoMipTerrain(const std::string &name);
   INLINE ~GeoMipTerrain();
 
-  INLINE PNMImage &heightfield();
+  INLINE const PNMImage &heightfield() const;
   bool set_heightfield(const Filename &filename, PNMFileType *type = nullptr);
   INLINE bool set_heightfield(const PNMImage &image);
-  INLINE PNMImage &color_map();
+  INLINE const PNMImage &color_map() const;
   INLINE bool set_color_map(const Filename &filename,
                                   PNMFileType *type = nullptr);
   INLINE bool set_color_map(const PNMImage &image);
@@ -104,15 +108,59 @@ PUBLISHED:
   INLINE double get_near();
   INLINE int get_flatten_mode();
 
+  INLINE void set_num_threads(int num_threads);
+  INLINE int get_num_threads() const;
+  INLINE void set_async_update(bool async_update);
+  INLINE bool get_async_update() const;
+  INLINE bool is_update_pending() const;
+  void finish_update();
+
   PNMImage make_slope_image();
   void generate();
   bool update();
 
 private:
+  // The levels of detail that a block is generated with: its own, and that
+  // of each of its neighbors, for fixing up the t-junctions.
+  class BlockLevels {
+  public:
+    unsigned short _level;
+    unsigned short _left;
+    unsigned short _right;
+    unsigned short _bottom;
+    unsigned short _top;
+  };
+
+  // A block that is to be (re)generated, possibly on another thread.
+  class BlockJob {
+  public:
+    GeoMipTerrain *_terrain;
+    unsigned short _mx;
+    unsigned short _my;
+    BlockLevels _levels;
+    PT(GeomNode) _node;
+  };
+  typedef pvector<BlockJob> BlockJobs;
+
+  class AOData;
+  class AOJob;
 
-  PT(GeomNode) generate_block(unsigned short mx, unsigned short my, unsigned short level);
+  PT(GeomNode) generate_block(unsigned short mx, unsigned short my,
+                              const BlockLevels &levels);
+  void calc_block_levels(unsigned short mx, unsigned short my,
+                         unsigned short level, BlockLevels &levels);
   bool update_block(unsigned short mx, unsigned short my,
                     signed short level = -1, bool forced = false);
+  void start_blocks(bool async);
+  bool blocks_ready() const;
+  void wait_for_blocks();
+  void swap_blocks();
+  void unflatten();
+  static AsyncTask::DoneStatus st_build_block(GenericAsyncTask *task, void *data);
+
+  void ao_blur_rows(AOData &data, int begin, int end);
+  void ao_combine_rows(AOData &data, int begin, int end);
+  static AsyncTask::DoneStatus st_ao_job(GenericAsyncTask *task, void *data);
   void calc_levels();
   void auto_flatten();
   bool root_flattened();
@@ -150,6 +198,16 @@ private:
   pvector<pvector<unsigned short> > _levels;
   pvector<pvector<unsigned short> > _old_levels;
 
+  int _num_threads;
+  bool _async_update;
+
+  // The blocks queued up by update_block(), and the tasks that are building
+  // them.  The blocks in the scene graph are not replaced until all of these
+  // are ready, so that the t-junctions between them stay stitched.
+  BlockJobs _block_jobs;
+  vector_int _block_job_index;
+  pvector< PT(AsyncTask) > _block_tasks;
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
@@ -22,15 +22,35 @@
 #include "sceneGraphReducer.h"
 #include "omniBoundingVolume.h"
 #include "cullTraverserData.h"
+#include "config_grutil.h"
+#include "compose_matrix.h"
+#include "lmatrix_batch.h"
+#include "geomVertexReader.h"
+#include "lightMutexHolder.h"
+#include "genericAsyncTask.h"
+#include "asyncTaskManager.h"
+#include "pStatTimer.h"
+
+// Ranges longer than this are broken up, so that the work may be spread
+// evenly across the threads.
+static const int direct_max_work_rows = 4096;
+
+// There is no point in waking up the threads for less than this many rows
+// apiece.
+static const size_t direct_min_job_rows = 1024;
 
 TypeHandle RigidBodyCombiner::_type_handle;
+PStatCollector RigidBodyCombiner::_direct_pcollector("Cull:Rigid body combiner");
 
 
 /**
  *
  */
 RigidBodyCombiner::
-RigidBodyCombiner(const std::string &name) : PandaNode(name) {
+RigidBodyCombiner(const std::string &name) :
+  PandaNode(name),
+  _any_animated(false)
+{
   set_cull_callback();
 
   _internal_root = new PandaNode(name);
@@ -47,7 +67,11 @@ RigidBodyCombiner(const std::string &name) : PandaNode(name) {
  *
  */
 RigidBodyCombiner::
-RigidBodyCombiner(const RigidBodyCombiner &copy) : PandaNode(copy) {
+RigidBodyCombiner(const RigidBodyCombiner &copy) :
+  PandaNode(copy),
+  _direct(copy._direct),
+  _any_animated(copy._any_animated)
+{
   set_cull_callback();
 
   _internal_root = copy._internal_root;
@@ -99,6 +123,13 @@ collect() {
   gr.apply_attribs(_internal_root);
   gr.collect_vertex_data(_internal_root, ~(SceneGraphReducer::CVD_format | SceneGraphReducer::CVD_name | SceneGraphReducer::CVD_animation_type));
   gr.unify(_internal_root, false);
+
+  _direct.clear();
+  if (rigid_body_combiner_direct) {
+    make_direct();
+  } else {
+    _any_animated = true;
+  }
 }
 
 /**
@@ -134,14 +165,20 @@ get_internal_scene() {
  */
 bool RigidBodyCombiner::
 cull_callback(CullTraverser *trav, CullTraverserData &data) {
-  // Pretend that all of our transforms have been modified (since we don't
-  // really know which ones have).
   Thread *current_thread = Thread::get_current_thread();
-  Transforms::iterator ti;
-  for (ti = _internal_transforms.begin();
-       ti != _internal_transforms.end();
-       ++ti) {
-    (*ti)->mark_modified(current_thread);
+  if (_direct != nullptr) {
+    update_direct(current_thread);
+  }
+
+  if (_any_animated) {
+    // Pretend that all of our transforms have been modified (since we don't
+    // really know which ones have).
+    Transforms::iterator ti;
+    for (ti = _internal_transforms.begin();
+         ti != _internal_transforms.end();
+         ++ti) {
+      (*ti)->mark_modified(current_thread);
+    }
   }
 
   // Render the internal scene only--this is the optimized scene.
@@ -242,3 +279,387 @@ convert_vd(const VertexTransform *transform, const GeomVertexData *orig) {
 
   return new_data;
 }
+
+/**
+ * Called by collect() to set up the direct transformation of the vertices.
+ * Each GeomVertexData produced by collect() is replaced with a copy that is
+ * not animated, whose vertices are instead transformed by update_direct().
+ * Any vertex data that this can't handle, such as one with true blends of
+ * several transforms, is left to the vertex animation code.
+ */
+void RigidBodyCombiner::
+make_direct() {
+  _any_animated = false;
+  if (_internal_transforms.empty()) {
+    return;
+  }
+
+  TransformIndex transform_index;
+  for (size_t ti = 0; ti < _internal_transforms.size(); ++ti) {
+    transform_index[_internal_transforms[ti]] = (int)ti;
+  }
+
+  PT(DirectState) state = new DirectState;
+
+  // Every transform is applied the first time.
+  DirectTransform initial;
+  initial._mat = LMatrix4f::ident_mat();
+  initial._normal_mat = LMatrix4f::ident_mat();
+  initial._normalize = false;
+  initial._changed = true;
+  state->_transforms.assign(_internal_transforms.size(), initial);
+
+  typedef pmap<const GeomVertexData *, PT(GeomVertexData) > Converted;
+  Converted converted;
+
+  GeomNode *gnode = DCAST(GeomNode, _internal_root);
+  int num_geoms = gnode->get_num_geoms();
+  for (int i = 0; i < num_geoms; ++i) {
+    CPT(GeomVertexData) orig = gnode->get_geom(i)->get_vertex_data();
+    if (orig->get_format()->get_animation().get_animation_type() != Geom::AT_panda) {
+      continue;
+    }
+
+    Converted::iterator ci = converted.find(orig);
+    if (ci == converted.end()) {
+      PT(GeomVertexData) animated = make_direct_vd(state, orig, transform_index);
+      ci = converted.insert(Converted::value_type(orig, animated)).first;
+    }
+
+    if ((*ci).second == nullptr) {
+      _any_animated = true;
+    } else {
+      gnode->modify_geom(i)->set_vertex_data((*ci).second);
+    }
+  }
+
+  if (!state->_datas.empty()) {
+    _direct = state;
+  }
+}
+
+/**
+ * Builds the DirectData for the indicated GeomVertexData, and returns the
+ * unanimated copy of it that should be rendered in its place, or NULL if its
+ * vertices can't be transformed directly.
+ */
+PT(GeomVertexData) RigidBodyCombiner::
+make_direct_vd(DirectState *state, const GeomVertexData *orig,
+               const TransformIndex &transform_index) {
+  const GeomVertexFormat *format = orig->get_format();
+  const TransformBlendTable *table = orig->get_transform_blend_table();
+  if (table == nullptr || orig->get_slider_table() != nullptr ||
+      table->get_rows().is_inverse()) {
+    return nullptr;
+  }
+
+  // Each blend must be a single one of our transforms, at full weight.
+  size_t num_blends = table->get_num_blends();
+  vector_int blend_transforms(num_blends);
+  for (size_t bi = 0; bi < num_blends; ++bi) {
+    const TransformBlend &blend = table->get_blend(bi);
+    if (blend.get_num_transforms() != 1 || blend.get_weight((size_t)0) != 1.0f) {
+      return nullptr;
+    }
+    TransformIndex::const_iterator ti = transform_index.find(blend.get_transform((size_t)0));
+    if (ti == transform_index.end()) {
+      return nullptr;
+    }
+    blend_transforms[bi] = (*ti).second;
+  }
+
+  DirectData dd;
+
+  // Find the columns to transform.  They must all be tables of LVecBase3f's.
+  size_t num_points = format->get_num_points();
+  size_t num_vectors = format->get_num_vectors();
+  for (size_t ci = 0; ci < num_points + num_vectors; ++ci) {
+    const InternalName *name = (ci < num_points) ?
+      format->get_point(ci) : format->get_vector(ci - num_points);
+    const GeomVertexColumn *column = format->get_column(name);
+    if (column == nullptr ||
+        column->get_numeric_type() != Geom::NT_float32 ||
+        column->get_num_components() != 3) {
+      return nullptr;
+    }
+
+    DirectColumn dc;
+    dc._array = format->get_array_with(name);
+    dc._start = column->get_start();
+    dc._stride = format->get_array(dc._array)->get_stride();
+    if (ci < num_points) {
+      dc._type = CT_point;
+    } else if (column->get_contents() == Geom::C_normal) {
+      dc._type = CT_normal;
+    } else {
+      dc._type = CT_vector;
+    }
+    dd._columns.push_back(dc);
+  }
+
+  // Now find the runs of rows that share a transform.
+  GeomVertexReader reader(orig, InternalName::get_transform_blend());
+  if (!reader.has_column()) {
+    return nullptr;
+  }
+
+  const SparseArray &rows = table->get_rows();
+  int num_rows = orig->get_num_rows();
+  int num_subranges = rows.get_num_subranges();
+  for (int si = 0; si < num_subranges; ++si) {
+    int begin = rows.get_subrange_begin(si);
+    int end = std::min(rows.get_subrange_end(si), num_rows);
+    reader.set_row_unsafe(begin);
+    for (int row = begin; row < end; ++row) {
+      int bi = reader.get_data1i();
+      if (bi < 0 || (size_t)bi >= num_blends) {
+        return nullptr;
+      }
+      int transform = blend_transforms[bi];
+      if (!dd._ranges.empty() && dd._ranges.back()._transform == transform &&
+          dd._ranges.back()._end == row) {
+        ++dd._ranges.back()._end;
+      } else {
+        DirectRange range;
+        range._transform = transform;
+        range._begin = row;
+        range._end = row + 1;
+        dd._ranges.push_back(range);
+      }
+    }
+  }
+
+  // The copy that we render has the same layout, but no animation.
+  PT(GeomVertexFormat) new_format = new GeomVertexFormat(*format);
+  new_format->set_animation(GeomVertexAnimationSpec());
+
+  PT(GeomVertexData) animated = new GeomVertexData(*orig);
+  animated->unclean_set_format(GeomVertexFormat::register_format(new_format));
+  animated->clear_transform_blend_table();
+
+  dd._orig = orig;
+  dd._animated = animated;
+  state->_datas.push_back(dd);
+  return animated;
+}
+
+/**
+ * Called at cull time to transform the vertices of each of the moving nodes
+ * whose transform has changed since the last time, from the original
+ * vertices into the copy that is rendered.
+ */
+void RigidBodyCombiner::
+update_direct(Thread *current_thread) {
+  DirectState *state = _direct;
+  LightMutexHolder holder(state->_lock);
+  PStatTimer timer(_direct_pcollector, current_thread);
+
+  // First, find out which transforms have changed.
+  bool any_changed = false;
+  size_t num_transforms = _internal_transforms.size();
+  for (size_t ti = 0; ti < num_transforms; ++ti) {
+    DirectTransform &dt = state->_transforms[ti];
+
+    LMatrix4 mat;
+    _internal_transforms[ti]->get_matrix(mat);
+    LMatrix4f matf = LCAST(float, mat);
+    if (!dt._changed && matf == dt._mat) {
+      continue;
+    }
+
+    dt._mat = matf;
+    dt._changed = true;
+    any_changed = true;
+
+    // Work out how to transform the normals, the same way that
+    // GeomVertexData::do_transform_vector_column() does.
+    LMatrix4 normal_mat;
+    dt._normalize = false;
+    LVecBase3 scale_sq(mat.get_row3(0).length_squared(),
+                       mat.get_row3(1).length_squared(),
+                       mat.get_row3(2).length_squared());
+    if (IS_THRESHOLD_EQUAL(scale_sq[0], scale_sq[1], 2.0e-3f) &&
+        IS_THRESHOLD_EQUAL(scale_sq[0], scale_sq[2], 2.0e-3f)) {
+      LVecBase3 scale, shear, hpr;
+      if (IS_THRESHOLD_EQUAL(scale_sq[0], 1, 2.0e-3f)) {
+        normal_mat = mat;
+      } else if (decompose_matrix(mat.get_upper_3(), scale, shear, hpr)) {
+        compose_matrix(normal_mat, LVecBase3(1, 1, 1), shear, hpr, LVecBase3::zero());
+      } else {
+        normal_mat = mat;
+        dt._normalize = true;
+      }
+    } else {
+      normal_mat.invert_from(mat);
+      normal_mat.transpose_in_place();
+      dt._normalize = true;
+    }
+    dt._normal_mat = LCAST(float, normal_mat);
+  }
+
+  if (!any_changed) {
+    return;
+  }
+
+  // Now gather up the rows that need to be transformed.
+  state->_work.clear();
+  size_t total_rows = 0;
+
+  DirectDatas::iterator di;
+  for (di = state->_datas.begin(); di != state->_datas.end(); ++di) {
+    DirectData &dd = (*di);
+    size_t first_work = state->_work.size();
+
+    DirectRanges::const_iterator ri;
+    for (ri = dd._ranges.begin(); ri != dd._ranges.end(); ++ri) {
+      const DirectRange &range = (*ri);
+      if (!state->_transforms[range._transform]._changed) {
+        continue;
+      }
+      for (int begin = range._begin; begin < range._end; begin += direct_max_work_rows) {
+        DirectWork work;
+        work._data = &dd;
+        work._transform = range._transform;
+        work._begin = begin;
+        work._end = std::min(begin + direct_max_work_rows, range._end);
+        state->_work.push_back(work);
+      }
+      total_rows += range._end - range._begin;
+    }
+
+    if (state->_work.size() == first_work) {
+      continue;
+    }
+
+    // Get the pointers to the arrays we'll be reading and writing.
+    size_t num_arrays = dd._orig->get_num_arrays();
+    dd._in_handles.assign(num_arrays, nullptr);
+    dd._out_handles.assign(num_arrays, nullptr);
+    dd._in_pointers.assign(num_arrays, nullptr);
+    dd._out_pointers.assign(num_arrays, nullptr);
+
+    DirectColumns::const_iterator ci;
+    for (ci = dd._columns.begin(); ci != dd._columns.end(); ++ci) {
+      int ai = (*ci)._array;
+      if (dd._in_handles[ai] == nullptr) {
+        dd._in_handles[ai] = dd._orig->get_array_handle(ai);
+        dd._out_handles[ai] = dd._animated->modify_array_handle(ai);
+        dd._in_pointers[ai] = dd._in_handles[ai]->get_read_pointer(true);
+        dd._out_pointers[ai] = dd._out_handles[ai]->get_write_pointer();
+      }
+    }
+  }
+
+  // Decide how many threads it is worth using.
+  size_t num_jobs = 1;
+  int num_threads = rigid_body_combiner_num_threads;
+  if (num_threads > 0 && Thread::is_threading_supported()) {
+    num_jobs = std::min((size_t)num_threads + 1, total_rows / direct_min_job_rows);
+    num_jobs = std::min(num_jobs, state->_work.size());
+  }
+
+  if (num_jobs <= 1) {
+    transform_rows(state, 0, state->_work.size());
+
+  } else {
+    // Divide the work list into jobs with about the same number of rows, and
+    // hand all but the first to the task chain.
+    state->_jobs.resize(num_jobs);
+    size_t wi = 0;
+    size_t rows_so_far = 0;
+    for (size_t ji = 0; ji < num_jobs; ++ji) {
+      DirectJob &job = state->_jobs[ji];
+      job._state = state;
+      job._begin = wi;
+      size_t target = total_rows * (ji + 1) / num_jobs;
+      while (wi < state->_work.size() &&
+             (rows_so_far < target || ji + 1 == num_jobs)) {
+        rows_so_far += state->_work[wi]._end - state->_work[wi]._begin;
+        ++wi;
+      }
+      job._end = wi;
+    }
+
+    AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+    PT(AsyncTaskChain) chain = task_mgr->make_task_chain("rigid_body_combiner");
+    if (chain->get_num_threads() < num_threads) {
+      chain->set_num_threads(num_threads);
+    }
+    for (size_t ji = 1; ji < num_jobs; ++ji) {
+      PT(GenericAsyncTask) task =
+        new GenericAsyncTask("rigid_body_combiner", &st_transform_rows, &state->_jobs[ji]);
+      task->set_task_chain(chain->get_name());
+      task_mgr->add(task);
+    }
+    transform_rows(state, state->_jobs[0]._begin, state->_jobs[0]._end);
+    chain->wait_for_tasks();
+  }
+
+  // Clean up for next time.
+  for (size_t ti = 0; ti < num_transforms; ++ti) {
+    state->_transforms[ti]._changed = false;
+  }
+  for (di = state->_datas.begin(); di != state->_datas.end(); ++di) {
+    (*di)._in_handles.clear();
+    (*di)._out_handles.clear();
+    (*di)._in_pointers.clear();
+    (*di)._out_pointers.clear();
+  }
+  state->_work.clear();
+}
+
+/**
+ * Transforms the rows described by the indicated portion of the work list.
+ * This may be called on several threads at once, for different portions.
+ */
+void RigidBodyCombiner::
+transform_rows(const DirectState *state, size_t begin, size_t end) {
+  for (size_t wi = begin; wi < end; ++wi) {
+    const DirectWork &work = state->_work[wi];
+    const DirectData &dd = *work._data;
+    const DirectTransform &dt = state->_transforms[work._transform];
+    size_t num_rows = work._end - work._begin;
+
+    DirectColumns::const_iterator ci;
+    for (ci = dd._columns.begin(); ci != dd._columns.end(); ++ci) {
+      const DirectColumn &dc = (*ci);
+      size_t offset = dc._start + work._begin * dc._stride;
+      const float *in = (const float *)(dd._in_pointers[dc._array] + offset);
+      float *out = (float *)(dd._out_pointers[dc._array] + offset);
+
+      switch (dc._type) {
+      case CT_point:
+        batch_xform_points(dt._mat.get_data(), in, out, num_rows,
+                           dc._stride, dc._stride);
+        break;
+
+      case CT_vector:
+        batch_xform_vecs(dt._mat.get_data(), in, out, num_rows,
+                         dc._stride, dc._stride);
+        break;
+
+      case CT_normal:
+        batch_xform_vecs(dt._normal_mat.get_data(), in, out, num_rows,
+                         dc._stride, dc._stride);
+        if (dt._normalize) {
+          unsigned char *row = (unsigned char *)out;
+          for (size_t i = 0; i < num_rows; ++i) {
+            ((LVector3f *)row)->normalize();
+            row += dc._stride;
+          }
+        }
+        break;
+      }
+    }
+  }
+}
+
+/**
+ * The task function that runs one DirectJob on the task chain.
+ */
+AsyncTask::DoneStatus RigidBodyCombiner::
+st_transform_rows(GenericAsyncTask *, void *data) {
+  const DirectJob *job = (const DirectJob *)data;
+  transform_rows(job->_state, job->_begin, job->_end);
+  return AsyncTask::DS_done;
+}
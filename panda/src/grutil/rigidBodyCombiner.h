@@ -18,9 +18,15 @@
 
 #include "pandaNode.h"
 #include "nodeVertexTransform.h"
+#include "geomVertexData.h"
+#include "asyncTaskChain.h"
+#include "lightMutex.h"
 #include "pvector.h"
+#include "pmap.h"
+#include "pStatCollector.h"
 
 class NodePath;
+class GenericAsyncTask;
 
 /**
  * This is a special node that combines multiple independently-moving rigid
@@ -40,6 +46,11 @@ class NodePath;
  * freely without having to call collect() again.
  *
  * RenderEffects such as Billboards are not supported below this node.
+ *
+ * By default (see rigid-body-combiner-direct), the combiner keeps a table of
+ * the transforms of its moving children and applies them to the vertices
+ * itself at cull time, updating only the vertices whose transform has
+ * changed since the last frame.
  */
 class EXPCL_PANDA_GRUTIL RigidBodyCombiner : public PandaNode {
 PUBLISHED:
@@ -64,11 +75,118 @@ private:
   PT(GeomVertexData) convert_vd(const VertexTransform *transform,
                                 const GeomVertexData *orig);
 
+  typedef pmap<const VertexTransform *, int> TransformIndex;
+
+  class DirectState;
+
+  void make_direct();
+  PT(GeomVertexData) make_direct_vd(DirectState *state,
+                                    const GeomVertexData *orig,
+                                    const TransformIndex &transform_index);
+  void update_direct(Thread *current_thread);
+  static void transform_rows(const DirectState *state,
+                             size_t begin, size_t end);
+  static AsyncTask::DoneStatus st_transform_rows(GenericAsyncTask *task,
+                                                 void *data);
+
   PT(PandaNode) _internal_root;
 
   typedef pvector< PT(NodeVertexTransform) > Transforms;
   Transforms _internal_transforms;
 
+  // The following support the direct transformation of the vertices.  Each
+  // DirectTransform records the matrix of one of the _internal_transforms as
+  // last applied to the vertices.
+  class DirectTransform {
+  public:
+    LMatrix4f _mat;
+    LMatrix4f _normal_mat;
+    bool _normalize;
+    bool _changed;
+  };
+  typedef pvector<DirectTransform> DirectTransforms;
+
+  enum ColumnType {
+    CT_point,
+    CT_vector,
+    CT_normal,
+  };
+
+  // A float32 column with three components that is transformed by the
+  // vertex's transform.
+  class DirectColumn {
+  public:
+    int _array;
+    size_t _start;
+    size_t _stride;
+    ColumnType _type;
+  };
+  typedef pvector<DirectColumn> DirectColumns;
+
+  // A run of consecutive rows that are all assigned to the same transform.
+  class DirectRange {
+  public:
+    int _transform;
+    int _begin;
+    int _end;
+  };
+  typedef pvector<DirectRange> DirectRanges;
+
+  // A GeomVertexData whose vertices we transform directly.  _orig holds the
+  // untransformed vertices, as produced by collect(), and _animated is the
+  // copy that is actually rendered.
+  class DirectData {
+  public:
+    CPT(GeomVertexData) _orig;
+    PT(GeomVertexData) _animated;
+    DirectColumns _columns;
+    DirectRanges _ranges;
+
+    // These are only valid during update_direct().
+    pvector< CPT(GeomVertexArrayDataHandle) > _in_handles;
+    pvector< PT(GeomVertexArrayDataHandle) > _out_handles;
+    pvector<const unsigned char *> _in_pointers;
+    pvector<unsigned char *> _out_pointers;
+  };
+  typedef pvector<DirectData> DirectDatas;
+
+  // Some rows whose transform has changed, to be transformed this frame.
+  class DirectWork {
+  public:
+    const DirectData *_data;
+    int _transform;
+    int _begin;
+    int _end;
+  };
+  typedef pvector<DirectWork> DirectWorks;
+
+  // A portion of the work list that is handed to a worker thread.
+  class DirectJob {
+  public:
+    const DirectState *_state;
+    size_t _begin;
+    size_t _end;
+  };
+
+  // Everything needed to transform the vertices of one internal scene.  A
+  // copy of the RigidBodyCombiner shares the internal scene, and therefore
+  // this object, with the original, so that the lock protects the vertices
+  // no matter which copy is being culled.
+  class DirectState : public ReferenceCount {
+  public:
+    DirectTransforms _transforms;
+    DirectDatas _datas;
+
+    LightMutex _lock;
+    DirectWorks _work;
+    pvector<DirectJob> _jobs;
+  };
+
+  PT(DirectState) _direct;
+  bool _any_animated;
+
+  static PStatCollector _direct_pcollector;
+
   class VDUnifier {
   public:
     INLINE VDUnifier(const VertexTransform *transform,
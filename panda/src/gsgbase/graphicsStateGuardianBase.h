@@ -217,6 +217,12 @@ public:
   virtual bool draw_points(const GeomPrimitivePipelineReader *reader, bool force)=0;
   virtual void end_draw_primitives()=0;
 
+  virtual void draw_instances(const GeomPipelineReader *geom_reader,
+                              const GeomVertexDataPipelineReader *data_reader,
+                              const RenderState *state,
+                              const TransformState * const *transforms,
+                              size_t num_instances, bool force)=0;
+
   virtual bool framebuffer_copy_to_texture
   (Texture *tex, int view, int z, const DisplayRegion *dr, const RenderBuffer &rb)=0;
   virtual bool framebuffer_copy_to_ram
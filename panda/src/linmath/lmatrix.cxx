@@ -12,6 +12,7 @@
  */
 
 #include "lmatrix.h"
+#include "lmatrix_batch.h"
 
 #include "fltnames.h"
 #include "lmatrix3_src.cxx"
@@ -302,6 +302,85 @@ almost_equal(const FLOATNAME(LMatrix4) &other, FLOATTYPE threshold) const {
 #endif
 }
 
+/**
+ * Transforms the n 3-component points in the in array by this matrix, which
+ * is assumed to be an affine transform, and stores the results in the out
+ * array.  This is equivalent to calling xform_point() on each point, but is
+ * much faster for large arrays.
+ */
+void FLOATNAME(LMatrix4)::
+xform_points(const FLOATNAME(LVecBase3) *in, FLOATNAME(LVecBase3) *out, size_t n) const {
+  const size_t stride = sizeof(FLOATNAME(LVecBase3));
+  batch_xform_points(get_data(), in->get_data(), (FLOATTYPE *)out, n, stride, stride);
+}
+
+/**
+ * Transforms the n 3-component vectors in the in array by the upper 3x3 of
+ * this matrix, and stores the results in the out array.  This is equivalent
+ * to calling xform_vec() on each vector.
+ */
+void FLOATNAME(LMatrix4)::
+xform_vecs(const FLOATNAME(LVecBase3) *in, FLOATNAME(LVecBase3) *out, size_t n) const {
+  const size_t stride = sizeof(FLOATNAME(LVecBase3));
+  batch_xform_vecs(get_data(), in->get_data(), (FLOATTYPE *)out, n, stride, stride);
+}
+
+/**
+ * Transforms the n 4-component vectors in the in array by this matrix, and
+ * stores the results in the out array.  This is equivalent to calling xform()
+ * on each vector.
+ */
+void FLOATNAME(LMatrix4)::
+xform_array(const FLOATNAME(LVecBase4) *in, FLOATNAME(LVecBase4) *out, size_t n) const {
+  const size_t stride = sizeof(FLOATNAME(LVecBase4));
+  batch_xform(get_data(), in->get_data(), (FLOATTYPE *)out, n, stride, stride);
+}
+
+/**
+ * Computes out[i] = a[i] * b[i] for each of the n matrices in the arrays.
+ * The out array may be the same as either of the input arrays.
+ */
+void FLOATNAME(LMatrix4)::
+multiply_array(FLOATNAME(LMatrix4) *out, const FLOATNAME(LMatrix4) *a,
+               const FLOATNAME(LMatrix4) *b, size_t n) {
+  static_assert(sizeof(FLOATNAME(LMatrix4)) == sizeof(FLOATTYPE) * 16, "LMatrix4 must be tightly packed");
+  batch_multiply(a->get_data(), b->get_data(), (FLOATTYPE *)out, n, 16);
+}
+
+/**
+ * Computes out[i] = a[i] * b for each of the n matrices in the arrays.  The
+ * out array may be the same as the a array.
+ */
+void FLOATNAME(LMatrix4)::
+multiply_array(FLOATNAME(LMatrix4) *out, const FLOATNAME(LMatrix4) *a,
+               const FLOATNAME(LMatrix4) &b, size_t n) {
+  nassertv(out != &b);
+  batch_multiply(a->get_data(), b.get_data(), (FLOATTYPE *)out, n, 0);
+}
+
+/**
+ * Inverts each of the n matrices in the in array, storing the results in the
+ * out array, which may be the same as the in array.  Returns true if all of
+ * the matrices were invertible; the singular ones are replaced with the
+ * identity matrix, as in invert_from().
+ */
+bool FLOATNAME(LMatrix4)::
+invert_array(FLOATNAME(LMatrix4) *out, const FLOATNAME(LMatrix4) *in, size_t n) {
+  bool all_invertible = true;
+  for (size_t i = 0; i < n; ++i) {
+    if (out == in) {
+      if (!out[i].invert_in_place()) {
+        all_invertible = false;
+      }
+    } else {
+      if (!out[i].invert_from(in[i])) {
+        all_invertible = false;
+      }
+    }
+  }
+  return all_invertible;
+}
+
 /**
  *
  */
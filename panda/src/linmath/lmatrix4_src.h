@@ -281,6 +281,25 @@ PUBLISHED:
   void write_datagram(Datagram &destination) const;
   void read_datagram(DatagramIterator &source);
 
+public:
+  // These transform or combine whole arrays at once, using SIMD kernels
+  // where available.  The output array may be the same as the input array.
+  void xform_points(const FLOATNAME(LVecBase3) *in,
+                    FLOATNAME(LVecBase3) *out, size_t n) const;
+  void xform_vecs(const FLOATNAME(LVecBase3) *in,
+                  FLOATNAME(LVecBase3) *out, size_t n) const;
+  void xform_array(const FLOATNAME(LVecBase4) *in,
+                   FLOATNAME(LVecBase4) *out, size_t n) const;
+
+  static void multiply_array(FLOATNAME(LMatrix4) *out,
+                             const FLOATNAME(LMatrix4) *a,
+                             const FLOATNAME(LMatrix4) *b, size_t n);
+  static void multiply_array(FLOATNAME(LMatrix4) *out,
+                             const FLOATNAME(LMatrix4) *a,
+                             const FLOATNAME(LMatrix4) &b, size_t n);
+  static bool invert_array(FLOATNAME(LMatrix4) *out,
+                           const FLOATNAME(LMatrix4) *in, size_t n);
+
 public:
   // The underlying implementation is via the Eigen library, if available.
 
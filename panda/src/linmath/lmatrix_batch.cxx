@@ -0,0 +1,471 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file lmatrix_batch.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "lmatrix_batch.h"
+
+#if defined(__SSE2__) || (_M_IX86_FP >= 2) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define LMATRIX_BATCH_SSE2
+
+// With FMA3 available (which is implied by any AVX2-capable target we build
+// for), the multiply-adds can be fused.
+#ifdef __FMA__
+#include <immintrin.h>
+#define BATCH_MADD(a, b, c) _mm_fmadd_ps((a), (b), (c))
+#else
+#define BATCH_MADD(a, b, c) _mm_add_ps(_mm_mul_ps((a), (b)), (c))
+#endif
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LMATRIX_BATCH_NEON
+#endif
+
+/**
+ * Advances a pointer by the indicated number of bytes.
+ */
+template<class Type>
+static inline const Type *
+advance(const Type *ptr, size_t stride) {
+  return (const Type *)((const unsigned char *)ptr + stride);
+}
+
+/**
+ * Advances a pointer by the indicated number of bytes.
+ */
+template<class Type>
+static inline Type *
+advance(Type *ptr, size_t stride) {
+  return (Type *)((unsigned char *)ptr + stride);
+}
+
+/**
+ * The portable implementation of batch_xform_points(), used for doubles and
+ * for the leftover elements that don't fill a SIMD register.
+ */
+template<class Type>
+static inline void
+scalar_xform_points(const Type *m, const Type *in, Type *out, size_t n,
+                    size_t in_stride, size_t out_stride) {
+  for (size_t i = 0; i < n; ++i) {
+    Type x = in[0], y = in[1], z = in[2];
+    out[0] = x * m[0] + y * m[4] + z * m[8] + m[12];
+    out[1] = x * m[1] + y * m[5] + z * m[9] + m[13];
+    out[2] = x * m[2] + y * m[6] + z * m[10] + m[14];
+    in = advance(in, in_stride);
+    out = advance(out, out_stride);
+  }
+}
+
+/**
+ * The portable implementation of batch_xform_vecs().
+ */
+template<class Type>
+static inline void
+scalar_xform_vecs(const Type *m, const Type *in, Type *out, size_t n,
+                  size_t in_stride, size_t out_stride) {
+  for (size_t i = 0; i < n; ++i) {
+    Type x = in[0], y = in[1], z = in[2];
+    out[0] = x * m[0] + y * m[4] + z * m[8];
+    out[1] = x * m[1] + y * m[5] + z * m[9];
+    out[2] = x * m[2] + y * m[6] + z * m[10];
+    in = advance(in, in_stride);
+    out = advance(out, out_stride);
+  }
+}
+
+/**
+ * The portable implementation of batch_xform().
+ */
+template<class Type>
+static inline void
+scalar_xform(const Type *m, const Type *in, Type *out, size_t n,
+             size_t in_stride, size_t out_stride) {
+  for (size_t i = 0; i < n; ++i) {
+    Type x = in[0], y = in[1], z = in[2], w = in[3];
+    out[0] = x * m[0] + y * m[4] + z * m[8] + w * m[12];
+    out[1] = x * m[1] + y * m[5] + z * m[9] + w * m[13];
+    out[2] = x * m[2] + y * m[6] + z * m[10] + w * m[14];
+    out[3] = x * m[3] + y * m[7] + z * m[11] + w * m[15];
+    in = advance(in, in_stride);
+    out = advance(out, out_stride);
+  }
+}
+
+/**
+ * The portable implementation of batch_multiply().
+ */
+template<class Type>
+static inline void
+scalar_multiply(const Type *a, const Type *b, Type *out, size_t n,
+                size_t b_stride) {
+  for (size_t i = 0; i < n; ++i) {
+    Type r[16];
+    for (int row = 0; row < 4; ++row) {
+      const Type *ar = a + row * 4;
+      for (int col = 0; col < 4; ++col) {
+        r[row * 4 + col] =
+          ar[0] * b[col] + ar[1] * b[4 + col] +
+          ar[2] * b[8 + col] + ar[3] * b[12 + col];
+      }
+    }
+    for (int j = 0; j < 16; ++j) {
+      out[j] = r[j];
+    }
+    a += 16;
+    b += b_stride;
+    out += 16;
+  }
+}
+
+#ifdef LMATRIX_BATCH_SSE2
+/**
+ * Loads four tightly-packed 3-component vectors and transposes them, so that
+ * x, y and z each receive one component of all four vectors.
+ */
+static inline void
+load_transpose3(const float *in, __m128 &x, __m128 &y, __m128 &z) {
+  __m128 a = _mm_loadu_ps(in);
+  __m128 b = _mm_loadu_ps(in + 4);
+  __m128 c = _mm_loadu_ps(in + 8);
+
+  x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)),
+                     _MM_SHUFFLE(2, 0, 3, 0));
+  y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)),
+                     _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)),
+                     _MM_SHUFFLE(2, 0, 2, 0));
+  z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)),
+                     c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+/**
+ * The inverse of load_transpose3(): interleaves the components back into
+ * four tightly-packed 3-component vectors.
+ */
+static inline void
+transpose_store3(float *out, __m128 x, __m128 y, __m128 z) {
+  _mm_storeu_ps(out, _mm_shuffle_ps(_mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 0, 0, 0)),
+                                    _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)),
+                                    _MM_SHUFFLE(2, 0, 2, 0)));
+  _mm_storeu_ps(out + 4, _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)),
+                                        _mm_shuffle_ps(x, y, _MM_SHUFFLE(2, 2, 2, 2)),
+                                        _MM_SHUFFLE(2, 0, 2, 0)));
+  _mm_storeu_ps(out + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+                                        _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+                                        _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/**
+ * Stores the first three components of v.
+ */
+static inline void
+store3(float *out, __m128 v) {
+  _mm_storel_pi((__m64 *)out, v);
+  _mm_store_ss(out + 2, _mm_movehl_ps(v, v));
+}
+#endif  // LMATRIX_BATCH_SSE2
+
+/**
+ *
+ */
+void
+batch_xform_points(const float *m, const float *in, float *out, size_t n,
+                   size_t in_stride, size_t out_stride) {
+  size_t i = 0;
+
+#if defined(LMATRIX_BATCH_SSE2)
+  if (in_stride == sizeof(float) * 3 && out_stride == sizeof(float) * 3) {
+    // Four packed points at a time occupy exactly three registers.  We
+    // transpose them, do the arithmetic on all four points at once, and
+    // transpose the result back.
+    const __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]);
+    const __m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]);
+    const __m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]);
+    const __m128 m30 = _mm_set1_ps(m[12]), m31 = _mm_set1_ps(m[13]), m32 = _mm_set1_ps(m[14]);
+
+    for (; i + 4 <= n; i += 4) {
+      __m128 x, y, z;
+      load_transpose3(in, x, y, z);
+      transpose_store3(out,
+        BATCH_MADD(x, m00, BATCH_MADD(y, m10, BATCH_MADD(z, m20, m30))),
+        BATCH_MADD(x, m01, BATCH_MADD(y, m11, BATCH_MADD(z, m21, m31))),
+        BATCH_MADD(x, m02, BATCH_MADD(y, m12, BATCH_MADD(z, m22, m32))));
+      in += 12;
+      out += 12;
+    }
+  } else {
+    // Interleaved data; transform one point at a time, as a linear
+    // combination of the matrix rows.
+    const __m128 r0 = _mm_loadu_ps(m);
+    const __m128 r1 = _mm_loadu_ps(m + 4);
+    const __m128 r2 = _mm_loadu_ps(m + 8);
+    const __m128 r3 = _mm_loadu_ps(m + 12);
+
+    for (; i < n; ++i) {
+      store3(out, BATCH_MADD(_mm_set1_ps(in[0]), r0,
+                  BATCH_MADD(_mm_set1_ps(in[1]), r1,
+                  BATCH_MADD(_mm_set1_ps(in[2]), r2, r3))));
+      in = advance(in, in_stride);
+      out = advance(out, out_stride);
+    }
+  }
+
+#elif defined(LMATRIX_BATCH_NEON)
+  if (in_stride == sizeof(float) * 3 && out_stride == sizeof(float) * 3) {
+    // NEON can deinterleave packed points for us as it loads them.
+    for (; i + 4 <= n; i += 4) {
+      float32x4x3_t p = vld3q_f32(in);
+      float32x4x3_t r;
+      for (int j = 0; j < 3; ++j) {
+        float32x4_t v = vdupq_n_f32(m[12 + j]);
+        v = vmlaq_n_f32(v, p.val[0], m[j]);
+        v = vmlaq_n_f32(v, p.val[1], m[4 + j]);
+        r.val[j] = vmlaq_n_f32(v, p.val[2], m[8 + j]);
+      }
+      vst3q_f32(out, r);
+      in += 12;
+      out += 12;
+    }
+  } else {
+    const float32x4_t r0 = vld1q_f32(m);
+    const float32x4_t r1 = vld1q_f32(m + 4);
+    const float32x4_t r2 = vld1q_f32(m + 8);
+    const float32x4_t r3 = vld1q_f32(m + 12);
+
+    for (; i < n; ++i) {
+      float32x4_t v = vmlaq_n_f32(r3, r0, in[0]);
+      v = vmlaq_n_f32(v, r1, in[1]);
+      v = vmlaq_n_f32(v, r2, in[2]);
+      vst1_f32(out, vget_low_f32(v));
+      vst1q_lane_f32(out + 2, v, 2);
+      in = advance(in, in_stride);
+      out = advance(out, out_stride);
+    }
+  }
+#endif
+
+  scalar_xform_points(m, in, out, n - i, in_stride, out_stride);
+}
+
+/**
+ *
+ */
+void
+batch_xform_points(const double *m, const double *in, double *out, size_t n,
+                   size_t in_stride, size_t out_stride) {
+  scalar_xform_points(m, in, out, n, in_stride, out_stride);
+}
+
+/**
+ *
+ */
+void
+batch_xform_vecs(const float *m, const float *in, float *out, size_t n,
+                 size_t in_stride, size_t out_stride) {
+  size_t i = 0;
+
+#if defined(LMATRIX_BATCH_SSE2)
+  if (in_stride == sizeof(float) * 3 && out_stride == sizeof(float) * 3) {
+    const __m128 m00 = _mm_set1_ps(m[0]), m01 = _mm_set1_ps(m[1]), m02 = _mm_set1_ps(m[2]);
+    const __m128 m10 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m12 = _mm_set1_ps(m[6]);
+    const __m128 m20 = _mm_set1_ps(m[8]), m21 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]);
+
+    for (; i + 4 <= n; i += 4) {
+      __m128 x, y, z;
+      load_transpose3(in, x, y, z);
+      transpose_store3(out,
+        BATCH_MADD(x, m00, BATCH_MADD(y, m10, _mm_mul_ps(z, m20))),
+        BATCH_MADD(x, m01, BATCH_MADD(y, m11, _mm_mul_ps(z, m21))),
+        BATCH_MADD(x, m02, BATCH_MADD(y, m12, _mm_mul_ps(z, m22))));
+      in += 12;
+      out += 12;
+    }
+  } else {
+    const __m128 r0 = _mm_loadu_ps(m);
+    const __m128 r1 = _mm_loadu_ps(m + 4);
+    const __m128 r2 = _mm_loadu_ps(m + 8);
+
+    for (; i < n; ++i) {
+      store3(out, BATCH_MADD(_mm_set1_ps(in[0]), r0,
+                  BATCH_MADD(_mm_set1_ps(in[1]), r1,
+                  _mm_mul_ps(_mm_set1_ps(in[2]), r2))));
+      in = advance(in, in_stride);
+      out = advance(out, out_stride);
+    }
+  }
+
+#elif defined(LMATRIX_BATCH_NEON)
+  if (in_stride == sizeof(float) * 3 && out_stride == sizeof(float) * 3) {
+    for (; i + 4 <= n; i += 4) {
+      float32x4x3_t p = vld3q_f32(in);
+      float32x4x3_t r;
+      for (int j = 0; j < 3; ++j) {
+        float32x4_t v = vmulq_n_f32(p.val[0], m[j]);
+        v = vmlaq_n_f32(v, p.val[1], m[4 + j]);
+        r.val[j] = vmlaq_n_f32(v, p.val[2], m[8 + j]);
+      }
+      vst3q_f32(out, r);
+      in += 12;
+      out += 12;
+    }
+  } else {
+    const float32x4_t r0 = vld1q_f32(m);
+    const float32x4_t r1 = vld1q_f32(m + 4);
+    const float32x4_t r2 = vld1q_f32(m + 8);
+
+    for (; i < n; ++i) {
+      float32x4_t v = vmulq_n_f32(r0, in[0]);
+      v = vmlaq_n_f32(v, r1, in[1]);
+      v = vmlaq_n_f32(v, r2, in[2]);
+      vst1_f32(out, vget_low_f32(v));
+      vst1q_lane_f32(out + 2, v, 2);
+      in = advance(in, in_stride);
+      out = advance(out, out_stride);
+    }
+  }
+#endif
+
+  scalar_xform_vecs(m, in, out, n - i, in_stride, out_stride);
+}
+
+/**
+ *
+ */
+void
+batch_xform_vecs(const double *m, const double *in, double *out, size_t n,
+                 size_t in_stride, size_t out_stride) {
+  scalar_xform_vecs(m, in, out, n, in_stride, out_stride);
+}
+
+/**
+ *
+ */
+void
+batch_xform(const float *m, const float *in, float *out, size_t n,
+            size_t in_stride, size_t out_stride) {
+#if defined(LMATRIX_BATCH_SSE2)
+  const __m128 r0 = _mm_loadu_ps(m);
+  const __m128 r1 = _mm_loadu_ps(m + 4);
+  const __m128 r2 = _mm_loadu_ps(m + 8);
+  const __m128 r3 = _mm_loadu_ps(m + 12);
+
+  for (size_t i = 0; i < n; ++i) {
+    __m128 v = _mm_loadu_ps(in);
+    __m128 x = _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+    __m128 y = _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    __m128 z = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+    __m128 w = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+    _mm_storeu_ps(out, BATCH_MADD(x, r0, BATCH_MADD(y, r1, BATCH_MADD(z, r2, _mm_mul_ps(w, r3)))));
+    in = advance(in, in_stride);
+    out = advance(out, out_stride);
+  }
+
+#elif defined(LMATRIX_BATCH_NEON)
+  const float32x4_t r0 = vld1q_f32(m);
+  const float32x4_t r1 = vld1q_f32(m + 4);
+  const float32x4_t r2 = vld1q_f32(m + 8);
+  const float32x4_t r3 = vld1q_f32(m + 12);
+
+  for (size_t i = 0; i < n; ++i) {
+    float32x4_t r = vmulq_n_f32(r0, in[0]);
+    r = vmlaq_n_f32(r, r1, in[1]);
+    r = vmlaq_n_f32(r, r2, in[2]);
+    r = vmlaq_n_f32(r, r3, in[3]);
+    vst1q_f32(out, r);
+    in = advance(in, in_stride);
+    out = advance(out, out_stride);
+  }
+
+#else
+  scalar_xform(m, in, out, n, in_stride, out_stride);
+#endif
+}
+
+/**
+ *
+ */
+void
+batch_xform(const double *m, const double *in, double *out, size_t n,
+            size_t in_stride, size_t out_stride) {
+  scalar_xform(m, in, out, n, in_stride, out_stride);
+}
+
+/**
+ *
+ */
+void
+batch_multiply(const float *a, const float *b, float *out, size_t n,
+               size_t b_stride) {
+#if defined(LMATRIX_BATCH_SSE2)
+  // Each row of the result is a linear combination of the rows of b,
+  // weighted by the elements of the corresponding row of a.
+  for (size_t i = 0; i < n; ++i) {
+    __m128 b0 = _mm_loadu_ps(b);
+    __m128 b1 = _mm_loadu_ps(b + 4);
+    __m128 b2 = _mm_loadu_ps(b + 8);
+    __m128 b3 = _mm_loadu_ps(b + 12);
+
+    __m128 r[4];
+    for (int row = 0; row < 4; ++row) {
+      const float *ar = a + row * 4;
+      r[row] = BATCH_MADD(_mm_set1_ps(ar[0]), b0,
+               BATCH_MADD(_mm_set1_ps(ar[1]), b1,
+               BATCH_MADD(_mm_set1_ps(ar[2]), b2,
+                          _mm_mul_ps(_mm_set1_ps(ar[3]), b3))));
+    }
+    _mm_storeu_ps(out, r[0]);
+    _mm_storeu_ps(out + 4, r[1]);
+    _mm_storeu_ps(out + 8, r[2]);
+    _mm_storeu_ps(out + 12, r[3]);
+    a += 16;
+    b += b_stride;
+    out += 16;
+  }
+
+#elif defined(LMATRIX_BATCH_NEON)
+  for (size_t i = 0; i < n; ++i) {
+    float32x4_t b0 = vld1q_f32(b);
+    float32x4_t b1 = vld1q_f32(b + 4);
+    float32x4_t b2 = vld1q_f32(b + 8);
+    float32x4_t b3 = vld1q_f32(b + 12);
+
+    float32x4_t r[4];
+    for (int row = 0; row < 4; ++row) {
+      const float *ar = a + row * 4;
+      float32x4_t v = vmulq_n_f32(b0, ar[0]);
+      v = vmlaq_n_f32(v, b1, ar[1]);
+      v = vmlaq_n_f32(v, b2, ar[2]);
+      r[row] = vmlaq_n_f32(v, b3, ar[3]);
+    }
+    vst1q_f32(out, r[0]);
+    vst1q_f32(out + 4, r[1]);
+    vst1q_f32(out + 8, r[2]);
+    vst1q_f32(out + 12, r[3]);
+    a += 16;
+    b += b_stride;
+    out += 16;
+  }
+
+#else
+  scalar_multiply(a, b, out, n, b_stride);
+#endif
+}
+
+/**
+ *
+ */
+void
+batch_multiply(const double *a, const double *b, double *out, size_t n,
+               size_t b_stride) {
+  scalar_multiply(a, b, out, n, b_stride);
+}
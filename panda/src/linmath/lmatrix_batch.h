@@ -0,0 +1,67 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file lmatrix_batch.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef LMATRIX_BATCH_H
+#define LMATRIX_BATCH_H
+
+#include "pandabase.h"
+
+/*
+ * These are the low-level kernels behind the array forms of the LMatrix4
+ * operations, such as LMatrix4::xform_points().  They operate on raw arrays
+ * of floats or doubles, in the same row-major layout used by LMatrix4 and
+ * LVecBase3/LVecBase4, and are hand-vectorized with SSE2 or NEON for the
+ * single-precision case where the compiler allows it.  Normally you should
+ * call the LMatrix4 methods instead of these.
+ *
+ * The vector kernels accept the stride, in bytes, between consecutive input
+ * and output vectors, so that they may be applied directly to a column of
+ * interleaved vertex data; the fastest path is taken when the vectors are
+ * tightly packed.  In all cases, the output array may be the same as the
+ * input array (with the same stride), but it may not otherwise overlap it.
+ */
+
+// Transforms n 3-component points by the affine matrix mat.
+EXPCL_PANDA_LINMATH void
+batch_xform_points(const float *mat, const float *in, float *out, size_t n,
+                   size_t in_stride, size_t out_stride);
+EXPCL_PANDA_LINMATH void
+batch_xform_points(const double *mat, const double *in, double *out, size_t n,
+                   size_t in_stride, size_t out_stride);
+
+// Transforms n 3-component vectors by the upper 3x3 of mat.
+EXPCL_PANDA_LINMATH void
+batch_xform_vecs(const float *mat, const float *in, float *out, size_t n,
+                 size_t in_stride, size_t out_stride);
+EXPCL_PANDA_LINMATH void
+batch_xform_vecs(const double *mat, const double *in, double *out, size_t n,
+                 size_t in_stride, size_t out_stride);
+
+// Transforms n 4-component vectors by the full matrix mat.
+EXPCL_PANDA_LINMATH void
+batch_xform(const float *mat, const float *in, float *out, size_t n,
+            size_t in_stride, size_t out_stride);
+EXPCL_PANDA_LINMATH void
+batch_xform(const double *mat, const double *in, double *out, size_t n,
+            size_t in_stride, size_t out_stride);
+
+// Computes out[i] = a[i] * b[i] for n 4x4 matrices (stride 16).  If b_stride
+// is 0, the same matrix b is used for every product.
+EXPCL_PANDA_LINMATH void
+batch_multiply(const float *a, const float *b, float *out, size_t n,
+               size_t b_stride = 16);
+EXPCL_PANDA_LINMATH void
+batch_multiply(const double *a, const double *b, double *out, size_t n,
+               size_t b_stride = 16);
+
+#endif
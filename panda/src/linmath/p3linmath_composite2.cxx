@@ -4,6 +4,7 @@
 #include "config_linmath.cxx"
 #include "coordinateSystem.cxx"
 #include "lmatrix.cxx"
+#include "lmatrix_batch.cxx"
 #include "lorientation.cxx"
 #include "lpoint2.cxx"
 #include "lpoint3.cxx"
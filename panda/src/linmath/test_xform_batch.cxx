@@ -0,0 +1,151 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_xform_batch.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "luse.h"
+#include "lmatrix.h"
+#include "lmatrix_batch.h"
+#include "pvector.h"
+
+#include "pnotify.h"
+#include <chrono>
+#include <stdlib.h>
+
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock Clock;
+
+static const int num_points = 100000;
+static const int num_matrices = 10000;
+static const int num_iterations = 100;
+
+/**
+ * Returns the number of nanoseconds elapsed since start, divided by count.
+ */
+static double
+ns_per(Clock::time_point start, double count) {
+  std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  return elapsed.count() / count;
+}
+
+/**
+ * Returns a random number in the range [-1, 1].
+ */
+static float
+frand() {
+  return (float)rand() / (float)RAND_MAX * 2.0f - 1.0f;
+}
+
+/**
+ * Compares the batch operations against the equivalent loops over the
+ * one-at-a-time operations, both for speed and for correctness.
+ */
+int
+main(int argc, char *argv[]) {
+  LMatrix4f mat = LMatrix4f::scale_mat(1.5f) *
+    LMatrix4f::rotate_mat(30.0f, LVector3f(0.3f, 0.5f, 0.8f).normalized()) *
+    LMatrix4f::translate_mat(1.0f, -2.0f, 3.0f);
+
+  pvector<LPoint3f> points(num_points);
+  for (LPoint3f &point : points) {
+    point.set(frand(), frand(), frand());
+  }
+  pvector<LPoint3f> out1(num_points), out2(num_points);
+
+  // xform_point(), one at a time.
+  Clock::time_point start = Clock::now();
+  for (int it = 0; it < num_iterations; ++it) {
+    for (int i = 0; i < num_points; ++i) {
+      out1[i] = mat.xform_point(points[i]);
+    }
+  }
+  double single_ns = ns_per(start, (double)num_points * num_iterations);
+
+  // xform_points(), in one batch.
+  start = Clock::now();
+  for (int it = 0; it < num_iterations; ++it) {
+    mat.xform_points(&points[0], &out2[0], num_points);
+  }
+  double batch_ns = ns_per(start, (double)num_points * num_iterations);
+
+  for (int i = 0; i < num_points; ++i) {
+    if (!out1[i].almost_equal(out2[i], 1.0e-4f)) {
+      cerr << "xform_points mismatch at " << i << ": " << out1[i]
+           << " vs. " << out2[i] << endl;
+      return 1;
+    }
+  }
+  cerr << "xform_point:  " << single_ns << " ns/point, xform_points: "
+       << batch_ns << " ns/point (" << single_ns / batch_ns << "x)\n";
+
+  // The same thing, on an interleaved table such as a GeomVertexData with a
+  // position and a normal column.
+  pvector<float> table(num_points * 6);
+  for (float &f : table) {
+    f = frand();
+  }
+  pvector<float> table1(table), table2(table);
+
+  start = Clock::now();
+  for (int it = 0; it < num_iterations; ++it) {
+    for (int i = 0; i < num_points; ++i) {
+      LPoint3f &vertex = *(LPoint3f *)&table1[i * 6];
+      vertex = mat.xform_point(vertex);
+    }
+  }
+  single_ns = ns_per(start, (double)num_points * num_iterations);
+
+  start = Clock::now();
+  for (int it = 0; it < num_iterations; ++it) {
+    batch_xform_points(mat.get_data(), &table2[0], &table2[0], num_points,
+                       sizeof(float) * 6, sizeof(float) * 6);
+  }
+  batch_ns = ns_per(start, (double)num_points * num_iterations);
+
+  cerr << "interleaved:  " << single_ns << " ns/point, batch: "
+       << batch_ns << " ns/point (" << single_ns / batch_ns << "x)\n";
+
+  // Matrix multiplication.
+  pvector<LMatrix4f> mats(num_matrices);
+  for (LMatrix4f &m : mats) {
+    for (int i = 0; i < 16; ++i) {
+      m.set_cell(i / 4, i % 4, frand());
+    }
+  }
+  pvector<LMatrix4f> prod1(num_matrices), prod2(num_matrices);
+
+  start = Clock::now();
+  for (int it = 0; it < num_iterations; ++it) {
+    for (int i = 0; i < num_matrices; ++i) {
+      prod1[i].multiply(mats[i], mat);
+    }
+  }
+  single_ns = ns_per(start, (double)num_matrices * num_iterations);
+
+  start = Clock::now();
+  for (int it = 0; it < num_iterations; ++it) {
+    LMatrix4f::multiply_array(&prod2[0], &mats[0], mat, num_matrices);
+  }
+  batch_ns = ns_per(start, (double)num_matrices * num_iterations);
+
+  for (int i = 0; i < num_matrices; ++i) {
+    if (!prod1[i].almost_equal(prod2[i], 1.0e-4f)) {
+      cerr << "multiply_array mismatch at " << i << endl;
+      return 1;
+    }
+  }
+  cerr << "multiply:     " << single_ns << " ns/matrix, multiply_array: "
+       << batch_ns << " ns/matrix (" << single_ns / batch_ns << "x)\n";
+
+  return 0;
+}
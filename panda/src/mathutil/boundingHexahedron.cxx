@@ -20,6 +20,11 @@
 #include <math.h>
 #include <algorithm>
 
+#if !defined(STDFLOAT_DOUBLE) && (defined(__SSE2__) || (_M_IX86_FP >= 2) || defined(_M_X64) || defined(_M_AMD64))
+#include <emmintrin.h>
+#define BOUNDING_HEXAHEDRON_SSE2
+#endif
+
 using std::max;
 using std::min;
 
@@ -305,6 +310,83 @@ contains_sphere(const BoundingSphere *sphere) const {
   return result;
 }
 
+/**
+ * Tests an array of spheres against the hexahedron, storing the result of
+ * each test in the corresponding element of results.  Each sphere is given as
+ * a center point in the first three components and a radius in the fourth.
+ * This produces the same results as calling contains() on the equivalent
+ * BoundingSphere objects, but it avoids the virtual dispatch per volume, and
+ * tests four spheres against each plane at once where the compiler allows.
+ * It is used to cull the children of a node against the view frustum.
+ */
+void BoundingHexahedron::
+contains_sphere_array(int *results, const LVecBase4 *spheres,
+                      size_t num_spheres) const {
+  nassertv(!is_empty());
+
+  size_t i = 0;
+
+#ifdef BOUNDING_HEXAHEDRON_SSE2
+  __m128 pa[num_planes], pb[num_planes], pc[num_planes], pd[num_planes];
+  for (int p = 0; p < num_planes; ++p) {
+    pa[p] = _mm_set1_ps(_planes[p][0]);
+    pb[p] = _mm_set1_ps(_planes[p][1]);
+    pc[p] = _mm_set1_ps(_planes[p][2]);
+    pd[p] = _mm_set1_ps(_planes[p][3]);
+  }
+
+  const float *data = spheres[0].get_data();
+  __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= num_spheres; i += 4) {
+    __m128 x = _mm_loadu_ps(data + i * 4);
+    __m128 y = _mm_loadu_ps(data + i * 4 + 4);
+    __m128 z = _mm_loadu_ps(data + i * 4 + 8);
+    __m128 r = _mm_loadu_ps(data + i * 4 + 12);
+    _MM_TRANSPOSE4_PS(x, y, z, r);
+    __m128 neg_r = _mm_sub_ps(zero, r);
+
+    __m128 outside = zero;
+    __m128 partial = zero;
+    for (int p = 0; p < num_planes; ++p) {
+      __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, pa[p]), _mm_mul_ps(y, pb[p])),
+                               _mm_add_ps(_mm_mul_ps(z, pc[p]), pd[p]));
+      outside = _mm_or_ps(outside, _mm_cmpgt_ps(dist, r));
+      partial = _mm_or_ps(partial, _mm_cmpgt_ps(dist, neg_r));
+    }
+
+    int outside_mask = _mm_movemask_ps(outside);
+    int partial_mask = _mm_movemask_ps(partial);
+    for (int j = 0; j < 4; ++j) {
+      if (outside_mask & (1 << j)) {
+        results[i + j] = IF_no_intersection;
+      } else if (partial_mask & (1 << j)) {
+        results[i + j] = IF_possible | IF_some;
+      } else {
+        results[i + j] = IF_possible | IF_some | IF_all;
+      }
+    }
+  }
+#endif  // BOUNDING_HEXAHEDRON_SSE2
+
+  // The remainder, or all of them if we don't have SSE2.
+  for (; i < num_spheres; ++i) {
+    LPoint3 center = spheres[i].get_xyz();
+    PN_stdfloat radius = spheres[i][3];
+
+    int result = IF_possible | IF_some | IF_all;
+    for (int p = 0; p < num_planes; ++p) {
+      PN_stdfloat dist = _planes[p].dist_to_plane(center);
+      if (dist > radius) {
+        result = IF_no_intersection;
+        break;
+      } else if (dist > -radius) {
+        result &= ~IF_all;
+      }
+    }
+    results[i] = result;
+  }
+}
+
 /**
  *
  */
@@ -68,6 +68,9 @@ PUBLISHED:
 public:
   virtual const BoundingHexahedron *as_bounding_hexahedron() const;
 
+  void contains_sphere_array(int *results, const LVecBase4 *spheres,
+                             size_t num_spheres) const;
+
 protected:
   virtual bool extend_other(BoundingVolume *other) const;
   virtual bool around_other(BoundingVolume *other,
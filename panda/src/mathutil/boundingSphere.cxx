@@ -22,6 +22,11 @@
 
 #include <algorithm>
 
+#if !defined(STDFLOAT_DOUBLE) && (defined(__SSE2__) || (_M_IX86_FP >= 2) || defined(_M_X64) || defined(_M_AMD64))
+#include <emmintrin.h>
+#define BOUNDING_SPHERE_SSE2
+#endif
+
 using std::max;
 using std::min;
 
@@ -138,6 +143,91 @@ as_bounding_sphere() const {
   return this;
 }
 
+/**
+ * Sets the sphere to enclose the indicated array of spheres, each of which is
+ * given as a center point in the first three components and a radius in the
+ * fourth.  This produces the same result as calling around() on the
+ * equivalent list of BoundingSphere objects, but it avoids the virtual
+ * dispatch per volume, and it is vectorized where the compiler allows.  It is
+ * used when recomputing the bounding volumes of the scene graph.
+ *
+ * All of the spheres must be finite, and there must be at least one.
+ */
+bool BoundingSphere::
+around_sphere_array(const LVecBase4 *spheres, size_t num_spheres) {
+  nassertr(num_spheres > 0, false);
+
+  // First, get the bounding box of all of the spheres.  The center of that
+  // box becomes our center, as in around_finite().
+#ifdef BOUNDING_SPHERE_SSE2
+  const float *data = spheres[0].get_data();
+  __m128 v = _mm_loadu_ps(data);
+  __m128 r = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+  __m128 lo = _mm_sub_ps(v, r);
+  __m128 hi = _mm_add_ps(v, r);
+  for (size_t i = 1; i < num_spheres; ++i) {
+    v = _mm_loadu_ps(data + i * 4);
+    r = _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+    lo = _mm_min_ps(lo, _mm_sub_ps(v, r));
+    hi = _mm_max_ps(hi, _mm_add_ps(v, r));
+  }
+  LVecBase4f center4;
+  _mm_storeu_ps(&center4[0], _mm_mul_ps(_mm_add_ps(lo, hi), _mm_set1_ps(0.5f)));
+  _center.set(center4[0], center4[1], center4[2]);
+
+  // Now find the farthest extent of any sphere from that center, four spheres
+  // at a time.
+  __m128 cx = _mm_set1_ps(_center[0]);
+  __m128 cy = _mm_set1_ps(_center[1]);
+  __m128 cz = _mm_set1_ps(_center[2]);
+  __m128 max_dist = _mm_setzero_ps();
+  size_t i = 0;
+  for (; i + 4 <= num_spheres; i += 4) {
+    __m128 x = _mm_loadu_ps(data + i * 4);
+    __m128 y = _mm_loadu_ps(data + i * 4 + 4);
+    __m128 z = _mm_loadu_ps(data + i * 4 + 8);
+    __m128 w = _mm_loadu_ps(data + i * 4 + 12);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    __m128 dx = _mm_sub_ps(x, cx);
+    __m128 dy = _mm_sub_ps(y, cy);
+    __m128 dz = _mm_sub_ps(z, cz);
+    __m128 dist2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)),
+                              _mm_mul_ps(dz, dz));
+    max_dist = _mm_max_ps(max_dist, _mm_add_ps(_mm_sqrt_ps(dist2), w));
+  }
+  max_dist = _mm_max_ps(max_dist, _mm_shuffle_ps(max_dist, max_dist, _MM_SHUFFLE(1, 0, 3, 2)));
+  max_dist = _mm_max_ps(max_dist, _mm_shuffle_ps(max_dist, max_dist, _MM_SHUFFLE(2, 3, 0, 1)));
+  _radius = _mm_cvtss_f32(max_dist);
+
+#else
+  LPoint3 min_box = spheres[0].get_xyz() - LVecBase3(spheres[0][3]);
+  LPoint3 max_box = spheres[0].get_xyz() + LVecBase3(spheres[0][3]);
+  for (size_t i = 1; i < num_spheres; ++i) {
+    const LVecBase4 &sphere = spheres[i];
+    PN_stdfloat radius = sphere[3];
+    min_box.set(min(min_box[0], sphere[0] - radius),
+                min(min_box[1], sphere[1] - radius),
+                min(min_box[2], sphere[2] - radius));
+    max_box.set(max(max_box[0], sphere[0] + radius),
+                max(max_box[1], sphere[1] + radius),
+                max(max_box[2], sphere[2] + radius));
+  }
+  _center = (min_box + max_box) * 0.5f;
+  _radius = 0.0f;
+  size_t i = 0;
+#endif
+
+  // Pick up whatever is left over.
+  for (; i < num_spheres; ++i) {
+    const LVecBase4 &sphere = spheres[i];
+    PN_stdfloat dist = length(sphere.get_xyz() - _center);
+    _radius = max(_radius, dist + sphere[3]);
+  }
+
+  _flags = 0;
+  return true;
+}
+
 /**
  *
  */
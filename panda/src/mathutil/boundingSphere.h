@@ -53,6 +53,8 @@ PUBLISHED:
 public:
   virtual const BoundingSphere *as_bounding_sphere() const;
 
+  bool around_sphere_array(const LVecBase4 *spheres, size_t num_spheres);
+
 protected:
   virtual bool extend_other(BoundingVolume *other) const;
   virtual bool around_other(BoundingVolume *other,
@@ -0,0 +1,112 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_bounding_hexahedron.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "pandabase.h"
+
+#include "boundingHexahedron.h"
+#include "boundingSphere.h"
+#include "randomizer.h"
+#include "pvector.h"
+
+using std::cerr;
+
+static int num_failures = 0;
+
+#define CHECK(condition) \
+  if (!(condition)) { \
+    cerr << "FAILED: " #condition " (line " << __LINE__ << ")\n"; \
+    ++num_failures; \
+  }
+
+/**
+ * Checks that contains_sphere_array() gives the same answer as contains() on
+ * the equivalent BoundingSphere, for every sphere in the array.  An odd count
+ * is used so that both the four-wide path and the remainder are exercised.
+ */
+static void
+test_sphere_array(const BoundingHexahedron &hexahedron, Randomizer &random,
+                  size_t num_spheres) {
+  pvector<LVecBase4> spheres;
+  spheres.reserve(num_spheres);
+
+  // A few spheres that are known to be in, out and across the frustum.
+  spheres.push_back(LVecBase4(0, 50, 0, 1));
+  spheres.push_back(LVecBase4(0, -50, 0, 1));
+  spheres.push_back(LVecBase4(0, 1, 0, 5));
+  spheres.push_back(LVecBase4(500, 50, 0, 1));
+
+  while (spheres.size() < num_spheres) {
+    spheres.push_back(LVecBase4(random.random_real(200.0) - 100.0,
+                                random.random_real(200.0) - 50.0,
+                                random.random_real(200.0) - 100.0,
+                                random.random_real(20.0) + 0.01));
+  }
+
+  pvector<int> results(num_spheres, -1);
+  hexahedron.contains_sphere_array(&results[0], &spheres[0], num_spheres);
+
+  int num_all = 0;
+  int num_some = 0;
+  int num_none = 0;
+  for (size_t i = 0; i < num_spheres; ++i) {
+    PT(BoundingSphere) sphere =
+      new BoundingSphere(spheres[i].get_xyz(), spheres[i][3]);
+    int expected = hexahedron.contains(sphere);
+    if (results[i] != expected) {
+      cerr << "sphere " << spheres[i] << ": got " << results[i]
+           << ", expected " << expected << "\n";
+    }
+    CHECK(results[i] == expected);
+
+    if (expected & BoundingVolume::IF_all) {
+      ++num_all;
+    } else if (expected & BoundingVolume::IF_some) {
+      ++num_some;
+    } else {
+      ++num_none;
+    }
+  }
+
+  // Make sure that all three outcomes were actually tested.
+  CHECK(num_all > 0);
+  CHECK(num_some > 0);
+  CHECK(num_none > 0);
+}
+
+/**
+ * Usage: test_bounding_hexahedron
+ */
+int
+main(int argc, char *argv[]) {
+  LFrustum frustum;
+  frustum.make_perspective_hfov(60.0f, 1.0f, 1.0f, 100.0f);
+  BoundingHexahedron hexahedron(frustum, false);
+
+  Randomizer random(42);
+  test_sphere_array(hexahedron, random, 4);
+  test_sphere_array(hexahedron, random, 7);
+  test_sphere_array(hexahedron, random, 1001);
+
+  // The same again after moving the frustum, so that none of the planes are
+  // axis-aligned.
+  hexahedron.xform(LMatrix4::rotate_mat(30.0f, LVector3(1, 2, 3)) *
+                   LMatrix4::translate_mat(5, -10, 2));
+  test_sphere_array(hexahedron, random, 1001);
+
+  if (num_failures != 0) {
+    cerr << num_failures << " checks failed.\n";
+    return 1;
+  }
+  cerr << "All checks passed.\n";
+  return 0;
+}
@@ -0,0 +1,232 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file audioDecodeCache.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "audioDecodeCache.h"
+#include "audioDecodeRequest.h"
+#include "movieAudioCursor.h"
+#include "config_movies.h"
+#include "asyncTaskManager.h"
+#include "asyncTaskChain.h"
+#include "mutexHolder.h"
+#include "pStatTimer.h"
+
+AudioDecodeCache *AudioDecodeCache::_global_ptr = nullptr;
+
+PStatCollector AudioDecodeCache::_decode_pcollector("*:Decode audio");
+
+/**
+ *
+ */
+AudioDecodeCache::
+AudioDecodeCache() :
+  _max_size((size_t)std::max((int)audio_decode_cache_size, 0)),
+  _total_size(0),
+  _lock("AudioDecodeCache::_lock"),
+  _cvar(_lock)
+{
+}
+
+/**
+ * Returns the decoded samples of the indicated audio source, decoding them
+ * now if they are not already in the cache.  If a cursor is given, it must
+ * be freshly opened on the source; it is used for the decoding rather than
+ * opening a new one.
+ *
+ * Sources that do not have a filename are decoded, but not cached.  Returns
+ * NULL if the source cannot be opened or has no fixed length.
+ *
+ * If another thread is already decoding the same file, this waits for it to
+ * finish rather than decoding it twice.
+ */
+PT(PCMAudio) AudioDecodeCache::
+decode(MovieAudio *source, MovieAudioCursor *cursor) {
+  nassertr(source != nullptr, nullptr);
+  std::string key = source->get_filename().get_fullpath();
+
+  if (!key.empty()) {
+    MutexHolder holder(_lock);
+    while (true) {
+      Entries::iterator ei = _entries.find(key);
+      if (ei != _entries.end()) {
+        Entry &entry = (*ei).second;
+        _recent.splice(_recent.end(), _recent, entry._recent);
+        return entry._audio;
+      }
+      if (_pending.find(key) == _pending.end()) {
+        break;
+      }
+      _cvar.wait();
+    }
+    _pending.insert(key);
+  }
+
+  PT(PCMAudio) audio;
+  {
+    PStatTimer timer(_decode_pcollector);
+    PT(MovieAudioCursor) stream = cursor;
+    if (stream == nullptr) {
+      stream = source->open();
+    }
+    if (stream != nullptr) {
+      audio = PCMAudio::decode(stream);
+    }
+  }
+
+  if (!key.empty()) {
+    MutexHolder holder(_lock);
+    _pending.erase(key);
+
+    if (audio != nullptr && audio->get_data_size() <= _max_size) {
+      Entry &entry = _entries[key];
+      entry._audio = audio;
+      entry._recent = _recent.insert(_recent.end(), key);
+      _total_size += audio->get_data_size();
+
+      // The new sound fits, so this never evicts it.
+      evict(_max_size);
+    }
+    _cvar.notify_all();
+  }
+
+  return audio;
+}
+
+/**
+ * Begins decoding the indicated audio source on the "audio_decode" task
+ * chain, and returns a future whose result will be the PCMAudio, or NULL if
+ * it could not be decoded.  If the sound is already in the cache, the future
+ * completes immediately.
+ */
+PT(AsyncFuture) AudioDecodeCache::
+decode_async(MovieAudio *source) {
+  PT(AudioDecodeRequest) request = new AudioDecodeRequest(source);
+  request->set_task_chain(get_task_chain()->get_name());
+  AsyncTaskManager::get_global_ptr()->add(request);
+  return request;
+}
+
+/**
+ * Returns true if the decoded samples of the indicated file are in the cache.
+ */
+bool AudioDecodeCache::
+has_audio(const Filename &filename) const {
+  MutexHolder holder(_lock);
+  return _entries.find(filename.get_fullpath()) != _entries.end();
+}
+
+/**
+ * Removes the decoded samples of the indicated file from the cache.  Sounds
+ * that are already using them are not affected.
+ */
+void AudioDecodeCache::
+uncache(const Filename &filename) {
+  MutexHolder holder(_lock);
+  Entries::iterator ei = _entries.find(filename.get_fullpath());
+  if (ei != _entries.end()) {
+    _total_size -= (*ei).second._audio->get_data_size();
+    _recent.erase((*ei).second._recent);
+    _entries.erase(ei);
+  }
+}
+
+/**
+ * Removes all of the decoded samples from the cache.
+ */
+void AudioDecodeCache::
+clear() {
+  MutexHolder holder(_lock);
+  _entries.clear();
+  _recent.clear();
+  _total_size = 0;
+}
+
+/**
+ * Changes the maximum number of bytes of decoded samples that the cache may
+ * hold.  Sounds are discarded, least recently used first, until it fits.
+ */
+void AudioDecodeCache::
+set_max_size(size_t max_size) {
+  MutexHolder holder(_lock);
+  _max_size = max_size;
+  evict(_max_size);
+}
+
+/**
+ * Returns the maximum number of bytes of decoded samples that the cache may
+ * hold.
+ */
+size_t AudioDecodeCache::
+get_max_size() const {
+  MutexHolder holder(_lock);
+  return _max_size;
+}
+
+/**
+ * Returns the number of bytes of decoded samples currently in the cache.
+ */
+size_t AudioDecodeCache::
+get_total_size() const {
+  MutexHolder holder(_lock);
+  return _total_size;
+}
+
+/**
+ * Returns the number of sounds currently in the cache.
+ */
+size_t AudioDecodeCache::
+get_num_sounds() const {
+  MutexHolder holder(_lock);
+  return _entries.size();
+}
+
+/**
+ * Returns the global AudioDecodeCache.
+ */
+AudioDecodeCache *AudioDecodeCache::
+get_global_ptr() {
+  if (_global_ptr == nullptr) {
+    _global_ptr = new AudioDecodeCache;
+  }
+  return _global_ptr;
+}
+
+/**
+ * Returns the task chain on which audio is decoded in the background, both
+ * by decode_async() and by ReadAheadAudioCursor.
+ */
+AsyncTaskChain *AudioDecodeCache::
+get_task_chain() {
+  AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+  AsyncTaskChain *chain = task_mgr->make_task_chain("audio_decode");
+  int num_threads = std::max((int)audio_decode_threads, 1);
+  if (chain->get_num_threads() < num_threads &&
+      Thread::is_threading_supported()) {
+    chain->set_num_threads(num_threads);
+  }
+  return chain;
+}
+
+/**
+ * Discards the least recently used sounds until the cache holds no more than
+ * the indicated number of bytes.  Assumes the lock is held.
+ */
+void AudioDecodeCache::
+evict(size_t max_size) {
+  while (_total_size > max_size && !_recent.empty()) {
+    Entries::iterator ei = _entries.find(_recent.front());
+    nassertv(ei != _entries.end());
+    _total_size -= (*ei).second._audio->get_data_size();
+    _entries.erase(ei);
+    _recent.pop_front();
+  }
+}
@@ -0,0 +1,93 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file audioDecodeCache.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef AUDIODECODECACHE_H
+#define AUDIODECODECACHE_H
+
+#include "pandabase.h"
+#include "pcmAudio.h"
+#include "asyncFuture.h"
+#include "pmutex.h"
+#include "conditionVar.h"
+#include "pmap.h"
+#include "pset.h"
+#include "plist.h"
+#include "pStatCollector.h"
+
+class AsyncTaskChain;
+
+/**
+ * A process-wide cache of decoded audio, shared by all of the AudioManagers,
+ * so that a sound file that is loaded again, or by more than one manager, is
+ * only decoded once.  The cache holds decoded samples up to a total size in
+ * bytes, set by audio-decode-cache-size, discarding the least recently used
+ * sounds first.  By default the size is 0, so that nothing is kept.
+ *
+ * Sounds may also be decoded asynchronously, on the "audio_decode" task
+ * chain, so that many sounds can be made ready without stalling the caller.
+ */
+class EXPCL_PANDA_MOVIES AudioDecodeCache {
+protected:
+  AudioDecodeCache();
+
+PUBLISHED:
+  PT(PCMAudio) decode(MovieAudio *source, MovieAudioCursor *cursor = nullptr);
+  PT(AsyncFuture) decode_async(MovieAudio *source);
+
+  bool has_audio(const Filename &filename) const;
+  void uncache(const Filename &filename);
+  void clear();
+
+  void set_max_size(size_t max_size);
+  size_t get_max_size() const;
+  size_t get_total_size() const;
+  size_t get_num_sounds() const;
+
+  MAKE_PROPERTY(max_size, get_max_size, set_max_size);
+  MAKE_PROPERTY(total_size, get_total_size);
+  MAKE_PROPERTY(num_sounds, get_num_sounds);
+
+  static AudioDecodeCache *get_global_ptr();
+
+public:
+  static AsyncTaskChain *get_task_chain();
+
+private:
+  void evict(size_t max_size);
+
+  typedef plist<std::string> Recent;
+
+  class Entry {
+  public:
+    PT(PCMAudio) _audio;
+    Recent::iterator _recent;
+  };
+  typedef pmap<std::string, Entry> Entries;
+  typedef pset<std::string> Pending;
+
+  // The most recently used sound is at the back of _recent.
+  Entries _entries;
+  Recent _recent;
+  Pending _pending;
+  size_t _max_size;
+  size_t _total_size;
+
+  mutable Mutex _lock;
+  ConditionVar _cvar;
+
+  static AudioDecodeCache *_global_ptr;
+
+  static PStatCollector _decode_pcollector;
+};
+
+#endif
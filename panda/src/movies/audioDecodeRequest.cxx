@@ -0,0 +1,28 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file audioDecodeRequest.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "audioDecodeRequest.h"
+#include "audioDecodeCache.h"
+
+TypeHandle AudioDecodeRequest::_type_handle;
+
+/**
+ * Performs the task: that is, decodes the one sound.
+ */
+AsyncTask::DoneStatus AudioDecodeRequest::
+do_task() {
+  set_result(AudioDecodeCache::get_global_ptr()->decode(_source));
+
+  // Don't continue the task; we're done.
+  return DS_done;
+}
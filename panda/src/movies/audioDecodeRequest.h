@@ -0,0 +1,67 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file audioDecodeRequest.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef AUDIODECODEREQUEST_H
+#define AUDIODECODEREQUEST_H
+
+#include "pandabase.h"
+#include "asyncTask.h"
+#include "movieAudio.h"
+#include "pcmAudio.h"
+#include "pointerTo.h"
+
+/**
+ * A class object that manages a single asynchronous audio decode request,
+ * made through AudioDecodeCache::decode_async().  Its result is the decoded
+ * PCMAudio, which is also stored in the AudioDecodeCache if it is large
+ * enough.
+ */
+class EXPCL_PANDA_MOVIES AudioDecodeRequest : public AsyncTask {
+public:
+  ALLOC_DELETED_CHAIN(AudioDecodeRequest);
+
+PUBLISHED:
+  INLINE explicit AudioDecodeRequest(MovieAudio *source);
+
+  INLINE MovieAudio *get_source() const;
+
+  INLINE bool is_ready() const;
+  INLINE PCMAudio *get_audio() const;
+
+protected:
+  virtual DoneStatus do_task();
+
+private:
+  PT(MovieAudio) _source;
+
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    AsyncTask::init_type();
+    register_type(_type_handle, "AudioDecodeRequest",
+                  AsyncTask::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {init_type(); return get_class_type();}
+
+private:
+  static TypeHandle _type_handle;
+};
+
+#include "audioDecodeRequest.I"
+
+#endif
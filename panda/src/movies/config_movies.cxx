@@ -13,6 +13,7 @@
 
 #include "config_movies.h"
 #include "dconfig.h"
+#include "audioDecodeRequest.h"
 #include "flacAudio.h"
 #include "flacAudioCursor.h"
 #include "inkblotVideo.h"
@@ -25,6 +26,9 @@
 #include "movieVideoCursor.h"
 #include "opusAudio.h"
 #include "opusAudioCursor.h"
+#include "pcmAudio.h"
+#include "pcmAudioCursor.h"
+#include "readAheadAudioCursor.h"
 #include "userDataAudio.h"
 #include "userDataAudioCursor.h"
 #include "vorbisAudio.h"
@@ -74,6 +78,30 @@ ConfigVariableBool vorbis_seek_lap
           "the new playback position when seeking in order to eliminate "
           "clicking and boundary discontinuities."));
 
+ConfigVariableInt audio_decode_cache_size
+("audio-decode-cache-size", 0,
+ PRC_DESC("This is the maximum number of bytes of decoded audio samples "
+          "that are kept in the AudioDecodeCache, which is shared by all "
+          "of the audio managers.  The least recently used sounds are "
+          "discarded first when it is exceeded.  The default, 0, keeps "
+          "nothing, so that each sound is decoded every time it is loaded; "
+          "the audio managers already keep their own copy of the sounds "
+          "that are loaded into memory, so this is only worth setting if "
+          "sounds are often unloaded and loaded again."));
+
+ConfigVariableInt audio_decode_threads
+("audio-decode-threads", 1,
+ PRC_DESC("The number of threads on the audio_decode task chain, which "
+          "decodes sounds for AudioDecodeCache::decode_async() and reads "
+          "ahead in sounds that are streamed."));
+
+ConfigVariableDouble audio_read_ahead
+("audio-read-ahead", 1.0,
+ PRC_DESC("The number of seconds of audio that are decoded ahead of the "
+          "play position, on the audio_decode task chain, for sounds that "
+          "are streamed rather than loaded into memory.  Set this to 0 to "
+          "decode streamed sounds on the thread that plays them."));
+
 /**
  * Initializes the library.  This must be called at least once before any of
  * the functions or classes in this library can be used.  Normally it will be
@@ -88,6 +116,7 @@ init_libmovies() {
   }
   initialized = true;
 
+  AudioDecodeRequest::init_type();
   FlacAudio::init_type();
   FlacAudioCursor::init_type();
   InkblotVideo::init_type();
@@ -97,6 +126,9 @@ init_libmovies() {
   MovieAudioCursor::init_type();
   MovieVideo::init_type();
   MovieVideoCursor::init_type();
+  PCMAudio::init_type();
+  PCMAudioCursor::init_type();
+  ReadAheadAudioCursor::init_type();
   UserDataAudio::init_type();
   UserDataAudioCursor::init_type();
   WavAudio::init_type();
@@ -18,6 +18,8 @@
 #include "notifyCategoryProxy.h"
 #include "configVariableBool.h"
 #include "configVariableList.h"
+#include "configVariableInt.h"
+#include "configVariableDouble.h"
 #include "threadPriority.h"
 #include "dconfig.h"
 
@@ -32,6 +34,10 @@ extern ConfigVariableBool opus_enable_seek;
 extern ConfigVariableBool vorbis_enable_seek;
 extern ConfigVariableBool vorbis_seek_lap;
 
+extern EXPCL_PANDA_MOVIES ConfigVariableInt audio_decode_cache_size;
+extern EXPCL_PANDA_MOVIES ConfigVariableInt audio_decode_threads;
+extern EXPCL_PANDA_MOVIES ConfigVariableDouble audio_read_ahead;
+
 extern EXPCL_PANDA_MOVIES void init_libmovies();
 
 #endif /* CONFIG_MOVIES_H */
@@ -1,3 +1,5 @@
+#include "audioDecodeCache.cxx"
+#include "audioDecodeRequest.cxx"
 #include "config_movies.cxx"
 #include "flacAudio.cxx"
 #include "flacAudioCursor.cxx"
@@ -12,6 +14,9 @@
 #include "movieVideoCursor.cxx"
 #include "opusAudio.cxx"
 #include "opusAudioCursor.cxx"
+#include "pcmAudio.cxx"
+#include "pcmAudioCursor.cxx"
+#include "readAheadAudioCursor.cxx"
 #include "userDataAudio.cxx"
 #include "userDataAudioCursor.cxx"
 #include "vorbisAudio.cxx"
@@ -0,0 +1,92 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file pcmAudio.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "pcmAudio.h"
+#include "pcmAudioCursor.h"
+#include "movieAudioCursor.h"
+#include "config_movies.h"
+
+TypeHandle PCMAudio::_type_handle;
+
+/**
+ *
+ */
+PCMAudio::
+PCMAudio(MovieAudio *source, int rate, int channels) :
+  MovieAudio(source->get_name()),
+  _audio_rate(rate),
+  _audio_channels(channels)
+{
+  _filename = source->get_filename();
+}
+
+/**
+ *
+ */
+PCMAudio::
+~PCMAudio() {
+}
+
+/**
+ * Reads all of the remaining samples from the indicated cursor, and returns a
+ * new PCMAudio that holds them.  Returns NULL if the cursor does not have a
+ * known length, such as a cursor reading from a microphone.
+ */
+PT(PCMAudio) PCMAudio::
+decode(MovieAudioCursor *cursor) {
+  nassertr(cursor != nullptr, nullptr);
+  if (cursor->ready() != 0x40000000 || cursor->length() > 3600.0) {
+    // We can't read all of a stream that is still being produced.
+    return nullptr;
+  }
+
+  MovieAudio *source = cursor->get_source();
+  int rate = cursor->audio_rate();
+  int channels = cursor->audio_channels();
+  nassertr(rate > 0 && channels > 0, nullptr);
+
+  PT(PCMAudio) audio = new PCMAudio(source, rate, channels);
+
+  // The length is only an estimate for some formats, so keep reading until
+  // the cursor runs dry.
+  size_t expected = (size_t)(cursor->length() * rate) + 1;
+  audio->_data.resize(expected * channels);
+  size_t num_samples = 0;
+  while (true) {
+    if (num_samples == expected) {
+      expected += expected / 2 + 4096;
+      audio->_data.resize(expected * channels);
+    }
+    int n = cursor->read_samples((int)(expected - num_samples),
+                                 audio->_data.data() + num_samples * channels);
+    if (n <= 0) {
+      break;
+    }
+    num_samples += n;
+  }
+
+  audio->_data.resize(num_samples * channels);
+  audio->_data.shrink_to_fit();
+
+  movies_debug("Decoded " << source->get_name() << ": " << num_samples
+               << " samples, " << channels << " channels");
+  return audio;
+}
+
+/**
+ * Opens a new cursor that reads the samples from memory.
+ */
+PT(MovieAudioCursor) PCMAudio::
+open() {
+  return new PCMAudioCursor(this);
+}
@@ -0,0 +1,78 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file pcmAudio.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef PCMAUDIO_H
+#define PCMAUDIO_H
+
+#include "pandabase.h"
+#include "movieAudio.h"
+#include "pvector.h"
+
+class MovieAudioCursor;
+
+/**
+ * A MovieAudio that holds the entire decoded contents of another MovieAudio
+ * in memory, as interleaved 16-bit samples.  Opening it costs nothing more
+ * than a copy of the samples as they are read, and any number of cursors may
+ * read it at once.  These are normally obtained from the AudioDecodeCache.
+ *
+ * The samples may not be modified once the PCMAudio has been constructed.
+ */
+class EXPCL_PANDA_MOVIES PCMAudio : public MovieAudio {
+PUBLISHED:
+  static PT(PCMAudio) decode(MovieAudioCursor *cursor);
+  virtual ~PCMAudio();
+
+  virtual PT(MovieAudioCursor) open();
+
+  INLINE int get_audio_rate() const;
+  INLINE int get_audio_channels() const;
+  INLINE size_t get_num_samples() const;
+  INLINE size_t get_data_size() const;
+
+  MAKE_PROPERTY(audio_rate, get_audio_rate);
+  MAKE_PROPERTY(audio_channels, get_audio_channels);
+  MAKE_PROPERTY(num_samples, get_num_samples);
+  MAKE_PROPERTY(data_size, get_data_size);
+
+public:
+  INLINE const int16_t *get_data() const;
+
+private:
+  PCMAudio(MovieAudio *source, int rate, int channels);
+
+  int _audio_rate;
+  int _audio_channels;
+  pvector<int16_t> _data;
+
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    MovieAudio::init_type();
+    register_type(_type_handle, "PCMAudio",
+                  MovieAudio::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {init_type(); return get_class_type();}
+
+private:
+  static TypeHandle _type_handle;
+};
+
+#include "pcmAudio.I"
+
+#endif
@@ -0,0 +1,76 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file pcmAudioCursor.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "pcmAudioCursor.h"
+#include "pcmAudio.h"
+
+#include <string.h>
+
+TypeHandle PCMAudioCursor::_type_handle;
+
+/**
+ *
+ */
+PCMAudioCursor::
+PCMAudioCursor(PCMAudio *src) :
+  MovieAudioCursor(src),
+  _position(0)
+{
+  _audio_rate = src->get_audio_rate();
+  _audio_channels = src->get_audio_channels();
+  _length = (double)src->get_num_samples() / _audio_rate;
+  _can_seek = true;
+  _can_seek_fast = true;
+}
+
+/**
+ *
+ */
+PCMAudioCursor::
+~PCMAudioCursor() {
+}
+
+/**
+ * Seeks to the indicated offset, in seconds.
+ */
+void PCMAudioCursor::
+seek(double offset) {
+  PCMAudio *source = (PCMAudio *)(MovieAudio *)_source;
+  offset = std::max(offset, 0.0);
+  _position = std::min((size_t)(offset * _audio_rate), source->get_num_samples());
+  _last_seek = offset;
+  _samples_read = 0;
+}
+
+/**
+ * Read audio samples from the stream.  N is the number of samples you wish to
+ * read.  Your buffer must be equal in size to N * channels.  Multiple-channel
+ * audio will be interleaved.
+ */
+int PCMAudioCursor::
+read_samples(int n, int16_t *data) {
+  PCMAudio *source = (PCMAudio *)(MovieAudio *)_source;
+  size_t avail = source->get_num_samples() - _position;
+  if (n <= 0 || avail == 0) {
+    return 0;
+  }
+  if ((size_t)n > avail) {
+    n = (int)avail;
+  }
+
+  memcpy(data, source->get_data() + _position * _audio_channels,
+         n * _audio_channels * sizeof(int16_t));
+  _position += n;
+  _samples_read += n;
+  return n;
+}
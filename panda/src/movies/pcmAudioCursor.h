@@ -0,0 +1,56 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file pcmAudioCursor.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef PCMAUDIOCURSOR_H
+#define PCMAUDIOCURSOR_H
+
+#include "pandabase.h"
+#include "movieAudioCursor.h"
+
+class PCMAudio;
+
+/**
+ * Reads the samples held in memory by a PCMAudio.  Seeking is fast and exact.
+ */
+class EXPCL_PANDA_MOVIES PCMAudioCursor : public MovieAudioCursor {
+PUBLISHED:
+  explicit PCMAudioCursor(PCMAudio *src);
+  virtual ~PCMAudioCursor();
+
+  virtual void seek(double offset);
+
+public:
+  virtual int read_samples(int n, int16_t *data);
+
+private:
+  size_t _position;
+
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    MovieAudioCursor::init_type();
+    register_type(_type_handle, "PCMAudioCursor",
+                  MovieAudioCursor::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {init_type(); return get_class_type();}
+
+private:
+  static TypeHandle _type_handle;
+};
+
+#endif
@@ -0,0 +1,244 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file readAheadAudioCursor.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "readAheadAudioCursor.h"
+#include "audioDecodeCache.h"
+#include "asyncTaskManager.h"
+#include "asyncTaskChain.h"
+#include "genericAsyncTask.h"
+#include "mutexHolder.h"
+
+#include <string.h>
+
+TypeHandle ReadAheadAudioCursor::_type_handle;
+
+// The number of samples read from the source cursor at a time.
+static const int read_ahead_chunk = 4096;
+
+/**
+ * Wraps the indicated cursor, which should not be used directly afterwards.
+ * The read_ahead parameter is the number of seconds of audio to keep decoded
+ * ahead of the read position.
+ */
+ReadAheadAudioCursor::
+ReadAheadAudioCursor(MovieAudioCursor *source, double read_ahead) :
+  MovieAudioCursor(source->get_source()),
+  _source_lock("ReadAheadAudioCursor::_source_lock"),
+  _source_cursor(source),
+  _lock("ReadAheadAudioCursor::_lock"),
+  _buffer_head(0),
+  _buffer_size(0),
+  _read_ahead(read_ahead),
+  _source_done(false),
+  _refill_pending(false)
+{
+  _audio_rate = source->audio_rate();
+  _audio_channels = source->audio_channels();
+  _length = source->length();
+  _can_seek = source->can_seek();
+  _can_seek_fast = source->can_seek_fast();
+  _aborted = source->aborted();
+  _last_seek = source->tell();
+  _source_ready = (source->ready() == 0x40000000);
+
+  _capacity = (size_t)(std::max(read_ahead, 0.0) * _audio_rate) * _audio_channels;
+  _buffer.resize(_capacity);
+
+  request_refill();
+}
+
+/**
+ *
+ */
+ReadAheadAudioCursor::
+~ReadAheadAudioCursor() {
+}
+
+/**
+ * Returns the number of samples that have been decoded ahead of the read
+ * position.
+ */
+int ReadAheadAudioCursor::
+get_num_buffered() const {
+  MutexHolder holder(_lock);
+  return (int)(_buffer_size / _audio_channels);
+}
+
+/**
+ * Returns the number of audio samples that are ready to read.  If the source
+ * cursor can produce samples on demand, so can this one; otherwise, only the
+ * samples already read from it are ready.
+ */
+int ReadAheadAudioCursor::
+ready() const {
+  if (_source_ready) {
+    return 0x40000000;
+  }
+  return get_num_buffered();
+}
+
+/**
+ * Discards the samples that were decoded ahead, and seeks the source cursor
+ * to the indicated offset.
+ */
+void ReadAheadAudioCursor::
+seek(double offset) {
+  {
+    MutexHolder source_holder(_source_lock);
+    MutexHolder holder(_lock);
+    _buffer_head = 0;
+    _buffer_size = 0;
+    _source_cursor->seek(offset);
+    _source_done = false;
+    _aborted = _source_cursor->aborted();
+  }
+  _last_seek = offset;
+  _samples_read = 0;
+
+  request_refill();
+}
+
+/**
+ * Read audio samples from the stream.  N is the number of samples you wish to
+ * read.  Your buffer must be equal in size to N * channels.  Multiple-channel
+ * audio will be interleaved.
+ */
+int ReadAheadAudioCursor::
+read_samples(int n, int16_t *data) {
+  if (n <= 0) {
+    return 0;
+  }
+
+  int got = take_buffered(n, data);
+  if (got < n) {
+    // We've caught up with the read-ahead.  Hold the source so that no refill
+    // can slip in between, pick up anything that was added meanwhile, and
+    // decode the rest ourselves.
+    MutexHolder source_holder(_source_lock);
+    got += take_buffered(n - got, data + got * _audio_channels);
+    while (got < n) {
+      int count = _source_cursor->read_samples(n - got, data + got * _audio_channels);
+      if (count <= 0) {
+        MutexHolder holder(_lock);
+        _source_done = true;
+        break;
+      }
+      got += count;
+    }
+    _aborted = _source_cursor->aborted();
+  }
+
+  _samples_read += got;
+  request_refill();
+  return got;
+}
+
+/**
+ * Copies up to n samples out of the read-ahead buffer.  Returns the number
+ * copied.
+ */
+int ReadAheadAudioCursor::
+take_buffered(int n, int16_t *data) {
+  MutexHolder holder(_lock);
+  size_t avail = _buffer_size / _audio_channels;
+  size_t count = std::min((size_t)n, avail);
+  if (count == 0) {
+    return 0;
+  }
+  size_t values = count * _audio_channels;
+
+  // The samples may wrap around the end of the ring buffer.
+  size_t first = std::min(values, _capacity - _buffer_head);
+  memcpy(data, _buffer.data() + _buffer_head, first * sizeof(int16_t));
+  memcpy(data + first, _buffer.data(), (values - first) * sizeof(int16_t));
+
+  _buffer_head = (_buffer_head + values) % _capacity;
+  _buffer_size -= values;
+  return (int)count;
+}
+
+/**
+ * Starts a task to fill the read-ahead buffer, if it is less than half full
+ * and no such task is already pending.
+ */
+void ReadAheadAudioCursor::
+request_refill() {
+  {
+    MutexHolder holder(_lock);
+    if (_refill_pending || _source_done || _buffer_size * 2 >= _capacity) {
+      return;
+    }
+    _refill_pending = true;
+  }
+
+  // The task holds a reference to us until it has run.
+  ref();
+  PT(GenericAsyncTask) task =
+    new GenericAsyncTask("audio_read_ahead", &st_refill, this);
+  task->set_task_chain(AudioDecodeCache::get_task_chain()->get_name());
+  AsyncTaskManager::get_global_ptr()->add(task);
+}
+
+/**
+ * Reads from the source cursor until the read-ahead buffer is full.  This is
+ * run by a task on the audio_decode task chain.
+ */
+void ReadAheadAudioCursor::
+refill() {
+  pvector<int16_t> chunk(read_ahead_chunk * _audio_channels);
+
+  while (true) {
+    MutexHolder source_holder(_source_lock);
+
+    // Only read as many samples as there is room for.  Nothing else adds to
+    // the buffer while we hold the source lock, so the room can only grow.
+    int room;
+    {
+      MutexHolder holder(_lock);
+      room = (int)((_capacity - _buffer_size) / _audio_channels);
+      if (_source_done || room <= 0) {
+        _refill_pending = false;
+        return;
+      }
+    }
+
+    int count = _source_cursor->read_samples(std::min(room, read_ahead_chunk), chunk.data());
+
+    MutexHolder holder(_lock);
+    if (count <= 0) {
+      _source_done = true;
+      _refill_pending = false;
+      return;
+    }
+
+    // Append the samples at the tail of the ring buffer, which may wrap
+    // around to the beginning.
+    size_t values = (size_t)count * _audio_channels;
+    size_t tail = (_buffer_head + _buffer_size) % _capacity;
+    size_t first = std::min(values, _capacity - tail);
+    memcpy(_buffer.data() + tail, chunk.data(), first * sizeof(int16_t));
+    memcpy(_buffer.data(), chunk.data() + first, (values - first) * sizeof(int16_t));
+    _buffer_size += values;
+  }
+}
+
+/**
+ * The task callback for refill().
+ */
+AsyncTask::DoneStatus ReadAheadAudioCursor::
+st_refill(GenericAsyncTask *, void *data) {
+  ReadAheadAudioCursor *self = (ReadAheadAudioCursor *)data;
+  self->refill();
+  unref_delete(self);
+  return AsyncTask::DS_done;
+}
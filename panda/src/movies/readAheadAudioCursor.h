@@ -0,0 +1,93 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file readAheadAudioCursor.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef READAHEADAUDIOCURSOR_H
+#define READAHEADAUDIOCURSOR_H
+
+#include "pandabase.h"
+#include "movieAudioCursor.h"
+#include "asyncTask.h"
+#include "genericAsyncTask.h"
+#include "pmutex.h"
+#include "pvector.h"
+
+/**
+ * A MovieAudioCursor that wraps another cursor, and keeps a buffer of samples
+ * decoded ahead of the read position by a task on the "audio_decode" task
+ * chain.  This is intended for long sounds that are streamed, such as music,
+ * so that the decoding work is moved off the thread that feeds the sound
+ * card.
+ *
+ * If the reader ever catches up with the buffer, the remaining samples are
+ * decoded on the spot, so the output is exactly what the wrapped cursor
+ * would have produced.
+ */
+class EXPCL_PANDA_MOVIES ReadAheadAudioCursor : public MovieAudioCursor {
+PUBLISHED:
+  explicit ReadAheadAudioCursor(MovieAudioCursor *source, double read_ahead);
+  virtual ~ReadAheadAudioCursor();
+
+  INLINE MovieAudioCursor *get_source_cursor() const;
+  INLINE double get_read_ahead() const;
+  int get_num_buffered() const;
+
+  virtual int ready() const;
+  virtual void seek(double offset);
+
+public:
+  virtual int read_samples(int n, int16_t *data);
+
+private:
+  int take_buffered(int n, int16_t *data);
+  void request_refill();
+  void refill();
+  static AsyncTask::DoneStatus st_refill(GenericAsyncTask *task, void *data);
+
+  // Protects _source_cursor.  If both are held, this one is acquired first.
+  Mutex _source_lock;
+  PT(MovieAudioCursor) _source_cursor;
+  bool _source_ready;
+
+  // Protects the members below.  The samples decoded ahead are kept in a ring
+  // buffer of _capacity values, of which _buffer_size, starting at
+  // _buffer_head, are filled.
+  mutable Mutex _lock;
+  pvector<int16_t> _buffer;
+  size_t _buffer_head;
+  size_t _buffer_size;
+  size_t _capacity;
+  double _read_ahead;
+  bool _source_done;
+  bool _refill_pending;
+
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    MovieAudioCursor::init_type();
+    register_type(_type_handle, "ReadAheadAudioCursor",
+                  MovieAudioCursor::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {init_type(); return get_class_type();}
+
+private:
+  static TypeHandle _type_handle;
+};
+
+#include "readAheadAudioCursor.I"
+
+#endif
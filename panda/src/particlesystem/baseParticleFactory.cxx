@@ -48,6 +48,16 @@ BaseParticleFactory::
 ~BaseParticleFactory() {
 }
 
+/**
+ * Returns true if the particles made by this factory carry no state and no
+ * behavior beyond what is held in a ParticlePool, so that a ParticleSystem
+ * may update them in the pool instead of one object at a time.
+ */
+bool BaseParticleFactory::
+supports_particle_pool() const {
+  return false;
+}
+
 /**
  * public
  */
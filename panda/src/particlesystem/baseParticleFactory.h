@@ -50,6 +50,9 @@ PUBLISHED:
   virtual void output(std::ostream &out) const;
   virtual void write(std::ostream &out, int indent=0) const;
 
+public:
+  virtual bool supports_particle_pool() const;
+
 protected:
   BaseParticleFactory();
   BaseParticleFactory(const BaseParticleFactory &copy);
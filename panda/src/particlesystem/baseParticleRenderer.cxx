@@ -29,6 +29,8 @@ BaseParticleRenderer(ParticleRendererAlphaMode alpha_mode) :
 
   _user_alpha = 1.0f;
   _ignore_scale = false;
+  _defer_render_node_update = false;
+  _render_node_update_pending = false;
 
   update_alpha_mode(alpha_mode);
 }
@@ -44,6 +46,8 @@ BaseParticleRenderer(const BaseParticleRenderer& copy) :
 
   _user_alpha = copy._user_alpha;
   set_ignore_scale(copy._ignore_scale);
+  _defer_render_node_update = false;
+  _render_node_update_pending = false;
 
   update_alpha_mode(copy._alpha_mode);
 }
@@ -75,6 +79,71 @@ set_ignore_scale(bool ignore_scale) {
   }
 }
 
+/**
+ * Returns true if render() modifies only data owned by this renderer, apart
+ * from the changes made through update_render_node(), so that several
+ * particle systems may be rendered at once on different threads.
+ */
+bool BaseParticleRenderer::
+supports_parallel_render() const {
+  return false;
+}
+
+/**
+ * Should be called by render() once it has filled in the geometry, to make
+ * the corresponding changes to the render node.  These changes propagate up
+ * the scene graph, so they may be held back until the particle system is
+ * back on the main thread.
+ */
+void BaseParticleRenderer::
+update_render_node() {
+  if (_defer_render_node_update) {
+    _render_node_update_pending = true;
+  } else {
+    do_update_render_node();
+  }
+}
+
+/**
+ * Makes the changes to the render node requested by update_render_node().
+ * The default implementation simply marks its bounding volume stale.
+ */
+void BaseParticleRenderer::
+do_update_render_node() {
+  _render_node->mark_internal_bounds_stale();
+}
+
+/**
+ * Enables or disables the deferring of update_render_node().  When it is
+ * disabled, any update that was held back is made immediately.
+ */
+void BaseParticleRenderer::
+set_defer_render_node_update(bool defer) {
+  _defer_render_node_update = defer;
+  if (!defer && _render_node_update_pending) {
+    _render_node_update_pending = false;
+    do_update_render_node();
+  }
+}
+
+/**
+ * Returns true if this renderer can draw the particles directly out of a
+ * ParticlePool, via render_pool().
+ */
+bool BaseParticleRenderer::
+supports_particle_pool() const {
+  return false;
+}
+
+/**
+ * Renders the particles held in the pool.  This is only called if
+ * supports_particle_pool() returns true.
+ */
+void BaseParticleRenderer::
+render_pool(ParticlePool &, int) {
+  nassert_raise("render_pool() not supported by this renderer");
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
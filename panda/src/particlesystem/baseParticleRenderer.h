@@ -26,6 +26,8 @@
 
 #include "pvector.h"
 
+class ParticlePool;
+
 /**
  * Pure virtual particle renderer base class
  */
@@ -67,6 +69,7 @@ PUBLISHED:
 
 public:
   virtual BaseParticleRenderer *make_copy() = 0;
+  virtual bool supports_parallel_render() const;
 
 protected:
   ParticleRendererAlphaMode _alpha_mode;
@@ -81,6 +84,8 @@ protected:
 
   INLINE PN_stdfloat get_cur_alpha(BaseParticle* bp);
 
+  void update_render_node();
+
   virtual void resize_pool(int new_size) = 0;
 
   CPT(RenderState) _render_state;
@@ -92,6 +97,15 @@ private:
   PN_stdfloat _user_alpha;
   bool _ignore_scale;
 
+  // While this is set, the changes that render() would make to the render
+  // node (and hence to the scene graph above it) are held back until it is
+  // cleared again.  This is done while rendering on a worker thread.
+  bool _defer_render_node_update;
+  bool _render_node_update_pending;
+
+  virtual void do_update_render_node();
+  void set_defer_render_node_update(bool defer);
+
   // birth and kill particle are for renderers that might do maintenance
   // faster if it was notified on a per-event basis.  An example:
   // geomParticleRenderer maintains an arc for every particle.  Instead of
@@ -106,7 +120,11 @@ private:
   virtual void render(pvector< PT(PhysicsObject) >& po_vector,
                       int ttl_particles) = 0;
 
+  virtual bool supports_particle_pool() const;
+  virtual void render_pool(ParticlePool &pool, int ttl_particles);
+
   friend class ParticleSystem;
+  friend class ParticleSystemManager;
 };
 
 #include "baseParticleRenderer.I"
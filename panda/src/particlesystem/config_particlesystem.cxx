@@ -23,6 +23,24 @@
 ConfigureDef(config_particlesystem);
 NotifyCategoryDef(particlesystem, "");
 
+ConfigVariableBool particle_soa_pool
+("particle-soa-pool", false,
+ PRC_DESC("Set this true to allow particle systems to keep their particles in "
+          "a structure-of-arrays pool, which is aged, integrated and rendered "
+          "in tight loops rather than one object at a time.  This is only "
+          "done for systems whose factory, renderer and forces are simple "
+          "enough to be handled by the pool; see "
+          "ParticleSystem::set_soa_pool_flag().  This sets the default for "
+          "new particle systems."));
+
+ConfigVariableInt particle_num_threads
+("particle-num-threads", 0,
+ PRC_DESC("The number of worker threads a ParticleSystemManager uses to "
+          "update and render its particle systems in parallel.  If this is "
+          "0, the systems are stepped one at a time on the calling thread.  "
+          "This sets the default for new managers; see "
+          "ParticleSystemManager::set_num_threads()."));
+
 ConfigureFn(config_particlesystem) {
   ColorInterpolationFunction::init_type();
   ColorInterpolationFunctionConstant::init_type();
@@ -17,10 +17,15 @@
 #include "pandabase.h"
 #include "notifyCategoryProxy.h"
 #include "dconfig.h"
+#include "configVariableBool.h"
+#include "configVariableInt.h"
 
 ConfigureDecl(config_particlesystem, EXPCL_PANDA_PARTICLESYSTEM, EXPTP_PANDA_PARTICLESYSTEM);
 NotifyCategoryDecl(particlesystem, EXPCL_PANDA_PARTICLESYSTEM, EXPTP_PANDA_PARTICLESYSTEM);
 
+extern EXPCL_PANDA_PARTICLESYSTEM ConfigVariableBool particle_soa_pool;
+extern EXPCL_PANDA_PARTICLESYSTEM ConfigVariableInt particle_num_threads;
+
 extern EXPCL_PANDA_PARTICLESYSTEM void init_libparticlesystem();
 
 #endif // CONFIG_PARTICLESYSTEM_H
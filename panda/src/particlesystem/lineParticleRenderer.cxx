@@ -79,6 +79,14 @@ make_copy() {
   return new LineParticleRenderer(*this);
 }
 
+/**
+ * Returns true, since this renderer writes only to its own vertex data.
+ */
+bool LineParticleRenderer::
+supports_parallel_render() const {
+  return true;
+}
+
 /**
  * child birth
  */
@@ -225,7 +233,7 @@ render(pvector< PT(PhysicsObject) >& po_vector, int ttl_particles) {
 
   BoundingSphere sphere(aabb_center, radius);
   _line_primitive->set_bounds(&sphere);
-  get_render_node()->mark_internal_bounds_stale();
+  update_render_node();
 }
 
 /**
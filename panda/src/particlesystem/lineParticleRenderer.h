@@ -40,6 +40,7 @@ PUBLISHED:
 
 public:
   virtual BaseParticleRenderer *make_copy();
+  virtual bool supports_parallel_render() const;
 
 PUBLISHED:
   INLINE void set_head_color(const LColor& c);
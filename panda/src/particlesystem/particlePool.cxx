@@ -0,0 +1,247 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file particlePool.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "particlePool.h"
+#include "baseParticle.h"
+
+#if !defined(STDFLOAT_DOUBLE) && (defined(__SSE2__) || (_M_IX86_FP >= 2) || defined(_M_X64) || defined(_M_AMD64))
+#include <emmintrin.h>
+#define PARTICLE_POOL_SSE2
+#endif
+
+/**
+ *
+ */
+ParticlePool::LinearForces::
+LinearForces() {
+  clear();
+}
+
+/**
+ * Resets the forces to nothing at all.
+ */
+void ParticlePool::LinearForces::
+clear() {
+  _md_vector = LVector3::zero();
+  _vector = LVector3::zero();
+  _md_friction.fill(0.0f);
+  _friction.fill(0.0f);
+  _has_friction = false;
+  _viscosity_damper = 1.0f;
+}
+
+/**
+ *
+ */
+ParticlePool::
+ParticlePool() : _size(0) {
+}
+
+/**
+ * Changes the number of slots in the pool.  Any new slots are initially not
+ * alive; the contents of the existing slots are preserved.
+ */
+void ParticlePool::
+resize(int size) {
+  nassertv(size >= 0);
+  _pos_x.resize(size, 0.0f);
+  _pos_y.resize(size, 0.0f);
+  _pos_z.resize(size, 0.0f);
+  _vel_x.resize(size, 0.0f);
+  _vel_y.resize(size, 0.0f);
+  _vel_z.resize(size, 0.0f);
+  _age.resize(size, 0.0f);
+  _lifespan.resize(size, 0.0f);
+  _inv_mass.resize(size, 1.0f);
+  _terminal_velocity.resize(size, 0.0f);
+  _alive.resize(size, 0);
+  _index.resize(size, 0);
+  _size = size;
+}
+
+/**
+ * Copies the state of the indicated particle into the given slot.
+ */
+void ParticlePool::
+store(int index, const BaseParticle *bp) {
+  nassertv(index >= 0 && index < _size);
+
+  LPoint3 pos = bp->get_position();
+  LVector3 vel = bp->get_velocity();
+  _pos_x[index] = pos[0];
+  _pos_y[index] = pos[1];
+  _pos_z[index] = pos[2];
+  _vel_x[index] = vel[0];
+  _vel_y[index] = vel[1];
+  _vel_z[index] = vel[2];
+  _age[index] = bp->get_age();
+  _lifespan[index] = bp->get_lifespan();
+
+  PN_stdfloat mass = bp->get_mass();
+  nassertv(mass != 0.0f);
+  _inv_mass[index] = 1.0f / mass;
+  _terminal_velocity[index] = bp->get_terminal_velocity();
+  _alive[index] = bp->get_alive();
+  _index[index] = bp->get_index();
+}
+
+/**
+ * Copies the state held in the given slot back into the indicated particle.
+ * Only the state that the pool modifies is copied.
+ */
+void ParticlePool::
+fetch(int index, BaseParticle *bp) const {
+  nassertv(index >= 0 && index < _size);
+
+  bp->reset_position(get_position(index));
+  bp->set_velocity(get_velocity(index));
+  bp->set_age(_age[index]);
+  bp->set_index(_index[index]);
+}
+
+/**
+ * Adds dt to the age of every particle in the pool.
+ */
+void ParticlePool::
+age(PN_stdfloat dt) {
+  PN_stdfloat *age = _age.data();
+  int i = 0;
+
+#ifdef PARTICLE_POOL_SSE2
+  __m128 dt4 = _mm_set1_ps(dt);
+  for (; i + 4 <= _size; i += 4) {
+    _mm_storeu_ps(age + i, _mm_add_ps(_mm_loadu_ps(age + i), dt4));
+  }
+#endif
+
+  for (; i < _size; ++i) {
+    age[i] += dt;
+  }
+}
+
+/**
+ * Steps the position and velocity of every particle in the pool by dt under
+ * the influence of the given forces.  This performs the same computation as
+ * LinearEulerIntegrator::child_integrate(), but four particles at a time
+ * where the hardware allows it.
+ *
+ * Slots that are not alive are integrated along with the rest, since it is
+ * cheaper than skipping them; their contents are replaced by store() when a
+ * particle is next born into them.
+ */
+void ParticlePool::
+integrate(const LinearForces &forces, PN_stdfloat dt) {
+  PN_stdfloat *px = _pos_x.data();
+  PN_stdfloat *py = _pos_y.data();
+  PN_stdfloat *pz = _pos_z.data();
+  PN_stdfloat *vx = _vel_x.data();
+  PN_stdfloat *vy = _vel_y.data();
+  PN_stdfloat *vz = _vel_z.data();
+  const PN_stdfloat *inv_mass = _inv_mass.data();
+
+  const LVector3 &cm = forces._md_vector;
+  const LVector3 &c = forces._vector;
+  const LMatrix3 &km = forces._md_friction;
+  const LMatrix3 &k = forces._friction;
+  PN_stdfloat damper = forces._viscosity_damper;
+  PN_stdfloat half_dt2 = 0.5f * dt * dt;
+
+  int i = 0;
+
+#ifdef PARTICLE_POOL_SSE2
+  __m128 dt4 = _mm_set1_ps(dt);
+  __m128 half_dt24 = _mm_set1_ps(half_dt2);
+  __m128 damper4 = _mm_set1_ps(damper);
+  __m128 cmx = _mm_set1_ps(cm[0]);
+  __m128 cmy = _mm_set1_ps(cm[1]);
+  __m128 cmz = _mm_set1_ps(cm[2]);
+  __m128 cx = _mm_set1_ps(c[0]);
+  __m128 cy = _mm_set1_ps(c[1]);
+  __m128 cz = _mm_set1_ps(c[2]);
+
+  if (forces._has_friction) {
+    __m128 km4[9], k4[9];
+    for (int j = 0; j < 9; ++j) {
+      km4[j] = _mm_set1_ps(km.get_cell(j / 3, j % 3));
+      k4[j] = _mm_set1_ps(k.get_cell(j / 3, j % 3));
+    }
+
+    for (; i + 4 <= _size; i += 4) {
+      __m128 x = _mm_loadu_ps(vx + i);
+      __m128 y = _mm_loadu_ps(vy + i);
+      __m128 z = _mm_loadu_ps(vz + i);
+      __m128 im = _mm_loadu_ps(inv_mass + i);
+
+      // f = c + v * K, for each of the mass-dependent and independent sets.
+      __m128 fmx = _mm_add_ps(cmx, _mm_add_ps(_mm_mul_ps(x, km4[0]), _mm_add_ps(_mm_mul_ps(y, km4[3]), _mm_mul_ps(z, km4[6]))));
+      __m128 fmy = _mm_add_ps(cmy, _mm_add_ps(_mm_mul_ps(x, km4[1]), _mm_add_ps(_mm_mul_ps(y, km4[4]), _mm_mul_ps(z, km4[7]))));
+      __m128 fmz = _mm_add_ps(cmz, _mm_add_ps(_mm_mul_ps(x, km4[2]), _mm_add_ps(_mm_mul_ps(y, km4[5]), _mm_mul_ps(z, km4[8]))));
+      __m128 fx = _mm_add_ps(cx, _mm_add_ps(_mm_mul_ps(x, k4[0]), _mm_add_ps(_mm_mul_ps(y, k4[3]), _mm_mul_ps(z, k4[6]))));
+      __m128 fy = _mm_add_ps(cy, _mm_add_ps(_mm_mul_ps(x, k4[1]), _mm_add_ps(_mm_mul_ps(y, k4[4]), _mm_mul_ps(z, k4[7]))));
+      __m128 fz = _mm_add_ps(cz, _mm_add_ps(_mm_mul_ps(x, k4[2]), _mm_add_ps(_mm_mul_ps(y, k4[5]), _mm_mul_ps(z, k4[8]))));
+
+      __m128 ax = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(fmx, im), fx), damper4);
+      __m128 ay = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(fmy, im), fy), damper4);
+      __m128 az = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(fmz, im), fz), damper4);
+
+      _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_add_ps(_mm_mul_ps(x, dt4), _mm_mul_ps(ax, half_dt24))));
+      _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_add_ps(_mm_mul_ps(y, dt4), _mm_mul_ps(ay, half_dt24))));
+      _mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_add_ps(_mm_mul_ps(z, dt4), _mm_mul_ps(az, half_dt24))));
+      _mm_storeu_ps(vx + i, _mm_add_ps(x, _mm_mul_ps(ax, dt4)));
+      _mm_storeu_ps(vy + i, _mm_add_ps(y, _mm_mul_ps(ay, dt4)));
+      _mm_storeu_ps(vz + i, _mm_add_ps(z, _mm_mul_ps(az, dt4)));
+    }
+
+  } else {
+    // Without friction, the acceleration depends only on the mass.
+    for (; i + 4 <= _size; i += 4) {
+      __m128 x = _mm_loadu_ps(vx + i);
+      __m128 y = _mm_loadu_ps(vy + i);
+      __m128 z = _mm_loadu_ps(vz + i);
+      __m128 im = _mm_loadu_ps(inv_mass + i);
+
+      __m128 ax = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cmx, im), cx), damper4);
+      __m128 ay = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cmy, im), cy), damper4);
+      __m128 az = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(cmz, im), cz), damper4);
+
+      _mm_storeu_ps(px + i, _mm_add_ps(_mm_loadu_ps(px + i), _mm_add_ps(_mm_mul_ps(x, dt4), _mm_mul_ps(ax, half_dt24))));
+      _mm_storeu_ps(py + i, _mm_add_ps(_mm_loadu_ps(py + i), _mm_add_ps(_mm_mul_ps(y, dt4), _mm_mul_ps(ay, half_dt24))));
+      _mm_storeu_ps(pz + i, _mm_add_ps(_mm_loadu_ps(pz + i), _mm_add_ps(_mm_mul_ps(z, dt4), _mm_mul_ps(az, half_dt24))));
+      _mm_storeu_ps(vx + i, _mm_add_ps(x, _mm_mul_ps(ax, dt4)));
+      _mm_storeu_ps(vy + i, _mm_add_ps(y, _mm_mul_ps(ay, dt4)));
+      _mm_storeu_ps(vz + i, _mm_add_ps(z, _mm_mul_ps(az, dt4)));
+    }
+  }
+#endif  // PARTICLE_POOL_SSE2
+
+  // The remainder, or all of them if we don't have SSE2.
+  for (; i < _size; ++i) {
+    LVector3 vel(vx[i], vy[i], vz[i]);
+    LVector3 md_accum_vec = cm;
+    LVector3 non_md_accum_vec = c;
+    if (forces._has_friction) {
+      md_accum_vec += vel * km;
+      non_md_accum_vec += vel * k;
+    }
+
+    LVector3 accel_vec = md_accum_vec * inv_mass[i] + non_md_accum_vec;
+    accel_vec *= damper;
+
+    px[i] += vel[0] * dt + accel_vec[0] * half_dt2;
+    py[i] += vel[1] * dt + accel_vec[1] * half_dt2;
+    pz[i] += vel[2] * dt + accel_vec[2] * half_dt2;
+    vx[i] += accel_vec[0] * dt;
+    vy[i] += accel_vec[1] * dt;
+    vz[i] += accel_vec[2] * dt;
+  }
+}
@@ -0,0 +1,98 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file particlePool.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef PARTICLEPOOL_H
+#define PARTICLEPOOL_H
+
+#include "pandabase.h"
+#include "luse.h"
+#include "pvector.h"
+#include "vector_int.h"
+#include "nearly_zero.h"
+
+class BaseParticle;
+
+/**
+ * Holds the per-frame state of every particle in a ParticleSystem in
+ * structure-of-arrays form: one contiguous array per component, indexed by
+ * the particle's slot in the system's pool.  This lets the system age,
+ * integrate and render its particles in tight loops over a few arrays,
+ * rather than chasing a pointer to a separate BaseParticle for each one.
+ *
+ * The BaseParticle objects remain the authoritative storage for the cold
+ * data, such as the mass and the lifespan as generated by the factory; use
+ * store() to copy a particle into the pool and fetch() to copy it back out.
+ */
+class EXPCL_PANDA_PARTICLESYSTEM ParticlePool {
+public:
+  /**
+   * The net effect of a set of linear forces on a particle, after they have
+   * been transformed into the space in which the particles are integrated.
+   * The constant part of each force is summed into a vector; forces that
+   * scale with the velocity, such as friction, are summed into a matrix by
+   * which the velocity is multiplied.  As in LinearEulerIntegrator, the
+   * mass-dependent forces are kept apart so that they can be divided by the
+   * mass of each particle.
+   */
+  class EXPCL_PANDA_PARTICLESYSTEM LinearForces {
+  public:
+    LinearForces();
+
+    void clear();
+
+    LVector3 _md_vector;
+    LVector3 _vector;
+    LMatrix3 _md_friction;
+    LMatrix3 _friction;
+    bool _has_friction;
+    PN_stdfloat _viscosity_damper;
+  };
+
+  ParticlePool();
+
+  void resize(int size);
+  INLINE int get_size() const;
+
+  void store(int index, const BaseParticle *bp);
+  void fetch(int index, BaseParticle *bp) const;
+
+  INLINE void set_alive(int index, bool alive);
+  INLINE bool get_alive(int index) const;
+
+  INLINE LPoint3 get_position(int index) const;
+  INLINE LVector3 get_velocity(int index) const;
+  INLINE PN_stdfloat get_parameterized_age(int index) const;
+  INLINE PN_stdfloat get_parameterized_vel(int index) const;
+
+  void age(PN_stdfloat dt);
+  void integrate(const LinearForces &forces, PN_stdfloat dt);
+
+public:
+  typedef pvector<PN_stdfloat> FloatArray;
+
+  FloatArray _pos_x, _pos_y, _pos_z;
+  FloatArray _vel_x, _vel_y, _vel_z;
+  FloatArray _age;
+  FloatArray _lifespan;
+  FloatArray _inv_mass;
+  FloatArray _terminal_velocity;
+  pvector<unsigned char> _alive;
+  vector_int _index;
+
+private:
+  int _size;
+};
+
+#include "particlePool.I"
+
+#endif // PARTICLEPOOL_H
@@ -18,6 +18,9 @@
 #include "clockObject.h"
 #include "physicsManager.h"
 #include "physicalNode.h"
+#include "linearIntegrator.h"
+#include "linearVectorForce.h"
+#include "linearFrictionForce.h"
 #include "nearly_zero.h"
 #include "transformState.h"
 #include "nodePath.h"
@@ -60,6 +63,8 @@ ParticleSystem(int pool_size) :
   _i_was_spawned_flag = false;
   _particle_pool_size = 0;
   _floor_z = -HUGE_VAL;
+  _soa_pool_flag = particle_soa_pool;
+  _pool_active = false;
 
   // just in case someone tries to do something that requires the use of an
   // emitter, renderer, or factory before they've actually assigned one.  This
@@ -110,6 +115,8 @@ ParticleSystem(const ParticleSystem& copy) :
   _tics_since_birth = 0.0;
   _system_lifespan = copy._system_lifespan;
   _living_particles = 0;
+  _soa_pool_flag = copy._soa_pool_flag;
+  _pool_active = false;
 
   set_pool_size(copy._particle_pool_size);
 }
@@ -188,6 +195,13 @@ birth_particle() {
   bp->reset_position(world_pos/* + (NORMALIZED_RAND() * new_vel)*/);
   bp->set_velocity(new_vel);
 
+  if (_pool_active) {
+    // The particle lives in the pool from now on; make sure the physics
+    // manager leaves the object alone.
+    _pool.store(pool_index, bp);
+    bp->set_active(false);
+  }
+
   ++_living_particles;
 
   // propogate information down to renderer
@@ -301,6 +315,10 @@ kill_particle(int pool_index) {
   bp->set_active(false);
   bp->die();
 
+  if (_pool_active) {
+    _pool.set_alive(pool_index, false);
+  }
+
   _free_particle_fifo.push_back(pool_index);
 
   // tell renderer
@@ -338,6 +356,12 @@ resize_pool(int size) {
     return;
   }
 
+  // Put the particles back into their objects while we shuffle them around.
+  // The next call to update() will move them into the pool again.
+  if (_pool_active) {
+    set_pool_active(false);
+  }
+
   _particle_pool_size = size;
 
   // make sure the physics_objects array is OK
@@ -457,11 +481,6 @@ void ParticleSystem::
 update(PN_stdfloat dt) {
   PStatTimer t1(_update_collector);
 
-  int ttl_updates_left = _living_particles;
-  int current_index = 0, index_counter = 0;
-  BaseParticle *bp;
-  PN_stdfloat age;
-
   #ifdef PSSANITYCHECK
   // check up on things
   if (sanity_check()) return;
@@ -472,6 +491,45 @@ update(PN_stdfloat dt) {
        << ", live particles: " << _living_particles << endl;
   #endif
 
+  // Move the particles into or out of the pool, if the system has changed
+  // such that it can or can no longer use it.
+  ParticlePool::LinearForces forces;
+  bool use_pool = _soa_pool_flag && get_pool_forces(forces);
+  if (use_pool != _pool_active) {
+    set_pool_active(use_pool);
+  }
+
+  if (_pool_active) {
+    update_pool(dt, forces);
+  } else {
+    update_objects(dt);
+  }
+
+  // generate new particles if necessary.
+  _tics_since_birth += dt;
+
+  while (_tics_since_birth >= _cur_birth_rate) {
+    birth_litter();
+    _tics_since_birth -= _cur_birth_rate;
+  }
+
+  #ifdef PARTICLE_SYSTEM_UPDATE_SENTRIES
+  cout << "particle update complete" << endl;
+  #endif
+
+}
+
+/**
+ * Ages each living particle object, and kills the ones that have expired.
+ * The objects are moved separately, by the PhysicsManager.
+ */
+void ParticleSystem::
+update_objects(PN_stdfloat dt) {
+  int ttl_updates_left = _living_particles;
+  int current_index = 0, index_counter = 0;
+  BaseParticle *bp;
+  PN_stdfloat age;
+
   // run through the particle array
   while (ttl_updates_left) {
     current_index = index_counter;
@@ -519,20 +577,165 @@ update(PN_stdfloat dt) {
     // break out early if we're lucky
     ttl_updates_left--;
   }
+}
 
+/**
+ * Moves, ages and kills the particles held in the pool.  This does the work
+ * of both update_objects() and the PhysicsManager, for a system that has
+ * been found simple enough by get_pool_forces().
+ */
+void ParticleSystem::
+update_pool(PN_stdfloat dt, const ParticlePool::LinearForces &forces) {
+  _pool.integrate(forces, dt);
+  _pool.age(dt);
 
-  // generate new particles if necessary.
-  _tics_since_birth += dt;
+  bool has_floor = (get_floor_z() != -HUGE_VAL);
+  int ttl_updates_left = _living_particles;
 
-  while (_tics_since_birth >= _cur_birth_rate) {
-    birth_litter();
-    _tics_since_birth -= _cur_birth_rate;
+  for (int i = 0; ttl_updates_left > 0 && i < _pool.get_size(); ++i) {
+    if (!_pool._alive[i]) {
+      continue;
+    }
+
+    if (_pool._age[i] >= _pool._lifespan[i]) {
+      kill_particle(i);
+    } else if (has_floor && _pool._pos_z[i] <= get_floor_z()) {
+      kill_particle(i);
+    }
+
+    ttl_updates_left--;
   }
+}
 
-  #ifdef PARTICLE_SYSTEM_UPDATE_SENTRIES
-  cout << "particle update complete" << endl;
-  #endif
+/**
+ * Adds the effect of the indicated force to the pool forces, transformed
+ * from the force's space into the space of the physical's parent, as by
+ * BaseIntegrator::precompute_linear_matrices().  Returns false if the force
+ * is not of a kind that can be applied to the pool.
+ */
+static bool
+add_pool_force(ParticlePool::LinearForces &forces, LinearForce *force,
+               const NodePath &parent_physical_np) {
+  if (!force->get_active()) {
+    return true;
+  }
+  if (force->get_force_node() == nullptr) {
+    return false;
+  }
+
+  CPT(TransformState) transform =
+    force->get_force_node_path().get_transform(parent_physical_np);
+  const LMatrix4 &mat = transform->get_mat();
+  LVector3 masks = force->get_vector_masks();
+  PN_stdfloat amplitude = force->get_amplitude();
+  bool mass_dependent = force->get_mass_dependent();
+
+  if (force->is_exact_type(LinearVectorForce::get_class_type())) {
+    // A constant force.
+    LVector3 f = ((LinearVectorForce *)force)->get_local_vector() * amplitude;
+    f.componentwise_mult(masks);
+    f = f * mat;
+
+    if (mass_dependent) {
+      forces._md_vector += f;
+    } else {
+      forces._vector += f;
+    }
+    return true;
+  }
+
+  if (force->is_exact_type(LinearFrictionForce::get_class_type())) {
+    // A force that is a linear function of the velocity, f = v * -coef.
+    PN_stdfloat scale = -((LinearFrictionForce *)force)->get_coef() * amplitude;
+    LMatrix3 &k = mass_dependent ? forces._md_friction : forces._friction;
+    for (int i = 0; i < 3; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        k(i, j) += masks[i] * scale * mat(i, j);
+      }
+    }
+    forces._has_friction = true;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * Determines whether the system can currently keep its particles in the
+ * pool, and if so, fills in the forces that act on them.  Returns false if
+ * the system must use the BaseParticle objects instead.
+ */
+bool ParticleSystem::
+get_pool_forces(ParticlePool::LinearForces &forces) {
+  if (_spawn_on_death_flag || _factory.is_null() || _renderer.is_null() ||
+      !_factory->supports_particle_pool() ||
+      !_renderer->supports_particle_pool()) {
+    return false;
+  }
+
+  // The pool does the integration in place of the PhysicsManager, so it may
+  // only do so if the PhysicsManager would have done the same thing.
+  PhysicsManager *manager = get_physics_manager();
+  if (manager == nullptr || get_physical_node() == nullptr) {
+    return false;
+  }
+  LinearIntegrator *integrator = manager->get_linear_integrator();
+  if (integrator == nullptr || !integrator->is_explicit_euler()) {
+    return false;
+  }
+
+  NodePath parent_physical_np = get_physical_node_path().get_parent();
+
+  forces.clear();
+  forces._viscosity_damper = 1.0f - get_viscosity();
+
+  for (LinearForce *force : manager->get_linear_forces()) {
+    if (!add_pool_force(forces, force, parent_physical_np)) {
+      return false;
+    }
+  }
+  for (LinearForce *force : get_linear_forces()) {
+    if (!add_pool_force(forces, force, parent_physical_np)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Moves the state of the living particles into the pool, or back out of it
+ * into the BaseParticle objects.  The objects of the particles in the pool
+ * are made inactive, so that the PhysicsManager doesn't move them as well.
+ */
+void ParticleSystem::
+set_pool_active(bool active) {
+  if (active == _pool_active) {
+    return;
+  }
+
+  int num_objects = (int)_physics_objects.size();
+  if (active) {
+    _pool.resize(num_objects);
+    for (int i = 0; i < num_objects; ++i) {
+      BaseParticle *bp = (BaseParticle *) _physics_objects[i].p();
+      _pool.store(i, bp);
+      if (bp->get_alive()) {
+        bp->set_active(false);
+      }
+    }
+  } else {
+    for (int i = 0; i < num_objects && i < _pool.get_size(); ++i) {
+      if (_pool.get_alive(i)) {
+        BaseParticle *bp = (BaseParticle *) _physics_objects[i].p();
+        _pool.fetch(i, bp);
+        bp->set_active(true);
+      }
+    }
+    _pool.resize(0);
+  }
 
+  _pool_active = active;
 }
 
 #ifdef PSSANITYCHECK
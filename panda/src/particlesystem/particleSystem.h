@@ -25,6 +25,7 @@
 #include "baseParticleRenderer.h"
 #include "baseParticleEmitter.h"
 #include "baseParticleFactory.h"
+#include "particlePool.h"
 
 class ParticleSystemManager;
 
@@ -60,6 +61,7 @@ PUBLISHED:
   INLINE void set_emitter(BaseParticleEmitter *e);
   INLINE void set_factory(BaseParticleFactory *f);
   INLINE void set_floor_z(PN_stdfloat z);
+  INLINE void set_soa_pool_flag(bool flag);
 
   INLINE void clear_floor_z();
 
@@ -84,6 +86,8 @@ PUBLISHED:
   INLINE BaseParticleFactory *get_factory() const;
   INLINE PN_stdfloat get_floor_z() const;
   INLINE PN_stdfloat get_tics_since_birth() const;
+  INLINE bool get_soa_pool_flag() const;
+  INLINE bool is_using_soa_pool() const;
 
   // particle template vector
 
@@ -113,6 +117,10 @@ private:
   void kill_particle(int pool_index);
   void birth_litter();
   void resize_pool(int size);
+  void update_objects(PN_stdfloat dt);
+  void update_pool(PN_stdfloat dt, const ParticlePool::LinearForces &forces);
+  bool get_pool_forces(ParticlePool::LinearForces &forces);
+  void set_pool_active(bool active);
 
   pdeque< int > _free_particle_fifo;
 
@@ -156,6 +164,12 @@ private:
   // information for spawned systems
   bool _i_was_spawned_flag;
 
+  // While _pool_active is true, the living particles are held and updated in
+  // _pool; their BaseParticle objects are inactive and hold stale state.
+  bool _soa_pool_flag;
+  bool _pool_active;
+  ParticlePool _pool;
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
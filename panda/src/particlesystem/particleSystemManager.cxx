@@ -18,17 +18,27 @@
 #include "physicsManager.h"
 #include "clockObject.h"
 #include "pStatTimer.h"
+#include "config_particlesystem.h"
+#include "genericAsyncTask.h"
+#include "asyncTaskManager.h"
+#include "trueClock.h"
+#include "pmap.h"
 
 #include <algorithm>
 
 PStatCollector ParticleSystemManager::_do_particles_collector("App:Particles:Do Particles");
+PStatCollector ParticleSystemManager::_particles_pcollector("Particles");
+PStatCollector ParticleSystemManager::_particles_per_second_pcollector("Particles per second");
+PStatCollector ParticleSystemManager::_system_time_pcollector("Particle system time");
 
 /**
  * default constructor
  */
 ParticleSystemManager::
 ParticleSystemManager(int every_nth_frame) :
-  _nth_frame(every_nth_frame), _cur_frame(0) {
+  _nth_frame(every_nth_frame), _cur_frame(0), _num_threads(0),
+  _particles_per_second(0.0), _time_per_system(0.0) {
+  set_num_threads(particle_num_threads);
 }
 
 /**
@@ -38,6 +48,30 @@ ParticleSystemManager::
 ~ParticleSystemManager() {
 }
 
+/**
+ * Sets the number of worker threads used by do_particles() to update and
+ * render the particle systems in parallel.  If this is 0, or if threading is
+ * not available, the systems are stepped one at a time on the calling thread.
+ *
+ * The threads belong to a task chain that is shared by all of the managers;
+ * it is given at least as many threads as the largest number requested.
+ */
+void ParticleSystemManager::
+set_num_threads(int num_threads) {
+  nassertv(num_threads >= 0);
+  _num_threads = num_threads;
+
+  if (_num_threads > 0 && Thread::is_threading_supported()) {
+    AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+    _task_chain = task_mgr->make_task_chain("particle_system_manager");
+    if (_task_chain->get_num_threads() < _num_threads) {
+      _task_chain->set_num_threads(_num_threads);
+    }
+  } else {
+    _task_chain = nullptr;
+  }
+}
+
 /**
  * removes a ps from the maintenance list
  */
@@ -76,6 +110,16 @@ do_particles(PN_stdfloat dt) {
     render_due = true;
   }
 
+  if (_task_chain != nullptr && _ps_list.size() > 1) {
+    do_particles_parallel(dt, render_due);
+    return;
+  }
+
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double start = clock->get_short_time();
+  int num_particles = 0;
+  int num_systems = 0;
+
   cur = _ps_list.begin();
 
   // cout << "PSM::do_particles on a vector of size " << _ps_list.size() <<
@@ -89,6 +133,8 @@ do_particles(PN_stdfloat dt) {
       // cout << "  system " << cs++ << endl; cout << "  count is: " <<
       // cur_ps->get_render_parent()->get_ref_count() << endl;
       cur_ps->update(dt);
+      num_particles += cur_ps->get_living_particles();
+      ++num_systems;
 
       // Handle age:
       if (cur_ps->get_system_grows_older_flag() == true) {
@@ -117,6 +163,9 @@ do_particles(PN_stdfloat dt) {
   }
   // cout << "PSM::do_particles finished."  << endl; cout <<
   // "ParticleSystemManager::doparticles exiting."  << endl;
+
+  double elapsed = clock->get_short_time() - start;
+  record_stats(elapsed, elapsed, num_particles, num_systems);
 }
 
 /**
@@ -141,6 +190,198 @@ do_particles(PN_stdfloat dt, ParticleSystem *ps, bool do_render) {
   }
 }
 
+/**
+ * The implementation of do_particles() when there are worker threads.
+ *
+ * The systems are divided into jobs, which are stepped in parallel: one on
+ * the calling thread, and the rest on the task chain.  Each renderer writes
+ * only to its own vertex data; the changes it would make to the scene graph
+ * are held back until all of the jobs are finished.  Systems that share an
+ * emitter are placed in the same job, since an emitter may keep state while
+ * it generates particles.
+ *
+ * Systems that spawn other systems when their particles die, or whose
+ * renderer modifies the scene graph directly, are first stepped serially.
+ */
+void ParticleSystemManager::
+do_particles_parallel(PN_stdfloat dt, bool render_due) {
+  TrueClock *clock = TrueClock::get_global_ptr();
+  double start = clock->get_short_time();
+
+  StepJob serial;
+  serial._dt = dt;
+  serial._render_due = render_due;
+
+  // Gather the systems into groups that share an emitter.
+  typedef pmap<BaseParticleEmitter *, size_t> GroupMap;
+  GroupMap group_map;
+  StepJobs groups;
+
+  plist< PT(ParticleSystem) >::const_iterator psi;
+  for (psi = _ps_list.begin(); psi != _ps_list.end(); ++psi) {
+    ParticleSystem *ps = *psi;
+    if (!ps->get_active_system_flag()) {
+      continue;
+    }
+
+    BaseParticleRenderer *renderer = ps->get_renderer();
+    if (ps->get_spawn_on_death_flag() || renderer == nullptr ||
+        !renderer->supports_parallel_render()) {
+      serial._systems.push_back(ps);
+      continue;
+    }
+
+    std::pair<GroupMap::iterator, bool> result =
+      group_map.insert(GroupMap::value_type(ps->get_emitter(), groups.size()));
+    if (result.second) {
+      groups.push_back(StepJob());
+    }
+    StepJob &group = groups[result.first->second];
+    group._systems.push_back(ps);
+    group._weight += ps->get_living_particles() + 1;
+  }
+
+  // The serial systems may modify the scene graph, so they have to be done
+  // before any of the other systems are started.
+  step_job(serial);
+
+  // Hand out the groups, heaviest first, to whichever job has the least work
+  // so far.
+  size_t num_jobs = std::min(groups.size(), (size_t)_num_threads + 1);
+  _jobs.clear();
+  _jobs.resize(num_jobs);
+
+  pvector<size_t> order(groups.size());
+  for (size_t gi = 0; gi < groups.size(); ++gi) {
+    order[gi] = gi;
+  }
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return groups[a]._weight > groups[b]._weight;
+  });
+
+  for (size_t gi : order) {
+    StepJob &group = groups[gi];
+    StepJob *job = &_jobs[0];
+    for (StepJob &other : _jobs) {
+      if (other._weight < job->_weight) {
+        job = &other;
+      }
+    }
+    job->_systems.insert(job->_systems.end(), group._systems.begin(), group._systems.end());
+    job->_weight += group._weight;
+  }
+
+  for (StepJob &job : _jobs) {
+    job._dt = dt;
+    job._render_due = render_due;
+    for (ParticleSystem *ps : job._systems) {
+      ps->get_renderer()->set_defer_render_node_update(true);
+    }
+  }
+
+  // Start all but the first job on the task chain, and do the first one
+  // ourselves while we wait.
+  if (num_jobs > 1) {
+    AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+    for (size_t ji = 1; ji < num_jobs; ++ji) {
+      PT(GenericAsyncTask) task =
+        new GenericAsyncTask("particles", &st_step_job, &_jobs[ji]);
+      task->set_task_chain(_task_chain->get_name());
+      task_mgr->add(task);
+    }
+  }
+  if (num_jobs > 0) {
+    step_job(_jobs[0]);
+  }
+  if (num_jobs > 1) {
+    _task_chain->wait_for_tasks();
+  }
+
+  // Now we are the only thread touching the systems again; publish the
+  // changes to the render nodes and remove the systems that have died.
+  int num_particles = serial._num_particles;
+  double system_time = serial._system_time;
+  size_t num_systems = serial._systems.size();
+  pvector<ParticleSystem *> expired(serial._expired);
+
+  for (StepJob &job : _jobs) {
+    for (ParticleSystem *ps : job._systems) {
+      ps->get_renderer()->set_defer_render_node_update(false);
+    }
+    num_particles += job._num_particles;
+    system_time += job._system_time;
+    num_systems += job._systems.size();
+    expired.insert(expired.end(), job._expired.begin(), job._expired.end());
+  }
+  _jobs.clear();
+
+  for (ParticleSystem *ps : expired) {
+    remove_particlesystem(ps);
+  }
+
+  record_stats(clock->get_short_time() - start, system_time, num_particles,
+               (int)num_systems);
+}
+
+/**
+ * Updates, ages and renders each of the systems in the job in turn.  A
+ * system that reaches the end of its lifespan is not rendered; it is added to
+ * the job's list of expired systems instead, to be removed by the caller.
+ */
+void ParticleSystemManager::
+step_job(StepJob &job) {
+  TrueClock *clock = TrueClock::get_global_ptr();
+
+  for (ParticleSystem *ps : job._systems) {
+    double start = clock->get_short_time();
+
+    ps->update(job._dt);
+    job._num_particles += ps->get_living_particles();
+
+    bool expired = false;
+    if (ps->get_system_grows_older_flag()) {
+      PN_stdfloat age = ps->get_system_age() + job._dt;
+      ps->set_system_age(age);
+
+      if (age >= ps->get_system_lifespan()) {
+        job._expired.push_back(ps);
+        expired = true;
+      }
+    }
+
+    if (job._render_due && !expired) {
+      ps->render();
+    }
+
+    job._system_time += clock->get_short_time() - start;
+  }
+}
+
+/**
+ * The task function that steps a StepJob on the task chain.
+ */
+AsyncTask::DoneStatus ParticleSystemManager::
+st_step_job(GenericAsyncTask *, void *data) {
+  step_job(*(StepJob *)data);
+  return AsyncTask::DS_done;
+}
+
+/**
+ * Records the statistics for a call to do_particles(): the elapsed wall-clock
+ * time, and the total time spent on the individual systems, which is greater
+ * than the elapsed time when they are stepped in parallel.
+ */
+void ParticleSystemManager::
+record_stats(double elapsed, double system_time, int num_particles,
+             int num_systems) {
+  _particles_per_second = (elapsed > 0.0) ? num_particles / elapsed : 0.0;
+  _time_per_system = (num_systems > 0) ? system_time / num_systems : 0.0;
+
+  _particles_pcollector.set_level(num_particles);
+  _particles_per_second_pcollector.set_level(_particles_per_second);
+  _system_time_pcollector.set_level(_time_per_system * 1000.0);
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
@@ -176,6 +417,7 @@ write(std::ostream &out, int indent) const {
   out.width(indent); out<<""; out<<"ParticleSystemManager:\n";
   out.width(indent+2); out<<""; out<<"_nth_frame "<<_nth_frame<<"\n";
   out.width(indent+2); out<<""; out<<"_cur_frame "<<_cur_frame<<"\n";
+  out.width(indent+2); out<<""; out<<"_num_threads "<<_num_threads<<"\n";
   write_ps_list(out, indent+2);
   #endif //] NDEBUG
 }
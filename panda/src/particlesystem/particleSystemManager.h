@@ -18,6 +18,10 @@
 #include "plist.h"
 #include "particleSystem.h"
 #include "pStatCollector.h"
+#include "asyncTaskChain.h"
+#include "pvector.h"
+
+class GenericAsyncTask;
 
 /**
  * Manages a set of individual ParticleSystem objects, so that each individual
@@ -32,6 +36,12 @@ PUBLISHED:
   INLINE void set_frame_stepping(int every_nth_frame);
   INLINE int get_frame_stepping() const;
 
+  void set_num_threads(int num_threads);
+  INLINE int get_num_threads() const;
+
+  INLINE double get_particles_per_second() const;
+  INLINE double get_time_per_system() const;
+
   INLINE void attach_particlesystem(ParticleSystem *ps);
   void remove_particlesystem(ParticleSystem *ps);
   INLINE void clear();
@@ -44,12 +54,44 @@ PUBLISHED:
   virtual void write(std::ostream &out, int indent=0) const;
 
 private:
+  // A set of particle systems to be stepped, one after the other, on a single
+  // thread.
+  class StepJob {
+  public:
+    INLINE StepJob();
+
+    pvector<ParticleSystem *> _systems;
+    pvector<ParticleSystem *> _expired;
+    PN_stdfloat _dt;
+    bool _render_due;
+    int _weight;
+    int _num_particles;
+    double _system_time;
+  };
+  typedef pvector<StepJob> StepJobs;
+
+  void do_particles_parallel(PN_stdfloat dt, bool render_due);
+  static void step_job(StepJob &job);
+  static AsyncTask::DoneStatus st_step_job(GenericAsyncTask *task, void *data);
+  void record_stats(double elapsed, double system_time, int num_particles,
+                    int num_systems);
+
   plist< PT(ParticleSystem) > _ps_list;
 
   int _nth_frame;
   int _cur_frame;
 
+  int _num_threads;
+  PT(AsyncTaskChain) _task_chain;
+  StepJobs _jobs;
+
+  double _particles_per_second;
+  double _time_per_system;
+
   static PStatCollector _do_particles_collector;
+  static PStatCollector _particles_pcollector;
+  static PStatCollector _particles_per_second_pcollector;
+  static PStatCollector _system_time_pcollector;
 };
 
 #include "particleSystemManager.I"
@@ -55,6 +55,14 @@ alloc_particle() const {
   return new PointParticle;
 }
 
+/**
+ * Returns true, since a PointParticle has no behavior of its own.
+ */
+bool PointParticleFactory::
+supports_particle_pool() const {
+  return true;
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
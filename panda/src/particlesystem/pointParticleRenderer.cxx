@@ -12,6 +12,7 @@
  */
 
 #include "pointParticleRenderer.h"
+#include "particlePool.h"
 #include "boundingSphere.h"
 #include "geomNode.h"
 #include "geom.h"
@@ -69,6 +70,14 @@ make_copy() {
   return new PointParticleRenderer(*this);
 }
 
+/**
+ * Returns true, since this renderer writes only to its own vertex data.
+ */
+bool PointParticleRenderer::
+supports_parallel_render() const {
+  return true;
+}
+
 /**
  * reallocate the space for the vertex and color pools
  */
@@ -119,10 +128,27 @@ kill_particle(int) {
  */
 LColor PointParticleRenderer::
 create_color(const BaseParticle *p) {
+  // Only compute the parameters that will actually be used.
+  PN_stdfloat parameterized_age = 1.0f;
+  PN_stdfloat parameterized_vel = 0.0f;
+  if (_blend_type == PP_BLEND_LIFE ||
+      (_alpha_mode != PR_ALPHA_NONE && _alpha_mode != PR_ALPHA_USER)) {
+    parameterized_age = p->get_parameterized_age();
+  }
+  if (_blend_type == PP_BLEND_VEL) {
+    parameterized_vel = p->get_parameterized_vel();
+  }
+  return create_color(parameterized_age, parameterized_vel);
+}
+
+/**
+ * Generates the point color based on the render_type, given the particle's
+ * age and speed as fractions of its lifespan and terminal velocity.
+ */
+LColor PointParticleRenderer::
+create_color(PN_stdfloat parameterized_age, PN_stdfloat parameterized_vel) {
   LColor color;
   PN_stdfloat life_t, vel_t;
-  PN_stdfloat parameterized_age = 1.0f;
-  bool have_alpha_t = false;
 
   switch (_blend_type) {
   case PP_ONE_COLOR:
@@ -132,9 +158,7 @@ create_color(const BaseParticle *p) {
 
   case PP_BLEND_LIFE:
     // Blending colors based on life
-    parameterized_age = p->get_parameterized_age();
     life_t = parameterized_age;
-    have_alpha_t = true;
 
     if (_blend_method == PP_BLEND_CUBIC) {
       life_t = CUBIC_T(life_t);
@@ -145,7 +169,7 @@ create_color(const BaseParticle *p) {
 
   case PP_BLEND_VEL:
     // Blending colors based on vel
-    vel_t = p->get_parameterized_vel();
+    vel_t = parameterized_vel;
 
     if (_blend_method == PP_BLEND_CUBIC) {
       vel_t = CUBIC_T(vel_t);
@@ -160,10 +184,6 @@ create_color(const BaseParticle *p) {
     if (_alpha_mode == PR_ALPHA_USER) {
       parameterized_age = 1.0;
     } else {
-      if (!have_alpha_t) {
-        parameterized_age = p->get_parameterized_age();
-      }
-
       if (_alpha_mode == PR_ALPHA_OUT) {
         parameterized_age = 1.0f - parameterized_age;
       } else if (_alpha_mode == PR_ALPHA_IN_OUT) {
@@ -250,7 +270,121 @@ render(pvector< PT(PhysicsObject) >& po_vector, int ttl_particles) {
 
   BoundingSphere sphere(aabb_center, radius);
   _point_primitive->set_bounds(&sphere);
-  get_render_node()->mark_internal_bounds_stale();
+  update_render_node();
+}
+
+/**
+ * Returns true, since this renderer can draw directly out of a ParticlePool.
+ */
+bool PointParticleRenderer::
+supports_particle_pool() const {
+  return true;
+}
+
+/**
+ * Renders the particles held in the pool.  This produces the same result as
+ * render(), but writes the vertices straight into the vertex array instead
+ * of going through a GeomVertexWriter for each one.
+ */
+void PointParticleRenderer::
+render_pool(ParticlePool &pool, int ttl_particles) {
+  PStatTimer t1(_render_collector);
+
+  int remaining_particles = ttl_particles;
+  int i;
+
+  // init the aabb
+
+  _aabb_min.set(99999.0f, 99999.0f, 99999.0f);
+  _aabb_max.set(-99999.0f, -99999.0f, -99999.0f);
+
+  {
+    PT(GeomVertexArrayDataHandle) handle = _vdata->modify_array_handle(0);
+    handle->unclean_set_num_rows(ttl_particles);
+
+    const GeomVertexArrayFormat *format = handle->get_array_format();
+    const GeomVertexColumn *vertex_column = format->get_column(InternalName::get_vertex());
+    const GeomVertexColumn *color_column = format->get_column(InternalName::get_color());
+    nassertv(vertex_column != nullptr && color_column != nullptr);
+    nassertv(vertex_column->get_numeric_type() == GeomEnums::NT_stdfloat &&
+             vertex_column->get_num_components() == 3);
+    nassertv(color_column->get_numeric_type() == GeomEnums::NT_packed_dabc);
+
+    size_t stride = format->get_stride();
+    unsigned char *vertex_ptr = handle->get_write_pointer() + vertex_column->get_start();
+    unsigned char *color_ptr = handle->get_write_pointer() + color_column->get_start();
+
+    // The color only needs to be computed once if it doesn't vary.
+    bool constant_color = (_blend_type == PP_ONE_COLOR &&
+                           (_alpha_mode == PR_ALPHA_NONE ||
+                            _alpha_mode == PR_ALPHA_USER));
+    uint32_t packed_color = 0;
+    if (constant_color) {
+      packed_color = pack_color(create_color(1.0f, 0.0f));
+    }
+
+    // run through every filled slot
+
+    for (i = 0; i < pool.get_size() && remaining_particles > 0; i++) {
+      if (!pool._alive[i])
+        continue;
+
+      PN_stdfloat x = pool._pos_x[i];
+      PN_stdfloat y = pool._pos_y[i];
+      PN_stdfloat z = pool._pos_z[i];
+
+      _aabb_min[0] = std::min(_aabb_min[0], x);
+      _aabb_max[0] = std::max(_aabb_max[0], x);
+      _aabb_min[1] = std::min(_aabb_min[1], y);
+      _aabb_max[1] = std::max(_aabb_max[1], y);
+      _aabb_min[2] = std::min(_aabb_min[2], z);
+      _aabb_max[2] = std::max(_aabb_max[2], z);
+
+      // stuff it into the arrays
+
+      PN_stdfloat *vertex = (PN_stdfloat *)vertex_ptr;
+      vertex[0] = x;
+      vertex[1] = y;
+      vertex[2] = z;
+      vertex_ptr += stride;
+
+      if (constant_color) {
+        *(uint32_t *)color_ptr = packed_color;
+      } else {
+        *(uint32_t *)color_ptr =
+          pack_color(create_color(pool.get_parameterized_age(i),
+                                  pool.get_parameterized_vel(i)));
+      }
+      color_ptr += stride;
+
+      remaining_particles--;
+    }
+  }
+
+  _points->clear_vertices();
+  _points->add_next_vertices(ttl_particles);
+
+  // done filling geompoint node, now do the bb stuff
+
+  LPoint3 aabb_center = _aabb_min + ((_aabb_max - _aabb_min) * 0.5f);
+  PN_stdfloat radius = (aabb_center - _aabb_min).length();
+
+  BoundingSphere sphere(aabb_center, radius);
+  _point_primitive->set_bounds(&sphere);
+  update_render_node();
+}
+
+/**
+ * Packs the color in the format used by the color column of the vertex data,
+ * in the same way as GeomVertexWriter would.
+ */
+uint32_t PointParticleRenderer::
+pack_color(const LColor &color) {
+  return GeomVertexData::pack_abcd
+    ((unsigned int)(std::min(std::max(color[3], (PN_stdfloat)0.0f), (PN_stdfloat)1.0f) * 255.0f),
+     (unsigned int)(std::min(std::max(color[0], (PN_stdfloat)0.0f), (PN_stdfloat)1.0f) * 255.0f),
+     (unsigned int)(std::min(std::max(color[1], (PN_stdfloat)0.0f), (PN_stdfloat)1.0f) * 255.0f),
+     (unsigned int)(std::min(std::max(color[2], (PN_stdfloat)0.0f), (PN_stdfloat)1.0f) * 255.0f));
 }
 
 /**
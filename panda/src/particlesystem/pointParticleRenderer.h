@@ -50,6 +50,7 @@ PUBLISHED:
 
 public:
   virtual BaseParticleRenderer *make_copy();
+  virtual bool supports_parallel_render() const;
 
 PUBLISHED:
   INLINE void set_point_size(PN_stdfloat point_size);
@@ -86,12 +87,17 @@ private:
   LPoint3 _aabb_max;
 
   LColor create_color(const BaseParticle *p);
+  LColor create_color(PN_stdfloat parameterized_age,
+                      PN_stdfloat parameterized_vel);
+  static uint32_t pack_color(const LColor &color);
 
   virtual void birth_particle(int index);
   virtual void kill_particle(int index);
   virtual void init_geoms();
   virtual void render(pvector< PT(PhysicsObject) >& po_vector,
                       int ttl_particles);
+  virtual bool supports_particle_pool() const;
+  virtual void render_pool(ParticlePool &pool, int ttl_particles);
   virtual void resize_pool(int new_size);
 
   static PStatCollector _render_collector;
@@ -51,6 +51,7 @@ PUBLISHED:
 
 public:
   virtual BaseParticleRenderer *make_copy();
+  virtual bool supports_parallel_render() const;
 
 PUBLISHED:
   INLINE void set_center_color(const LColor& c);
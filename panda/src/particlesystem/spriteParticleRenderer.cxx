@@ -12,6 +12,7 @@
  */
 
 #include "spriteParticleRenderer.h"
+#include "particlePool.h"
 #include "boundingSphere.h"
 #include "geomNode.h"
 #include "sequenceNode.h"
@@ -114,6 +115,15 @@ make_copy() {
   return new SpriteParticleRenderer(*this);
 }
 
+/**
+ * Returns true, since this renderer writes only to its own vertex data.  The
+ * Geoms are reassigned to the render node in do_update_render_node().
+ */
+bool SpriteParticleRenderer::
+supports_parallel_render() const {
+  return true;
+}
+
 
 /**
  * Pull either a set of textures from a SequenceNode or a single texture from
@@ -532,9 +542,8 @@ render(pvector< PT(PhysicsObject) >& po_vector, int ttl_particles) {
 
   BaseParticle *cur_particle;
   int remaining_particles = ttl_particles;
-  int i,j;                                  // loop counters
+  int i;                                    // loop counter
   int anim_count = _anims.size();           // number of animations
-  int frame;                                // frame index, used in indicating which frame to use when not animated
   // First, since this is the only time we have access to the actual
   // particles, do some delayed initialization.
   if (_animate_frames || anim_count) {
@@ -563,6 +572,96 @@ render(pvector< PT(PhysicsObject) >& po_vector, int ttl_particles) {
   }
   _birth_list.clear();
 
+  begin_render();
+
+  // run through every filled slot
+  for (i = 0; i < (int)po_vector.size(); i++) {
+    cur_particle = (BaseParticle *) po_vector[i].p();
+
+    if (!cur_particle->get_alive()) {
+      continue;
+    }
+
+    int anim_index = cur_particle->get_index();
+    add_particle(cur_particle->get_position(),
+                 cur_particle->get_parameterized_age(),
+                 cur_particle->get_age(), anim_index,
+                 cur_particle->get_theta());
+    if (anim_index != cur_particle->get_index()) {
+      cur_particle->set_index(anim_index);
+    }
+
+    // maybe jump out early?
+    remaining_particles--;
+    if (remaining_particles == 0) {
+      break;
+    }
+  }
+
+  end_render();
+}
+
+/**
+ * Returns true, since this renderer can draw directly out of a ParticlePool.
+ */
+bool SpriteParticleRenderer::
+supports_particle_pool() const {
+  return true;
+}
+
+/**
+ * Renders the particles held in the pool.  This is the equivalent of
+ * render(), reading the particles out of the pool's arrays.
+ */
+void SpriteParticleRenderer::
+render_pool(ParticlePool &pool, int ttl_particles) {
+  PStatTimer t1(_render_collector);
+  // There is no texture data available, exit.
+  if (_anims.empty()) {
+    return;
+  }
+
+  int remaining_particles = ttl_particles;
+  int anim_count = _anims.size();
+
+  // Do the same delayed initialization as render().
+  if (_animate_frames || anim_count) {
+    for (int index : _birth_list) {
+      int i = int(NORMALIZED_RAND()*anim_count);
+      pool._index[index] = (i < anim_count ? i : i - 1);
+
+      if (_animate_frames) {
+        pool._age[index] += i / 10.0 * pool._lifespan[index];
+      }
+    }
+  }
+  _birth_list.clear();
+
+  begin_render();
+
+  // Only point particles are held in the pool, so theta is always 0.
+  for (int i = 0; i < pool.get_size() && remaining_particles > 0; i++) {
+    if (!pool._alive[i]) {
+      continue;
+    }
+
+    add_particle(pool.get_position(i), pool.get_parameterized_age(i),
+                 pool._age[i], pool._index[i], 0.0f);
+    remaining_particles--;
+  }
+
+  end_render();
+}
+
+/**
+ * Prepares the vertex writers and the bounding box for a call to render() or
+ * render_pool().
+ */
+void SpriteParticleRenderer::
+begin_render() {
+  int i, j;
+  int anim_count = _anims.size();
+
   // Create vertex writers for each of the possible geoms.  Could possibly be
   // changed to only create writers for geoms that would be used according to
   // the animation configuration.
@@ -581,123 +680,119 @@ render(pvector< PT(PhysicsObject) >& po_vector, int ttl_particles) {
   // init the aabb
   _aabb_min.set(99999.0f, 99999.0f, 99999.0f);
   _aabb_max.set(-99999.0f, -99999.0f, -99999.0f);
+}
 
-  // run through every filled slot
-  for (i = 0; i < (int)po_vector.size(); i++) {
-    cur_particle = (BaseParticle *) po_vector[i].p();
-
-    if (!cur_particle->get_alive()) {
-      continue;
-    }
-
-    LPoint3 position = cur_particle->get_position();
-
-    // x aabb adjust
-    if (position[0] > _aabb_max[0])
-      _aabb_max[0] = position[0];
-    else if (position[0] < _aabb_min[0])
-      _aabb_min[0] = position[0];
-
-    // y aabb adjust
-    if (position[1] > _aabb_max[1])
-      _aabb_max[1] = position[1];
-    else if (position[1] < _aabb_min[1])
-      _aabb_min[1] = position[1];
-
-    // z aabb adjust
-    if (position[2] > _aabb_max[2])
-      _aabb_max[2] = position[2];
-    else if (position[2] < _aabb_min[2])
-      _aabb_min[2] = position[2];
-
-
-    PN_stdfloat t = cur_particle->get_parameterized_age();
-    int anim_index = cur_particle->get_index();
-
-    // If an animation has been removed, we need to reassign those particles
-    // assigned to the removed animation.
-    if(_animation_removed && (anim_index >= anim_count)) {
-      anim_index = int(NORMALIZED_RAND()*anim_count);
-      anim_index = anim_index<anim_count?anim_index:anim_index-1;
-      cur_particle->set_index(anim_index);
-    }
+/**
+ * Adds a single particle to the geoms.  If the particle's animation has been
+ * removed, anim_index is updated with the newly chosen animation.
+ */
+void SpriteParticleRenderer::
+add_particle(const LPoint3 &position, PN_stdfloat t, PN_stdfloat age,
+             int &anim_index, PN_stdfloat theta) {
+  int anim_count = _anims.size();
+  int frame;
+
+  // x aabb adjust
+  if (position[0] > _aabb_max[0])
+    _aabb_max[0] = position[0];
+  else if (position[0] < _aabb_min[0])
+    _aabb_min[0] = position[0];
+
+  // y aabb adjust
+  if (position[1] > _aabb_max[1])
+    _aabb_max[1] = position[1];
+  else if (position[1] < _aabb_min[1])
+    _aabb_min[1] = position[1];
+
+  // z aabb adjust
+  if (position[2] > _aabb_max[2])
+    _aabb_max[2] = position[2];
+  else if (position[2] < _aabb_min[2])
+    _aabb_min[2] = position[2];
+
+  // If an animation has been removed, we need to reassign those particles
+  // assigned to the removed animation.
+  if(_animation_removed && (anim_index >= anim_count)) {
+    anim_index = int(NORMALIZED_RAND()*anim_count);
+    anim_index = anim_index<anim_count?anim_index:anim_index-1;
+  }
 
-    // Find the frame
-    if (_animate_frames) {
-      if (_animate_frames_rate == 0.0f) {
-        frame = (int)(t*_anim_size[anim_index]);
-      } else {
-        frame = (int)fmod(cur_particle->get_age()*_animate_frames_rate+1,_anim_size[anim_index]);
-      }
+  // Find the frame
+  if (_animate_frames) {
+    if (_animate_frames_rate == 0.0f) {
+      frame = (int)(t*_anim_size[anim_index]);
     } else {
-      frame = _animate_frames_index;
+      frame = (int)fmod(age*_animate_frames_rate+1,_anim_size[anim_index]);
     }
+  } else {
+    frame = _animate_frames_index;
+  }
 
-    // Quick check make sure our math above didn't result in an invalid frame.
-    frame = (frame < _anim_size[anim_index]) ? frame : (_anim_size[anim_index]-1);
-    ++_ttl_count[anim_index][frame];
-
-    // Calculate the color This is where we'll want to give the renderer the
-    // new color
-    LColor c = _color_interpolation_manager->generateColor(t);
-
-    int alphamode=get_alpha_mode();
-    if (alphamode != PR_ALPHA_NONE) {
-      if (alphamode == PR_ALPHA_OUT)
-        c[3] *= (1.0f - t) * get_user_alpha();
-      else if (alphamode == PR_ALPHA_IN)
-        c[3] *= t * get_user_alpha();
-      else if (alphamode == PR_ALPHA_IN_OUT) {
-        c[3] *= 2.0f * min(t, 1.0f - t) * get_user_alpha();
-      }
-      else {
-        assert(alphamode == PR_ALPHA_USER);
-        c[3] *= get_user_alpha();
-      }
+  // Quick check make sure our math above didn't result in an invalid frame.
+  frame = (frame < _anim_size[anim_index]) ? frame : (_anim_size[anim_index]-1);
+  ++_ttl_count[anim_index][frame];
+
+  // Calculate the color This is where we'll want to give the renderer the
+  // new color
+  LColor c = _color_interpolation_manager->generateColor(t);
+
+  int alphamode=get_alpha_mode();
+  if (alphamode != PR_ALPHA_NONE) {
+    if (alphamode == PR_ALPHA_OUT)
+      c[3] *= (1.0f - t) * get_user_alpha();
+    else if (alphamode == PR_ALPHA_IN)
+      c[3] *= t * get_user_alpha();
+    else if (alphamode == PR_ALPHA_IN_OUT) {
+      c[3] *= 2.0f * min(t, 1.0f - t) * get_user_alpha();
     }
+    else {
+      assert(alphamode == PR_ALPHA_USER);
+      c[3] *= get_user_alpha();
+    }
+  }
 
-    // Send the data on its way...
-    _sprite_writer[anim_index][frame].vertex.add_data3(position);
-    _sprite_writer[anim_index][frame].color.add_data4(c);
-
-    PN_stdfloat current_x_scale = _initial_x_scale;
-    PN_stdfloat current_y_scale = _initial_y_scale;
+  // Send the data on its way...
+  _sprite_writer[anim_index][frame].vertex.add_data3(position);
+  _sprite_writer[anim_index][frame].color.add_data4(c);
 
-    if (_animate_x_ratio || _animate_y_ratio) {
-      if (_blend_method == PP_BLEND_CUBIC) {
-        t = CUBIC_T(t);
-      }
+  PN_stdfloat current_x_scale = _initial_x_scale;
+  PN_stdfloat current_y_scale = _initial_y_scale;
 
-      if (_animate_x_ratio) {
-        current_x_scale = (_initial_x_scale +
-                           (t * (_final_x_scale - _initial_x_scale)));
-      }
-      if (_animate_y_ratio) {
-        current_y_scale = (_initial_y_scale +
-                           (t * (_final_y_scale - _initial_y_scale)));
-      }
+  if (_animate_x_ratio || _animate_y_ratio) {
+    if (_blend_method == PP_BLEND_CUBIC) {
+      t = CUBIC_T(t);
     }
 
-    if (_sprite_writer[anim_index][frame].size.has_column()) {
-      _sprite_writer[anim_index][frame].size.add_data1f(current_y_scale * _height);
-    }
-    if (_sprite_writer[anim_index][frame].aspect_ratio.has_column()) {
-      _sprite_writer[anim_index][frame].aspect_ratio.add_data1f(_aspect_ratio * current_x_scale / current_y_scale);
+    if (_animate_x_ratio) {
+      current_x_scale = (_initial_x_scale +
+                         (t * (_final_x_scale - _initial_x_scale)));
     }
-    if (_animate_theta) {
-      _sprite_writer[anim_index][frame].rotate.add_data1f(cur_particle->get_theta());
-    } else if (_sprite_writer[anim_index][frame].rotate.has_column()) {
-      _sprite_writer[anim_index][frame].rotate.add_data1f(_theta);
+    if (_animate_y_ratio) {
+      current_y_scale = (_initial_y_scale +
+                         (t * (_final_y_scale - _initial_y_scale)));
     }
+  }
 
-    // maybe jump out early?
-    remaining_particles--;
-    if (remaining_particles == 0) {
-      break;
-    }
+  if (_sprite_writer[anim_index][frame].size.has_column()) {
+    _sprite_writer[anim_index][frame].size.add_data1f(current_y_scale * _height);
   }
-  int n = 0;
-  GeomNode *render_node = get_render_node();
+  if (_sprite_writer[anim_index][frame].aspect_ratio.has_column()) {
+    _sprite_writer[anim_index][frame].aspect_ratio.add_data1f(_aspect_ratio * current_x_scale / current_y_scale);
+  }
+  if (_animate_theta) {
+    _sprite_writer[anim_index][frame].rotate.add_data1f(theta);
+  } else if (_sprite_writer[anim_index][frame].rotate.has_column()) {
+    _sprite_writer[anim_index][frame].rotate.add_data1f(_theta);
+  }
+}
+
+/**
+ * Finishes the geoms after all of the particles have been added.
+ */
+void SpriteParticleRenderer::
+end_render() {
+  int i, j;
+  int anim_count = _anims.size();
 
   for (i = 0; i < anim_count; ++i) {
     for (j = 0; j < _anim_size[i]; ++j) {
@@ -705,12 +800,10 @@ render(pvector< PT(PhysicsObject) >& po_vector, int ttl_particles) {
       _sprite_writer[i][j].clear();
 
       // We have to reassign the GeomVertexData and GeomPrimitive to the Geom,
-      // and the Geom to the GeomNode, in case it got flattened away.
+      // and the Geom to the GeomNode, in case it got flattened away.  The
+      // latter is done in do_update_render_node().
       _sprite_primitive[i][j]->set_primitive(0, _sprites[i][j]);
       _sprite_primitive[i][j]->set_vertex_data(_vdata[i][j]);
-
-      render_node->set_geom(n, _sprite_primitive[i][j]);
-      ++n;
     }
   }
 
@@ -738,11 +831,31 @@ render(pvector< PT(PhysicsObject) >& po_vector, int ttl_particles) {
     }
   }
 
-  get_render_node()->mark_internal_bounds_stale();
-  nassertv(render_node->check_valid());
+  update_render_node();
   _animation_removed = false;
 }
 
+/**
+ * Reassigns the Geoms to the render node, in case they got flattened away,
+ * and marks its bounding volume stale.
+ */
+void SpriteParticleRenderer::
+do_update_render_node() {
+  int anim_count = _anims.size();
+  int n = 0;
+  GeomNode *render_node = get_render_node();
+
+  for (int i = 0; i < anim_count; ++i) {
+    for (int j = 0; j < _anim_size[i]; ++j) {
+      render_node->set_geom(n, _sprite_primitive[i][j]);
+      ++n;
+    }
+  }
+
+  render_node->mark_internal_bounds_stale();
+  nassertv(render_node->check_valid());
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
@@ -159,6 +159,7 @@ PUBLISHED:
 
 public:
   virtual BaseParticleRenderer *make_copy();
+  virtual bool supports_parallel_render() const;
 
 PUBLISHED:
   void set_from_node(const NodePath &node_path, bool size_from_texels = false);
@@ -262,7 +263,14 @@ private:
   virtual void init_geoms();
   virtual void render(pvector< PT(PhysicsObject) > &po_vector,
                       int ttl_particles);
+  virtual bool supports_particle_pool() const;
+  virtual void render_pool(ParticlePool &pool, int ttl_particles);
   virtual void resize_pool(int new_size);
+  void begin_render();
+  void add_particle(const LPoint3 &position, PN_stdfloat t, PN_stdfloat age,
+                    int &anim_index, PN_stdfloat theta);
+  void end_render();
+  virtual void do_update_render_node();
   int extract_textures_from_node(const NodePath &node_path, NodePathCollection &np_col, TextureCollection &tex_col);
 
   vector_int _anim_size;   // Holds the number of frames in each animation.
@@ -0,0 +1,201 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file cellVisibility.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "cellVisibility.h"
+#include "indent.h"
+
+#include <limits>
+
+/**
+ *
+ */
+CellVisibility::
+CellVisibility() :
+  _max_distance(0.0f)
+{
+}
+
+/**
+ * Adds a new, empty cell with the indicated name, and returns its index.  The
+ * new cell can be seen from itself, but from no other cell until
+ * add_visible() is called.
+ */
+int CellVisibility::
+add_cell(const std::string &name) {
+  int cell = (int)_cells.size();
+  _cells.push_back(Cell());
+  _cells.back()._name = name;
+  _cells.back()._visible.set_bit(cell);
+  _cells_by_name.insert(CellsByName::value_type(name, cell));
+  return cell;
+}
+
+/**
+ * Returns the index of the first cell that was added with the indicated name,
+ * or -1 if there is no such cell.
+ */
+int CellVisibility::
+find_cell(const std::string &name) const {
+  CellsByName::const_iterator ci = _cells_by_name.find(name);
+  if (ci == _cells_by_name.end()) {
+    return -1;
+  }
+  return (*ci).second;
+}
+
+/**
+ * Adds a node to the indicated cell.  During the cull traversal, the node,
+ * and everything below it, is pruned when the camera is in a cell from which
+ * this cell cannot be seen.  A node may belong to only one cell.
+ */
+void CellVisibility::
+add_cell_node(int cell, PandaNode *node) {
+  nassertv(cell >= 0 && cell < (int)_cells.size());
+  nassertv(node != nullptr);
+
+  _cells[cell]._nodes.push_back(node);
+  _node_cells.store(node, cell);
+}
+
+/**
+ * Adds a line segment on the ground to the indicated cell.  The camera is
+ * considered to be in the cell of whichever segment it is nearest to.  Only
+ * the X and Y coordinates of the points are used.
+ */
+void CellVisibility::
+add_cell_segment(int cell, const LPoint3 &a, const LPoint3 &b) {
+  nassertv(cell >= 0 && cell < (int)_cells.size());
+
+  Segment segment;
+  segment._a.set(a[0], a[1]);
+  segment._ab.set(b[0] - a[0], b[1] - a[1]);
+  PN_stdfloat length2 = segment._ab.length_squared();
+  segment._inv_length2 = (length2 > 0.0f) ? 1.0f / length2 : 0.0f;
+  segment._cell = cell;
+  _segments.push_back(segment);
+}
+
+/**
+ * Records that to_cell can be seen from from_cell.  This is not symmetric;
+ * call it again with the cells reversed if from_cell can also be seen from
+ * to_cell.
+ */
+void CellVisibility::
+add_visible(int from_cell, int to_cell) {
+  nassertv(from_cell >= 0 && from_cell < (int)_cells.size());
+  nassertv(to_cell >= 0 && to_cell < (int)_cells.size());
+  _cells[from_cell]._visible.set_bit(to_cell);
+}
+
+/**
+ * Returns the number of cells that can be seen from the indicated cell,
+ * including itself.
+ */
+int CellVisibility::
+get_num_visible(int from_cell) const {
+  nassertr(from_cell >= 0 && from_cell < (int)_cells.size(), 0);
+  return _cells[from_cell]._visible.get_num_on_bits();
+}
+
+/**
+ * Returns the index of the cell that contains the indicated point, which is
+ * the cell of the nearest segment in the XY plane, or -1 if there is no
+ * segment within get_max_distance().
+ */
+int CellVisibility::
+get_cell_at(const LPoint3 &point) const {
+  LPoint2 p(point[0], point[1]);
+
+  int best_cell = -1;
+  PN_stdfloat best_dist2 = (_max_distance > 0.0f)
+    ? _max_distance * _max_distance
+    : std::numeric_limits<PN_stdfloat>::max();
+
+  Segments::const_iterator si;
+  for (si = _segments.begin(); si != _segments.end(); ++si) {
+    const Segment &segment = (*si);
+    LVector2 ap = p - segment._a;
+
+    // Find the nearest point on the segment.
+    PN_stdfloat t = ap.dot(segment._ab) * segment._inv_length2;
+    t = std::max((PN_stdfloat)0.0f, std::min(t, (PN_stdfloat)1.0f));
+    LVector2 d = ap - segment._ab * t;
+
+    PN_stdfloat dist2 = d.length_squared();
+    if (dist2 < best_dist2) {
+      best_dist2 = dist2;
+      best_cell = segment._cell;
+    }
+  }
+
+  return best_cell;
+}
+
+/**
+ * Returns the index of the cell that the indicated camera (or other node) is
+ * in, or -1 if it is not in any cell.  See get_cell_at().
+ */
+int CellVisibility::
+get_camera_cell(const NodePath &camera) const {
+  nassertr(!camera.is_empty(), -1);
+  if (_segments.empty()) {
+    return -1;
+  }
+
+  LPoint3 pos;
+  if (_root.is_empty()) {
+    pos = camera.get_net_transform()->get_pos();
+  } else {
+    pos = camera.get_pos(_root);
+  }
+  return get_cell_at(pos);
+}
+
+/**
+ * Removes all of the cells.
+ */
+void CellVisibility::
+clear() {
+  _cells.clear();
+  _segments.clear();
+  _cells_by_name.clear();
+  _node_cells.clear();
+}
+
+/**
+ *
+ */
+void CellVisibility::
+output(std::ostream &out) const {
+  out << "CellVisibility, " << _cells.size() << " cells, "
+      << _segments.size() << " segments";
+}
+
+/**
+ *
+ */
+void CellVisibility::
+write(std::ostream &out, int indent_level) const {
+  indent(out, indent_level) << *this << ":\n";
+  for (int cell = 0; cell < (int)_cells.size(); ++cell) {
+    const Cell &c = _cells[cell];
+    indent(out, indent_level + 2)
+      << c._name << " (" << c._nodes.size() << " nodes) sees";
+    for (int other = 0; other < (int)_cells.size(); ++other) {
+      if (other != cell && c._visible.get_bit(other)) {
+        out << " " << _cells[other]._name;
+      }
+    }
+    out << "\n";
+  }
+}
@@ -0,0 +1,121 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file cellVisibility.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef CELLVISIBILITY_H
+#define CELLVISIBILITY_H
+
+#include "pandabase.h"
+#include "referenceCount.h"
+#include "pandaNode.h"
+#include "nodePath.h"
+#include "bitArray.h"
+#include "simpleHashMap.h"
+#include "pvector.h"
+#include "pmap.h"
+#include "luse.h"
+
+/**
+ * A precomputed table of which cells of a scene can be seen from which other
+ * cells.  Each cell is made up of one or more nodes, which are drawn only
+ * when the camera is in a cell from which that cell is visible, and a set of
+ * line segments on the ground, which are used to decide which cell the
+ * camera is in: the camera is in the cell of the nearest segment, measured
+ * in the XY plane.
+ *
+ * Assign one of these to a CullTraverser with
+ * CullTraverser::set_cell_visibility().  The traverser finds the camera's
+ * cell once at the start of each traversal, and then prunes the node of each
+ * cell that is not visible from it, without any further work at the
+ * application level.  When the camera is not near any segment, nothing is
+ * pruned.
+ *
+ * The table does not change during the cull traversal, so one may safely be
+ * shared between DisplayRegions that are culled in different threads.
+ */
+class EXPCL_PANDA_PGRAPH CellVisibility : public ReferenceCount {
+PUBLISHED:
+  CellVisibility();
+
+  INLINE void set_root(const NodePath &root);
+  INLINE const NodePath &get_root() const;
+  MAKE_PROPERTY(root, get_root, set_root);
+
+  INLINE void set_max_distance(PN_stdfloat max_distance);
+  INLINE PN_stdfloat get_max_distance() const;
+  MAKE_PROPERTY(max_distance, get_max_distance, set_max_distance);
+
+  int add_cell(const std::string &name);
+  INLINE int get_num_cells() const;
+  INLINE const std::string &get_cell_name(int cell) const;
+  MAKE_SEQ(get_cell_names, get_num_cells, get_cell_name);
+  int find_cell(const std::string &name) const;
+
+  void add_cell_node(int cell, PandaNode *node);
+  void add_cell_segment(int cell, const LPoint3 &a, const LPoint3 &b);
+  INLINE int get_num_segments() const;
+
+  void add_visible(int from_cell, int to_cell);
+  INLINE bool is_visible(int from_cell, int to_cell) const;
+  int get_num_visible(int from_cell) const;
+
+  int get_cell_at(const LPoint3 &point) const;
+  int get_camera_cell(const NodePath &camera) const;
+
+  void clear();
+
+  void output(std::ostream &out) const;
+  void write(std::ostream &out, int indent_level = 0) const;
+
+public:
+  INLINE bool is_hidden_from(int from_cell, const PandaNode *node) const;
+
+private:
+  class Cell {
+  public:
+    std::string _name;
+    pvector<PT(PandaNode)> _nodes;
+
+    // The set of cells visible from this one.
+    BitArray _visible;
+  };
+  typedef pvector<Cell> Cells;
+  Cells _cells;
+
+  class Segment {
+  public:
+    LPoint2 _a;
+    LVector2 _ab;
+    PN_stdfloat _inv_length2;
+    int _cell;
+  };
+  typedef pvector<Segment> Segments;
+  Segments _segments;
+
+  typedef pmap<std::string, int> CellsByName;
+  CellsByName _cells_by_name;
+
+  typedef SimpleHashMap<const PandaNode *, int, pointer_hash> NodeCells;
+  NodeCells _node_cells;
+
+  NodePath _root;
+  PN_stdfloat _max_distance;
+};
+
+INLINE std::ostream &operator << (std::ostream &out, const CellVisibility &vis) {
+  vis.output(out);
+  return out;
+}
+
+#include "cellVisibility.I"
+
+#endif
@@ -304,6 +304,16 @@ ConfigVariableBool flatten_geoms
           "only the NodePath interfaces; you may still make the lower-level "
           "SceneGraphReducer calls directly."));
 
+ConfigVariableInt flatten_num_threads
+("flatten-num-threads", 0,
+ PRC_DESC("The number of worker threads that the SceneGraphReducer may use "
+          "to flatten the children of the root node, collect vertex data "
+          "and unify Geoms in parallel.  Only the parts of the scene graph "
+          "that are not instanced are processed in parallel, so the result "
+          "is the same as when this is 0, in which case everything is done "
+          "on the calling thread.  This may also be set for an individual "
+          "SceneGraphReducer with set_num_threads()."));
+
 ConfigVariableInt max_lenses
 ("max-lenses", 100,
  PRC_DESC("Specifies an upper limit on the maximum number of lenses "
@@ -348,6 +358,88 @@ ConfigVariableBool m_dual_flash
 ("m-dual-flash", false,
  PRC_DESC("Set this true to flash any objects that use M_dual, for debugging."));
 
+ConfigVariableBool cull_arena
+("cull-arena", true,
+ PRC_DESC("Set this true to allocate the CullableObjects generated during "
+          "each cull traversal from a per-frame arena owned by the "
+          "CullResult, which is released all at once after the frame has "
+          "been drawn.  Set it false to allocate each object from the heap "
+          "individually, as in earlier versions of Panda."));
+
+ConfigVariableInt cull_arena_chunk_size
+("cull-arena-chunk-size", 65536,
+ PRC_DESC("The size in bytes of each block of memory that is allocated by "
+          "the cull arena.  A frame that needs more than this allocates "
+          "additional blocks."));
+
+ConfigVariableInt cull_arena_pool_size
+("cull-arena-pool-size", 32,
+ PRC_DESC("The maximum number of unused cull arena blocks that are kept "
+          "around for reuse by subsequent frames, rather than being "
+          "returned to the system."));
+
+ConfigVariableBool batch_bounds_update
+("batch-bounds-update", true,
+ PRC_DESC("Set this true to bring the bounding volumes of each scene graph "
+          "up-to-date in a single pass before the cull traversal begins, "
+          "merging the volumes of each node's children with a vectorized "
+          "loop where possible.  Set it false to compute them only as they "
+          "are encountered, one at a time, as in earlier versions of "
+          "Panda."));
+
+ConfigVariableInt cull_batch_children
+("cull-batch-children", 8,
+ PRC_DESC("When a node with at least this many children is encountered "
+          "during the cull traversal, the bounding volumes of its children "
+          "are tested against the view frustum together, in a single "
+          "vectorized pass, rather than one at a time.  This speeds up the "
+          "culling of wide, flat scene graphs.  Set it to 0 to disable "
+          "this."));
+
+ConfigVariableInt software_occlusion_buffer_size
+("software-occlusion-buffer-size", "256 128",
+ PRC_DESC("The width and height, in pixels, of the depth buffer into which a "
+          "SoftwareOcclusionCuller rasterizes its occluders.  This need not "
+          "match the size of the window; a small buffer is faster, but culls "
+          "fewer objects."));
+
+ConfigVariableString software_occlusion_tag
+("software-occlusion-tag", "occluder",
+ PRC_DESC("The name of the tag that marks a node as an occluder, for the "
+          "purposes of SoftwareOcclusionCuller::add_occluders()."));
+
+ConfigVariableBool model_root_find_index
+("model-root-find-index", false,
+ PRC_DESC("Set this true to make each ModelRoot keep an index of the names "
+          "and tags of the nodes below it, so that NodePath::find() and "
+          "find_all_matches() can answer queries of the form \"**/name\" "
+          "and \"**/=tag\" without visiting every node.  The index is "
+          "built on the first such query, and discarded whenever the "
+          "subgraph changes.  This may also be enabled for individual "
+          "models with ModelRoot::set_find_index()."));
+
+ConfigVariableBool model_pool_copy_on_write
+("model-pool-copy-on-write", false,
+ PRC_DESC("Set this true to make the models stored in the ModelPool share "
+          "their nodes with the copies that are made of them, instead of "
+          "having each copy duplicate the whole model.  A shared node is "
+          "replaced with a private copy as soon as it is modified through a "
+          "NodePath, so the cost of copying a model depends only on the "
+          "parts that are actually modified.  Nodes that change themselves "
+          "as they are rendered, such as Characters, LODNodes, SwitchNodes "
+          "and SequenceNodes, are never shared, nor is anything below "
+          "them."));
+
+ConfigVariableBool cull_batch_instances
+("cull-batch-instances", false,
+ PRC_DESC("Set this true to make the cull bins look for runs of objects that "
+          "draw the same Geom with the same vertex data and state, differing "
+          "only in their transform, and hand each run to the GSG to be drawn "
+          "at once.  The state is then only set once, and the OpenGL GSG "
+          "sets up the vertex arrays only once, reloading just the transform "
+          "between instances.  The state-sorted bin also orders objects by "
+          "Geom, so that these runs are found more often."));
+
 ConfigVariableList load_file_type
 ("load-file-type",
  PRC_DESC("List the model loader modules that Panda will automatically "
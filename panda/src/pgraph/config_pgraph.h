@@ -57,6 +57,7 @@ extern ConfigVariableInt max_collect_indices;
 extern EXPCL_PANDA_PGRAPH ConfigVariableBool premunge_data;
 extern ConfigVariableBool preserve_geom_nodes;
 extern ConfigVariableBool flatten_geoms;
+extern EXPCL_PANDA_PGRAPH ConfigVariableInt flatten_num_threads;
 extern EXPCL_PANDA_PGRAPH ConfigVariableInt max_lenses;
 
 extern ConfigVariableBool polylight_info;
@@ -69,6 +70,17 @@ extern ConfigVariableBool m_dual_opaque;
 extern ConfigVariableBool m_dual_transparent;
 extern ConfigVariableBool m_dual_flash;
 
+extern ConfigVariableBool cull_arena;
+extern ConfigVariableInt cull_arena_chunk_size;
+extern ConfigVariableInt cull_arena_pool_size;
+extern EXPCL_PANDA_PGRAPH ConfigVariableBool batch_bounds_update;
+extern ConfigVariableInt cull_batch_children;
+extern EXPCL_PANDA_PGRAPH ConfigVariableInt software_occlusion_buffer_size;
+extern EXPCL_PANDA_PGRAPH ConfigVariableString software_occlusion_tag;
+extern EXPCL_PANDA_PGRAPH ConfigVariableBool model_root_find_index;
+extern EXPCL_PANDA_PGRAPH ConfigVariableBool model_pool_copy_on_write;
+extern EXPCL_PANDA_PGRAPH ConfigVariableBool cull_batch_instances;
+
 extern ConfigVariableList load_file_type;
 extern ConfigVariableString default_model_extension;
 
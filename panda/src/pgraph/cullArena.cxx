@@ -0,0 +1,198 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file cullArena.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "cullArena.h"
+#include "config_pgraph.h"
+#include "lightMutexHolder.h"
+
+LightMutex CullArena::_pool_lock;
+CullArena::Chunk *CullArena::_pool = nullptr;
+int CullArena::_pool_count = 0;
+
+PStatCollector CullArena::_bytes_pcollector("Cull arena");
+
+#if defined(HAVE_THREADS) && !defined(SIMPLE_THREADS)
+// With true threads, each thread may be culling into its own CullResult.
+// With simple threads, several Panda threads share one OS thread, so we
+// cannot safely keep track of the current arena, and don't try.
+static thread_local CullArena *_current_arena = nullptr;
+#define CULL_ARENA_TRACK_CURRENT
+#elif !defined(HAVE_THREADS)
+static CullArena *_current_arena = nullptr;
+#define CULL_ARENA_TRACK_CURRENT
+#endif
+
+/**
+ *
+ */
+CullArena::
+CullArena() :
+  _next_ptr(nullptr),
+  _end_ptr(nullptr),
+  _chunks(nullptr),
+  _bytes_used(0),
+  _bytes_reserved(0)
+{
+}
+
+/**
+ *
+ */
+CullArena::
+~CullArena() {
+  reset();
+}
+
+/**
+ * Releases all of the memory held by the arena at once.  It is the caller's
+ * responsibility to ensure that any objects allocated from the arena have
+ * already been destructed.
+ */
+void CullArena::
+reset() {
+  Chunk *chunk = _chunks;
+  while (chunk != nullptr) {
+    Chunk *next = chunk->_next;
+    free_chunk(chunk);
+    chunk = next;
+  }
+  _chunks = nullptr;
+  _next_ptr = nullptr;
+  _end_ptr = nullptr;
+  _bytes_used = 0;
+  _bytes_reserved = 0;
+}
+
+/**
+ * Returns the CullArena that has been bound to the current thread with a
+ * CullArena::Scope, or NULL if there is none, or if the cull-arena feature
+ * has been disabled.
+ */
+CullArena *CullArena::
+get_current() {
+#ifdef CULL_ARENA_TRACK_CURRENT
+  return _current_arena;
+#else
+  return nullptr;
+#endif
+}
+
+/**
+ * Makes the indicated arena current for this thread.  NULL may be passed to
+ * temporarily stop allocating from an arena.
+ */
+CullArena::Scope::
+Scope(CullArena *arena) {
+#ifdef CULL_ARENA_TRACK_CURRENT
+  _prev_arena = _current_arena;
+  _current_arena = arena;
+#else
+  _prev_arena = nullptr;
+#endif
+}
+
+/**
+ *
+ */
+CullArena::Scope::
+~Scope() {
+#ifdef CULL_ARENA_TRACK_CURRENT
+  _current_arena = _prev_arena;
+#endif
+}
+
+/**
+ * Called by allocate() when the current chunk does not have enough room for
+ * the requested size.  Starts a new chunk and allocates from that.
+ */
+void *CullArena::
+grow(size_t size) {
+  size_t header_size = get_chunk_header_size();
+  size_t chunk_size = get_standard_chunk_size();
+  if (size + header_size > chunk_size) {
+    // This is an unusually large request; give it its own chunk.
+    chunk_size = size + header_size;
+  }
+
+  Chunk *chunk = alloc_chunk(chunk_size);
+  chunk->_next = _chunks;
+  _chunks = chunk;
+  _bytes_reserved += chunk->_size;
+
+  char *data = (char *)chunk + header_size;
+  _next_ptr = data + size;
+  _end_ptr = (char *)chunk + chunk->_size;
+  _bytes_used += size;
+  return data;
+}
+
+/**
+ * Returns the number of chunks that are currently waiting in the pool to be
+ * reused.
+ */
+int CullArena::
+get_num_pooled_chunks() {
+  LightMutexHolder holder(_pool_lock);
+  return _pool_count;
+}
+
+/**
+ * Returns the size of an ordinary chunk, which is the size given by
+ * cull-arena-chunk-size, but not less than 1024 bytes.  Only chunks of this
+ * size are kept in the pool.
+ */
+size_t CullArena::
+get_standard_chunk_size() {
+  return (size_t)std::max((int)cull_arena_chunk_size, 1024);
+}
+
+/**
+ * Returns a new chunk of the indicated size, recycling one from the pool if
+ * possible.
+ */
+CullArena::Chunk *CullArena::
+alloc_chunk(size_t size) {
+  if (size == get_standard_chunk_size()) {
+    LightMutexHolder holder(_pool_lock);
+    if (_pool != nullptr) {
+      Chunk *chunk = _pool;
+      _pool = chunk->_next;
+      --_pool_count;
+      return chunk;
+    }
+  }
+
+  Chunk *chunk = (Chunk *)PANDA_MALLOC_ARRAY(size);
+  chunk->_next = nullptr;
+  chunk->_size = size;
+  return chunk;
+}
+
+/**
+ * Returns the chunk to the pool, or frees it if the pool is full or the
+ * chunk is not of the standard size.
+ */
+void CullArena::
+free_chunk(Chunk *chunk) {
+  if (chunk->_size == get_standard_chunk_size()) {
+    LightMutexHolder holder(_pool_lock);
+    if (_pool_count < cull_arena_pool_size) {
+      chunk->_next = _pool;
+      _pool = chunk;
+      ++_pool_count;
+      return;
+    }
+  }
+
+  PANDA_FREE_ARRAY(chunk);
+}
@@ -0,0 +1,93 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file cullArena.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef CULLARENA_H
+#define CULLARENA_H
+
+#include "pandabase.h"
+#include "pStatCollector.h"
+#include "lightMutex.h"
+
+/**
+ * A simple bump allocator that holds the memory for the objects created
+ * during one cull traversal.  It is owned by the CullResult, and all of its
+ * memory is released at once when the CullResult goes away, after the frame
+ * has been drawn.
+ *
+ * While a CullArena is bound to the current thread with a CullArena::Scope,
+ * new CullableObjects are carved out of it instead of being allocated
+ * individually from the heap.  The objects must still be deleted normally,
+ * since they hold reference counts, but deleting them does not return any
+ * memory.
+ */
+class EXPCL_PANDA_PGRAPH CullArena {
+public:
+  CullArena();
+  ~CullArena();
+  CullArena(const CullArena &copy) = delete;
+  CullArena &operator = (const CullArena &copy) = delete;
+
+  INLINE void *allocate(size_t size);
+  void reset();
+
+  INLINE size_t get_bytes_used() const;
+  INLINE size_t get_bytes_reserved() const;
+
+  static CullArena *get_current();
+  static int get_num_pooled_chunks();
+
+  /**
+   * Binds a CullArena to the current thread for the lifetime of this object,
+   * restoring the previously bound arena (if any) upon destruction.
+   */
+  class EXPCL_PANDA_PGRAPH Scope {
+  public:
+    explicit Scope(CullArena *arena);
+    ~Scope();
+
+  private:
+    CullArena *_prev_arena;
+  };
+
+private:
+  void *grow(size_t size);
+
+  class Chunk {
+  public:
+    Chunk *_next;
+    size_t _size;
+  };
+
+  static Chunk *alloc_chunk(size_t size);
+  static void free_chunk(Chunk *chunk);
+  INLINE static size_t get_chunk_header_size();
+  static size_t get_standard_chunk_size();
+
+  char *_next_ptr;
+  char *_end_ptr;
+  Chunk *_chunks;
+  size_t _bytes_used;
+  size_t _bytes_reserved;
+
+  // Chunks of the standard size are recycled between frames.
+  static LightMutex _pool_lock;
+  static Chunk *_pool;
+  static int _pool_count;
+
+public:
+  static PStatCollector _bytes_pcollector;
+};
+
+#include "cullArena.I"
+
+#endif
@@ -70,6 +70,24 @@ make_result_graph() {
   return root_node;
 }
 
+/**
+ * Called by a derived CullBin class from draw(), to draw a run of objects
+ * that are all instances of the indicated object, one with each of the
+ * indicated transforms.  See CullableObject::is_instance_of().
+ */
+void CullBin::
+draw_instances(const CullableObject *object,
+               const InstanceTransforms &transforms,
+               bool force, Thread *current_thread) {
+  nassertv(object->_geom != nullptr && !transforms.empty());
+
+  GeomPipelineReader geom_reader(object->_geom, current_thread);
+  GeomVertexDataPipelineReader data_reader(object->_munged_data, current_thread);
+  data_reader.check_array_readers();
+  _gsg->draw_instances(&geom_reader, &data_reader, object->_state,
+                       &transforms[0], transforms.size(), force);
+}
+
 /**
  *
  */
@@ -19,6 +19,7 @@
 #include "typedReferenceCount.h"
 #include "pStatCollector.h"
 #include "pointerTo.h"
+#include "pvector.h"
 #include "luse.h"
 #include "geomNode.h"
 
@@ -65,6 +66,11 @@ protected:
   class ResultGraphBuilder;
   virtual void fill_result_graph(ResultGraphBuilder &builder)=0;
 
+  typedef pvector<const TransformState *> InstanceTransforms;
+  void draw_instances(const CullableObject *object,
+                      const InstanceTransforms &transforms,
+                      bool force, Thread *current_thread);
+
 private:
   void check_flash_color();
 
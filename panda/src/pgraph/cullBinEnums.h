@@ -29,6 +29,7 @@ PUBLISHED:
     BT_back_to_front,
     BT_front_to_back,
     BT_fixed,
+    BT_state_hashed,
   };
 };
 
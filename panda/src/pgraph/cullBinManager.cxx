@@ -301,6 +301,9 @@ parse_bin_type(const string &bin_type) {
   } else if (cmp_nocase_uh(bin_type, "state_sorted") == 0) {
     return BT_state_sorted;
 
+  } else if (cmp_nocase_uh(bin_type, "state_hashed") == 0) {
+    return BT_state_hashed;
+
   } else if (cmp_nocase_uh(bin_type, "fixed") == 0) {
     return BT_fixed;
 
@@ -338,6 +341,9 @@ operator << (std::ostream &out, CullBinManager::BinType bin_type) {
 
   case CullBinManager::BT_fixed:
     return out << "fixed";
+
+  case CullBinManager::BT_state_hashed:
+    return out << "state_hashed";
   }
 
   return out << "**invalid BinType(" << (int)bin_type << ")**";
@@ -64,6 +64,8 @@ CullResult(GraphicsStateGuardianBase *gsg,
   MemoryUsage::update_type(this, get_class_type());
 #endif
 
+  _use_arena = cull_arena.get_value();
+
 #ifndef NDEBUG
   _show_transparency = show_transparency.get_value();
 #endif
@@ -265,6 +267,8 @@ void CullResult::
 finish_cull(SceneSetup *scene_setup, Thread *current_thread) {
   CullBinManager *bin_manager = CullBinManager::get_global_ptr();
 
+  CullArena::_bytes_pcollector.add_level(_arena.get_bytes_used());
+
   for (size_t i = 0; i < _bins.size(); ++i) {
     if (!bin_manager->get_bin_active(i)) {
       // If the bin isn't active, don't sort it, and don't draw it.  In fact,
@@ -19,6 +19,7 @@
 #include "cullBinManager.h"
 #include "renderState.h"
 #include "cullableObject.h"
+#include "cullArena.h"
 #include "geomMunger.h"
 #include "referenceCount.h"
 #include "pointerTo.h"
@@ -59,6 +60,8 @@ PUBLISHED:
   PT(PandaNode) make_result_graph();
 
 public:
+  INLINE CullArena *get_arena();
+
   static void bin_removed(int bin_index);
 
 private:
@@ -82,6 +85,10 @@ private:
   GraphicsStateGuardianBase *_gsg;
   PStatCollector _draw_region_pcollector;
 
+  // The arena must outlive the bins, which hold the objects allocated in it.
+  CullArena _arena;
+  bool _use_arena = false;
+
   typedef pvector< PT(CullBin) > Bins;
   Bins _bins;
 
@@ -39,6 +39,8 @@ PStatCollector CullTraverser::_nodes_pcollector("Nodes");
 PStatCollector CullTraverser::_geom_nodes_pcollector("Nodes:GeomNodes");
 PStatCollector CullTraverser::_geoms_pcollector("Geoms");
 PStatCollector CullTraverser::_geoms_occluded_pcollector("Geoms:Occluded");
+PStatCollector CullTraverser::_nodes_occluded_pcollector("Nodes:Occluded");
+PStatCollector CullTraverser::_nodes_cell_culled_pcollector("Nodes:Cell culled");
 
 TypeHandle CullTraverser::_type_handle;
 
@@ -55,6 +57,7 @@ CullTraverser() :
   _initial_state = RenderState::make_empty();
   _cull_handler = nullptr;
   _portal_clipper = nullptr;
+  _camera_cell = -1;
   _effective_incomplete_render = true;
 }
 
@@ -73,6 +76,9 @@ CullTraverser(const CullTraverser &copy) :
   _view_frustum(copy._view_frustum),
   _cull_handler(copy._cull_handler),
   _portal_clipper(copy._portal_clipper),
+  _occlusion_culler(copy._occlusion_culler),
+  _cell_visibility(copy._cell_visibility),
+  _camera_cell(copy._camera_cell),
   _effective_incomplete_render(copy._effective_incomplete_render)
 {
 }
@@ -109,6 +115,18 @@ traverse(const NodePath &root) {
   nassertv(_cull_handler != nullptr);
   nassertv(_scene_setup != nullptr);
 
+  if (_occlusion_culler != nullptr) {
+    _occlusion_culler->prepare(_occlusion_buffer,
+                               _scene_setup->get_world_transform(),
+                               _scene_setup->get_camera_path(),
+                               _scene_setup->get_lens(), _camera_mask);
+  }
+
+  _camera_cell = -1;
+  if (_cell_visibility != nullptr) {
+    _camera_cell = _cell_visibility->get_camera_cell(_scene_setup->get_cull_center());
+  }
+
   if (allow_portal_cull) {
     // This _view_frustum is in cull_center space Erik: obsolete?
     // PT(GeometricBoundingVolume) vf = _view_frustum;
@@ -200,9 +218,21 @@ traverse_below(CullTraverserData &data) {
   node_reader->release();
   int num_children = children.get_num_children();
   if (!node->has_selective_visibility()) {
-    for (int i = 0; i < num_children; ++i) {
-      CullTraverserData next_data(data, children.get_child(i));
-      do_traverse(next_data);
+    // If there are many children, it is faster to test them against the
+    // view frustum all at once.
+    const BoundingHexahedron *frustum = nullptr;
+    if (data._view_frustum != nullptr && cull_batch_children > 0 &&
+        num_children >= cull_batch_children && !fake_view_frustum_cull) {
+      frustum = data._view_frustum->as_bounding_hexahedron();
+    }
+
+    if (frustum != nullptr && !frustum->is_empty()) {
+      traverse_children_batch(data, children, frustum);
+    } else {
+      for (int i = 0; i < num_children; ++i) {
+        CullTraverserData next_data(data, children.get_child(i));
+        do_traverse(next_data);
+      }
     }
   } else {
     int i = node->get_first_visible_child();
@@ -214,6 +244,71 @@ traverse_below(CullTraverserData &data) {
   }
 }
 
+/**
+ * Traverses the indicated children of the node, after first testing their
+ * bounding volumes against the view frustum in batches.  Children that are
+ * entirely outside the frustum are skipped without being visited at all;
+ * children that are entirely inside it are visited without a view frustum.
+ * Children whose bounding volumes are neither spheres nor boxes are left to
+ * the usual test in is_in_view().
+ */
+void CullTraverser::
+traverse_children_batch(CullTraverserData &data,
+                        const PandaNode::Children &children,
+                        const BoundingHexahedron *frustum) {
+  static const int batch_size = 64;
+  LVecBase4 spheres[batch_size];
+  int slots[batch_size];
+  int results[batch_size];
+
+  int num_children = children.get_num_children();
+  for (int start = 0; start < num_children; start += batch_size) {
+    int end = std::min(start + batch_size, num_children);
+
+    // Gather the bounding volumes of this batch of children as spheres.  A
+    // box is tested by its circumscribing sphere, which is also what
+    // BoundingHexahedron::contains_box() does first.
+    int num_spheres = 0;
+    for (int i = start; i < end; ++i) {
+      CPT(BoundingVolume) bounds = children.get_child(i)->get_bounds(_current_thread);
+      int &slot = slots[i - start];
+      slot = -1;
+      if (bounds->is_empty() || bounds->is_infinite()) {
+        continue;
+      }
+
+      const BoundingSphere *sphere = bounds->as_bounding_sphere();
+      if (sphere != nullptr) {
+        spheres[num_spheres] = LVecBase4(sphere->get_center(), sphere->get_radius());
+        slot = num_spheres++;
+        continue;
+      }
+
+      const BoundingBox *box = bounds->as_bounding_box();
+      if (box != nullptr) {
+        LPoint3 center = (box->get_minq() + box->get_maxq()) * 0.5f;
+        spheres[num_spheres] = LVecBase4(center, (box->get_maxq() - center).length());
+        slot = num_spheres++;
+      }
+    }
+
+    frustum->contains_sphere_array(results, spheres, num_spheres);
+
+    for (int i = start; i < end; ++i) {
+      int slot = slots[i - start];
+      if (slot >= 0 && results[slot] == BoundingVolume::IF_no_intersection) {
+        continue;
+      }
+
+      CullTraverserData next_data(data, children.get_child(i));
+      if (slot >= 0 && (results[slot] & BoundingVolume::IF_all) != 0) {
+        next_data._view_frustum = nullptr;
+      }
+      do_traverse(next_data);
+    }
+  }
+}
+
 /**
  * Should be called when the traverser has finished traversing its scene, this
  * gives it a chance to do any necessary finalization.
@@ -248,11 +343,31 @@ draw_bounding_volume(const BoundingVolume *vol,
 /**
  * Returns true if the current node is fully or partially within the viewing
  * area and should be drawn, or false if it (and all of its children) should
- * be pruned.
+ * be pruned.  This also prunes the nodes of cells that cannot be seen from
+ * the camera's cell, if a CellVisibility table has been set, and nodes that
+ * are hidden behind the occluders of the SoftwareOcclusionCuller, if one has
+ * been set.
  */
 bool CullTraverser::
 is_in_view(CullTraverserData &data) {
-  return data.is_in_view(_camera_mask);
+  if (_camera_cell >= 0 &&
+      _cell_visibility->is_hidden_from(_camera_cell, data.node())) {
+    _nodes_cell_culled_pcollector.add_level(1);
+    return false;
+  }
+
+  if (!data.is_in_view(_camera_mask)) {
+    return false;
+  }
+
+  if (_occlusion_culler != nullptr &&
+      _occlusion_culler->is_occluded(_occlusion_buffer,
+                                     data.node_reader()->get_bounds(),
+                                     data.get_net_transform(this)->get_mat())) {
+    _nodes_occluded_pcollector.add_level(1);
+    return false;
+  }
+  return true;
 }
 
 /**
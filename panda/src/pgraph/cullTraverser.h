@@ -27,6 +27,7 @@
 #include "typedReferenceCount.h"
 #include "pStatCollector.h"
 #include "fogAttrib.h"
+#include "softwareOcclusionCuller.h"
 
 class GraphicsStateGuardian;
 class PandaNode;
@@ -34,6 +35,8 @@ class CullHandler;
 class CullableObject;
 class CullTraverserData;
 class PortalClipper;
+class BoundingHexahedron;
+class CellVisibility;
 class NodePath;
 
 /**
@@ -75,6 +78,13 @@ PUBLISHED:
   INLINE void set_portal_clipper(PortalClipper *portal_clipper);
   INLINE PortalClipper *get_portal_clipper() const;
 
+  INLINE void set_occlusion_culler(SoftwareOcclusionCuller *occlusion_culler);
+  INLINE SoftwareOcclusionCuller *get_occlusion_culler() const;
+
+  INLINE void set_cell_visibility(CellVisibility *cell_visibility);
+  INLINE CellVisibility *get_cell_visibility() const;
+  INLINE int get_camera_cell() const;
+
   INLINE bool get_effective_incomplete_render() const;
 
   void traverse(const NodePath &root);
@@ -99,8 +109,13 @@ public:
   static PStatCollector _geom_nodes_pcollector;
   static PStatCollector _geoms_pcollector;
   static PStatCollector _geoms_occluded_pcollector;
+  static PStatCollector _nodes_occluded_pcollector;
+  static PStatCollector _nodes_cell_culled_pcollector;
 
 private:
+  void traverse_children_batch(CullTraverserData &data,
+                               const PandaNode::Children &children,
+                               const BoundingHexahedron *frustum);
   void show_bounds(CullTraverserData &data, bool tight);
   static PT(Geom) make_bounds_viz(const BoundingVolume *vol);
   PT(Geom) make_tight_bounds_viz(PandaNode *node) const;
@@ -120,6 +135,10 @@ private:
   PT(GeometricBoundingVolume) _view_frustum;
   CullHandler *_cull_handler;
   PortalClipper *_portal_clipper;
+  PT(SoftwareOcclusionCuller) _occlusion_culler;
+  SoftwareOcclusionCuller::DepthBuffer _occlusion_buffer;
+  PT(CellVisibility) _cell_visibility;
+  int _camera_cell;
   bool _effective_incomplete_render;
 
 public:
@@ -141,6 +160,7 @@ private:
 };
 
 #include "cullTraverserData.h"
+#include "cellVisibility.h"
 
 #include "cullTraverser.I"
 
@@ -43,6 +43,103 @@ PStatCollector CullableObject::_sw_sprites_pcollector("SW Sprites");
 
 TypeHandle CullableObject::_type_handle;
 
+/**
+ * Every CullableObject is preceded in memory by one of these, which records
+ * where its memory came from.  It is padded to preserve the alignment of the
+ * object that follows it.
+ */
+enum CullableObjectSource {
+  COS_arena,
+  COS_chain,
+  COS_global,
+};
+
+union CullableObjectHeader {
+  CullableObjectSource _source;
+  char _padding[MEMORY_HOOK_ALIGNMENT];
+};
+
+/**
+ * This is the block that is allocated from the heap for a CullableObject
+ * when there is no current CullArena.
+ */
+struct HeapCullableObject {
+  CullableObjectHeader _header;
+  char _object[sizeof(CullableObject)];
+};
+
+/**
+ * Returns the DeletedBufferChain used for CullableObjects that are not
+ * allocated from a CullArena.
+ */
+static DeletedBufferChain *
+get_heap_chain() {
+  static DeletedBufferChain *chain =
+    memory_hook->get_deleted_chain(sizeof(HeapCullableObject));
+  return chain;
+}
+
+/**
+ * Allocates the memory for a new CullableObject.  If a CullArena has been
+ * bound to the current thread, the object is carved out of that; otherwise,
+ * it comes from the heap.  A class derived from CullableObject that is larger
+ * than it is always allocated with the global operator new.
+ */
+void *CullableObject::
+operator new(size_t size) {
+  CullableObjectHeader *header;
+  CullArena *arena = CullArena::get_current();
+  if (size > sizeof(CullableObject)) {
+    header = (CullableObjectHeader *)
+      ::operator new(sizeof(CullableObjectHeader) + size);
+    header->_source = COS_global;
+
+  } else if (arena != nullptr) {
+    header = (CullableObjectHeader *)
+      arena->allocate(sizeof(CullableObjectHeader) + size);
+    header->_source = COS_arena;
+
+  } else {
+    header = (CullableObjectHeader *)
+      get_heap_chain()->allocate(sizeof(HeapCullableObject), get_class_type());
+    header->_source = COS_chain;
+  }
+
+  void *ptr = (void *)(header + 1);
+#ifdef DO_MEMORY_USAGE
+  memory_hook->mark_pointer(ptr, size, nullptr);
+#endif
+  return ptr;
+}
+
+/**
+ * Frees the memory for a CullableObject.  If it was allocated from a
+ * CullArena, this does nothing; the memory is reclaimed when the arena is.
+ */
+void CullableObject::
+operator delete(void *ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+#ifdef DO_MEMORY_USAGE
+  memory_hook->mark_pointer(ptr, 0, nullptr);
+#endif
+
+  CullableObjectHeader *header = (CullableObjectHeader *)ptr - 1;
+  switch (header->_source) {
+  case COS_arena:
+    break;
+
+  case COS_chain:
+    get_heap_chain()->deallocate(header, get_class_type());
+    break;
+
+  case COS_global:
+    ::operator delete(header);
+    break;
+  }
+}
+
 /**
  * Uses the indicated GeomMunger to transform the geom and/or its vertices.
  *
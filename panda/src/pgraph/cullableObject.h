@@ -25,6 +25,7 @@
 #include "cullTraverserData.h"
 #include "pStatCollector.h"
 #include "deletedChain.h"
+#include "cullArena.h"
 #include "graphicsStateGuardianBase.h"
 #include "sceneSetup.h"
 #include "lightMutex.h"
@@ -62,8 +63,13 @@ public:
   INLINE void draw_callback(GraphicsStateGuardianBase *gsg,
                             bool force, Thread *current_thread);
 
+  INLINE bool is_instance_of(const CullableObject &other) const;
+
 public:
-  ALLOC_DELETED_CHAIN(CullableObject);
+  void *operator new(size_t size);
+  INLINE void *operator new(size_t size, void *ptr);
+  void operator delete(void *ptr);
+  INLINE void operator delete(void *, void *);
 
   void output(std::ostream &out) const;
 
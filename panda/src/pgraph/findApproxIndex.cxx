@@ -0,0 +1,250 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file findApproxIndex.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "findApproxIndex.h"
+#include "config_pgraph.h"
+#include "nodePath.h"
+#include "nodePathCollection.h"
+#include "pandaNode.h"
+#include "pStatTimer.h"
+#include "string_utils.h"
+
+#include <algorithm>
+
+PStatCollector FindApproxIndex::_build_pcollector("*:Find index");
+
+/**
+ * Records every path below the indicated root node.
+ */
+FindApproxIndex::
+FindApproxIndex(PandaNode *root, Thread *current_thread) {
+  PStatTimer timer(_build_pcollector, current_thread);
+
+  // NodePath::find_matches() searches one level at a time, and it builds the
+  // list of entries for the next level by prepending each child it finds to
+  // the front of the list.  Each level is therefore considered in the
+  // reverse of the order in which the children of the previous level were
+  // visited.  We do the same, so that the entries end up in the order in
+  // which the search would return them.
+  int max_depth = NodePath::get_max_search_depth();
+
+  Entries level;
+  add_children(level, root, -1, 1, false, current_thread);
+
+  while (!level.empty() && level[0]._depth < max_depth) {
+    size_t level_begin = _entries.size();
+    _entries.insert(_entries.end(), level.rbegin(), level.rend());
+    size_t level_end = _entries.size();
+
+    level.clear();
+    for (size_t i = level_begin; i < level_end; ++i) {
+      const Entry &entry = _entries[i];
+      add_children(level, entry._node, (int)i, entry._depth + 1,
+                   entry._stashed, current_thread);
+    }
+  }
+
+  // Now index the entries by name and by tag.  Since we add them in order,
+  // each list of indices comes out sorted.
+  vector_string keys;
+  int num_entries = (int)_entries.size();
+  for (int i = 0; i < num_entries; ++i) {
+    PandaNode *node = _entries[i]._node;
+    _names[node->get_name()].push_back(i);
+
+    if (node->has_tags()) {
+      keys.clear();
+      node->get_tag_keys(keys);
+      for (const std::string &key : keys) {
+        _tags[key].push_back(i);
+      }
+    }
+  }
+}
+
+/**
+ * Appends an entry for each of the children of the indicated node, followed
+ * by each of its stashed children, to level.
+ */
+void FindApproxIndex::
+add_children(Entries &level, PandaNode *node, int parent, int depth,
+             bool stashed, Thread *current_thread) {
+  // Any change to this node from now on must be reported again.
+  node->clear_subgraph_stale();
+
+  Entry entry;
+  entry._parent = parent;
+  entry._depth = depth;
+
+  PandaNode::Children children = node->get_children(current_thread);
+  size_t num_children = children.get_num_children();
+  for (size_t i = 0; i < num_children; ++i) {
+    entry._node = children.get_child(i);
+    entry._stashed = stashed;
+    level.push_back(entry);
+  }
+
+  PandaNode::Stashed stashed_children = node->get_stashed(current_thread);
+  size_t num_stashed = stashed_children.get_num_stashed();
+  for (size_t i = 0; i < num_stashed; ++i) {
+    entry._node = stashed_children.get_stashed(i);
+    entry._stashed = true;
+    level.push_back(entry);
+  }
+}
+
+/**
+ * Returns true if the indicated path is one that find_matches() can answer,
+ * which is to say that it consists of "**" followed by a single component
+ * that matches a node by name or by tag.
+ */
+bool FindApproxIndex::
+is_indexable(const FindApproxPath &approx_path) {
+  if (approx_path._path.size() != 2) {
+    return false;
+  }
+
+  const FindApproxPath::Component &first = approx_path._path[0];
+  const FindApproxPath::Component &last = approx_path._path[1];
+  if (first._type != FindApproxPath::CT_match_many ||
+      first._flags != 0 || last._flags != 0) {
+    return false;
+  }
+
+  switch (last._type) {
+  case FindApproxPath::CT_match_name:
+  case FindApproxPath::CT_match_name_insensitive:
+  case FindApproxPath::CT_match_name_glob:
+  case FindApproxPath::CT_match_tag:
+  case FindApproxPath::CT_match_tag_value:
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+/**
+ * Adds the paths below root that match the indicated path to result, in the
+ * same order as NodePath::find_matches() would have found them.  The root
+ * must be the node that this index was built for, and the path must be one
+ * for which is_indexable() returned true.
+ */
+void FindApproxIndex::
+find_matches(NodePathCollection &result, const NodePath &root,
+             const FindApproxPath &approx_path, int max_matches) const {
+  nassertv(is_indexable(approx_path));
+  const FindApproxPath::Component &comp = approx_path._path[1];
+
+  Indices indices;
+  Lookup::const_iterator li;
+
+  switch (comp._type) {
+  case FindApproxPath::CT_match_name:
+    li = _names.find(comp._name);
+    if (li != _names.end()) {
+      add_matches(indices, (*li).second, approx_path, comp);
+    }
+    break;
+
+  case FindApproxPath::CT_match_name_insensitive:
+  case FindApproxPath::CT_match_name_glob:
+    // We have to check each distinct name, but there are usually far fewer
+    // of those than there are nodes.
+    for (li = _names.begin(); li != _names.end(); ++li) {
+      const std::string &name = (*li).first;
+      if (comp._type == FindApproxPath::CT_match_name_insensitive ?
+          cmp_nocase(comp._name, name) == 0 : comp._glob.matches(name)) {
+        add_matches(indices, (*li).second, approx_path, comp);
+      }
+    }
+    std::sort(indices.begin(), indices.end());
+    break;
+
+  case FindApproxPath::CT_match_tag:
+  case FindApproxPath::CT_match_tag_value:
+    li = _tags.find(comp._name);
+    if (li != _tags.end()) {
+      add_matches(indices, (*li).second, approx_path, comp);
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  for (int index : indices) {
+    result.add_path(make_node_path(root, index));
+    if (max_matches > 0 && result.get_num_paths() >= max_matches) {
+      return;
+    }
+  }
+}
+
+/**
+ * Appends to indices those of the entries listed in from that are still
+ * valid matches for the indicated component.
+ */
+void FindApproxIndex::
+add_matches(Indices &indices, const Indices &from,
+            const FindApproxPath &approx_path,
+            const FindApproxPath::Component &comp) const {
+  for (int index : from) {
+    if (is_entry_valid(index, approx_path, comp)) {
+      indices.push_back(index);
+    }
+  }
+}
+
+/**
+ * Returns true if the indicated entry should be returned as a match.  This
+ * rechecks the component against the node, since the name of a node may have
+ * been changed with PandaNode::set_name() without our knowledge, and applies
+ * the hidden and stashed rules of the path.
+ */
+bool FindApproxIndex::
+is_entry_valid(int index, const FindApproxPath &approx_path,
+               const FindApproxPath::Component &comp) const {
+  const Entry &entry = _entries[index];
+  if (entry._stashed && !approx_path.return_stashed()) {
+    return false;
+  }
+
+  if (!comp.matches(entry._node)) {
+    return false;
+  }
+
+  if (!approx_path.return_hidden()) {
+    // A hidden node anywhere along the path stops the search.
+    while (index >= 0) {
+      if (_entries[index]._node->is_overall_hidden()) {
+        return false;
+      }
+      index = _entries[index]._parent;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Returns the NodePath from root to the node of the indicated entry.
+ */
+NodePath FindApproxIndex::
+make_node_path(const NodePath &root, int index) const {
+  const Entry &entry = _entries[index];
+  if (entry._parent < 0) {
+    return NodePath(root, entry._node);
+  }
+  return NodePath(make_node_path(root, entry._parent), entry._node);
+}
@@ -0,0 +1,90 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file findApproxIndex.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef FINDAPPROXINDEX_H
+#define FINDAPPROXINDEX_H
+
+#include "pandabase.h"
+
+#include "findApproxPath.h"
+#include "referenceCount.h"
+#include "pandaNode.h"
+#include "pointerTo.h"
+#include "pvector.h"
+#include "pmap.h"
+#include "pStatCollector.h"
+
+class NodePath;
+class NodePathCollection;
+
+/**
+ * This class is local to this package only; it doesn't get exported.  It
+ * records the name and tags of every node in the subgraph below a particular
+ * node, along with the path by which each one is reached, so that a search
+ * for every node below the root with a particular name or tag can be answered
+ * by a lookup instead of by visiting every node.
+ *
+ * The index is a snapshot; it must be discarded whenever the subgraph
+ * changes.  It clears the subgraph-stale flag of each node it visits, so that
+ * the owning node's PandaNode::subgraph_changed() is called when this
+ * happens.
+ */
+class FindApproxIndex : public ReferenceCount {
+public:
+  FindApproxIndex(PandaNode *root, Thread *current_thread);
+
+  static bool is_indexable(const FindApproxPath &approx_path);
+  void find_matches(NodePathCollection &result, const NodePath &root,
+                    const FindApproxPath &approx_path,
+                    int max_matches) const;
+
+  INLINE size_t get_num_entries() const;
+
+private:
+  typedef pvector<int> Indices;
+
+  void add_matches(Indices &indices, const Indices &from,
+                   const FindApproxPath &approx_path,
+                   const FindApproxPath::Component &comp) const;
+  bool is_entry_valid(int index, const FindApproxPath &approx_path,
+                      const FindApproxPath::Component &comp) const;
+  NodePath make_node_path(const NodePath &root, int index) const;
+
+  // One of these is stored for each path to each node below the root.  The
+  // entries are stored in the order in which the breadth-first search in
+  // NodePath::find_matches() would reach them, so that the results come out
+  // in the same order.
+  class Entry {
+  public:
+    PT(PandaNode) _node;
+    int _parent;
+    int _depth;
+    bool _stashed;
+  };
+  typedef pvector<Entry> Entries;
+
+  static void add_children(Entries &level, PandaNode *node, int parent,
+                           int depth, bool stashed, Thread *current_thread);
+
+  Entries _entries;
+
+  typedef pmap<std::string, Indices> Lookup;
+  Lookup _names;
+  Lookup _tags;
+
+  static PStatCollector _build_pcollector;
+};
+
+#include "findApproxIndex.I"
+
+#endif
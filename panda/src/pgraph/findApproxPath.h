@@ -101,6 +101,7 @@ private:
   bool _case_insensitive;
 
 friend std::ostream &operator << (std::ostream &, FindApproxPath::ComponentType);
+friend class FindApproxIndex;
 friend INLINE std::ostream &operator << (std::ostream &, const FindApproxPath::Component &);
 };
 
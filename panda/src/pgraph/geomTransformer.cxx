@@ -46,7 +46,8 @@ TypeHandle GeomTransformer::NewCollectedData::_type_handle;
 GeomTransformer::
 GeomTransformer() :
   // The default value here comes from the Config file.
-  _max_collect_vertices(max_collect_vertices)
+  _max_collect_vertices(max_collect_vertices),
+  _num_threads(0)
 {
 }
 
@@ -55,7 +56,8 @@ GeomTransformer() :
  */
 GeomTransformer::
 GeomTransformer(const GeomTransformer &copy) :
-  _max_collect_vertices(copy._max_collect_vertices)
+  _max_collect_vertices(copy._max_collect_vertices),
+  _num_threads(copy._num_threads)
 {
 }
 
@@ -1092,16 +1094,32 @@ finish_collect(bool format_only) {
   int num_adjusted = 0;
 
   NewCollectedList::iterator nci;
-  for (nci = _new_collected_list.begin();
-       nci != _new_collected_list.end();
-       ++nci) {
-    NewCollectedData *ncd = (*nci);
-    if (format_only) {
-      num_adjusted += ncd->apply_format_only_changes();
-    } else {
-      num_adjusted += ncd->apply_collect_changes();
+  if (!format_only && _num_threads > 0 && _new_collected_list.size() > 1) {
+    // Each NewCollectedData has its own source Geoms, so they can all be
+    // built at once.
+    SceneGraphReducer::run_jobs(_num_threads, _new_collected_list.size(),
+                                &st_apply_collect_changes,
+                                &_new_collected_list);
+    for (nci = _new_collected_list.begin();
+         nci != _new_collected_list.end();
+         ++nci) {
+      NewCollectedData *ncd = (*nci);
+      num_adjusted += ncd->_num_adjusted;
+      delete ncd;
+    }
+
+  } else {
+    for (nci = _new_collected_list.begin();
+         nci != _new_collected_list.end();
+         ++nci) {
+      NewCollectedData *ncd = (*nci);
+      if (format_only) {
+        num_adjusted += ncd->apply_format_only_changes();
+      } else {
+        num_adjusted += ncd->apply_collect_changes();
+      }
+      delete ncd;
     }
-    delete ncd;
   }
 
   _new_collected_list.clear();
@@ -1111,6 +1129,17 @@ finish_collect(bool format_only) {
   return num_adjusted;
 }
 
+/**
+ * The job function that finish_collect() runs on the worker threads, which
+ * applies the nth NewCollectedData in the list.
+ */
+void GeomTransformer::
+st_apply_collect_changes(void *data, size_t n) {
+  NewCollectedList *list = (NewCollectedList *)data;
+  NewCollectedData *ncd = (*list)[n];
+  ncd->_num_adjusted = ncd->apply_collect_changes();
+}
+
 /**
  * Uses the indicated munger to premunge the given Geom to optimize it for
  * eventual rendering.  See SceneGraphReducer::premunge().
@@ -1144,6 +1173,7 @@ NewCollectedData(const GeomVertexData *source_data) {
   _vdata_name = source_data->get_name();
   _usage_hint = source_data->get_usage_hint();
   _num_vertices = 0;
+  _num_adjusted = 0;
 }
 
 /**
@@ -48,6 +48,9 @@ public:
   INLINE int get_max_collect_vertices() const;
   INLINE void set_max_collect_vertices(int max_collect_vertices);
 
+  INLINE int get_num_threads() const;
+  INLINE void set_num_threads(int num_threads);
+
   void register_vertices(Geom *geom, bool might_have_unused);
   void register_vertices(GeomNode *node, bool might_have_unused);
 
@@ -92,6 +95,7 @@ public:
 
 private:
   int _max_collect_vertices;
+  int _num_threads;
 
   typedef pvector<PT(Geom) > GeomList;
 
@@ -228,6 +232,10 @@ private:
     SourceGeoms _source_geoms;
     int _num_vertices;
 
+    // The result of apply_collect_changes(), when it is run on a worker
+    // thread.
+    int _num_adjusted;
+
   private:
     // These are used just during apply_changes().
     void append_vdata(const GeomVertexData *vdata, int vertex_offset);
@@ -251,6 +259,8 @@ private:
   private:
     static TypeHandle _type_handle;
   };
+  static void st_apply_collect_changes(void *data, size_t n);
+
   typedef pvector<NewCollectedData *> NewCollectedList;
   typedef pmap<NewCollectedKey, NewCollectedData *> NewCollectedMap;
   NewCollectedList _new_collected_list;
@@ -147,6 +147,10 @@ ns_load_model(const Filename &filename, const LoaderOptions &options) {
       node->add_child(panda_node);
     }
     node->set_fullpath(filename);
+
+    if (model_pool_copy_on_write) {
+      node->share_subgraph();
+    }
   }
 
   {
@@ -172,6 +176,11 @@ ns_load_model(const Filename &filename, const LoaderOptions &options) {
  */
 void ModelPool::
 ns_add_model(const Filename &filename, ModelRoot *model) {
+  if (model_pool_copy_on_write) {
+    // The copies made of this model from now on will share its nodes.
+    model->share_subgraph();
+  }
+
   LightMutexHolder holder(_lock);
   if (pgraph_cat.is_debug()) {
     pgraph_cat.debug()
@@ -199,6 +208,10 @@ ns_release_model(const Filename &filename) {
  */
 void ModelPool::
 ns_add_model(ModelRoot *model) {
+  if (model_pool_copy_on_write) {
+    model->share_subgraph();
+  }
+
   LightMutexHolder holder(_lock);
   // We blow away whatever model was there previously, if any.
   _models[model->get_fullpath()] = model;
@@ -12,9 +12,51 @@
  */
 
 #include "modelRoot.h"
+#include "nodePath.h"
+#include "lightMutexHolder.h"
 
 TypeHandle ModelRoot::_type_handle;
 
+/**
+ * Specifies whether this node keeps an index of the names and tags of the
+ * nodes below it.  When it does, a search with NodePath::find() or
+ * find_all_matches() that starts at this node, and that consists of "**"
+ * followed by a single name, name pattern or tag, is answered by looking it
+ * up in the index, rather than by visiting every node below it.  Other
+ * searches are unaffected.
+ *
+ * The index is built on the first such search, and discarded whenever nodes
+ * are added, removed or stashed anywhere below this node, or their tags are
+ * changed, or they are renamed.  A subgraph that is
+ * searched many times between changes will benefit the most.
+ *
+ * The initial value of this is taken from the model-root-find-index config
+ * variable.
+ */
+void ModelRoot::
+set_find_index(bool find_index) {
+  if (find_index == _find_index_enabled) {
+    return;
+  }
+
+  _find_index_enabled = find_index;
+  if (!find_index) {
+    invalidate_find_index();
+  }
+}
+
+/**
+ * Discards the find index, if it has been built, so that it will be rebuilt
+ * the next time it is needed.  This is done automatically whenever the
+ * subgraph changes.
+ */
+void ModelRoot::
+invalidate_find_index() {
+  LightMutexHolder holder(_find_index_lock);
+  _find_index.clear();
+  ++_find_index_seq;
+}
+
 
 /**
  * Returns a newly-allocated Node that is a shallow copy of this one.  It will
@@ -26,6 +68,57 @@ make_copy() const {
   return new ModelRoot(*this);
 }
 
+/**
+ * Searches for the nodes below this one that match the indicated path, using
+ * the find index.  root should be a NodePath to this node.  Returns true if
+ * this was done, or false if this node has no index, or the path is not one
+ * that the index can answer, in which case the caller must search the usual
+ * way.
+ */
+bool ModelRoot::
+find_matches(NodePathCollection &result, const NodePath &root,
+             const FindApproxPath &approx_path, int max_matches,
+             Thread *current_thread) {
+  if (!_find_index_enabled || !FindApproxIndex::is_indexable(approx_path)) {
+    return false;
+  }
+
+  PT(FindApproxIndex) index;
+  int seq;
+  {
+    LightMutexHolder holder(_find_index_lock);
+    index = _find_index;
+    seq = _find_index_seq;
+  }
+
+  if (index == nullptr) {
+    // We build the index without holding the lock, since another thread may
+    // be holding a node's lock while it waits to invalidate the index.  If
+    // the subgraph changed while we were building it, it is still good for
+    // this search, but we shouldn't keep it.
+    index = new FindApproxIndex(this, current_thread);
+
+    LightMutexHolder holder(_find_index_lock);
+    if (_find_index_seq == seq) {
+      _find_index = index;
+    }
+  }
+
+  index->find_matches(result, root, approx_path, max_matches);
+  return true;
+}
+
+/**
+ * Called when the name, tags or children of this node or of any node below it
+ * have changed.  Discards the find index.
+ */
+void ModelRoot::
+subgraph_changed() {
+  if (_find_index_enabled) {
+    invalidate_find_index();
+  }
+}
+
 /**
  * Tells the BamReader how to create objects of type ModelRoot.
  */
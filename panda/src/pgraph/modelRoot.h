@@ -17,6 +17,11 @@
 #include "pandabase.h"
 #include "referenceCount.h"
 #include "modelNode.h"
+#include "findApproxIndex.h"
+#include "lightMutex.h"
+#include "config_pgraph.h"
+
+class NodePathCollection;
 
 /**
  * A node of this type is created automatically at the root of each model file
@@ -50,17 +55,34 @@ PUBLISHED:
   void set_reference(ModelReference *ref);
   MAKE_PROPERTY(reference, get_reference, set_reference);
 
+  void set_find_index(bool find_index);
+  INLINE bool get_find_index() const;
+  void invalidate_find_index();
+  MAKE_PROPERTY(find_index, get_find_index, set_find_index);
+
 protected:
   INLINE ModelRoot(const ModelRoot &copy);
 
 public:
   virtual PandaNode *make_copy() const;
 
+  bool find_matches(NodePathCollection &result, const NodePath &root,
+                    const FindApproxPath &approx_path, int max_matches,
+                    Thread *current_thread);
+
+protected:
+  virtual void subgraph_changed();
+
 private:
   Filename _fullpath;
   time_t _timestamp;
   PT(ModelReference) _reference;
 
+  bool _find_index_enabled;
+  PT(FindApproxIndex) _find_index;
+  int _find_index_seq;
+  LightMutex _find_index_lock;
+
 public:
   static void register_with_read_factory();
   virtual void write_datagram(BamWriter *manager, Datagram &dg);
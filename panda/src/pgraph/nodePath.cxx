@@ -68,6 +68,7 @@
 #include "pStatCollector.h"
 #include "pStatTimer.h"
 #include "modelNode.h"
+#include "modelRoot.h"
 #include "bam.h"
 #include "bamWriter.h"
 #include "datagramBuffer.h"
@@ -394,8 +395,11 @@ reparent_to(const NodePath &other, int sort, Thread *current_thread) {
   nassertv_always(!is_empty());
   nassertv(other._error_type == ET_ok);
 
-  // Reparenting implicitly resets the delta vector.
-  node()->reset_prev_transform();
+  // Reparenting implicitly resets the delta vector.  Both ends must be
+  // unshared first, so that the other copies of a shared model keep their
+  // children where they were.
+  modify_node(current_thread)->reset_prev_transform(current_thread);
+  other.modify_node(current_thread);
 
   int pipeline_stage = current_thread->get_pipeline_stage();
   bool reparented = PandaNode::reparent(other._head, _head, sort, false,
@@ -416,7 +420,8 @@ stash_to(const NodePath &other, int sort, Thread *current_thread) {
   nassertv(other._error_type == ET_ok);
 
   // Reparenting implicitly resets the delta vector.
-  node()->reset_prev_transform();
+  modify_node(current_thread)->reset_prev_transform(current_thread);
+  other.modify_node(current_thread);
 
   int pipeline_stage = current_thread->get_pipeline_stage();
   bool reparented = PandaNode::reparent(other._head, _head, sort, true,
@@ -438,7 +443,7 @@ wrt_reparent_to(const NodePath &other, int sort, Thread *current_thread) {
 
   if (get_transform(current_thread) == get_prev_transform(current_thread)) {
     set_transform(get_transform(other, current_thread), current_thread);
-    node()->reset_prev_transform(current_thread);
+    modify_node(current_thread)->reset_prev_transform(current_thread);
   } else {
     set_transform(get_transform(other, current_thread), current_thread);
     set_prev_transform(get_prev_transform(other, current_thread), current_thread);
@@ -475,6 +480,7 @@ instance_to(const NodePath &other, int sort, Thread *current_thread) const {
   nassertr(other._error_type == ET_ok, NodePath::fail());
 
   NodePath new_instance;
+  other.modify_node(current_thread);
 
   // First, we'll attach to NULL, to guarantee we get a brand new instance.
   int pipeline_stage = current_thread->get_pipeline_stage();
@@ -564,6 +570,7 @@ attach_new_node(PandaNode *node, int sort, Thread *current_thread) const {
   nassertr(verify_complete(current_thread), NodePath::fail());
   nassertr(_error_type == ET_ok, NodePath::fail());
   nassertr(node != nullptr, NodePath::fail());
+  modify_node(current_thread);
 
   NodePath new_path(*this);
   int pipeline_stage = current_thread->get_pipeline_stage();
@@ -595,7 +602,7 @@ remove_node(Thread *current_thread) {
   // we have no nodes, maybe we were already removed.  In either case, quietly
   // do nothing except to ensure the NodePath is clear.
   if (!is_empty() && !is_singleton(current_thread)) {
-    node()->reset_prev_transform(current_thread);
+    modify_node(current_thread)->reset_prev_transform(current_thread);
     int pipeline_stage = current_thread->get_pipeline_stage();
     PandaNode::detach(_head, pipeline_stage, current_thread);
   }
@@ -630,8 +637,8 @@ remove_node(Thread *current_thread) {
 void NodePath::
 detach_node(Thread *current_thread) {
   nassertv(_error_type != ET_not_found);
-  if (!is_empty() && !is_singleton()) {
-    node()->reset_prev_transform();
+  if (!is_empty() && !is_singleton(current_thread)) {
+    modify_node(current_thread)->reset_prev_transform(current_thread);
     int pipeline_stage = current_thread->get_pipeline_stage();
     PandaNode::detach(_head, pipeline_stage, current_thread);
   }
@@ -923,7 +930,7 @@ void NodePath::
 set_pos(const LVecBase3 &pos) {
   nassertv_always(!is_empty());
   set_transform(get_transform()->set_pos(pos));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 void NodePath::
@@ -1190,7 +1197,7 @@ set_pos_hpr(const LVecBase3 &pos, const LVecBase3 &hpr) {
   transform = TransformState::make_pos_hpr_scale_shear
     (pos, hpr, transform->get_scale(), transform->get_shear());
   set_transform(transform);
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1204,7 +1211,7 @@ set_pos_quat(const LVecBase3 &pos, const LQuaternion &quat) {
   transform = TransformState::make_pos_quat_scale_shear
     (pos, quat, transform->get_scale(), transform->get_shear());
   set_transform(transform);
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1243,7 +1250,7 @@ set_pos_hpr_scale(const LVecBase3 &pos, const LVecBase3 &hpr,
   nassertv_always(!is_empty());
   set_transform(TransformState::make_pos_hpr_scale
                 (pos, hpr, scale));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1256,7 +1263,7 @@ set_pos_quat_scale(const LVecBase3 &pos, const LQuaternion &quat,
   nassertv_always(!is_empty());
   set_transform(TransformState::make_pos_quat_scale
                 (pos, quat, scale));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1269,7 +1276,7 @@ set_pos_hpr_scale_shear(const LVecBase3 &pos, const LVecBase3 &hpr,
   nassertv_always(!is_empty());
   set_transform(TransformState::make_pos_hpr_scale_shear
                 (pos, hpr, scale, shear));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1282,7 +1289,7 @@ set_pos_quat_scale_shear(const LVecBase3 &pos, const LQuaternion &quat,
   nassertv_always(!is_empty());
   set_transform(TransformState::make_pos_quat_scale_shear
                 (pos, quat, scale, shear));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1292,7 +1299,7 @@ void NodePath::
 set_mat(const LMatrix4 &mat) {
   nassertv_always(!is_empty());
   set_transform(TransformState::make_mat(mat));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1351,7 +1358,7 @@ set_pos(const NodePath &other, const LVecBase3 &pos) {
     // If we didn't have a componentwise transform already, never mind.
     set_transform(other, rel_transform->set_pos(pos));
   }
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 void NodePath::
@@ -1729,7 +1736,7 @@ set_pos_hpr(const NodePath &other, const LVecBase3 &pos,
     // If we didn't have a componentwise transform already, never mind.
     set_transform(other, TransformState::make_pos_hpr_scale_shear
                   (pos, hpr, rel_transform->get_scale(), rel_transform->get_shear()));
-    node()->reset_prev_transform();
+    modify_node()->reset_prev_transform();
   }
 }
 
@@ -1764,7 +1771,7 @@ set_pos_quat(const NodePath &other, const LVecBase3 &pos,
     // If we didn't have a componentwise transform already, never mind.
     set_transform(other, TransformState::make_pos_quat_scale_shear
                   (pos, quat, rel_transform->get_scale(), rel_transform->get_shear()));
-    node()->reset_prev_transform();
+    modify_node()->reset_prev_transform();
   }
 }
 
@@ -1814,7 +1821,7 @@ set_pos_hpr_scale(const NodePath &other,
   nassertv_always(!is_empty());
   set_transform(other, TransformState::make_pos_hpr_scale
                 (pos, hpr, scale));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1828,7 +1835,7 @@ set_pos_quat_scale(const NodePath &other,
   nassertv_always(!is_empty());
   set_transform(other, TransformState::make_pos_quat_scale
                 (pos, quat, scale));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1842,7 +1849,7 @@ set_pos_hpr_scale_shear(const NodePath &other,
   nassertv_always(!is_empty());
   set_transform(other, TransformState::make_pos_hpr_scale_shear
                 (pos, hpr, scale, shear));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1856,7 +1863,7 @@ set_pos_quat_scale_shear(const NodePath &other,
   nassertv_always(!is_empty());
   set_transform(other, TransformState::make_pos_quat_scale_shear
                 (pos, quat, scale, shear));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1881,7 +1888,7 @@ void NodePath::
 set_mat(const NodePath &other, const LMatrix4 &mat) {
   nassertv_always(!is_empty());
   set_transform(other, TransformState::make_mat(mat));
-  node()->reset_prev_transform();
+  modify_node()->reset_prev_transform();
 }
 
 /**
@@ -1962,7 +1969,7 @@ set_color(PN_stdfloat r, PN_stdfloat g, PN_stdfloat b, PN_stdfloat a,
 void NodePath::
 set_color(const LColor &color, int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(ColorAttrib::make_flat(color), priority);
+  modify_node()->set_attrib(ColorAttrib::make_flat(color), priority);
 }
 
 /**
@@ -1974,7 +1981,7 @@ set_color(const LColor &color, int priority) {
 void NodePath::
 set_color_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(ColorAttrib::make_vertex(), priority);
+  modify_node()->set_attrib(ColorAttrib::make_vertex(), priority);
 }
 
 /**
@@ -1985,7 +1992,7 @@ set_color_off(int priority) {
 void NodePath::
 clear_color() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(ColorAttrib::get_class_slot());
+  modify_node()->clear_attrib(ColorAttrib::get_class_slot());
 }
 
 /**
@@ -2039,7 +2046,7 @@ has_color_scale() const {
 void NodePath::
 clear_color_scale() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(ColorScaleAttrib::get_class_slot());
+  modify_node()->clear_attrib(ColorScaleAttrib::get_class_slot());
 }
 
 /**
@@ -2064,11 +2071,11 @@ compose_color_scale(const LVecBase4 &scale, int priority) {
                                prev_color_scale[1]*scale[1],
                                prev_color_scale[2]*scale[2],
                                prev_color_scale[3]*scale[3]);
-    node()->set_attrib(csa->set_scale(new_color_scale), priority);
+    modify_node()->set_attrib(csa->set_scale(new_color_scale), priority);
 
   } else {
     // Create a new ColorScaleAttrib for this node.
-    node()->set_attrib(ColorScaleAttrib::make(scale), priority);
+    modify_node()->set_attrib(ColorScaleAttrib::make(scale), priority);
   }
 }
 
@@ -2088,11 +2095,11 @@ set_color_scale(const LVecBase4 &scale, int priority) {
     const ColorScaleAttrib *csa = DCAST(ColorScaleAttrib, attrib);
 
     // Modify the existing ColorScaleAttrib to add the indicated colorScale.
-    node()->set_attrib(csa->set_scale(scale), priority);
+    modify_node()->set_attrib(csa->set_scale(scale), priority);
 
   } else {
     // Create a new ColorScaleAttrib for this node.
-    node()->set_attrib(ColorScaleAttrib::make(scale), priority);
+    modify_node()->set_attrib(ColorScaleAttrib::make(scale), priority);
   }
 }
 
@@ -2110,7 +2117,7 @@ set_color_scale(const LVecBase4 &scale, int priority) {
 void NodePath::
 set_color_scale_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(ColorScaleAttrib::make_off(), priority);
+  modify_node()->set_attrib(ColorScaleAttrib::make_off(), priority);
 }
 
 /**
@@ -2131,11 +2138,11 @@ set_alpha_scale(PN_stdfloat scale, int priority) {
 
     // Modify the existing ColorScaleAttrib to add the indicated colorScale.
     const LVecBase4 &sc = csa->get_scale();
-    node()->set_attrib(csa->set_scale(LVecBase4(sc[0], sc[1], sc[2], scale)), priority);
+    modify_node()->set_attrib(csa->set_scale(LVecBase4(sc[0], sc[1], sc[2], scale)), priority);
 
   } else {
     // Create a new ColorScaleAttrib for this node.
-    node()->set_attrib(ColorScaleAttrib::make(LVecBase4(1.0f, 1.0f, 1.0f, scale)), priority);
+    modify_node()->set_attrib(ColorScaleAttrib::make(LVecBase4(1.0f, 1.0f, 1.0f, scale)), priority);
   }
 }
 
@@ -2157,11 +2164,11 @@ set_all_color_scale(PN_stdfloat scale, int priority) {
 
     // Modify the existing ColorScaleAttrib to add the indicated colorScale.
     const LVecBase4 &sc = csa->get_scale();
-    node()->set_attrib(csa->set_scale(LVecBase4(scale, scale, scale, sc[3])), priority);
+    modify_node()->set_attrib(csa->set_scale(LVecBase4(scale, scale, scale, sc[3])), priority);
 
   } else {
     // Create a new ColorScaleAttrib for this node.
-    node()->set_attrib(ColorScaleAttrib::make(LVecBase4(scale, scale, scale, 1.0f)), priority);
+    modify_node()->set_attrib(ColorScaleAttrib::make(LVecBase4(scale, scale, scale, 1.0f)), priority);
   }
 }
 
@@ -2205,12 +2212,12 @@ set_light(const NodePath &light, int priority) {
         const LightAttrib *la = DCAST(LightAttrib, attrib);
 
         // Modify the existing LightAttrib to add the indicated light.
-        node()->set_attrib(la->add_on_light(light), priority);
+        modify_node()->set_attrib(la->add_on_light(light), priority);
 
       } else {
         // Create a new LightAttrib for this node.
         CPT(LightAttrib) la = DCAST(LightAttrib, LightAttrib::make());
-        node()->set_attrib(la->add_on_light(light), priority);
+        modify_node()->set_attrib(la->add_on_light(light), priority);
       }
       return;
 
@@ -2229,12 +2236,12 @@ set_light(const NodePath &light, int priority) {
         const PolylightEffect *ple = DCAST(PolylightEffect, effect);
 
         // Modify the existing PolylightEffect to add the indicated light.
-        node()->set_effect(ple->add_light(light));
+        modify_node()->set_effect(ple->add_light(light));
 
       } else {
         // Create a new PolylightEffect for this node.
         CPT(PolylightEffect) ple = DCAST(PolylightEffect, PolylightEffect::make());
-        node()->set_effect(ple->add_light(light));
+        modify_node()->set_effect(ple->add_light(light));
       }
       return;
     }
@@ -2254,8 +2261,8 @@ set_light(const NodePath &light, int priority) {
 void NodePath::
 set_light_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(LightAttrib::make_all_off(), priority);
-  node()->clear_effect(PolylightEffect::get_class_type());
+  modify_node()->set_attrib(LightAttrib::make_all_off(), priority);
+  modify_node()->clear_effect(PolylightEffect::get_class_type());
 }
 
 /**
@@ -2284,13 +2291,13 @@ set_light_off(const NodePath &light, int priority) {
         // Modify the existing LightAttrib to add the indicated light to the
         // "off" list.  This also, incidentally, removes it from the "on" list
         // if it is there.
-        node()->set_attrib(la->add_off_light(light), priority);
+        modify_node()->set_attrib(la->add_off_light(light), priority);
 
       } else {
         // Create a new LightAttrib for this node that turns off the indicated
         // light.
         CPT(LightAttrib) la = DCAST(LightAttrib, LightAttrib::make());
-        node()->set_attrib(la->add_off_light(light), priority);
+        modify_node()->set_attrib(la->add_off_light(light), priority);
       }
       return;
     }
@@ -2305,8 +2312,8 @@ set_light_off(const NodePath &light, int priority) {
 void NodePath::
 clear_light() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(LightAttrib::get_class_slot());
-  node()->clear_effect(PolylightEffect::get_class_type());
+  modify_node()->clear_attrib(LightAttrib::get_class_slot());
+  modify_node()->clear_effect(PolylightEffect::get_class_type());
 }
 
 /**
@@ -2328,11 +2335,11 @@ clear_light(const NodePath &light) {
         la = DCAST(LightAttrib, la->remove_off_light(light));
 
         if (la->is_identity()) {
-          node()->clear_attrib(LightAttrib::get_class_slot());
+          modify_node()->clear_attrib(LightAttrib::get_class_slot());
 
         } else {
           int priority = node()->get_state()->get_override(LightAttrib::get_class_slot());
-          node()->set_attrib(la, priority);
+          modify_node()->set_attrib(la, priority);
         }
       }
       return;
@@ -2343,7 +2350,7 @@ clear_light(const NodePath &light) {
       if (effect != nullptr) {
         CPT(PolylightEffect) ple = DCAST(PolylightEffect, effect);
         ple = DCAST(PolylightEffect, ple->remove_light(light));
-        node()->set_effect(ple);
+        modify_node()->set_effect(ple);
       }
       return;
     }
@@ -2449,12 +2456,12 @@ set_clip_plane(const NodePath &clip_plane, int priority) {
       const ClipPlaneAttrib *la = DCAST(ClipPlaneAttrib, attrib);
 
       // Modify the existing ClipPlaneAttrib to add the indicated clip_plane.
-      node()->set_attrib(la->add_on_plane(clip_plane), priority);
+      modify_node()->set_attrib(la->add_on_plane(clip_plane), priority);
 
     } else {
       // Create a new ClipPlaneAttrib for this node.
       CPT(ClipPlaneAttrib) la = DCAST(ClipPlaneAttrib, ClipPlaneAttrib::make());
-      node()->set_attrib(la->add_on_plane(clip_plane), priority);
+      modify_node()->set_attrib(la->add_on_plane(clip_plane), priority);
     }
     return;
   }
@@ -2474,7 +2481,7 @@ set_clip_plane(const NodePath &clip_plane, int priority) {
 void NodePath::
 set_clip_plane_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(ClipPlaneAttrib::make_all_off(), priority);
+  modify_node()->set_attrib(ClipPlaneAttrib::make_all_off(), priority);
 }
 
 /**
@@ -2499,13 +2506,13 @@ set_clip_plane_off(const NodePath &clip_plane, int priority) {
       // Modify the existing ClipPlaneAttrib to add the indicated clip_plane
       // to the "off" list.  This also, incidentally, removes it from the "on"
       // list if it is there.
-      node()->set_attrib(la->add_off_plane(clip_plane), priority);
+      modify_node()->set_attrib(la->add_off_plane(clip_plane), priority);
 
     } else {
       // Create a new ClipPlaneAttrib for this node that turns off the
       // indicated clip_plane.
       CPT(ClipPlaneAttrib) la = DCAST(ClipPlaneAttrib, ClipPlaneAttrib::make());
-      node()->set_attrib(la->add_off_plane(clip_plane), priority);
+      modify_node()->set_attrib(la->add_off_plane(clip_plane), priority);
     }
     return;
   }
@@ -2519,7 +2526,7 @@ set_clip_plane_off(const NodePath &clip_plane, int priority) {
 void NodePath::
 clear_clip_plane() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(ClipPlaneAttrib::get_class_slot());
+  modify_node()->clear_attrib(ClipPlaneAttrib::get_class_slot());
 }
 
 /**
@@ -2538,11 +2545,11 @@ clear_clip_plane(const NodePath &clip_plane) {
       la = DCAST(ClipPlaneAttrib, la->remove_off_plane(clip_plane));
 
       if (la->is_identity()) {
-        node()->clear_attrib(ClipPlaneAttrib::get_class_slot());
+        modify_node()->clear_attrib(ClipPlaneAttrib::get_class_slot());
 
       } else {
         int priority = node()->get_state()->get_override(ClipPlaneAttrib::get_class_slot());
-        node()->set_attrib(la, priority);
+        modify_node()->set_attrib(la, priority);
       }
     }
     return;
@@ -2628,12 +2635,12 @@ set_occluder(const NodePath &occluder) {
       const OccluderEffect *la = DCAST(OccluderEffect, effect);
 
       // Modify the existing OccluderEffect to add the indicated occluder.
-      node()->set_effect(la->add_on_occluder(occluder));
+      modify_node()->set_effect(la->add_on_occluder(occluder));
 
     } else {
       // Create a new OccluderEffect for this node.
       CPT(OccluderEffect) la = DCAST(OccluderEffect, OccluderEffect::make());
-      node()->set_effect(la->add_on_occluder(occluder));
+      modify_node()->set_effect(la->add_on_occluder(occluder));
     }
     return;
   }
@@ -2647,7 +2654,7 @@ set_occluder(const NodePath &occluder) {
 void NodePath::
 clear_occluder() {
   nassertv_always(!is_empty());
-  node()->clear_effect(OccluderEffect::get_class_type());
+  modify_node()->clear_effect(OccluderEffect::get_class_type());
 }
 
 /**
@@ -2665,10 +2672,10 @@ clear_occluder(const NodePath &occluder) {
       la = DCAST(OccluderEffect, la->remove_on_occluder(occluder));
 
       if (la->is_identity()) {
-        node()->clear_effect(OccluderEffect::get_class_type());
+        modify_node()->clear_effect(OccluderEffect::get_class_type());
 
       } else {
-        node()->set_effect(la);
+        modify_node()->set_effect(la);
       }
     }
     return;
@@ -2800,7 +2807,7 @@ has_scissor() const {
 void NodePath::
 set_bin(const string &bin_name, int draw_order, int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(CullBinAttrib::make(bin_name, draw_order), priority);
+  modify_node()->set_attrib(CullBinAttrib::make(bin_name, draw_order), priority);
 }
 
 /**
@@ -2810,7 +2817,7 @@ set_bin(const string &bin_name, int draw_order, int priority) {
 void NodePath::
 clear_bin() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(CullBinAttrib::get_class_slot());
+  modify_node()->clear_attrib(CullBinAttrib::get_class_slot());
 }
 
 /**
@@ -2892,12 +2899,12 @@ set_texture(TextureStage *stage, Texture *tex, int priority) {
     int sg_priority = node()->get_state()->get_override(TextureAttrib::get_class_slot());
 
     // Modify the existing TextureAttrib to add the indicated texture.
-    node()->set_attrib(tsa->add_on_stage(stage, tex, priority), sg_priority);
+    modify_node()->set_attrib(tsa->add_on_stage(stage, tex, priority), sg_priority);
 
   } else {
     // Create a new TextureAttrib for this node.
     CPT(TextureAttrib) tsa = DCAST(TextureAttrib, TextureAttrib::make());
-    node()->set_attrib(tsa->add_on_stage(stage, tex, priority));
+    modify_node()->set_attrib(tsa->add_on_stage(stage, tex, priority));
   }
 }
 
@@ -2942,12 +2949,12 @@ set_texture(TextureStage *stage, Texture *tex, const SamplerState &sampler, int
     int sg_priority = node()->get_state()->get_override(TextureAttrib::get_class_slot());
 
     // Modify the existing TextureAttrib to add the indicated texture.
-    node()->set_attrib(tsa->add_on_stage(stage, tex, sampler, priority), sg_priority);
+    modify_node()->set_attrib(tsa->add_on_stage(stage, tex, sampler, priority), sg_priority);
 
   } else {
     // Create a new TextureAttrib for this node.
     CPT(TextureAttrib) tsa = DCAST(TextureAttrib, TextureAttrib::make());
-    node()->set_attrib(tsa->add_on_stage(stage, tex, sampler, priority));
+    modify_node()->set_attrib(tsa->add_on_stage(stage, tex, sampler, priority));
   }
 }
 
@@ -2960,7 +2967,7 @@ set_texture(TextureStage *stage, Texture *tex, const SamplerState &sampler, int
 void NodePath::
 set_texture_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(TextureAttrib::make_all_off(), priority);
+  modify_node()->set_attrib(TextureAttrib::make_all_off(), priority);
 }
 
 /**
@@ -2982,13 +2989,13 @@ set_texture_off(TextureStage *stage, int priority) {
     // Modify the existing TextureAttrib to add the indicated texture to the
     // "off" list.  This also, incidentally, removes it from the "on" list if
     // it is there.
-    node()->set_attrib(tsa->add_off_stage(stage, priority), sg_priority);
+    modify_node()->set_attrib(tsa->add_off_stage(stage, priority), sg_priority);
 
   } else {
     // Create a new TextureAttrib for this node that turns off the indicated
     // stage.
     CPT(TextureAttrib) tsa = DCAST(TextureAttrib, TextureAttrib::make());
-    node()->set_attrib(tsa->add_off_stage(stage, priority));
+    modify_node()->set_attrib(tsa->add_off_stage(stage, priority));
   }
 }
 
@@ -3001,7 +3008,7 @@ set_texture_off(TextureStage *stage, int priority) {
 void NodePath::
 clear_texture() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(TextureAttrib::get_class_slot());
+  modify_node()->clear_attrib(TextureAttrib::get_class_slot());
 }
 
 /**
@@ -3019,11 +3026,11 @@ clear_texture(TextureStage *stage) {
     tsa = DCAST(TextureAttrib, tsa->remove_off_stage(stage));
 
     if (tsa->is_identity()) {
-      node()->clear_attrib(TextureAttrib::get_class_slot());
+      modify_node()->clear_attrib(TextureAttrib::get_class_slot());
 
     } else {
       int priority = node()->get_state()->get_override(TextureAttrib::get_class_slot());
-      node()->set_attrib(tsa, priority);
+      modify_node()->set_attrib(tsa, priority);
     }
   }
 }
@@ -3147,6 +3154,7 @@ replace_texture(Texture *tex, Texture *new_tex) {
   nassertv_always(!is_empty());
   nassertv(tex != nullptr);
   nassertv(new_tex != nullptr);
+  unshare_subgraph();
 
   r_replace_texture(node(), tex, new_tex);
 }
@@ -3196,11 +3204,11 @@ set_shader(const Shader *sha, int priority) {
     priority = max(priority,
                    node()->get_state()->get_override(ShaderAttrib::get_class_slot()));
     const ShaderAttrib *sa = DCAST(ShaderAttrib, attrib);
-    node()->set_attrib(sa->set_shader(sha, priority));
+    modify_node()->set_attrib(sa->set_shader(sha, priority));
   } else {
     // Create a new ShaderAttrib for this node.
     CPT(ShaderAttrib) sa = DCAST(ShaderAttrib, ShaderAttrib::make());
-    node()->set_attrib(sa->set_shader(sha, priority));
+    modify_node()->set_attrib(sa->set_shader(sha, priority));
   }
 }
 
@@ -3225,11 +3233,11 @@ set_shader_auto(int priority) {
     priority = max(priority,
                    node()->get_state()->get_override(ShaderAttrib::get_class_slot()));
     const ShaderAttrib *sa = DCAST(ShaderAttrib, attrib);
-    node()->set_attrib(sa->set_shader_auto(priority));
+    modify_node()->set_attrib(sa->set_shader_auto(priority));
   } else {
     // Create a new ShaderAttrib for this node.
     CPT(ShaderAttrib) sa = DCAST(ShaderAttrib, ShaderAttrib::make());
-    node()->set_attrib(sa->set_shader_auto(priority));
+    modify_node()->set_attrib(sa->set_shader_auto(priority));
   }
 }
 
@@ -3246,11 +3254,11 @@ set_shader_auto(BitMask32 shader_switch, int priority) {
     priority = max(priority,
                    node()->get_state()->get_override(ShaderAttrib::get_class_slot()));
     const ShaderAttrib *sa = DCAST(ShaderAttrib, attrib);
-    node()->set_attrib(sa->set_shader_auto(shader_switch, priority));
+    modify_node()->set_attrib(sa->set_shader_auto(shader_switch, priority));
   } else {
     // Create a new ShaderAttrib for this node.
     CPT(ShaderAttrib) sa = DCAST(ShaderAttrib, ShaderAttrib::make());
-    node()->set_attrib(sa->set_shader_auto(shader_switch, priority));
+    modify_node()->set_attrib(sa->set_shader_auto(shader_switch, priority));
   }
 }
 /**
@@ -3264,7 +3272,7 @@ clear_shader() {
     node()->get_attrib(ShaderAttrib::get_class_slot());
   if (attrib != nullptr) {
     const ShaderAttrib *sa = DCAST(ShaderAttrib, attrib);
-    node()->set_attrib(sa->clear_shader());
+    modify_node()->set_attrib(sa->clear_shader());
   }
 }
 
@@ -3290,7 +3298,7 @@ void NodePath::
 set_shader_input(const ShaderInput &inp) {
   nassertv_always(!is_empty());
 
-  PandaNode *pnode = node();
+  PandaNode *pnode = modify_node();
   const RenderAttrib *attrib =
     pnode->get_attrib(ShaderAttrib::get_class_slot());
   if (attrib != nullptr) {
@@ -3310,7 +3318,7 @@ void NodePath::
 set_shader_input(ShaderInput &&inp) {
   nassertv_always(!is_empty());
 
-  PandaNode *pnode = node();
+  PandaNode *pnode = modify_node();
   const RenderAttrib *attrib =
     pnode->get_attrib(ShaderAttrib::get_class_slot());
   if (attrib != nullptr) {
@@ -3369,7 +3377,7 @@ clear_shader_input(CPT_InternalName id) {
     node()->get_attrib(ShaderAttrib::get_class_slot());
   if (attrib != nullptr) {
     const ShaderAttrib *sa = DCAST(ShaderAttrib, attrib);
-    node()->set_attrib(sa->clear_shader_input(id));
+    modify_node()->set_attrib(sa->clear_shader_input(id));
   }
 }
 
@@ -3386,11 +3394,11 @@ set_instance_count(int instance_count) {
     node()->get_attrib(ShaderAttrib::get_class_slot());
   if (attrib != nullptr) {
     const ShaderAttrib *sa = DCAST(ShaderAttrib, attrib);
-    node()->set_attrib(sa->set_instance_count(instance_count));
+    modify_node()->set_attrib(sa->set_instance_count(instance_count));
   } else {
     // Create a new ShaderAttrib for this node.
     CPT(ShaderAttrib) sa = DCAST(ShaderAttrib, ShaderAttrib::make());
-    node()->set_attrib(sa->set_instance_count(instance_count));
+    modify_node()->set_attrib(sa->set_instance_count(instance_count));
   }
 }
 
@@ -3408,11 +3416,11 @@ set_tex_transform(TextureStage *stage, const TransformState *transform) {
     const TexMatrixAttrib *tma = DCAST(TexMatrixAttrib, attrib);
 
     // Modify the existing TexMatrixAttrib to add the indicated stage.
-    node()->set_attrib(tma->add_stage(stage, transform));
+    modify_node()->set_attrib(tma->add_stage(stage, transform));
 
   } else {
     // Create a new TexMatrixAttrib for this node.
-    node()->set_attrib(TexMatrixAttrib::make(stage, transform));
+    modify_node()->set_attrib(TexMatrixAttrib::make(stage, transform));
   }
 }
 
@@ -3422,7 +3430,7 @@ set_tex_transform(TextureStage *stage, const TransformState *transform) {
 void NodePath::
 clear_tex_transform() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(TexMatrixAttrib::get_class_slot());
+  modify_node()->clear_attrib(TexMatrixAttrib::get_class_slot());
 }
 
 /**
@@ -3439,10 +3447,10 @@ clear_tex_transform(TextureStage *stage) {
     tma = DCAST(TexMatrixAttrib, tma->remove_stage(stage));
 
     if (tma->is_empty()) {
-      node()->clear_attrib(TexMatrixAttrib::get_class_slot());
+      modify_node()->clear_attrib(TexMatrixAttrib::get_class_slot());
 
     } else {
-      node()->set_attrib(tma);
+      modify_node()->set_attrib(tma);
     }
   }
 }
@@ -3518,7 +3526,7 @@ set_tex_transform(const NodePath &other, TextureStage *stage, const TransformSta
 
   // And apply only the TexMatrixAttrib to the current node, leaving the
   // others unchanged.
-  node()->set_attrib(new_state->get_attrib(TexMatrixAttrib::get_class_slot()));
+  modify_node()->set_attrib(new_state->get_attrib(TexMatrixAttrib::get_class_slot()));
 }
 
 /**
@@ -3562,7 +3570,7 @@ set_tex_gen(TextureStage *stage, RenderAttrib::TexGenMode mode, int priority) {
     tga = DCAST(TexGenAttrib, TexGenAttrib::make());
   }
 
-  node()->set_attrib(tga->add_stage(stage, mode), priority);
+  modify_node()->set_attrib(tga->add_stage(stage, mode), priority);
 }
 
 /**
@@ -3589,7 +3597,7 @@ set_tex_gen(TextureStage *stage, RenderAttrib::TexGenMode mode,
     tga = DCAST(TexGenAttrib, TexGenAttrib::make());
   }
 
-  node()->set_attrib(tga->add_stage(stage, mode, constant_value), priority);
+  modify_node()->set_attrib(tga->add_stage(stage, mode, constant_value), priority);
 }
 
 /**
@@ -3599,7 +3607,7 @@ set_tex_gen(TextureStage *stage, RenderAttrib::TexGenMode mode,
 void NodePath::
 clear_tex_gen() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(TexGenAttrib::get_class_slot());
+  modify_node()->clear_attrib(TexGenAttrib::get_class_slot());
 }
 
 /**
@@ -3617,10 +3625,10 @@ clear_tex_gen(TextureStage *stage) {
     tga = DCAST(TexGenAttrib, tga->remove_stage(stage));
 
     if (tga->is_empty()) {
-      node()->clear_attrib(TexGenAttrib::get_class_slot());
+      modify_node()->clear_attrib(TexGenAttrib::get_class_slot());
 
     } else {
-      node()->set_attrib(tga);
+      modify_node()->set_attrib(tga);
     }
   }
 }
@@ -3689,7 +3697,7 @@ set_tex_projector(TextureStage *stage, const NodePath &from, const NodePath &to,
     tpe = DCAST(TexProjectorEffect, TexProjectorEffect::make());
   }
 
-  node()->set_effect(tpe->add_stage(stage, from, to, lens_index));
+  modify_node()->set_effect(tpe->add_stage(stage, from, to, lens_index));
 }
 
 /**
@@ -3706,10 +3714,10 @@ clear_tex_projector(TextureStage *stage) {
     tpe = DCAST(TexProjectorEffect, tpe->remove_stage(stage));
 
     if (tpe->is_empty()) {
-      node()->clear_effect(TexProjectorEffect::get_class_type());
+      modify_node()->clear_effect(TexProjectorEffect::get_class_type());
 
     } else {
-      node()->set_effect(tpe);
+      modify_node()->set_effect(tpe);
     }
   }
 }
@@ -3720,7 +3728,7 @@ clear_tex_projector(TextureStage *stage) {
 void NodePath::
 clear_tex_projector() {
   nassertv_always(!is_empty());
-  node()->clear_effect(TexProjectorEffect::get_class_type());
+  modify_node()->clear_effect(TexProjectorEffect::get_class_type());
 }
 
 /**
@@ -4025,6 +4033,7 @@ find_all_texture_stages() const {
 void NodePath::
 unify_texture_stages(TextureStage *stage) {
   nassertv_always(!is_empty());
+  unshare_subgraph();
   r_unify_texture_stages(node(), stage);
 }
 
@@ -4115,7 +4124,7 @@ void NodePath::
 set_material(Material *mat, int priority) {
   nassertv_always(!is_empty());
   nassertv(mat != nullptr);
-  node()->set_attrib(MaterialAttrib::make(mat), priority);
+  modify_node()->set_attrib(MaterialAttrib::make(mat), priority);
 }
 
 /**
@@ -4127,7 +4136,7 @@ set_material(Material *mat, int priority) {
 void NodePath::
 set_material_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(MaterialAttrib::make_off(), priority);
+  modify_node()->set_attrib(MaterialAttrib::make_off(), priority);
 }
 
 /**
@@ -4137,7 +4146,7 @@ set_material_off(int priority) {
 void NodePath::
 clear_material() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(MaterialAttrib::get_class_slot());
+  modify_node()->clear_attrib(MaterialAttrib::get_class_slot());
 }
 
 /**
@@ -4187,6 +4196,7 @@ replace_material(Material *mat, Material *new_mat) {
   nassertv_always(!is_empty());
   nassertv(mat != nullptr);
   nassertv(new_mat != nullptr);
+  unshare_subgraph();
 
   CPT(RenderAttrib) new_attrib = MaterialAttrib::make(new_mat);
   r_replace_material(node(), mat, (const MaterialAttrib *)new_attrib.p());
@@ -4199,7 +4209,7 @@ replace_material(Material *mat, Material *new_mat) {
 void NodePath::
 set_fog(Fog *fog, int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(FogAttrib::make(fog), priority);
+  modify_node()->set_attrib(FogAttrib::make(fog), priority);
 }
 
 /**
@@ -4211,7 +4221,7 @@ set_fog(Fog *fog, int priority) {
 void NodePath::
 set_fog_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(FogAttrib::make_off(), priority);
+  modify_node()->set_attrib(FogAttrib::make_off(), priority);
 }
 
 /**
@@ -4222,7 +4232,7 @@ set_fog_off(int priority) {
 void NodePath::
 clear_fog() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(FogAttrib::get_class_slot());
+  modify_node()->clear_attrib(FogAttrib::get_class_slot());
 }
 
 /**
@@ -4291,7 +4301,7 @@ set_render_mode_wireframe(int priority) {
   nassertv_always(!is_empty());
   const RenderModeAttrib *rma;
   node()->get_state()->get_attrib_def(rma);
-  node()->set_attrib(RenderModeAttrib::make(RenderModeAttrib::M_wireframe, rma->get_thickness(), rma->get_perspective()), priority);
+  modify_node()->set_attrib(RenderModeAttrib::make(RenderModeAttrib::M_wireframe, rma->get_thickness(), rma->get_perspective()), priority);
 }
 
 /**
@@ -4303,7 +4313,7 @@ set_render_mode_filled(int priority) {
   nassertv_always(!is_empty());
   const RenderModeAttrib *rma;
   node()->get_state()->get_attrib_def(rma);
-  node()->set_attrib(RenderModeAttrib::make(RenderModeAttrib::M_filled, rma->get_thickness(), rma->get_perspective()), priority);
+  modify_node()->set_attrib(RenderModeAttrib::make(RenderModeAttrib::M_filled, rma->get_thickness(), rma->get_perspective()), priority);
 }
 
 /**
@@ -4316,7 +4326,7 @@ set_render_mode_filled_wireframe(const LColor &wireframe_color, int priority) {
   nassertv_always(!is_empty());
   const RenderModeAttrib *rma;
   node()->get_state()->get_attrib_def(rma);
-  node()->set_attrib(RenderModeAttrib::make(RenderModeAttrib::M_filled_wireframe, rma->get_thickness(), rma->get_perspective(), wireframe_color), priority);
+  modify_node()->set_attrib(RenderModeAttrib::make(RenderModeAttrib::M_filled_wireframe, rma->get_thickness(), rma->get_perspective(), wireframe_color), priority);
 }
 
 /**
@@ -4334,7 +4344,7 @@ set_render_mode_perspective(bool perspective, int priority) {
   nassertv_always(!is_empty());
   const RenderModeAttrib *rma;
   node()->get_state()->get_attrib_def(rma);
-  node()->set_attrib(RenderModeAttrib::make(rma->get_mode(), rma->get_thickness(), perspective, rma->get_wireframe_color()), priority);
+  modify_node()->set_attrib(RenderModeAttrib::make(rma->get_mode(), rma->get_thickness(), perspective, rma->get_wireframe_color()), priority);
 }
 
 /**
@@ -4350,7 +4360,7 @@ set_render_mode_thickness(PN_stdfloat thickness, int priority) {
   nassertv_always(!is_empty());
   const RenderModeAttrib *rma;
   node()->get_state()->get_attrib_def(rma);
-  node()->set_attrib(RenderModeAttrib::make(rma->get_mode(), thickness, rma->get_perspective(), rma->get_wireframe_color()), priority);
+  modify_node()->set_attrib(RenderModeAttrib::make(rma->get_mode(), thickness, rma->get_perspective(), rma->get_wireframe_color()), priority);
 }
 
 /**
@@ -4361,7 +4371,7 @@ void NodePath::
 set_render_mode(RenderModeAttrib::Mode mode, PN_stdfloat thickness, int priority) {
   nassertv_always(!is_empty());
 
-  node()->set_attrib(RenderModeAttrib::make(mode, thickness), priority);
+  modify_node()->set_attrib(RenderModeAttrib::make(mode, thickness), priority);
 }
 
 /**
@@ -4371,7 +4381,7 @@ set_render_mode(RenderModeAttrib::Mode mode, PN_stdfloat thickness, int priority
 void NodePath::
 clear_render_mode() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(RenderModeAttrib::get_class_slot());
+  modify_node()->clear_attrib(RenderModeAttrib::get_class_slot());
 }
 
 /**
@@ -4450,7 +4460,7 @@ set_two_sided(bool two_sided, int priority) {
     CullFaceAttrib::M_cull_none :
     CullFaceAttrib::M_cull_clockwise;
 
-  node()->set_attrib(CullFaceAttrib::make(mode), priority);
+  modify_node()->set_attrib(CullFaceAttrib::make(mode), priority);
 }
 
 /**
@@ -4463,7 +4473,7 @@ set_two_sided(bool two_sided, int priority) {
 void NodePath::
 clear_two_sided() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(CullFaceAttrib::get_class_slot());
+  modify_node()->clear_attrib(CullFaceAttrib::get_class_slot());
 }
 
 /**
@@ -4511,7 +4521,7 @@ set_depth_test(bool depth_test, int priority) {
     DepthTestAttrib::M_less :
     DepthTestAttrib::M_none;
 
-  node()->set_attrib(DepthTestAttrib::make(mode), priority);
+  modify_node()->set_attrib(DepthTestAttrib::make(mode), priority);
 }
 
 /**
@@ -4521,7 +4531,7 @@ set_depth_test(bool depth_test, int priority) {
 void NodePath::
 clear_depth_test() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(DepthTestAttrib::get_class_slot());
+  modify_node()->clear_attrib(DepthTestAttrib::get_class_slot());
 }
 
 /**
@@ -4568,7 +4578,7 @@ set_depth_write(bool depth_write, int priority) {
     DepthWriteAttrib::M_on :
     DepthWriteAttrib::M_off;
 
-  node()->set_attrib(DepthWriteAttrib::make(mode), priority);
+  modify_node()->set_attrib(DepthWriteAttrib::make(mode), priority);
 }
 
 /**
@@ -4578,7 +4588,7 @@ set_depth_write(bool depth_write, int priority) {
 void NodePath::
 clear_depth_write() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(DepthWriteAttrib::get_class_slot());
+  modify_node()->clear_attrib(DepthWriteAttrib::get_class_slot());
 }
 
 /**
@@ -4624,7 +4634,7 @@ void NodePath::
 set_depth_offset(int bias, int priority) {
   nassertv_always(!is_empty());
 
-  node()->set_attrib(DepthOffsetAttrib::make(bias), priority);
+  modify_node()->set_attrib(DepthOffsetAttrib::make(bias), priority);
 }
 
 /**
@@ -4634,7 +4644,7 @@ set_depth_offset(int bias, int priority) {
 void NodePath::
 clear_depth_offset() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(DepthOffsetAttrib::get_class_slot());
+  modify_node()->clear_attrib(DepthOffsetAttrib::get_class_slot());
 }
 
 /**
@@ -4764,7 +4774,7 @@ set_billboard_axis(const NodePath &camera, PN_stdfloat offset) {
   CPT(RenderEffect) billboard = BillboardEffect::make
     (LVector3::up(), false, true,
      offset, camera, LPoint3(0.0f, 0.0f, 0.0f));
-  node()->set_effect(billboard);
+  modify_node()->set_effect(billboard);
 }
 
 /**
@@ -4778,7 +4788,7 @@ set_billboard_point_eye(const NodePath &camera, PN_stdfloat offset, bool fixed_d
   CPT(RenderEffect) billboard = BillboardEffect::make
     (LVector3::up(), true, false,
      offset, camera, LPoint3(0.0f, 0.0f, 0.0f), fixed_depth);
-  node()->set_effect(billboard);
+  modify_node()->set_effect(billboard);
 }
 
 /**
@@ -4792,7 +4802,7 @@ set_billboard_point_world(const NodePath &camera, PN_stdfloat offset) {
   CPT(RenderEffect) billboard = BillboardEffect::make
     (LVector3::up(), false, false,
      offset, camera, LPoint3(0.0f, 0.0f, 0.0f));
-  node()->set_effect(billboard);
+  modify_node()->set_effect(billboard);
 }
 
 /**
@@ -4801,7 +4811,7 @@ set_billboard_point_world(const NodePath &camera, PN_stdfloat offset) {
 void NodePath::
 clear_billboard() {
   nassertv_always(!is_empty());
-  node()->clear_effect(BillboardEffect::get_class_type());
+  modify_node()->clear_effect(BillboardEffect::get_class_type());
 }
 
 /**
@@ -4821,7 +4831,7 @@ has_billboard() const {
 void NodePath::
 set_compass(const NodePath &reference) {
   nassertv_always(!is_empty());
-  node()->set_effect(CompassEffect::make(reference));
+  modify_node()->set_effect(CompassEffect::make(reference));
 }
 
 /**
@@ -4830,7 +4840,7 @@ set_compass(const NodePath &reference) {
 void NodePath::
 clear_compass() {
   nassertv_always(!is_empty());
-  node()->clear_effect(CompassEffect::get_class_type());
+  modify_node()->clear_effect(CompassEffect::get_class_type());
 }
 
 /**
@@ -4851,7 +4861,7 @@ void NodePath::
 set_transparency(TransparencyAttrib::Mode mode, int priority) {
   nassertv_always(!is_empty());
 
-  node()->set_attrib(TransparencyAttrib::make(mode), priority);
+  modify_node()->set_attrib(TransparencyAttrib::make(mode), priority);
 }
 
 /**
@@ -4863,7 +4873,7 @@ set_transparency(TransparencyAttrib::Mode mode, int priority) {
 void NodePath::
 clear_transparency() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(TransparencyAttrib::get_class_slot());
+  modify_node()->clear_attrib(TransparencyAttrib::get_class_slot());
 }
 
 /**
@@ -4908,7 +4918,7 @@ void NodePath::
 set_logic_op(LogicOpAttrib::Operation op, int priority) {
   nassertv_always(!is_empty());
 
-  node()->set_attrib(LogicOpAttrib::make(op), priority);
+  modify_node()->set_attrib(LogicOpAttrib::make(op), priority);
 }
 
 /**
@@ -4919,7 +4929,7 @@ set_logic_op(LogicOpAttrib::Operation op, int priority) {
 void NodePath::
 clear_logic_op() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(LogicOpAttrib::get_class_slot());
+  modify_node()->clear_attrib(LogicOpAttrib::get_class_slot());
 }
 
 /**
@@ -4963,7 +4973,7 @@ void NodePath::
 set_antialias(unsigned short mode, int priority) {
   nassertv_always(!is_empty());
 
-  node()->set_attrib(AntialiasAttrib::make(mode), priority);
+  modify_node()->set_attrib(AntialiasAttrib::make(mode), priority);
 }
 
 /**
@@ -4973,7 +4983,7 @@ set_antialias(unsigned short mode, int priority) {
 void NodePath::
 clear_antialias() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(AntialiasAttrib::get_class_slot());
+  modify_node()->clear_attrib(AntialiasAttrib::get_class_slot());
 }
 
 /**
@@ -5023,7 +5033,7 @@ has_audio_volume() const {
 void NodePath::
 clear_audio_volume() {
   nassertv_always(!is_empty());
-  node()->clear_attrib(AudioVolumeAttrib::get_class_slot());
+  modify_node()->clear_attrib(AudioVolumeAttrib::get_class_slot());
 }
 
 /**
@@ -5041,11 +5051,11 @@ set_audio_volume(PN_stdfloat volume, int priority) {
     CPT(AudioVolumeAttrib) ava = DCAST(AudioVolumeAttrib, attrib);
 
     // Modify the existing AudioVolumeAttrib to add the indicated volume.
-    node()->set_attrib(ava->set_volume(volume), priority);
+    modify_node()->set_attrib(ava->set_volume(volume), priority);
 
   } else {
     // Create a new AudioVolumeAttrib for this node.
-    node()->set_attrib(AudioVolumeAttrib::make(volume), priority);
+    modify_node()->set_attrib(AudioVolumeAttrib::make(volume), priority);
   }
 }
 
@@ -5061,7 +5071,7 @@ set_audio_volume(PN_stdfloat volume, int priority) {
 void NodePath::
 set_audio_volume_off(int priority) {
   nassertv_always(!is_empty());
-  node()->set_attrib(AudioVolumeAttrib::make_off(), priority);
+  modify_node()->set_attrib(AudioVolumeAttrib::make_off(), priority);
 }
 
 /**
@@ -5138,6 +5148,7 @@ void NodePath::
 stash(int sort, Thread *current_thread) {
   nassertv_always(!is_singleton() && !is_empty());
   nassertv(verify_complete());
+  modify_node(current_thread);
 
   int pipeline_stage = current_thread->get_pipeline_stage();
   bool reparented = PandaNode::reparent(_head->get_next(pipeline_stage, current_thread),
@@ -5155,6 +5166,7 @@ void NodePath::
 unstash(int sort, Thread *current_thread) {
   nassertv_always(!is_singleton() && !is_empty());
   nassertv(verify_complete());
+  modify_node(current_thread);
 
   int pipeline_stage = current_thread->get_pipeline_stage();
   bool reparented = PandaNode::reparent(_head->get_next(pipeline_stage, current_thread),
@@ -5318,6 +5330,7 @@ verify_complete(Thread *current_thread) const {
 void NodePath::
 premunge_scene(GraphicsStateGuardianBase *gsg) {
   nassertv_always(!is_empty());
+  unshare_subgraph();
 
   CPT(RenderState) state = RenderState::make_empty();
   if (has_parent()) {
@@ -5354,7 +5367,7 @@ prepare_scene(GraphicsStateGuardianBase *gsg) {
 void NodePath::
 show_bounds() {
   nassertv_always(!is_empty());
-  node()->set_effect(ShowBoundsEffect::make(false));
+  modify_node()->set_effect(ShowBoundsEffect::make(false));
 }
 
 /**
@@ -5366,7 +5379,7 @@ show_bounds() {
 void NodePath::
 show_tight_bounds() {
   nassertv_always(!is_empty());
-  node()->set_effect(ShowBoundsEffect::make(true));
+  modify_node()->set_effect(ShowBoundsEffect::make(true));
 }
 
 /**
@@ -5375,7 +5388,7 @@ show_tight_bounds() {
 void NodePath::
 hide_bounds() {
   nassertv_always(!is_empty());
-  node()->clear_effect(ShowBoundsEffect::get_class_type());
+  modify_node()->clear_effect(ShowBoundsEffect::get_class_type());
 }
 
 /**
@@ -5509,6 +5522,7 @@ analyze() const {
 int NodePath::
 flatten_light() {
   nassertr_always(!is_empty(), 0);
+  unshare_subgraph();
   SceneGraphReducer gr;
   gr.apply_attribs(node());
 
@@ -5529,6 +5543,7 @@ flatten_light() {
 int NodePath::
 flatten_medium() {
   nassertr_always(!is_empty(), 0);
+  unshare_subgraph();
   SceneGraphReducer gr;
   gr.apply_attribs(node());
   int num_removed = gr.flatten(node(), 0);
@@ -5557,6 +5572,7 @@ flatten_medium() {
 int NodePath::
 flatten_strong() {
   nassertr_always(!is_empty(), 0);
+  unshare_subgraph();
   SceneGraphReducer gr;
   gr.apply_attribs(node());
   int num_removed = gr.flatten(node(), ~0);
@@ -5587,6 +5603,7 @@ flatten_strong() {
 void NodePath::
 apply_texture_colors() {
   nassertv_always(!is_empty());
+  unshare_subgraph();
   SceneGraphReducer gr;
   gr.apply_attribs(node(), SceneGraphReducer::TT_apply_texture_color | SceneGraphReducer::TT_tex_matrix | SceneGraphReducer::TT_other);
 }
@@ -5848,6 +5865,37 @@ find_common_ancestor(const NodePath &a, const NodePath &b,
   return ac;
 }
 
+/**
+ * The recursive implementation of modify_node().  Replaces each shared node
+ * along the path, from the topmost one down to the indicated component, with
+ * a private copy, and returns the node that the component now references.
+ * The top node of the path must not be shared, since there is no parent to
+ * replace it in.
+ */
+PandaNode *NodePath::
+r_unshare_path(NodePathComponent *comp, int pipeline_stage,
+               Thread *current_thread) {
+  PandaNode *node = comp->get_node();
+  if (!node->is_copy_on_write()) {
+    return node;
+  }
+
+  if (comp->is_top_node(pipeline_stage, current_thread)) {
+    // There is no parent in the path to unshare this node from, so any change
+    // would be seen by every copy of the model.  The path must start above
+    // the shared part of the graph, for instance at the root of the copy.
+    pgraph_cat.error()
+      << "Cannot modify shared node " << *node << " through a NodePath that "
+      << "begins at it; use a NodePath that begins above it.\n";
+    nassert_raise("shared node at top of NodePath");
+    return node;
+  }
+
+  NodePathComponent *next = comp->get_next(pipeline_stage, current_thread);
+  PandaNode *parent = r_unshare_path(next, pipeline_stage, current_thread);
+  return parent->unshare_child(node, current_thread);
+}
+
 /**
  * Recursively determines the net state changes to the indicated component
  * node from the root of the graph.
@@ -6005,6 +6053,17 @@ find_matches(NodePathCollection &result, FindApproxPath &approx_path,
     return;
   }
 
+  // If this is a ModelRoot that keeps an index of its subgraph, it may be
+  // able to answer the query without a search.
+  PandaNode *this_node = node();
+  if (this_node->is_of_type(ModelRoot::get_class_type())) {
+    ModelRoot *model_root = (ModelRoot *)this_node;
+    if (model_root->find_matches(result, *this, approx_path, max_matches,
+                                 Thread::get_current_thread())) {
+      return;
+    }
+  }
+
   // We start with just one entry on the level.
   FindApproxLevelEntry *level =
     new FindApproxLevelEntry(WorkingNodePath(*this), approx_path);
@@ -214,6 +214,7 @@ PUBLISHED:
   NodePath get_top(Thread *current_thread = Thread::get_current_thread()) const;
 
   INLINE PandaNode *node() const;
+  INLINE PandaNode *modify_node(Thread *current_thread = Thread::get_current_thread()) const;
 
   INLINE int get_key() const;
   INLINE size_t add_hash(size_t hash) const;
@@ -909,6 +910,7 @@ PUBLISHED:
   int flatten_strong();
   void apply_texture_colors();
   INLINE int clear_model_nodes();
+  INLINE void unshare_subgraph();
 
   INLINE void set_tag(const std::string &key, const std::string &value);
   INLINE std::string get_tag(const std::string &key) const;
@@ -957,6 +959,9 @@ private:
                        int &a_count, int &b_count,
                        Thread *current_thread);
 
+  static PandaNode *r_unshare_path(NodePathComponent *comp, int pipeline_stage,
+                                   Thread *current_thread);
+
   CPT(RenderState) r_get_net_state(NodePathComponent *comp,
                                    Thread *current_thread) const;
   CPT(RenderState) r_get_partial_state(NodePathComponent *comp, int n,
@@ -243,7 +243,7 @@ py_decode_NodePath_from_bam_stream_persist(PyObject *unpickler, vector_uchar dat
  */
 void Extension<NodePath>::
 set_shader_input(CPT_InternalName name, PyObject *value, int priority) {
-  PT(PandaNode) node = _this->node();
+  PT(PandaNode) node = _this->modify_node();
   CPT(RenderAttrib) prev_attrib = node->get_attrib(ShaderAttrib::get_class_slot());
   PT(ShaderAttrib) attrib;
   if (prev_attrib == nullptr) {
@@ -271,7 +271,7 @@ set_shader_inputs(PyObject *args, PyObject *kwargs) {
     return;
   }
 
-  PT(PandaNode) node = _this->node();
+  PT(PandaNode) node = _this->modify_node();
   CPT(RenderAttrib) prev_attrib = node->get_attrib(ShaderAttrib::get_class_slot());
   PT(ShaderAttrib) attrib;
   if (prev_attrib == nullptr) {
@@ -8,6 +8,7 @@
 #include "billboardEffect.cxx"
 #include "cacheStats.cxx"
 #include "camera.cxx"
+#include "cellVisibility.cxx"
 #include "clipPlaneAttrib.cxx"
 #include "colorAttrib.cxx"
 #include "colorBlendAttrib.cxx"
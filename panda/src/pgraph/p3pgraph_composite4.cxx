@@ -14,6 +14,7 @@
 #include "shaderAttrib.cxx"
 #include "shaderPool.cxx"
 #include "showBoundsEffect.cxx"
+#include "softwareOcclusionCuller.cxx"
 #include "stateMunger.cxx"
 #include "stencilAttrib.cxx"
 #include "texMatrixAttrib.cxx"
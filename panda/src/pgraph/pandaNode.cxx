@@ -41,6 +41,7 @@ TypeHandle PandaNode::BamReaderAuxDataDown::_type_handle;
 PandaNode::SceneRootFunc *PandaNode::_scene_root_func;
 
 PandaNodeChain PandaNode::_dirty_prev_transforms("_dirty_prev_transforms");
+AtomicAdjust::Integer PandaNode::_num_copy_on_write = 0;
 DrawMask PandaNode::_overall_bit = DrawMask::bit(31);
 
 PStatCollector PandaNode::_reset_prev_pcollector("App:Collisions:Reset");
@@ -76,7 +77,9 @@ PandaNode::
 PandaNode(const string &name) :
   Namable(name),
   _paths_lock("PandaNode::_paths_lock"),
-  _dirty_prev_transform(false)
+  _dirty_prev_transform(false),
+  _copy_on_write(false),
+  _subgraph_stale(1)
 {
   if (pgraph_cat.is_debug()) {
     pgraph_cat.debug()
@@ -104,6 +107,10 @@ PandaNode::
     do_clear_dirty_prev_transform();
   }
 
+  if (_copy_on_write) {
+    AtomicAdjust::dec(_num_copy_on_write);
+  }
+
   // We shouldn't have any parents left by the time we destruct, or there's a
   // refcount fault somewhere.
 
@@ -132,6 +139,8 @@ PandaNode(const PandaNode &copy) :
   Namable(copy),
   _paths_lock("PandaNode::_paths_lock"),
   _dirty_prev_transform(false),
+  _copy_on_write(false),
+  _subgraph_stale(1),
   _python_tag_data(copy._python_tag_data),
   _unexpected_change_flags(0)
 {
@@ -248,6 +257,17 @@ safe_to_flatten_below() const {
   return true;
 }
 
+/**
+ * Returns true if it is safe for share_subgraph() to share this node between
+ * all of the copies of a model, or false if each copy needs its own instance
+ * of this node and of everything below it, for instance because the node
+ * makes its own copy of its subgraph when it is copied.
+ */
+bool PandaNode::
+safe_to_share() const {
+  return true;
+}
+
 /**
  * Returns true if the node's name has extrinsic meaning and must be preserved
  * across a flatten operation, false otherwise.
@@ -304,6 +324,58 @@ void PandaNode::
 xform(const LMatrix4 &) {
 }
 
+/**
+ * If the indicated child of this node has been shared by share_subgraph(),
+ * replaces it with a private copy, so that it may be modified without
+ * affecting the other copies of the subgraph, and returns the copy.  The
+ * children of the new copy remain shared.  Otherwise, returns the child
+ * unchanged.
+ *
+ * NodePaths that reached the child through this node are updated in-place to
+ * reference the copy instead, so they remain attached to the scene graph.
+ *
+ * If this node is itself shared, nothing is changed, since any change to our
+ * list of children would be seen by all of the copies; the caller should
+ * unshare this node first.
+ */
+PandaNode *PandaNode::
+unshare_child(PandaNode *child_node, Thread *current_thread) {
+  if (_copy_on_write || !child_node->_copy_on_write) {
+    return child_node;
+  }
+  if (find_child(child_node, current_thread) < 0 &&
+      find_stashed(child_node, current_thread) < 0) {
+    // It isn't our child.
+    return child_node;
+  }
+
+  PT(PandaNode) copy = child_node->make_copy();
+  copy->copy_children(child_node, current_thread);
+
+  // Move the NodePathComponents that go through this node over to the copy,
+  // as replace_node() does, before replace_child() severs them.
+  int pipeline_stage = current_thread->get_pipeline_stage();
+  {
+    LightReMutexHolder holder1(child_node->_paths_lock);
+    LightReMutexHolder holder2(copy->_paths_lock);
+    Paths::iterator pi = child_node->_paths.begin();
+    while (pi != child_node->_paths.end()) {
+      NodePathComponent *comp = (*pi);
+      if (!comp->is_top_node(pipeline_stage, current_thread) &&
+          comp->get_next(pipeline_stage, current_thread)->get_node() == this) {
+        comp->_node = copy;
+        copy->_paths.insert(comp);
+        pi = child_node->_paths.erase(pi);
+      } else {
+        ++pi;
+      }
+    }
+  }
+
+  replace_child(child_node, copy, current_thread);
+  return copy;
+}
+
 /**
  * Collapses this PandaNode with the other PandaNode, if possible, and returns
  * a pointer to the combined PandaNode, or NULL if the two PandaNodes cannot
@@ -472,6 +544,28 @@ void PandaNode::
 add_for_draw(CullTraverser *, CullTraverserData &) {
 }
 
+/**
+ * Indicates that the name, the tags or the set of children of this node have
+ * changed.  subgraph_changed() is called on this node and on each of its
+ * ancestors, up to the first one that has already been told of a change
+ * since its last call to clear_subgraph_stale().
+ */
+void PandaNode::
+mark_subgraph_stale() {
+  if (AtomicAdjust::compare_and_exchange(_subgraph_stale, 0, 1) != 0) {
+    // The nodes above us have already been told.
+    return;
+  }
+
+  subgraph_changed();
+
+  Parents parents = get_parents();
+  size_t num_parents = parents.get_num_parents();
+  for (size_t i = 0; i < num_parents; ++i) {
+    parents.get_parent(i)->mark_subgraph_stale();
+  }
+}
+
 /**
  * Returns a newly-allocated PandaNode that is a shallow copy of this one.  It
  * will be a different pointer, but its internal data may or may not be shared
@@ -494,6 +588,15 @@ copy_subgraph(Thread *current_thread) const {
   return r_copy_subgraph(inst_map, current_thread);
 }
 
+/**
+ * Changes the name of the node.
+ */
+void PandaNode::
+set_name(const string &name) {
+  Namable::set_name(name);
+  mark_subgraph_stale();
+}
+
 /**
  * Returns the number of nodes at and below this level.
  */
@@ -552,6 +655,8 @@ add_child(PandaNode *child_node, int sort, Thread *current_thread) {
   force_bounds_stale();
 
   children_changed();
+
+  mark_subgraph_stale();
   child_node->parents_changed();
   mark_bam_modified();
   child_node->mark_bam_modified();
@@ -582,6 +687,8 @@ remove_child(int child_index, Thread *current_thread) {
   force_bounds_stale(pipeline_stage, current_thread);
 
   children_changed();
+
+  mark_subgraph_stale();
   child_node->parents_changed();
   mark_bam_modified();
   child_node->mark_bam_modified();
@@ -616,6 +723,7 @@ remove_child(PandaNode *child_node, Thread *current_thread) {
   if (any_removed) {
     // Call callback hooks.
     children_changed();
+    mark_subgraph_stale();
     child_node->parents_changed();
   }
 
@@ -661,6 +769,7 @@ replace_child(PandaNode *orig_child, PandaNode *new_child,
 
   if (any_replaced) {
     children_changed();
+    mark_subgraph_stale();
     orig_child->parents_changed();
     new_child->parents_changed();
   }
@@ -704,6 +813,8 @@ stash_child(int child_index, Thread *current_thread) {
   force_bounds_stale(pipeline_stage, current_thread);
 
   children_changed();
+
+  mark_subgraph_stale();
   child_node->parents_changed();
   mark_bam_modified();
   child_node->mark_bam_modified();
@@ -746,6 +857,7 @@ unstash_child(int stashed_index, Thread *current_thread) {
 
   force_bounds_stale();
   children_changed();
+  mark_subgraph_stale();
   child_node->parents_changed();
   mark_bam_modified();
   child_node->mark_bam_modified();
@@ -788,6 +900,7 @@ add_stashed(PandaNode *child_node, int sort, Thread *current_thread) {
 
   // Call callback hooks.
   children_changed();
+  mark_subgraph_stale();
   child_node->parents_changed();
   mark_bam_modified();
   child_node->mark_bam_modified();
@@ -816,6 +929,8 @@ remove_stashed(int child_index, Thread *current_thread) {
   force_bounds_stale(pipeline_stage, current_thread);
 
   children_changed();
+
+  mark_subgraph_stale();
   child_node->parents_changed();
   mark_bam_modified();
   child_node->mark_bam_modified();
@@ -862,6 +977,7 @@ remove_all_children(Thread *current_thread) {
 
   force_bounds_stale();
   children_changed();
+  mark_subgraph_stale();
   mark_bam_modified();
 }
 
@@ -929,6 +1045,63 @@ copy_children(PandaNode *other, Thread *current_thread) {
   }
 }
 
+/**
+ * Marks the nodes below this node to be shared, rather than copied, by
+ * copy_subgraph().  This is intended for models that are loaded once and then
+ * copied many times, such as those in the ModelPool; most of the nodes in
+ * such a model are never modified, and there is no need for each copy to
+ * have its own instance of them.
+ *
+ * A node can be shared only if it and all of the nodes below it may be, and
+ * if none of the nodes above it forbids it; see safe_to_share().  This node
+ * itself is never shared, so that each copy has a root of its own.
+ *
+ * A shared node is replaced by a private copy of itself as soon as it is
+ * modified through a NodePath; see NodePath::modify_node().  However, a
+ * shared node that is modified directly, through the PandaNode interface,
+ * will change in all of the copies at once.
+ *
+ * Returns the number of nodes that are newly shared.
+ */
+int PandaNode::
+share_subgraph(Thread *current_thread) {
+  int count = 0;
+  Children children = get_children(current_thread);
+  for (size_t i = 0; i < children.get_num_children(); ++i) {
+    children.get_child(i)->r_share_subgraph(count, current_thread);
+  }
+  Stashed stashed = get_stashed(current_thread);
+  for (size_t i = 0; i < stashed.get_num_stashed(); ++i) {
+    stashed.get_stashed(i)->r_share_subgraph(count, current_thread);
+  }
+  return count;
+}
+
+/**
+ * Replaces all of the shared nodes below this node with private copies, so
+ * that the subgraph may be freely modified without affecting any other copy
+ * of the model it was copied from.  This undoes the effect of
+ * share_subgraph() on this one copy.
+ *
+ * This node itself must not be shared; if it is, nothing is changed.
+ */
+void PandaNode::
+unshare_subgraph(Thread *current_thread) {
+  if (AtomicAdjust::get(_num_copy_on_write) == 0 || _copy_on_write) {
+    // Nothing anywhere is shared, or we can't change our children.
+    return;
+  }
+
+  Children children = get_children(current_thread);
+  for (size_t i = 0; i < children.get_num_children(); ++i) {
+    unshare_child(children.get_child(i), current_thread)->unshare_subgraph(current_thread);
+  }
+  Stashed stashed = get_stashed(current_thread);
+  for (size_t i = 0; i < stashed.get_num_stashed(); ++i) {
+    unshare_child(stashed.get_stashed(i), current_thread)->unshare_subgraph(current_thread);
+  }
+}
+
 /**
  * Adds the indicated render attribute to the scene graph on this node.  This
  * attribute will now apply to this node and everything below.  If there was
@@ -1214,6 +1387,7 @@ set_tag(const string &key, const string &value, Thread *current_thread) {
   }
   CLOSE_ITERATE_CURRENT_AND_UPSTREAM(_cycler);
   mark_bam_modified();
+  mark_subgraph_stale();
 }
 
 /**
@@ -1229,6 +1403,7 @@ clear_tag(const string &key, Thread *current_thread) {
   }
   CLOSE_ITERATE_CURRENT_AND_UPSTREAM(_cycler);
   mark_bam_modified();
+  mark_subgraph_stale();
 }
 
 /**
@@ -1256,6 +1431,7 @@ copy_tags(PandaNode *other) {
     cdataw->set_fancy_bit(FB_tag, !cdataw->_tag_data.is_empty());
   }
   CLOSE_ITERATE_CURRENT_AND_UPSTREAM(_cycler);
+  mark_subgraph_stale();
 
   // It's okay to copy the tags by pointer, because get_python_tags does a
   // copy-on-write.
@@ -1414,6 +1590,7 @@ copy_all_properties(PandaNode *other) {
     }
   }
   CLOSE_ITERATE_CURRENT_AND_UPSTREAM(_cycler);
+  mark_subgraph_stale();
 
   // It's okay to copy the tags by pointer, because get_python_tags does a
   // copy-on-write.
@@ -2364,6 +2541,17 @@ draw_mask_changed() {
   nassertv((_unexpected_change_flags & UC_draw_mask) == 0);
 }
 
+/**
+ * Called by mark_subgraph_stale() when the name, tags or children of this
+ * node or of any node below it have changed.  This is called only for the
+ * first such change after each call to clear_subgraph_stale(), and it just
+ * provides a hook so derived classes that keep information about their
+ * subgraph can discard it.
+ */
+void PandaNode::
+subgraph_changed() {
+}
+
 /**
  * This is the recursive implementation of copy_subgraph(). It returns a copy
  * of the entire subgraph rooted at this node.
@@ -2419,6 +2607,10 @@ r_copy_children(const PandaNode *from, PandaNode::InstanceMap &inst_map,
     ci = inst_map.find(source_child);
     if (ci != inst_map.end()) {
       dest_child = (*ci).second;
+    } else if (source_child->_copy_on_write) {
+      // This child is shared between all of the copies; see
+      // share_subgraph().  Rather than copying it, we make another instance.
+      dest_child = source_child;
     } else {
       dest_child = source_child->r_copy_subgraph(inst_map, current_thread);
       inst_map[source_child] = dest_child;
@@ -2658,6 +2850,47 @@ find_node_above(PandaNode *node) {
   return false;
 }
 
+/**
+ * The recursive implementation of share_subgraph().  Marks this node and the
+ * nodes below it as shared, if they may be.  Returns true if this node is
+ * shared, or false if it (or something below it) can't be.
+ */
+bool PandaNode::
+r_share_subgraph(int &count, Thread *current_thread) {
+  if (_copy_on_write) {
+    // Already shared, perhaps because we reached it by another instance.
+    return true;
+  }
+
+  if (!safe_to_share()) {
+    // Nothing at this level or below may be shared.
+    return false;
+  }
+
+  // We must visit every child, even after we know that we can't share this
+  // node, since some of the children might still be shared.
+  bool shareable = true;
+  Children children = get_children(current_thread);
+  for (size_t i = 0; i < children.get_num_children(); ++i) {
+    if (!children.get_child(i)->r_share_subgraph(count, current_thread)) {
+      shareable = false;
+    }
+  }
+  Stashed stashed = get_stashed(current_thread);
+  for (size_t i = 0; i < stashed.get_num_stashed(); ++i) {
+    if (!stashed.get_stashed(i)->r_share_subgraph(count, current_thread)) {
+      shareable = false;
+    }
+  }
+
+  if (shareable) {
+    _copy_on_write = true;
+    AtomicAdjust::inc(_num_copy_on_write);
+    ++count;
+  }
+  return shareable;
+}
+
 /**
  * Creates a new parent-child relationship, and returns the new
  * NodePathComponent.  If the child was already attached to the indicated
@@ -2772,6 +3005,7 @@ detach_one_stage(NodePathComponent *child, int pipeline_stage,
 
   parent_node->force_bounds_stale(pipeline_stage, current_thread);
   parent_node->children_changed();
+  parent_node->mark_subgraph_stale();
   parent_node->mark_bam_modified();
 }
 
@@ -2807,6 +3041,7 @@ reparent(NodePathComponent *new_parent, NodePathComponent *child, int sort,
 
   if (new_parent != nullptr) {
     new_parent->get_node()->children_changed();
+    new_parent->get_node()->mark_subgraph_stale();
     new_parent->get_node()->mark_bam_modified();
   }
   child->get_node()->parents_changed();
@@ -3507,7 +3742,9 @@ update_cached(bool update_bounds, int pipeline_stage, PandaNode::CDLockedStageRe
           if (child_volumes_i > 0) {
             const BoundingVolume **child_begin = &child_volumes[0];
             const BoundingVolume **child_end = child_begin + child_volumes_i;
-            ((BoundingVolume *)gbv)->around(child_begin, child_end);
+            if (!around_child_volumes(gbv, child_begin, child_end)) {
+              ((BoundingVolume *)gbv)->around(child_begin, child_end);
+            }
 
             // If we have a transform, apply it to the bounding volume we just
             // computed.
@@ -3556,6 +3793,56 @@ update_cached(bool update_bounds, int pipeline_stage, PandaNode::CDLockedStageRe
   } while (true);
 }
 
+/**
+ * Called by update_cached() to compute the external bounding volume from the
+ * volumes of the node and its children, in the common case where they are
+ * all spheres or all boxes of the same type as the result.  The volumes are
+ * gathered into a flat array and merged in one pass, without the double
+ * dispatch performed by BoundingVolume::around().
+ *
+ * Returns true if the volume was computed, or false if the volumes are not
+ * all of a suitable type, in which case the caller should use around().
+ */
+bool PandaNode::
+around_child_volumes(GeometricBoundingVolume *gbv,
+                     const BoundingVolume **first,
+                     const BoundingVolume **last) {
+  if (!batch_bounds_update) {
+    return false;
+  }
+  size_t num_volumes = last - first;
+
+  BoundingSphere *sphere = gbv->as_bounding_sphere() != nullptr
+                         ? (BoundingSphere *)gbv : nullptr;
+  if (sphere != nullptr) {
+    LVecBase4 *spheres = (LVecBase4 *)alloca(sizeof(LVecBase4) * num_volumes);
+    for (size_t i = 0; i < num_volumes; ++i) {
+      const BoundingSphere *child = first[i]->as_bounding_sphere();
+      if (child == nullptr || child->is_infinite()) {
+        return false;
+      }
+      spheres[i] = LVecBase4(child->get_center(), child->get_radius());
+    }
+    return sphere->around_sphere_array(spheres, num_volumes);
+  }
+
+  if (gbv->as_bounding_box() != nullptr) {
+    // A box around boxes is simply the box around all of their corners.
+    LPoint3 *points = (LPoint3 *)alloca(sizeof(LPoint3) * num_volumes * 2);
+    for (size_t i = 0; i < num_volumes; ++i) {
+      const BoundingBox *child = first[i]->as_bounding_box();
+      if (child == nullptr || child->is_infinite()) {
+        return false;
+      }
+      points[i * 2] = child->get_minq();
+      points[i * 2 + 1] = child->get_maxq();
+    }
+    return gbv->around(points, points + num_volumes * 2);
+  }
+
+  return false;
+}
+
 /**
  * This is used by the GraphicsEngine to hook in a pointer to the
  * scene_root_func(), the function to determine whether the node is an active
@@ -46,6 +46,7 @@
 #include "lightReMutex.h"
 #include "extension.h"
 #include "simpleHashMap.h"
+#include "atomicAdjust.h"
 
 class NodePathComponent;
 class CullTraverser;
@@ -55,6 +56,7 @@ class FactoryParams;
 class AccumulatedAttribs;
 class GeomTransformer;
 class GraphicsStateGuardianBase;
+class GeometricBoundingVolume;
 
 /**
  * A basic node of the scene graph or data graph.  This is the base class of
@@ -83,6 +85,7 @@ public:
   virtual bool safe_to_combine() const;
   virtual bool safe_to_combine_children() const;
   virtual bool safe_to_flatten_below() const;
+  virtual bool safe_to_share() const;
   virtual bool preserve_name() const;
   virtual int get_unsafe_to_apply_attribs() const;
   virtual void apply_attribs_to_vertices(const AccumulatedAttribs &attribs,
@@ -90,6 +93,9 @@ public:
                                          GeomTransformer &transformer);
   virtual void xform(const LMatrix4 &mat);
 
+  PandaNode *unshare_child(PandaNode *child_node,
+                           Thread *current_thread = Thread::get_current_thread());
+
   virtual CPT(TransformState)
     calc_tight_bounds(LPoint3 &min_point, LPoint3 &max_point,
                       bool &found_any,
@@ -105,10 +111,16 @@ public:
   virtual bool is_renderable() const;
   virtual void add_for_draw(CullTraverser *trav, CullTraverserData &data);
 
+  void mark_subgraph_stale();
+  INLINE void clear_subgraph_stale();
+
 PUBLISHED:
   virtual PandaNode *make_copy() const;
   PT(PandaNode) copy_subgraph(Thread *current_thread = Thread::get_current_thread()) const;
 
+  void set_name(const std::string &name);
+  MAKE_PROPERTY(name, get_name, set_name);
+
   EXTENSION(PT(PandaNode) __copy__() const);
   EXTENSION(PyObject *__deepcopy__(PyObject *self, PyObject *memo) const);
 
@@ -154,6 +166,15 @@ PUBLISHED:
   void steal_children(PandaNode *other, Thread *current_thread = Thread::get_current_thread());
   void copy_children(PandaNode *other, Thread *current_thread = Thread::get_current_thread());
 
+  int share_subgraph(Thread *current_thread = Thread::get_current_thread());
+  void unshare_subgraph(Thread *current_thread = Thread::get_current_thread());
+  INLINE bool is_copy_on_write() const;
+
+public:
+  INLINE static bool has_any_copy_on_write();
+
+PUBLISHED:
+
   void set_attrib(const RenderAttrib *attrib, int override = 0);
   INLINE CPT(RenderAttrib) get_attrib(TypeHandle type) const;
   INLINE CPT(RenderAttrib) get_attrib(int slot) const;
@@ -356,6 +377,7 @@ protected:
   virtual void transform_changed();
   virtual void state_changed();
   virtual void draw_mask_changed();
+  virtual void subgraph_changed();
 
   typedef pmap<PandaNode *, PandaNode *> InstanceMap;
   virtual PT(PandaNode) r_copy_subgraph(InstanceMap &inst_map,
@@ -408,6 +430,8 @@ private:
   void report_cycle(PandaNode *node);
   bool find_node_above(PandaNode *node);
 
+  bool r_share_subgraph(int &count, Thread *current_thread);
+
   // parent-child manipulation for NodePath support.  Don't try to call these
   // directly.
   static PT(NodePathComponent) attach(NodePathComponent *parent,
@@ -518,6 +542,18 @@ private:
   bool _dirty_prev_transform;
   static PandaNodeChain _dirty_prev_transforms;
 
+  // This is set by share_subgraph() on nodes that are to be shared, rather
+  // than copied, by copy_subgraph().  It is never cleared; a shared node is
+  // instead replaced by a private copy of itself when it is unshared.
+  bool _copy_on_write;
+  static AtomicAdjust::Integer _num_copy_on_write;
+
+  // This is set by mark_subgraph_stale() when the names, tags or children of
+  // this node or any node below it change, and cleared again by
+  // clear_subgraph_stale().  While it is set, further changes below this
+  // node need not be passed up to the parents again.
+  AtomicAdjust::Integer _subgraph_stale;
+
   // This is used to maintain a table of keyed data on each node, for the
   // user's purposes.
   typedef SimpleHashMap<std::string, std::string, string_hash> TagData;
@@ -690,6 +726,9 @@ private:
   int do_find_child(PandaNode *node, const Down *down) const;
   CDStageWriter update_cached(bool update_bounds, int pipeline_stage,
                               CDLockedStageReader &cdata);
+  static bool around_child_volumes(GeometricBoundingVolume *gbv,
+                                   const BoundingVolume **first,
+                                   const BoundingVolume **last);
 
   static DrawMask _overall_bit;
 
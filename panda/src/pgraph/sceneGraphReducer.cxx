@@ -22,6 +22,8 @@
 #include "geomNode.h"
 #include "config_gobj.h"
 #include "thread.h"
+#include "genericAsyncTask.h"
+#include "asyncTaskManager.h"
 
 PStatCollector SceneGraphReducer::_flatten_collector("*:Flatten:flatten");
 PStatCollector SceneGraphReducer::_apply_collector("*:Flatten:apply");
@@ -92,15 +94,20 @@ flatten(PandaNode *root, int combine_siblings_bits) {
   do {
     num_pass_nodes = 0;
 
-    // Get a copy of the children list, so we don't have to worry about self-
-    // modifications.
-    PandaNode::Children cr = root->get_children();
+    if (use_threads(root->get_num_children())) {
+      num_pass_nodes += flatten_children_parallel(root, combine_siblings_bits);
 
-    // Now visit each of the children in turn.
-    int num_children = cr.get_num_children();
-    for (int i = 0; i < num_children; i++) {
-      PT(PandaNode) child_node = cr.get_child(i);
-      num_pass_nodes += r_flatten(root, child_node, combine_siblings_bits);
+    } else {
+      // Get a copy of the children list, so we don't have to worry about
+      // self-modifications.
+      PandaNode::Children cr = root->get_children();
+
+      // Now visit each of the children in turn.
+      int num_children = cr.get_num_children();
+      for (int i = 0; i < num_children; i++) {
+        PT(PandaNode) child_node = cr.get_child(i);
+        num_pass_nodes += r_flatten(root, child_node, combine_siblings_bits);
+      }
     }
 
     if (combine_siblings_bits != 0 &&
@@ -183,6 +190,24 @@ unify(PandaNode *root, bool preserve_order) {
   if (_gsg != nullptr) {
     max_indices = std::min(max_indices, _gsg->get_max_vertices_per_primitive());
   }
+
+  if (_num_threads > 0) {
+    UnifyJobs jobs;
+    jobs._max_indices = max_indices;
+    jobs._preserve_order = preserve_order;
+    r_find_geom_nodes(root, jobs._geom_nodes);
+
+    // A GeomNode that is instanced would be unified more than once by
+    // r_unify(), which may give a different result than unifying it once.
+    pset<GeomNode *> unique_nodes;
+    unique_nodes.insert(jobs._geom_nodes.begin(), jobs._geom_nodes.end());
+    if (unique_nodes.size() == jobs._geom_nodes.size() &&
+        use_threads(jobs._geom_nodes.size())) {
+      run_jobs(_num_threads, jobs._geom_nodes.size(), &st_unify, &jobs);
+      return;
+    }
+  }
+
   r_unify(root, max_indices, preserve_order);
 }
 
@@ -381,6 +406,25 @@ r_flatten(PandaNode *grandparent_node, PandaNode *parent_node,
       << ")\n";
   }
 
+  int num_nodes = r_flatten_below(parent_node, combine_siblings_bits);
+
+  if (parent_node->safe_to_flatten_below()) {
+    if (flatten_only_child(grandparent_node, parent_node)) {
+      num_nodes++;
+    }
+    num_nodes += finish_flatten(parent_node, combine_siblings_bits);
+  }
+
+  return num_nodes;
+}
+
+/**
+ * The first part of r_flatten(), which flattens the nodes below the
+ * indicated node, without changing the node itself or anything above it.
+ * The combine_siblings_bits are updated for the rest of r_flatten().
+ */
+int SceneGraphReducer::
+r_flatten_below(PandaNode *parent_node, int &combine_siblings_bits) {
   if ((combine_siblings_bits & (CS_geom_node | CS_other | CS_recurse)) != 0) {
     // Unset CS_within_radius, since we're going to flatten everything anyway.
     // This avoids needlessly calculating the bounding volume.
@@ -395,98 +439,347 @@ r_flatten(PandaNode *grandparent_node, PandaNode *parent_node,
         << "Not traversing further; " << *parent_node
         << " doesn't allow flattening below itself.\n";
     }
+    return 0;
+  }
 
-  } else {
-    if ((combine_siblings_bits & CS_within_radius) != 0) {
-      CPT(BoundingVolume) bv = parent_node->get_bounds();
-      if (bv->is_of_type(BoundingSphere::get_class_type())) {
-        const BoundingSphere *bs = DCAST(BoundingSphere, bv);
+  if ((combine_siblings_bits & CS_within_radius) != 0) {
+    CPT(BoundingVolume) bv = parent_node->get_bounds();
+    if (bv->is_of_type(BoundingSphere::get_class_type())) {
+      const BoundingSphere *bs = DCAST(BoundingSphere, bv);
+      if (pgraph_cat.is_spam()) {
+        pgraph_cat.spam()
+          << "considering radius of " << *parent_node
+          << ": " << *bs << " vs. " << _combine_radius << "\n";
+      }
+      if (!bs->is_infinite() && (bs->is_empty() || bs->get_radius() <= _combine_radius)) {
+        // This node fits within the specified radius; from here on down, we
+        // will have CS_other set, instead of CS_within_radius.
         if (pgraph_cat.is_spam()) {
           pgraph_cat.spam()
-            << "considering radius of " << *parent_node
-            << ": " << *bs << " vs. " << _combine_radius << "\n";
-        }
-        if (!bs->is_infinite() && (bs->is_empty() || bs->get_radius() <= _combine_radius)) {
-          // This node fits within the specified radius; from here on down, we
-          // will have CS_other set, instead of CS_within_radius.
-          if (pgraph_cat.is_spam()) {
-            pgraph_cat.spam()
-              << "node fits within radius; flattening tighter.\n";
-          }
-          combine_siblings_bits &= ~CS_within_radius;
-          combine_siblings_bits |= (CS_geom_node | CS_other | CS_recurse);
+            << "node fits within radius; flattening tighter.\n";
         }
+        combine_siblings_bits &= ~CS_within_radius;
+        combine_siblings_bits |= (CS_geom_node | CS_other | CS_recurse);
       }
     }
+  }
 
-    // First, recurse on each of the children.
-    {
-      PandaNode::Children cr = parent_node->get_children();
-      int num_children = cr.get_num_children();
-      for (int i = 0; i < num_children; i++) {
-        PT(PandaNode) child_node = cr.get_child(i);
-        num_nodes += r_flatten(parent_node, child_node, combine_siblings_bits);
-      }
+  // First, recurse on each of the children.
+  {
+    PandaNode::Children cr = parent_node->get_children();
+    int num_children = cr.get_num_children();
+    for (int i = 0; i < num_children; i++) {
+      PT(PandaNode) child_node = cr.get_child(i);
+      num_nodes += r_flatten(parent_node, child_node, combine_siblings_bits);
     }
+  }
 
-    // Now that the above loop has removed some children, the child list saved
-    // above is no longer accurate, so hereafter we must ask the node for its
-    // real child list.
+  // Now that the above loop has removed some children, the child list saved
+  // above is no longer accurate, so hereafter we must ask the node for its
+  // real child list.
+
+  // If we have CS_recurse set, then we flatten siblings before trying to
+  // flatten children.  Otherwise, we flatten children first, and then
+  // flatten siblings, which avoids overly enthusiastic flattening.
+  if ((combine_siblings_bits & CS_recurse) != 0 &&
+      parent_node->get_num_children() >= 2 &&
+      parent_node->safe_to_combine_children()) {
+    num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
+  }
 
-    // If we have CS_recurse set, then we flatten siblings before trying to
-    // flatten children.  Otherwise, we flatten children first, and then
-    // flatten siblings, which avoids overly enthusiastic flattening.
-    if ((combine_siblings_bits & CS_recurse) != 0 &&
-        parent_node->get_num_children() >= 2 &&
-        parent_node->safe_to_combine_children()) {
-      num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
-    }
+  return num_nodes;
+}
+
+/**
+ * The second part of r_flatten().  If the indicated node now has exactly one
+ * child, considers collapsing the two of them together, leaving the result
+ * attached to the grandparent.  Returns true if the nodes were collapsed.
+ *
+ * This is the only part of r_flatten() that changes the grandparent.
+ */
+bool SceneGraphReducer::
+flatten_only_child(PandaNode *grandparent_node, PandaNode *parent_node) {
+  if (parent_node->get_num_children() != 1) {
+    return false;
+  }
 
-    if (parent_node->get_num_children() == 1) {
-      // If we now have exactly one child, consider flattening the node out.
-      PT(PandaNode) child_node = parent_node->get_child(0);
-      int child_sort = parent_node->get_child_sort(0);
+  PT(PandaNode) child_node = parent_node->get_child(0);
+  int child_sort = parent_node->get_child_sort(0);
 
-      if (consider_child(grandparent_node, parent_node, child_node)) {
-        // Ok, do it.
-        parent_node->remove_child(child_node);
+  if (!consider_child(grandparent_node, parent_node, child_node)) {
+    return false;
+  }
 
-        if (do_flatten_child(grandparent_node, parent_node, child_node)) {
-          // Done!
-          num_nodes++;
-        } else {
-          // Chicken out.
-          parent_node->add_child(child_node, child_sort);
-        }
+  // Ok, do it.
+  parent_node->remove_child(child_node);
+
+  if (do_flatten_child(grandparent_node, parent_node, child_node)) {
+    // Done!
+    return true;
+  }
+
+  // Chicken out.
+  parent_node->add_child(child_node, child_sort);
+  return false;
+}
+
+/**
+ * The last part of r_flatten(), which combines the remaining children of the
+ * indicated node, if they may be combined, and removes any that are now
+ * empty.
+ */
+int SceneGraphReducer::
+finish_flatten(PandaNode *parent_node, int combine_siblings_bits) {
+  int num_nodes = 0;
+
+  if ((combine_siblings_bits & CS_recurse) == 0 &&
+      (combine_siblings_bits & ~CS_recurse) != 0 &&
+      parent_node->get_num_children() >= 2 &&
+      parent_node->safe_to_combine_children()) {
+    num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
+  }
+
+  // Finally, if any of our remaining children are plain PandaNodes with no
+  // children, just remove them.
+  if (parent_node->safe_to_combine_children()) {
+    for (int i = parent_node->get_num_children() - 1; i >= 0; --i) {
+      PandaNode *child_node = parent_node->get_child(i);
+      if (child_node->is_exact_type(PandaNode::get_class_type()) &&
+          child_node->get_num_children() == 0 &&
+          child_node->get_transform()->is_identity() &&
+          child_node->get_effects()->is_empty()) {
+        parent_node->remove_child(child_node);
+        ++num_nodes;
       }
     }
+  }
 
-    if ((combine_siblings_bits & CS_recurse) == 0 &&
-        (combine_siblings_bits & ~CS_recurse) != 0 &&
-        parent_node->get_num_children() >= 2 &&
-        parent_node->safe_to_combine_children()) {
-      num_nodes += flatten_siblings(parent_node, combine_siblings_bits);
-    }
-
-    // Finally, if any of our remaining children are plain PandaNodes with no
-    // children, just remove them.
-    if (parent_node->safe_to_combine_children()) {
-      for (int i = parent_node->get_num_children() - 1; i >= 0; --i) {
-        PandaNode *child_node = parent_node->get_child(i);
-        if (child_node->is_exact_type(PandaNode::get_class_type()) &&
-            child_node->get_num_children() == 0 &&
-            child_node->get_transform()->is_identity() &&
-            child_node->get_effects()->is_empty()) {
-          parent_node->remove_child(child_node);
-          ++num_nodes;
-        }
+  return num_nodes;
+}
+
+/**
+ * Performs one pass of flatten() over the children of the root node, the way
+ * the serial loop in flatten() would, but with the subgraphs below the
+ * children flattened on the worker threads.
+ *
+ * The first and last parts of r_flatten() only change the nodes below each
+ * child, so these are run in parallel for each child whose subgraph is not
+ * instanced anywhere else.  Collapsing a child into the root changes the
+ * root, so that part is done on this thread, in order.  The instanced
+ * subgraphs are flattened on this thread as well, in their original order,
+ * since the order in which they are visited makes a difference.
+ */
+int SceneGraphReducer::
+flatten_children_parallel(PandaNode *root, int combine_siblings_bits) {
+  PandaNode::Children cr = root->get_children();
+  int num_children = cr.get_num_children();
+
+  FlattenJobs jobs(num_children);
+  pvector<FlattenJob *> independent;
+  independent.reserve(num_children);
+  for (int i = 0; i < num_children; ++i) {
+    FlattenJob &job = jobs[i];
+    job._reducer = this;
+    job._node = cr.get_child(i);
+    job._combine_siblings_bits = combine_siblings_bits;
+    job._independent = r_is_independent(job._node);
+    job._flatten_below = job._node->safe_to_flatten_below();
+    job._num_nodes = 0;
+    if (job._independent) {
+      independent.push_back(&job);
+    }
+  }
+
+  // Flattening a node marks its bounds stale, all the way to the top of the
+  // scene graph.  If we do this first, the worker threads will stop at the
+  // root, and won't try to modify it (or anything above it) at the same time.
+  root->mark_bounds_stale();
+
+  run_jobs(_num_threads, independent.size(), &st_flatten_below, &independent);
+
+  // Now collapse the children into the root, in order.
+  int num_nodes = 0;
+  pvector<FlattenJob *> remaining;
+  remaining.reserve(independent.size());
+  for (FlattenJob &job : jobs) {
+    if (!job._independent) {
+      num_nodes += r_flatten(root, job._node, combine_siblings_bits);
+
+    } else if (job._flatten_below) {
+      if (flatten_only_child(root, job._node)) {
+        num_nodes++;
+      } else {
+        remaining.push_back(&job);
       }
     }
   }
 
+  run_jobs(_num_threads, remaining.size(), &st_finish_flatten, &remaining);
+
+  for (const FlattenJob &job : jobs) {
+    num_nodes += job._num_nodes;
+  }
   return num_nodes;
 }
 
+/**
+ * Returns true if the indicated node, and every node below it, has only one
+ * parent, so that the subgraph can be flattened without affecting any other
+ * part of the scene graph.
+ */
+bool SceneGraphReducer::
+r_is_independent(PandaNode *node) {
+  if (node->get_num_parents() != 1) {
+    return false;
+  }
+
+  PandaNode::Children cr = node->get_children();
+  int num_children = cr.get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    if (!r_is_independent(cr.get_child(i))) {
+      return false;
+    }
+  }
+
+  PandaNode::Stashed sr = node->get_stashed();
+  int num_stashed = sr.get_num_stashed();
+  for (int i = 0; i < num_stashed; ++i) {
+    if (!r_is_independent(sr.get_stashed(i))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * Calls func(data, n) for each n from 0 to num_jobs - 1, spread across up to
+ * num_threads worker threads on the "flatten" task chain, as well as the
+ * calling thread.  Does not return until all of the jobs have finished.  The
+ * jobs may be run in any order, so each one must only touch its own part of
+ * the data.
+ */
+void SceneGraphReducer::
+run_jobs(int num_threads, size_t num_jobs, JobFunc *func, void *data) {
+  if (num_jobs == 0) {
+    return;
+  }
+
+  JobQueue queue;
+  queue._func = func;
+  queue._data = data;
+  queue._num_jobs = (AtomicAdjust::Integer)num_jobs;
+  queue._next_job = 0;
+
+  int num_tasks = (int)std::min((size_t)std::max(num_threads, 0), num_jobs - 1);
+  if (num_tasks > 0 && Thread::is_threading_supported()) {
+    // If we are already running on the flatten chain, such as when a flatten
+    // is started from within one of these jobs, don't wait on tasks that may
+    // never get a thread.
+    TypedReferenceCount *current_task = Thread::get_current_thread()->get_current_task();
+    if (current_task != nullptr &&
+        current_task->is_of_type(AsyncTask::get_class_type()) &&
+        DCAST(AsyncTask, current_task)->get_task_chain() == "flatten") {
+      num_tasks = 0;
+    }
+  } else {
+    num_tasks = 0;
+  }
+
+  pvector<PT(AsyncTask)> tasks;
+  if (num_tasks > 0) {
+    AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+    AsyncTaskChain *chain = task_mgr->make_task_chain("flatten");
+    if (chain->get_num_threads() < num_tasks) {
+      chain->set_num_threads(num_tasks);
+    }
+
+    tasks.reserve(num_tasks);
+    for (int i = 0; i < num_tasks; ++i) {
+      PT(GenericAsyncTask) task =
+        new GenericAsyncTask("flatten", &st_run_jobs, &queue);
+      task->set_task_chain("flatten");
+      task_mgr->add(task);
+      tasks.push_back(task.p());
+    }
+  }
+
+  // This thread works through the queue too, so there is always progress
+  // even if the worker threads are busy.
+  st_run_jobs(nullptr, &queue);
+
+  for (AsyncTask *task : tasks) {
+    task->wait();
+  }
+}
+
+/**
+ * The task function for run_jobs().  Runs jobs from the queue until there
+ * are none left.
+ */
+AsyncTask::DoneStatus SceneGraphReducer::
+st_run_jobs(GenericAsyncTask *, void *data) {
+  JobQueue *queue = (JobQueue *)data;
+
+  AtomicAdjust::Integer n = AtomicAdjust::add(queue->_next_job, 1) - 1;
+  while (n < queue->_num_jobs) {
+    (*queue->_func)(queue->_data, (size_t)n);
+    n = AtomicAdjust::add(queue->_next_job, 1) - 1;
+  }
+  return AsyncTask::DS_done;
+}
+
+/**
+ * A job for run_jobs(), which flattens the nodes below one of the children
+ * of the root.  The data is a pvector of FlattenJob pointers.
+ */
+void SceneGraphReducer::
+st_flatten_below(void *data, size_t n) {
+  FlattenJob *job = (*(pvector<FlattenJob *> *)data)[n];
+  job->_num_nodes += job->_reducer->r_flatten_below(job->_node, job->_combine_siblings_bits);
+}
+
+/**
+ * A job for run_jobs(), which finishes flattening one of the children of the
+ * root that could not be collapsed into the root.  The data is a pvector of
+ * FlattenJob pointers.
+ */
+void SceneGraphReducer::
+st_finish_flatten(void *data, size_t n) {
+  FlattenJob *job = (*(pvector<FlattenJob *> *)data)[n];
+  job->_num_nodes += job->_reducer->finish_flatten(job->_node, job->_combine_siblings_bits);
+}
+
+/**
+ * A job for run_jobs(), which collects the vertices of one CollectGroup,
+ * using a copy of the original GeomTransformer.  The data is a CollectJobs.
+ */
+void SceneGraphReducer::
+st_collect_group(void *data, size_t n) {
+  CollectJobs *jobs = (CollectJobs *)data;
+  CollectGroup &group = jobs->_groups[n];
+
+  GeomTransformer transformer(*jobs->_transformer);
+  transformer.set_num_threads(0);
+
+  int num_adjusted = 0;
+  for (GeomNode *geom_node : group._geom_nodes) {
+    num_adjusted += transformer.collect_vertex_data(geom_node, jobs->_collect_bits, jobs->_format_only);
+  }
+  num_adjusted += transformer.finish_collect(jobs->_format_only);
+  group._num_adjusted = num_adjusted;
+}
+
+/**
+ * A job for run_jobs(), which unifies one GeomNode.  The data is a
+ * UnifyJobs.
+ */
+void SceneGraphReducer::
+st_unify(void *data, size_t n) {
+  UnifyJobs *jobs = (UnifyJobs *)data;
+  jobs->_geom_nodes[n]->unify(jobs->_max_indices, jobs->_preserve_order);
+}
+
 class SortByState {
 public:
   INLINE bool
@@ -795,13 +1088,46 @@ r_make_compatible_state(PandaNode *node, GeomTransformer &transformer) {
 }
 
 /**
- * The recursive implementation of collect_vertex_data().
+ * The implementation of collect_vertex_data() and make_compatible_format().
+ * Each separate collection of vertices is made on a worker thread, if we have
+ * any, unless some of the GeomNodes are instanced.
  */
 int SceneGraphReducer::
-r_collect_vertex_data(PandaNode *node, int collect_bits,
-                      GeomTransformer &transformer, bool format_only) {
-  int num_adjusted = 0;
+do_collect_vertex_data(PandaNode *root, int collect_bits, bool format_only) {
+  if (_num_threads > 0) {
+    CollectJobs jobs;
+    jobs._transformer = &_transformer;
+    jobs._collect_bits = collect_bits;
+    jobs._format_only = format_only;
+    jobs._groups.push_back(CollectGroup());
+
+    pset<GeomNode *> geom_nodes;
+    bool instanced = false;
+    r_find_collect_groups(root, collect_bits, 0, jobs._groups, geom_nodes, instanced);
+
+    if (!instanced && use_threads(jobs._groups.size())) {
+      run_jobs(_num_threads, jobs._groups.size(), &st_collect_group, &jobs);
+
+      int num_adjusted = 0;
+      for (const CollectGroup &group : jobs._groups) {
+        num_adjusted += group._num_adjusted;
+      }
+      return num_adjusted;
+    }
+  }
 
+  int count = r_collect_vertex_data(root, collect_bits, _transformer, format_only);
+  count += _transformer.finish_collect(format_only);
+  return count;
+}
+
+/**
+ * Returns the CollectVertexData bits that describe the indicated node.  If
+ * any of these are also in the collect_bits, a new collection is started at
+ * this node.
+ */
+int SceneGraphReducer::
+get_collect_node_bits(PandaNode *node) {
   int this_node_bits = 0;
   if (node->is_of_type(ModelNode::get_class_type())) {
     this_node_bits |= CVD_model;
@@ -812,7 +1138,50 @@ r_collect_vertex_data(PandaNode *node, int collect_bits,
   if (node->is_geom_node()) {
     this_node_bits |= CVD_one_node_only;
   }
+  return this_node_bits;
+}
+
+/**
+ * Divides the GeomNodes at this level and below into the same collections
+ * that r_collect_vertex_data() would use, with the GeomNodes of each in the
+ * same order.  Sets instanced to true if any GeomNode is reached more than
+ * once.
+ */
+void SceneGraphReducer::
+r_find_collect_groups(PandaNode *node, int collect_bits, size_t group,
+                      CollectGroups &groups, pset<GeomNode *> &geom_nodes,
+                      bool &instanced) {
+  if ((collect_bits & get_collect_node_bits(node)) != 0) {
+    // We need to start a unique collection here.
+    group = groups.size();
+    groups.push_back(CollectGroup());
+  }
 
+  if (node->is_geom_node()) {
+    GeomNode *geom_node = DCAST(GeomNode, node);
+    if (!geom_nodes.insert(geom_node).second) {
+      instanced = true;
+    }
+    groups[group]._geom_nodes.push_back(geom_node);
+  }
+
+  PandaNode::Children children = node->get_children();
+  int num_children = children.get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    r_find_collect_groups(children.get_child(i), collect_bits, group,
+                          groups, geom_nodes, instanced);
+  }
+}
+
+/**
+ * The recursive implementation of collect_vertex_data().
+ */
+int SceneGraphReducer::
+r_collect_vertex_data(PandaNode *node, int collect_bits,
+                      GeomTransformer &transformer, bool format_only) {
+  int num_adjusted = 0;
+
+  int this_node_bits = get_collect_node_bits(node);
   if ((collect_bits & this_node_bits) != 0) {
     // We need to start a unique collection here.
     GeomTransformer new_transformer(transformer);
@@ -913,6 +1282,23 @@ r_unify(PandaNode *node, int max_indices, bool preserve_order) {
   Thread::consider_yield();
 }
 
+/**
+ * Appends each GeomNode at this level and below to geom_nodes, in the order
+ * that r_unify() would visit them.
+ */
+void SceneGraphReducer::
+r_find_geom_nodes(PandaNode *node, pvector<GeomNode *> &geom_nodes) {
+  if (node->is_geom_node()) {
+    geom_nodes.push_back(DCAST(GeomNode, node));
+  }
+
+  PandaNode::Children children = node->get_children();
+  int num_children = children.get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    r_find_geom_nodes(children.get_child(i), geom_nodes);
+  }
+}
+
 /**
  * Recursively calls GeomTransformer::register_vertices() on all GeomNodes at
  * the indicated root and below.
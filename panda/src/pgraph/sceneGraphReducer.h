@@ -25,8 +25,16 @@
 #include "typedObject.h"
 #include "pointerTo.h"
 #include "graphicsStateGuardianBase.h"
+#include "pvector.h"
+#include "pset.h"
+#include "thread.h"
+#include "asyncTask.h"
+#include "atomicAdjust.h"
+#include "config_pgraph.h"
 
 class PandaNode;
+class GeomNode;
+class GenericAsyncTask;
 
 /**
  * An interface for simplifying ("flattening") scene graphs by eliminating
@@ -120,6 +128,9 @@ PUBLISHED:
   INLINE void set_combine_radius(PN_stdfloat combine_radius);
   INLINE PN_stdfloat get_combine_radius() const;
 
+  INLINE void set_num_threads(int num_threads);
+  INLINE int get_num_threads() const;
+
   INLINE void apply_attribs(PandaNode *node, int attrib_types = ~(TT_clip_plane | TT_cull_face | TT_apply_texture_color));
   INLINE void apply_attribs(PandaNode *node, const AccumulatedAttribs &attribs,
                             int attrib_types, GeomTransformer &transformer);
@@ -141,12 +152,22 @@ PUBLISHED:
   INLINE void premunge(PandaNode *root, const RenderState *initial_state);
   bool check_live_flatten(PandaNode *node);
 
+public:
+  typedef void JobFunc(void *data, size_t n);
+  static void run_jobs(int num_threads, size_t num_jobs,
+                       JobFunc *func, void *data);
+
 protected:
   void r_apply_attribs(PandaNode *node, const AccumulatedAttribs &attribs,
                        int attrib_types, GeomTransformer &transformer);
 
   int r_flatten(PandaNode *grandparent_node, PandaNode *parent_node,
                 int combine_siblings_bits);
+  int r_flatten_below(PandaNode *parent_node, int &combine_siblings_bits);
+  bool flatten_only_child(PandaNode *grandparent_node, PandaNode *parent_node);
+  int finish_flatten(PandaNode *parent_node, int combine_siblings_bits);
+  int flatten_children_parallel(PandaNode *root, int combine_siblings_bits);
+  bool r_is_independent(PandaNode *node);
   int flatten_siblings(PandaNode *parent_node,
                        int combine_siblings_bits);
 
@@ -171,18 +192,82 @@ protected:
 
   int r_make_compatible_state(PandaNode *node, GeomTransformer &transformer);
 
+  int do_collect_vertex_data(PandaNode *root, int collect_bits,
+                             bool format_only);
+  int get_collect_node_bits(PandaNode *node);
   int r_collect_vertex_data(PandaNode *node, int collect_bits,
                             GeomTransformer &transformer, bool format_only);
   int r_make_nonindexed(PandaNode *node, int collect_bits);
   void r_unify(PandaNode *node, int max_indices, bool preserve_order);
+  void r_find_geom_nodes(PandaNode *node, pvector<GeomNode *> &geom_nodes);
   void r_register_vertices(PandaNode *node, GeomTransformer &transformer);
   void r_decompose(PandaNode *node);
 
   void r_premunge(PandaNode *node, const RenderState *state);
 
 private:
+  // These are used to process parts of the scene graph on the worker
+  // threads.
+  class FlattenJob {
+  public:
+    SceneGraphReducer *_reducer;
+    PT(PandaNode) _node;
+    int _combine_siblings_bits;
+    bool _independent;
+    bool _flatten_below;
+    int _num_nodes;
+  };
+  typedef pvector<FlattenJob> FlattenJobs;
+
+  // Each CollectGroup lists the GeomNodes whose vertices would be collected
+  // by one GeomTransformer in r_collect_vertex_data().
+  class CollectGroup {
+  public:
+    pvector<GeomNode *> _geom_nodes;
+    int _num_adjusted;
+  };
+  typedef pvector<CollectGroup> CollectGroups;
+
+  class CollectJobs {
+  public:
+    const GeomTransformer *_transformer;
+    CollectGroups _groups;
+    int _collect_bits;
+    bool _format_only;
+  };
+
+  class UnifyJobs {
+  public:
+    pvector<GeomNode *> _geom_nodes;
+    int _max_indices;
+    bool _preserve_order;
+  };
+
+  void r_find_collect_groups(PandaNode *node, int collect_bits, size_t group,
+                             CollectGroups &groups,
+                             pset<GeomNode *> &geom_nodes, bool &instanced);
+
+  // This is shared by all of the threads working through one run_jobs()
+  // call.
+  class JobQueue {
+  public:
+    JobFunc *_func;
+    void *_data;
+    AtomicAdjust::Integer _num_jobs;
+    AtomicAdjust::Integer _next_job;
+  };
+  static AsyncTask::DoneStatus st_run_jobs(GenericAsyncTask *task, void *data);
+
+  static void st_flatten_below(void *data, size_t n);
+  static void st_finish_flatten(void *data, size_t n);
+  static void st_collect_group(void *data, size_t n);
+  static void st_unify(void *data, size_t n);
+
+  INLINE bool use_threads(size_t num_jobs) const;
+
   PT(GraphicsStateGuardianBase) _gsg;
   PN_stdfloat _combine_radius;
+  int _num_threads;
   GeomTransformer _transformer;
 
   static PStatCollector _flatten_collector;
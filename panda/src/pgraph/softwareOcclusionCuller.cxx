@@ -0,0 +1,522 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file softwareOcclusionCuller.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "softwareOcclusionCuller.h"
+#include "config_pgraph.h"
+#include "geomNode.h"
+#include "geomVertexReader.h"
+#include "cullFaceAttrib.h"
+#include "transparencyAttrib.h"
+#include "finiteBoundingVolume.h"
+#include "nodePathCollection.h"
+#include "pStatTimer.h"
+
+#include <float.h>
+
+#if !defined(STDFLOAT_DOUBLE) && (defined(__SSE2__) || (_M_IX86_FP >= 2) || defined(_M_X64) || defined(_M_AMD64))
+#include <emmintrin.h>
+#define OCCLUSION_CULLER_SSE2
+#endif
+
+PStatCollector SoftwareOcclusionCuller::_rasterize_pcollector("Cull:Occlusion:Rasterize");
+
+/**
+ *
+ */
+SoftwareOcclusionCuller::
+SoftwareOcclusionCuller() :
+  _width(0),
+  _height(0)
+{
+  set_buffer_size(software_occlusion_buffer_size[0],
+                  software_occlusion_buffer_size[1]);
+}
+
+/**
+ *
+ */
+SoftwareOcclusionCuller::
+~SoftwareOcclusionCuller() {
+}
+
+/**
+ * Changes the size of the depth buffer into which the occluders are
+ * rasterized.  A larger buffer culls more precisely, at the cost of more time
+ * spent rasterizing and testing.
+ */
+void SoftwareOcclusionCuller::
+set_buffer_size(int width, int height) {
+  nassertv(width > 0 && height > 0);
+  _width = width;
+  _height = height;
+  _buffer._prepared = false;
+  _buffer._any_covered = false;
+}
+
+/**
+ * Adds the indicated node as an occluder.  The triangles of all of the
+ * GeomNodes at and below the node are collected when this is called; if the
+ * geometry is later changed, the node must be removed and added again.  The
+ * node may still be moved freely.
+ *
+ * Only opaque geometry is collected.
+ */
+void SoftwareOcclusionCuller::
+add_occluder(const NodePath &occluder) {
+  nassertv(!occluder.is_empty());
+  remove_occluder(occluder);
+
+  Occluder occ;
+  occ._node_path = occluder;
+  collect_triangles(occ, occluder.node(), LMatrix4::ident_mat(),
+                    RenderState::make_empty());
+
+  if (pgraph_cat.is_debug()) {
+    pgraph_cat.debug()
+      << "Added occluder " << occluder << " with "
+      << occ._vertices.size() / 3 << " triangles\n";
+  }
+
+  if (!occ._vertices.empty()) {
+    _occluders.push_back(std::move(occ));
+  }
+}
+
+/**
+ * Adds as an occluder every node at or below the indicated root that has the
+ * tag named by the config variable software-occlusion-tag.
+ */
+void SoftwareOcclusionCuller::
+add_occluders(const NodePath &root) {
+  nassertv(!root.is_empty());
+  const std::string &tag = software_occlusion_tag;
+
+  if (root.has_tag(tag)) {
+    add_occluder(root);
+  }
+
+  NodePathCollection occluders = root.find_all_matches("**/=" + tag);
+  int num_occluders = occluders.get_num_paths();
+  for (int i = 0; i < num_occluders; ++i) {
+    add_occluder(occluders.get_path(i));
+  }
+}
+
+/**
+ * Removes the indicated node from the set of occluders.  Returns true if it
+ * was an occluder, false otherwise.
+ */
+bool SoftwareOcclusionCuller::
+remove_occluder(const NodePath &occluder) {
+  Occluders::iterator oi;
+  for (oi = _occluders.begin(); oi != _occluders.end(); ++oi) {
+    if ((*oi)._node_path == occluder) {
+      _occluders.erase(oi);
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * Removes all of the occluders.
+ */
+void SoftwareOcclusionCuller::
+clear_occluders() {
+  _occluders.clear();
+  _buffer._any_covered = false;
+}
+
+/**
+ * Rasterizes the occluders into the depth buffer, as seen from the indicated
+ * camera.  This must be called before is_occluded() is used; it is called
+ * automatically by the CullTraverser at the start of each traversal.
+ * Occluders that are hidden from the camera mask are skipped.
+ */
+void SoftwareOcclusionCuller::
+prepare(const NodePath &camera, const Lens *lens, DrawMask camera_mask) {
+  CPT(TransformState) world_transform =
+    camera.get_net_transform()->get_inverse();
+  prepare(_buffer, world_transform, camera, lens, camera_mask);
+}
+
+/**
+ * Returns true if the indicated node is entirely hidden behind the occluders
+ * from the point of view given to the most recent call to prepare().
+ */
+bool SoftwareOcclusionCuller::
+is_occluded(const NodePath &node) {
+  nassertr(!node.is_empty() && _buffer._prepared, false);
+
+  // The node's bounding volume is in the coordinate space of its parent.
+  CPT(TransformState) net_transform;
+  if (node.has_parent()) {
+    net_transform = node.get_parent().get_net_transform();
+  } else {
+    net_transform = TransformState::make_identity();
+  }
+  return is_occluded(_buffer, node.get_bounds(), net_transform->get_mat());
+}
+
+/**
+ * The version of prepare() called by the CullTraverser, which rasterizes the
+ * occluders into the indicated buffer, owned by the traverser.  The world
+ * transform is the transform of the scene root relative to the camera, as
+ * returned by SceneSetup::get_world_transform(); the net matrices passed to
+ * is_occluded() are then relative to the scene root.
+ *
+ * This does not modify the culler, so several traversers may call it at
+ * once, each with its own buffer.
+ */
+void SoftwareOcclusionCuller::
+prepare(DepthBuffer &buffer, const TransformState *world_transform,
+        const NodePath &camera, const Lens *lens,
+        DrawMask camera_mask) const {
+  PStatTimer timer(_rasterize_pcollector);
+  nassertv(lens != nullptr);
+
+  buffer._projection_mat = lens->get_projection_mat();
+  buffer._world_projection_mat =
+    world_transform->get_mat() * buffer._projection_mat;
+
+  buffer._width = _width;
+  buffer._height = _height;
+  buffer._depth.assign((size_t)_width * (size_t)_height, FLT_MAX);
+  buffer._prepared = true;
+  buffer._any_covered = false;
+  buffer._num_triangles = 0;
+  buffer._num_tested = 0;
+  buffer._num_occluded = 0;
+
+  Occluders::const_iterator oi;
+  for (oi = _occluders.begin(); oi != _occluders.end(); ++oi) {
+    const Occluder &occ = (*oi);
+    if (occ._node_path.is_empty() || occ._node_path.is_hidden(camera_mask)) {
+      continue;
+    }
+
+    CPT(TransformState) transform = occ._node_path.get_transform(camera);
+    if (transform->is_invalid() || transform->is_singular()) {
+      continue;
+    }
+
+    // A mirroring transform reverses the winding order of the triangles.
+    const LMatrix4 &mat = transform->get_mat();
+    bool flip = (mat.get_upper_3().determinant() < 0.0f);
+    buffer.rasterize(occ, mat * buffer._projection_mat, flip);
+  }
+}
+
+/**
+ * Returns true if the indicated bounding volume, transformed by the indicated
+ * matrix, is entirely hidden behind the occluders that were rasterized into
+ * the buffer by prepare().  Returns false if it might be at least partly
+ * visible, or if it is not entirely in front of the camera.
+ */
+bool SoftwareOcclusionCuller::
+is_occluded(DepthBuffer &buffer, const BoundingVolume *bounds,
+            const LMatrix4 &net_mat) const {
+  if (!buffer._any_covered || bounds->is_empty() || bounds->is_infinite()) {
+    return false;
+  }
+
+  const FiniteBoundingVolume *fbv = bounds->as_finite_bounding_volume();
+  if (fbv == nullptr) {
+    return false;
+  }
+
+  ++buffer._num_tested;
+
+  int x0, y0, x1, y1;
+  float min_z;
+  if (!buffer.project_box(fbv->get_min(), fbv->get_max(),
+                          net_mat * buffer._world_projection_mat,
+                          x0, y0, x1, y1, min_z)) {
+    return false;
+  }
+
+  if (buffer.test_rect(x0, y0, x1, y1, min_z)) {
+    ++buffer._num_occluded;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Recursively collects the triangles of all of the opaque Geoms at and below
+ * the indicated node into the occluder, in the coordinate space of the
+ * occluder node.
+ */
+void SoftwareOcclusionCuller::
+collect_triangles(Occluder &occluder, PandaNode *node, const LMatrix4 &mat,
+                  const RenderState *state) const {
+  CPT(RenderState) net_state = state->compose(node->get_state());
+
+  if (node->is_geom_node()) {
+    GeomNode *gnode = (GeomNode *)node;
+    int num_geoms = gnode->get_num_geoms();
+    for (int i = 0; i < num_geoms; ++i) {
+      CPT(RenderState) geom_state = net_state->compose(gnode->get_geom_state(i));
+
+      const TransparencyAttrib *ta;
+      if (geom_state->get_attrib(ta) &&
+          ta->get_mode() != TransparencyAttrib::M_none) {
+        continue;
+      }
+
+      bool two_sided = false;
+      const CullFaceAttrib *cfa;
+      if (geom_state->get_attrib(cfa) &&
+          cfa->get_effective_mode() == CullFaceAttrib::M_cull_none) {
+        two_sided = true;
+      }
+
+      CPT(Geom) geom = gnode->get_geom(i)->decompose();
+      if (geom->get_primitive_type() != Geom::PT_polygons) {
+        continue;
+      }
+
+      GeomVertexReader vertex(geom->get_vertex_data(),
+                              InternalName::get_vertex());
+      if (!vertex.has_column()) {
+        continue;
+      }
+
+      int num_primitives = geom->get_num_primitives();
+      for (int pi = 0; pi < num_primitives; ++pi) {
+        CPT(GeomPrimitive) prim = geom->get_primitive(pi);
+        int num_vertices = prim->get_num_vertices();
+        for (int vi = 0; vi + 2 < num_vertices; vi += 3) {
+          LPoint3 v[3];
+          for (int j = 0; j < 3; ++j) {
+            vertex.set_row_unsafe(prim->get_vertex(vi + j));
+            v[j] = mat.xform_point(vertex.get_data3());
+          }
+          occluder._vertices.push_back(v[0]);
+          occluder._vertices.push_back(v[1]);
+          occluder._vertices.push_back(v[2]);
+          if (two_sided) {
+            occluder._vertices.push_back(v[0]);
+            occluder._vertices.push_back(v[2]);
+            occluder._vertices.push_back(v[1]);
+          }
+        }
+      }
+    }
+  }
+
+  PandaNode::Children children = node->get_children();
+  int num_children = children.get_num_children();
+  for (int i = 0; i < num_children; ++i) {
+    PandaNode *child = children.get_child(i);
+    collect_triangles(occluder, child,
+                      child->get_transform()->get_mat() * mat, net_state);
+  }
+}
+
+/**
+ *
+ */
+SoftwareOcclusionCuller::DepthBuffer::
+DepthBuffer() :
+  _width(0),
+  _height(0),
+  _projection_mat(LMatrix4::ident_mat()),
+  _world_projection_mat(LMatrix4::ident_mat()),
+  _prepared(false),
+  _any_covered(false),
+  _num_triangles(0),
+  _num_tested(0),
+  _num_occluded(0)
+{
+}
+
+/**
+ * Rasterizes all of the triangles of the indicated occluder, given the matrix
+ * that transforms them into clip space.
+ */
+void SoftwareOcclusionCuller::DepthBuffer::
+rasterize(const Occluder &occluder, const LMatrix4 &mat, bool flip) {
+  PN_stdfloat half_width = _width * 0.5f;
+  PN_stdfloat half_height = _height * 0.5f;
+
+  size_t num_vertices = occluder._vertices.size();
+  for (size_t i = 0; i + 2 < num_vertices; i += 3) {
+    LPoint3f screen[3];
+    bool clipped = false;
+    for (int j = 0; j < 3 && !clipped; ++j) {
+      LVecBase4 clip = LVecBase4(occluder._vertices[i + j], 1.0f) * mat;
+
+      // Don't bother clipping triangles that cross the near plane; it is
+      // always safe to leave out an occluder.
+      if (clip[3] <= 0.0f || clip[2] < -clip[3]) {
+        clipped = true;
+        break;
+      }
+      PN_stdfloat inv_w = 1.0f / clip[3];
+      screen[j].set((float)((clip[0] * inv_w + 1.0f) * half_width),
+                    (float)((clip[1] * inv_w + 1.0f) * half_height),
+                    (float)(clip[2] * inv_w));
+    }
+    if (clipped) {
+      continue;
+    }
+
+    if (flip) {
+      rasterize_triangle(screen[0], screen[2], screen[1]);
+    } else {
+      rasterize_triangle(screen[0], screen[1], screen[2]);
+    }
+  }
+}
+
+/**
+ * Rasterizes a single triangle, given in pixel coordinates with the depth in
+ * the z component, into the depth buffer.  Only pixels that lie entirely
+ * within the triangle are written, and they are given the depth of the
+ * farthest vertex.  Back-facing triangles are ignored.
+ */
+void SoftwareOcclusionCuller::DepthBuffer::
+rasterize_triangle(const LPoint3f &v0, const LPoint3f &v1,
+                   const LPoint3f &v2) {
+  float area = (v1[0] - v0[0]) * (v2[1] - v0[1]) -
+               (v2[0] - v0[0]) * (v1[1] - v0[1]);
+  if (area <= 0.0f) {
+    // Back-facing or degenerate.
+    return;
+  }
+
+  int x0 = std::max(0, (int)floorf(std::min(v0[0], std::min(v1[0], v2[0]))));
+  int y0 = std::max(0, (int)floorf(std::min(v0[1], std::min(v1[1], v2[1]))));
+  int x1 = std::min(_width - 1, (int)ceilf(std::max(v0[0], std::max(v1[0], v2[0]))));
+  int y1 = std::min(_height - 1, (int)ceilf(std::max(v0[1], std::max(v1[1], v2[1]))));
+  if (x0 > x1 || y0 > y1) {
+    return;
+  }
+
+  ++_num_triangles;
+  float z = std::max(v0[2], std::max(v1[2], v2[2]));
+
+  // Each edge function is positive on the inside of its edge.  A pixel lies
+  // entirely inside the edge if the function, evaluated at its center, is
+  // at least half the sum of the absolute values of the coefficients.
+  const LPoint3f *v[3] = { &v0, &v1, &v2 };
+  float a[3], b[3], c[3];
+  for (int e = 0; e < 3; ++e) {
+    const LPoint3f &p = *v[e];
+    const LPoint3f &q = *v[(e + 1) % 3];
+    a[e] = p[1] - q[1];
+    b[e] = q[0] - p[0];
+    c[e] = -(a[e] * p[0] + b[e] * p[1]) - 0.5f * (fabsf(a[e]) + fabsf(b[e]));
+  }
+
+  for (int y = y0; y <= y1; ++y) {
+    float cy = y + 0.5f;
+    float cx = x0 + 0.5f;
+    float e0 = a[0] * cx + b[0] * cy + c[0];
+    float e1 = a[1] * cx + b[1] * cy + c[1];
+    float e2 = a[2] * cx + b[2] * cy + c[2];
+
+    float *row = &_depth[(size_t)y * _width];
+    for (int x = x0; x <= x1; ++x) {
+      if (e0 >= 0.0f && e1 >= 0.0f && e2 >= 0.0f && z < row[x]) {
+        row[x] = z;
+        _any_covered = true;
+      }
+      e0 += a[0];
+      e1 += a[1];
+      e2 += a[2];
+    }
+  }
+}
+
+/**
+ * Projects the indicated box into the depth buffer, and returns the range of
+ * pixels it touches along with its nearest depth.  Returns false if the box
+ * is not entirely in front of the near plane, or does not touch the buffer.
+ */
+bool SoftwareOcclusionCuller::DepthBuffer::
+project_box(const LPoint3 &min_point, const LPoint3 &max_point,
+            const LMatrix4 &mat, int &x0, int &y0, int &x1, int &y1,
+            float &min_z) const {
+  // Rather than transforming all eight corners, transform the minimum corner
+  // and the three edge vectors, and add them together.
+  LVecBase4 base = LVecBase4(min_point, 1.0f) * mat;
+  LVector3 size = max_point - min_point;
+  LVecBase4 dx = mat.get_row(0) * size[0];
+  LVecBase4 dy = mat.get_row(1) * size[1];
+  LVecBase4 dz = mat.get_row(2) * size[2];
+
+  PN_stdfloat min_x = FLT_MAX, min_y = FLT_MAX;
+  PN_stdfloat max_x = -FLT_MAX, max_y = -FLT_MAX;
+  PN_stdfloat near_z = FLT_MAX;
+
+  for (int i = 0; i < 8; ++i) {
+    LVecBase4 clip = base;
+    if (i & 1) clip += dx;
+    if (i & 2) clip += dy;
+    if (i & 4) clip += dz;
+
+    if (clip[3] <= 0.0f || clip[2] < -clip[3]) {
+      return false;
+    }
+    PN_stdfloat inv_w = 1.0f / clip[3];
+    PN_stdfloat x = clip[0] * inv_w;
+    PN_stdfloat y = clip[1] * inv_w;
+    min_x = std::min(min_x, x);
+    max_x = std::max(max_x, x);
+    min_y = std::min(min_y, y);
+    max_y = std::max(max_y, y);
+    near_z = std::min(near_z, clip[2] * inv_w);
+  }
+
+  // Anything beyond the edges of the buffer is outside the viewing frustum,
+  // so it is enough to test the part that is on the screen.
+  x0 = std::max(0, (int)floor((min_x + 1.0f) * _width * 0.5f));
+  y0 = std::max(0, (int)floor((min_y + 1.0f) * _height * 0.5f));
+  x1 = std::min(_width - 1, (int)floor((max_x + 1.0f) * _width * 0.5f));
+  y1 = std::min(_height - 1, (int)floor((max_y + 1.0f) * _height * 0.5f));
+  min_z = (float)near_z;
+  return (x0 <= x1 && y0 <= y1);
+}
+
+/**
+ * Returns true if every pixel within the indicated rectangle (inclusive) is
+ * covered by an occluder nearer than the indicated depth.
+ */
+bool SoftwareOcclusionCuller::DepthBuffer::
+test_rect(int x0, int y0, int x1, int y1, float min_z) const {
+#ifdef OCCLUSION_CULLER_SSE2
+  __m128 z4 = _mm_set1_ps(min_z);
+#endif
+
+  for (int y = y0; y <= y1; ++y) {
+    const float *row = &_depth[(size_t)y * _width];
+    int x = x0;
+
+#ifdef OCCLUSION_CULLER_SSE2
+    for (; x + 3 <= x1; x += 4) {
+      if (_mm_movemask_ps(_mm_cmpge_ps(_mm_loadu_ps(row + x), z4)) != 0) {
+        return false;
+      }
+    }
+#endif
+
+    for (; x <= x1; ++x) {
+      if (row[x] >= min_z) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
@@ -0,0 +1,142 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file softwareOcclusionCuller.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef SOFTWAREOCCLUSIONCULLER_H
+#define SOFTWAREOCCLUSIONCULLER_H
+
+#include "pandabase.h"
+#include "referenceCount.h"
+#include "nodePath.h"
+#include "lens.h"
+#include "renderState.h"
+#include "drawMask.h"
+#include "pvector.h"
+#include "pStatCollector.h"
+
+class BoundingVolume;
+
+/**
+ * Performs occlusion culling entirely on the CPU, without the help of the
+ * graphics hardware.  At the start of each cull traversal, the triangles of a
+ * set of occluder nodes are rasterized into a small depth buffer; each node
+ * encountered during the traversal is then tested by projecting its bounding
+ * box onto the same buffer, and culled if every pixel it covers is already
+ * covered by a nearer occluder.
+ *
+ * The rasterization is conservative: a pixel is only considered covered if it
+ * lies entirely within an occluder triangle, and it is given the depth of the
+ * farthest vertex of that triangle.  Back-facing triangles, and triangles
+ * that cross the near plane, are not rasterized at all.  This means that
+ * large, simple, opaque geometry, such as the walls of buildings, makes the
+ * best occluders.
+ *
+ * Assign one of these to a CullTraverser with
+ * CullTraverser::set_occlusion_culler().  Each CullTraverser rasterizes the
+ * occluders into a depth buffer of its own, so one culler may be shared
+ * between DisplayRegions that are culled in different threads, provided that
+ * the occluders are not added or removed during the traversal.  The
+ * prepare() and is_occluded() methods that take a NodePath use a buffer held
+ * by the culler itself, and are meant for use from a single thread.
+ */
+class EXPCL_PANDA_PGRAPH SoftwareOcclusionCuller : public ReferenceCount {
+PUBLISHED:
+  SoftwareOcclusionCuller();
+  virtual ~SoftwareOcclusionCuller();
+
+  void set_buffer_size(int width, int height);
+  INLINE int get_buffer_width() const;
+  INLINE int get_buffer_height() const;
+
+  void add_occluder(const NodePath &occluder);
+  void add_occluders(const NodePath &root);
+  bool remove_occluder(const NodePath &occluder);
+  void clear_occluders();
+  INLINE int get_num_occluders() const;
+  INLINE NodePath get_occluder(int n) const;
+  MAKE_SEQ(get_occluders, get_num_occluders, get_occluder);
+
+  void prepare(const NodePath &camera, const Lens *lens,
+               DrawMask camera_mask = DrawMask::all_on());
+  bool is_occluded(const NodePath &node);
+
+  INLINE int get_num_triangles() const;
+  INLINE int get_num_tested() const;
+  INLINE int get_num_occluded() const;
+
+  MAKE_PROPERTY(buffer_width, get_buffer_width);
+  MAKE_PROPERTY(buffer_height, get_buffer_height);
+  MAKE_PROPERTY(num_triangles, get_num_triangles);
+  MAKE_PROPERTY(num_tested, get_num_tested);
+  MAKE_PROPERTY(num_occluded, get_num_occluded);
+
+private:
+  class Occluder {
+  public:
+    NodePath _node_path;
+    pvector<LPoint3> _vertices;
+  };
+
+public:
+  // The depth buffer, and everything else that is set up by prepare() for
+  // one traversal.
+  class EXPCL_PANDA_PGRAPH DepthBuffer {
+  public:
+    DepthBuffer();
+
+    void rasterize(const Occluder &occluder, const LMatrix4 &mat, bool flip);
+    void rasterize_triangle(const LPoint3f &v0, const LPoint3f &v1,
+                            const LPoint3f &v2);
+    bool project_box(const LPoint3 &min_point, const LPoint3 &max_point,
+                     const LMatrix4 &mat, int &x0, int &y0, int &x1, int &y1,
+                     float &min_z) const;
+    bool test_rect(int x0, int y0, int x1, int y1, float min_z) const;
+
+    int _width;
+    int _height;
+    pvector<float> _depth;
+
+    LMatrix4 _projection_mat;
+    LMatrix4 _world_projection_mat;
+    bool _prepared;
+    bool _any_covered;
+
+    int _num_triangles;
+    int _num_tested;
+    int _num_occluded;
+  };
+
+  void prepare(DepthBuffer &buffer, const TransformState *world_transform,
+               const NodePath &camera, const Lens *lens,
+               DrawMask camera_mask) const;
+  bool is_occluded(DepthBuffer &buffer, const BoundingVolume *bounds,
+                   const LMatrix4 &net_mat) const;
+
+private:
+  void collect_triangles(Occluder &occluder, PandaNode *node,
+                         const LMatrix4 &mat, const RenderState *state) const;
+
+  typedef pvector<Occluder> Occluders;
+  Occluders _occluders;
+
+  int _width;
+  int _height;
+
+  // The buffer used by the PUBLISHED prepare() and is_occluded().
+  DepthBuffer _buffer;
+
+  static PStatCollector _rasterize_pcollector;
+};
+
+#include "softwareOcclusionCuller.I"
+
+#endif
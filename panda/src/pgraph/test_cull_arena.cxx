@@ -0,0 +1,119 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_cull_arena.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "config_pgraph.h"
+#include "cullArena.h"
+#include "cullableObject.h"
+
+#include "pnotify.h"
+
+using std::cerr;
+
+static int num_failures = 0;
+
+#define CHECK(condition) \
+  if (!(condition)) { \
+    cerr << "FAILED: " #condition " (line " << __LINE__ << ")\n"; \
+    ++num_failures; \
+  }
+
+/**
+ * A CullableObject that is too big to be carved out of the arena.
+ */
+class BigCullableObject : public CullableObject {
+public:
+  char _padding[256];
+};
+
+/**
+ * Checks that allocations are aligned and counted, and that chunks of the
+ * standard size are returned to the pool when the arena goes away, even
+ * when cull-arena-chunk-size is set below the minimum chunk size.
+ */
+static void
+test_chunks() {
+  cull_arena_chunk_size.set_value(256);
+
+  int pooled = CullArena::get_num_pooled_chunks();
+  {
+    CullArena arena;
+    for (int i = 0; i < 100; ++i) {
+      void *ptr = arena.allocate(24);
+      CHECK(((uintptr_t)ptr & (MEMORY_HOOK_ALIGNMENT - 1)) == 0);
+    }
+    CHECK(arena.get_bytes_used() >= 2400);
+    CHECK(arena.get_bytes_reserved() >= arena.get_bytes_used());
+  }
+  CHECK(CullArena::get_num_pooled_chunks() > pooled);
+
+  // The next arena takes its chunks back out of the pool.
+  pooled = CullArena::get_num_pooled_chunks();
+  {
+    CullArena arena;
+    arena.allocate(24);
+    CHECK(CullArena::get_num_pooled_chunks() == pooled - 1);
+  }
+
+  cull_arena_chunk_size.clear_local_value();
+}
+
+/**
+ * Checks that CullableObjects come out of the current arena, and from the
+ * heap otherwise, and that a derived class too large for the arena still
+ * gets valid memory.
+ */
+static void
+test_objects() {
+  CullArena arena;
+  {
+    CullArena::Scope scope(&arena);
+    CHECK(CullArena::get_current() == &arena);
+
+    size_t used = arena.get_bytes_used();
+    CullableObject *object = new CullableObject;
+    CHECK(arena.get_bytes_used() > used);
+    delete object;
+
+    used = arena.get_bytes_used();
+    BigCullableObject *big = new BigCullableObject;
+    CHECK(big != nullptr);
+    CHECK(arena.get_bytes_used() == used);
+    big->_padding[255] = 1;
+    delete big;
+  }
+  CHECK(CullArena::get_current() == nullptr);
+
+  size_t used = arena.get_bytes_used();
+  CullableObject *object = new CullableObject;
+  CHECK(object != nullptr);
+  CHECK(arena.get_bytes_used() == used);
+  delete object;
+}
+
+/**
+ * Usage: test_cull_arena
+ */
+int
+main(int argc, char *argv[]) {
+  init_libpgraph();
+
+  test_chunks();
+  test_objects();
+
+  if (num_failures != 0) {
+    cerr << num_failures << " checks failed.\n";
+    return 1;
+  }
+  cerr << "All checks passed.\n";
+  return 0;
+}
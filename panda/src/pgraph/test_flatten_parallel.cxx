@@ -0,0 +1,153 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_flatten_parallel.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "config_pgraph.h"
+#include "nodePath.h"
+#include "loader.h"
+#include "loaderOptions.h"
+#include "sceneGraphReducer.h"
+#include "pvector.h"
+
+#include "pnotify.h"
+#include <chrono>
+#include <stdlib.h>
+
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * The models that are used when none are named on the command line.  These
+ * are among those shipped in the models directory, which should be on the
+ * model-path.
+ */
+static const char *const default_models[] = {
+  "environment.egg",
+  "teapot.egg",
+  "smiley.egg",
+  "frowney.egg",
+  "box.egg",
+  "jack.egg",
+};
+static const int num_default_models = sizeof(default_models) / sizeof(default_models[0]);
+
+/**
+ * Builds a scene from num_copies copies of each of the indicated models, laid
+ * out on a grid with varying transforms and colors, so that there is plenty
+ * to flatten.
+ */
+static NodePath
+make_scene(const pvector<NodePath> &models, int num_copies) {
+  NodePath root("root");
+  for (int c = 0; c < num_copies; ++c) {
+    NodePath group = root.attach_new_node("group");
+    group.set_pos((PN_stdfloat)(c % 16) * 20, (PN_stdfloat)(c / 16) * 20, 0);
+
+    for (size_t m = 0; m < models.size(); ++m) {
+      NodePath copy = models[m].copy_to(group);
+      copy.set_pos((PN_stdfloat)m * 2, 0, 0);
+      copy.set_h((PN_stdfloat)((c + m) * 45 % 360));
+      copy.set_scale(0.5f + (PN_stdfloat)(c % 4) * 0.25f);
+      if (c % 3 != 0) {
+        copy.set_color(LColor((c % 3) / 2.0f, 0.5f, 1.0f, 1.0f));
+      }
+    }
+  }
+  return root;
+}
+
+/**
+ * Flattens the scene the same way NodePath::flatten_strong() does, with the
+ * indicated number of threads, and returns the time it took.
+ */
+static double
+flatten(NodePath &scene, int num_threads) {
+  Clock::time_point start = Clock::now();
+
+  SceneGraphReducer gr;
+  gr.set_num_threads(num_threads);
+  gr.apply_attribs(scene.node());
+  gr.flatten(scene.node(), ~0);
+  gr.make_compatible_state(scene.node());
+  gr.collect_vertex_data(scene.node(), ~(SceneGraphReducer::CVD_format | SceneGraphReducer::CVD_name | SceneGraphReducer::CVD_animation_type));
+  gr.unify(scene.node(), false);
+
+  std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+  return elapsed.count();
+}
+
+/**
+ * Usage: test_flatten_parallel [num-threads [num-copies [model ...]]]
+ */
+int
+main(int argc, char *argv[]) {
+  int num_threads = 4;
+  int num_copies = 64;
+  if (argc > 1) {
+    num_threads = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_copies = atoi(argv[2]);
+  }
+
+  init_libpgraph();
+
+  pvector<Filename> filenames;
+  for (int i = 3; i < argc; ++i) {
+    filenames.push_back(Filename::from_os_specific(argv[i]));
+  }
+  if (filenames.empty()) {
+    for (int i = 0; i < num_default_models; ++i) {
+      filenames.push_back(Filename(default_models[i]));
+    }
+  }
+
+  // Each model is loaded once, bypassing the ModelPool, and then copied.
+  Loader *loader = Loader::get_global_ptr();
+  LoaderOptions options(LoaderOptions::LF_search |
+                        LoaderOptions::LF_report_errors |
+                        LoaderOptions::LF_no_ram_cache);
+  pvector<NodePath> models;
+  for (size_t i = 0; i < filenames.size(); ++i) {
+    PT(PandaNode) node = loader->load_sync(filenames[i], options);
+    if (node == nullptr) {
+      cerr << "Could not load " << filenames[i] << "\n";
+      return 1;
+    }
+    models.push_back(NodePath(node));
+  }
+
+  NodePath serial = make_scene(models, num_copies);
+  NodePath parallel = make_scene(models, num_copies);
+
+  double serial_ms = flatten(serial, 0);
+  double parallel_ms = flatten(parallel, num_threads);
+
+  cerr << models.size() << " models x " << num_copies << " copies\n"
+       << "serial:     " << serial_ms << " ms\n"
+       << num_threads << " threads: " << parallel_ms << " ms ("
+       << serial_ms / parallel_ms << "x)\n";
+
+  // The two results should be written out identically.
+  vector_uchar serial_bam, parallel_bam;
+  serial.encode_to_bam_stream(serial_bam);
+  parallel.encode_to_bam_stream(parallel_bam);
+  if (serial_bam != parallel_bam) {
+    cerr << "Results are DIFFERENT.\n";
+    return 1;
+  }
+
+  cerr << "Results are identical.\n";
+  return 0;
+}
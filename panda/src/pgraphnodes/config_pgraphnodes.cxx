@@ -24,6 +24,7 @@
 #include "lightLensNode.h"
 #include "lightNode.h"
 #include "lodNode.h"
+#include "lodNodeData.h"
 #include "nodeCullCallbackData.h"
 #include "pointLight.h"
 #include "rectangleLight.h"
@@ -88,6 +89,52 @@ ConfigVariableBool verify_lods
           "actual size of their geometry.  This test is only made in NDEBUG "
           "mode (the variable is ignored in a production build)."));
 
+ConfigVariableBool lod_budget_controlled
+("lod-budget-controlled", false,
+ PRC_DESC("Set this true to make newly-created LODNodes take their switch "
+          "distances from the LODBudgetManager by default, scaling them up "
+          "or down to keep the scene within the budget configured there.  "
+          "This can also be set for individual nodes with "
+          "LODNode::set_budget_controlled()."));
+
+ConfigVariableInt lod_budget_vertices
+("lod-budget-vertices", 0,
+ PRC_DESC("The number of vertices per frame that budget-controlled LODNodes "
+          "should try to stay within, counting the vertices of the levels "
+          "they select.  Set this to 0 to have no vertex budget."));
+
+ConfigVariableDouble lod_budget_frame_time
+("lod-budget-frame-time", 0.0,
+ PRC_DESC("The frame time, in seconds, that budget-controlled LODNodes "
+          "should try to stay within.  Set this to 0 to have no frame time "
+          "budget."));
+
+ConfigVariableDouble lod_budget_hysteresis
+("lod-budget-hysteresis", 0.1,
+ PRC_DESC("The fraction by which the load must drop below the LOD budget "
+          "before the LODBudgetManager starts to bring detail back in, and "
+          "also the fraction by which a budget-controlled LODNode widens the "
+          "switch range of its current level, so that levels do not flicker "
+          "back and forth when the load or distance hovers near a limit."));
+
+ConfigVariableDouble lod_budget_adjust_rate
+("lod-budget-adjust-rate", 0.05,
+ PRC_DESC("The fraction by which the LODBudgetManager changes its distance "
+          "scale each frame while the load is outside of the budget."));
+
+ConfigVariableDouble lod_budget_min_scale
+("lod-budget-min-scale", 0.5,
+ PRC_DESC("The smallest distance scale the LODBudgetManager will apply.  "
+          "Values below 1 draw higher levels of detail farther away than "
+          "their switch distances call for, when there is room in the "
+          "budget."));
+
+ConfigVariableDouble lod_budget_max_scale
+("lod-budget-max-scale", 4.0,
+ PRC_DESC("The largest distance scale the LODBudgetManager will apply, and "
+          "therefore the furthest it will push levels of detail towards the "
+          "camera to stay within the budget."));
+
 ConfigVariableInt parallax_mapping_samples
 ("parallax-mapping-samples", 3,
  PRC_DESC("Sets the amount of samples to use in the parallax mapping "
@@ -124,6 +171,7 @@ init_libpgraphnodes() {
   LightLensNode::init_type();
   LightNode::init_type();
   LODNode::init_type();
+  LODNodeData::init_type();
   NodeCullCallbackData::init_type();
   PointLight::init_type();
   RectangleLight::init_type();
@@ -36,6 +36,13 @@ extern ConfigVariableString lod_fade_bin_name;
 extern ConfigVariableInt lod_fade_bin_draw_order;
 extern ConfigVariableInt lod_fade_state_override;
 extern ConfigVariableBool verify_lods;
+extern EXPCL_PANDA_PGRAPHNODES ConfigVariableBool lod_budget_controlled;
+extern ConfigVariableInt lod_budget_vertices;
+extern ConfigVariableDouble lod_budget_frame_time;
+extern ConfigVariableDouble lod_budget_hysteresis;
+extern ConfigVariableDouble lod_budget_adjust_rate;
+extern ConfigVariableDouble lod_budget_min_scale;
+extern ConfigVariableDouble lod_budget_max_scale;
 
 extern ConfigVariableInt parallax_mapping_samples;
 extern ConfigVariableDouble parallax_mapping_scale;
@@ -94,19 +94,25 @@ cull_callback(CullTraverser *trav, CullTraverserData &data) {
 
   Camera *camera = trav->get_scene()->get_camera_node();
   NodePath this_np = data.get_node_path();
-  FadeLODNodeData *ldata =
-    DCAST(FadeLODNodeData, camera->get_aux_scene_data(this_np));
+  AuxSceneData *aux = camera->get_aux_scene_data(this_np);
+  FadeLODNodeData *ldata = nullptr;
+  if (aux != nullptr && aux->is_of_type(FadeLODNodeData::get_class_type())) {
+    // It may instead be the LODNodeData stored while support-fade-lod was
+    // off.
+    ldata = DCAST(FadeLODNodeData, aux);
+  }
 
   double now = ClockObject::get_global_clock()->get_frame_time();
 
   if (ldata == nullptr || now > ldata->get_expiration_time()) {
     // This is the first time we have rendered this instance of this LOD node
-    // in a while.
+    // in a while.  The data is stored before the child is computed, since a
+    // budget-controlled node keeps its level in it.
     ldata = new FadeLODNodeData;
     ldata->_fade_mode = FadeLODNodeData::FM_solid;
     ldata->_fade_out = -1;
-    ldata->_fade_in = compute_child(trav, data);
     camera->set_aux_scene_data(this_np, ldata);
+    ldata->_fade_in = compute_child(trav, data);
 
   } else {
     // We had rendered this LOD node last frame (or not too long ago, at
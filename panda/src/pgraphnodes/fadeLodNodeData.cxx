@@ -21,7 +21,7 @@ TypeHandle FadeLODNodeData::_type_handle;
  */
 void FadeLODNodeData::
 output(std::ostream &out) const {
-  AuxSceneData::output(out);
+  LODNodeData::output(out);
   if (_fade_mode != FM_solid) {
     out << " fading " << _fade_out << " to " << _fade_in << " since "
         << _fade_start;
@@ -16,13 +16,13 @@
 
 #include "pandabase.h"
 
-#include "auxSceneData.h"
+#include "lodNodeData.h"
 
 /**
  * This is the data that is associated with a particular instance of the
  * FadeLODNode for the scene graph.
  */
-class EXPCL_PANDA_PGRAPHNODES FadeLODNodeData : public AuxSceneData {
+class EXPCL_PANDA_PGRAPHNODES FadeLODNodeData : public LODNodeData {
 public:
   enum FadeMode {
     FM_solid,
@@ -41,9 +41,9 @@ public:
     return _type_handle;
   }
   static void init_type() {
-    AuxSceneData::init_type();
+    LODNodeData::init_type();
     register_type(_type_handle, "FadeLODNodeData",
-                  AuxSceneData::get_class_type());
+                  LODNodeData::get_class_type());
   }
   virtual TypeHandle get_type() const {
     return get_class_type();
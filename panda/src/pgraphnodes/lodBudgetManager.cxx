@@ -0,0 +1,132 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file lodBudgetManager.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "lodBudgetManager.h"
+
+LODBudgetManager *LODBudgetManager::_global_ptr = nullptr;
+
+PStatCollector LODBudgetManager::_vertices_pcollector("LOD budget vertices");
+PStatCollector LODBudgetManager::_scale_pcollector("LOD budget scale");
+
+/**
+ *
+ */
+LODBudgetManager::
+LODBudgetManager() :
+  _lock("LODBudgetManager::_lock"),
+  _vertex_budget(lod_budget_vertices),
+  _frame_time_budget(lod_budget_frame_time),
+  _hysteresis(lod_budget_hysteresis),
+  _adjust_rate(lod_budget_adjust_rate),
+  _min_scale(lod_budget_min_scale),
+  _max_scale(lod_budget_max_scale),
+  _scale(1.0f),
+  _measured_vertices(0),
+  _measured_frame_time(0.0),
+  _frame(-1),
+  _frame_vertices(0)
+{
+  _scale = std::max(_min_scale, std::min(_scale, _max_scale));
+}
+
+/**
+ * Returns the distance scale to 1, or as near as the scale range allows, and
+ * forgets the load measured so far.
+ */
+void LODBudgetManager::
+reset() {
+  LightMutexHolder holder(_lock);
+  _scale = std::max(_min_scale, std::min((PN_stdfloat)1.0f, _max_scale));
+  _measured_vertices = 0;
+  _measured_frame_time = 0.0;
+  AtomicAdjust::set(_frame_vertices, 0);
+}
+
+/**
+ *
+ */
+void LODBudgetManager::
+output(std::ostream &out) const {
+  out << "LODBudgetManager scale " << _scale << ", " << _measured_vertices
+      << " vertices";
+  if (_vertex_budget > 0) {
+    out << " of " << _vertex_budget;
+  }
+  out << ", " << _measured_frame_time * 1000.0 << " ms";
+  if (_frame_time_budget > 0.0) {
+    out << " of " << _frame_time_budget * 1000.0;
+  }
+}
+
+/**
+ * Returns the pointer to the global LODBudgetManager object.
+ */
+LODBudgetManager *LODBudgetManager::
+get_global_ptr() {
+  if (_global_ptr == nullptr) {
+    _global_ptr = new LODBudgetManager;
+  }
+  return _global_ptr;
+}
+
+/**
+ * Takes the load measured over the previous frame and adjusts the scale
+ * accordingly, at the start of the indicated frame.
+ */
+void LODBudgetManager::
+do_update(int frame, Thread *current_thread) {
+  LightMutexHolder holder(_lock);
+  if (frame == (int)AtomicAdjust::get(_frame)) {
+    // Another cull thread got here first.
+    return;
+  }
+  AtomicAdjust::set(_frame, frame);
+
+  _measured_vertices = (int)AtomicAdjust::set(_frame_vertices, 0);
+
+  // The frame time is noisy, so we smooth it out a bit before comparing it
+  // to the budget.
+  double dt = ClockObject::get_global_clock()->get_dt(current_thread);
+  if (_measured_frame_time <= 0.0) {
+    _measured_frame_time = dt;
+  } else {
+    _measured_frame_time += (dt - _measured_frame_time) * 0.2;
+  }
+
+  // Find how heavily loaded we are relative to whichever budget is the
+  // tightest.
+  double load = 0.0;
+  bool have_budget = false;
+  if (_vertex_budget > 0) {
+    load = std::max(load, (double)_measured_vertices / (double)_vertex_budget);
+    have_budget = true;
+  }
+  if (_frame_time_budget > 0.0) {
+    load = std::max(load, _measured_frame_time / _frame_time_budget);
+    have_budget = true;
+  }
+
+  if (have_budget) {
+    if (load > 1.0) {
+      // Over budget; push the switches towards the camera.
+      _scale = std::min(_scale * (1.0f + _adjust_rate), _max_scale);
+
+    } else if (load < 1.0 - _hysteresis) {
+      // Comfortably under budget; bring detail back in.
+      _scale = std::max(_scale / (1.0f + _adjust_rate), _min_scale);
+    }
+  }
+
+  _vertices_pcollector.set_level(_measured_vertices);
+  _scale_pcollector.set_level(_scale);
+}
@@ -0,0 +1,120 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file lodBudgetManager.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef LODBUDGETMANAGER_H
+#define LODBUDGETMANAGER_H
+
+#include "pandabase.h"
+#include "config_pgraphnodes.h"
+#include "lightMutex.h"
+#include "lightMutexHolder.h"
+#include "clockObject.h"
+#include "atomicAdjust.h"
+#include "pStatCollector.h"
+
+/**
+ * This global object scales the switch distances of every budget-controlled
+ * LODNode (see LODNode::set_budget_controlled()) up or down to keep the scene
+ * within a vertex budget, a frame time budget, or both.
+ *
+ * Each frame, the budget-controlled LODNodes report the number of vertices in
+ * the levels they select, and the frame time is taken from the global clock.
+ * When either exceeds its budget, the distance scale is increased, which
+ * moves the switches towards the camera; when both have dropped below their
+ * budgets by more than the hysteresis fraction, it is decreased again.  In
+ * between, the scale is left alone, so that it does not swing back and forth
+ * between two values.
+ *
+ * The measured load and the current scale are reported to PStats as "LOD
+ * budget vertices" and "LOD budget scale".
+ */
+class EXPCL_PANDA_PGRAPHNODES LODBudgetManager {
+protected:
+  LODBudgetManager();
+
+PUBLISHED:
+  INLINE void set_vertex_budget(int budget);
+  INLINE int get_vertex_budget() const;
+  MAKE_PROPERTY(vertex_budget, get_vertex_budget, set_vertex_budget);
+
+  INLINE void set_frame_time_budget(double budget);
+  INLINE double get_frame_time_budget() const;
+  MAKE_PROPERTY(frame_time_budget, get_frame_time_budget, set_frame_time_budget);
+
+  INLINE void set_hysteresis(PN_stdfloat hysteresis);
+  INLINE PN_stdfloat get_hysteresis() const;
+  MAKE_PROPERTY(hysteresis, get_hysteresis, set_hysteresis);
+
+  INLINE void set_adjust_rate(PN_stdfloat adjust_rate);
+  INLINE PN_stdfloat get_adjust_rate() const;
+  MAKE_PROPERTY(adjust_rate, get_adjust_rate, set_adjust_rate);
+
+  INLINE void set_scale_range(PN_stdfloat min_scale, PN_stdfloat max_scale);
+  INLINE PN_stdfloat get_min_scale() const;
+  INLINE PN_stdfloat get_max_scale() const;
+  MAKE_PROPERTY(min_scale, get_min_scale);
+  MAKE_PROPERTY(max_scale, get_max_scale);
+
+  INLINE PN_stdfloat get_scale() const;
+  INLINE int get_measured_vertices() const;
+  INLINE double get_measured_frame_time() const;
+  MAKE_PROPERTY(scale, get_scale);
+  MAKE_PROPERTY(measured_vertices, get_measured_vertices);
+  MAKE_PROPERTY(measured_frame_time, get_measured_frame_time);
+
+  void reset();
+
+  void output(std::ostream &out) const;
+
+  static LODBudgetManager *get_global_ptr();
+
+public:
+  INLINE PN_stdfloat begin_cull(Thread *current_thread);
+  INLINE void add_vertices(int num_vertices);
+
+private:
+  void do_update(int frame, Thread *current_thread);
+
+private:
+  LightMutex _lock;
+
+  int _vertex_budget;
+  double _frame_time_budget;
+  PN_stdfloat _hysteresis;
+  PN_stdfloat _adjust_rate;
+  PN_stdfloat _min_scale;
+  PN_stdfloat _max_scale;
+
+  PN_stdfloat _scale;
+  int _measured_vertices;
+  double _measured_frame_time;
+
+  // The frame in which the scale was last updated, and the vertices that
+  // have been counted so far in that frame.
+  AtomicAdjust::Integer _frame;
+  AtomicAdjust::Integer _frame_vertices;
+
+  static PStatCollector _vertices_pcollector;
+  static PStatCollector _scale_pcollector;
+
+  static LODBudgetManager *_global_ptr;
+};
+
+INLINE std::ostream &operator << (std::ostream &out, const LODBudgetManager &manager) {
+  manager.output(out);
+  return out;
+}
+
+#include "lodBudgetManager.I"
+
+#endif
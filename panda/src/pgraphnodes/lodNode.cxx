@@ -13,6 +13,10 @@
 
 #include "lodNode.h"
 #include "fadeLodNode.h"
+#include "lodBudgetManager.h"
+#include "lodNodeData.h"
+#include "fadeLodNodeData.h"
+#include "clockObject.h"
 #include "cullTraverserData.h"
 #include "cullTraverser.h"
 #include "config_pgraphnodes.h"
@@ -91,6 +95,17 @@ safe_to_combine_children() const {
   return false;
 }
 
+/**
+ * Returns true if it is safe for share_subgraph() to share this node between
+ * all of the copies of a model.  An LODNode is never shared, since it
+ * remembers the level it last chose for each camera, which is different for
+ * each copy.
+ */
+bool LODNode::
+safe_to_share() const {
+  return false;
+}
+
 /**
  * Transforms the contents of this PandaNode by the indicated matrix, if it
  * means anything to do so.  For most kinds of PandaNodes, this does nothing.
@@ -146,6 +161,21 @@ cull_callback(CullTraverser *trav, CullTraverserData &data) {
   LPoint3 center = cdata->_center * rel_transform->get_mat();
   PN_stdfloat dist2 = center.dot(center);
 
+  if (cdata->_budget_controlled && !cdata->_got_force_switch) {
+    // In this mode, we draw just the one level chosen by the budget.
+    Camera *camera = trav->get_scene()->get_camera_node();
+    int index = do_compute_budget_child(cdata, dist2 * cdata->_lod_scale
+                                        * camera->get_lod_scale(), trav, data);
+    if (index >= 0 && index < get_num_children()) {
+      PandaNode *child = get_child(index);
+      if (child != nullptr) {
+        CullTraverserData next_data(data, child);
+        trav->traverse(next_data);
+      }
+    }
+    return false;
+  }
+
   int num_children = std::min(get_num_children(), (int)cdata->_switch_vector.size());
   for (int index = 0; index < num_children; ++index) {
     const Switch &sw = cdata->_switch_vector[index];
@@ -192,6 +222,9 @@ output(std::ostream &out) const {
       ++si;
     }
   }
+  if (cdata->_budget_controlled) {
+    out << " budget";
+  }
 }
 
 /**
@@ -325,6 +358,18 @@ compute_child(CullTraverser *trav, CullTraverserData &data) {
   LPoint3 center = cdata->_center * rel_transform->get_mat();
   PN_stdfloat dist2 = center.dot(center);
 
+  if (cdata->_budget_controlled) {
+    Camera *camera = trav->get_scene()->get_camera_node();
+    int index = do_compute_budget_child(cdata, dist2 * cdata->_lod_scale
+                                        * camera->get_lod_scale(), trav, data);
+    if (pgraph_cat.is_debug()) {
+      pgraph_cat.debug()
+        << data.get_node_path() << " at distance " << sqrt(dist2)
+        << ", selected child " << index << " within budget\n";
+    }
+    return index;
+  }
+
   for (int index = 0; index < (int)cdata->_switch_vector.size(); ++index) {
     if (cdata->_switch_vector[index].in_range_2(dist2 * cdata->_lod_scale
          * trav->get_scene()->get_camera_node()->get_lod_scale())) {
@@ -483,6 +528,70 @@ get_rel_transform(CullTraverser *trav, CullTraverserData &data) {
   return rel_transform;
 }
 
+/**
+ * Chooses the level to draw in budget-controlled mode, given the square of
+ * the distance to the camera with the node's own lod scales already applied.
+ * The level chosen last time for the same instance of the node, as seen by
+ * the same camera, is kept while it is still within its widened range.  The
+ * vertices of the chosen level are counted towards the budget.  Returns the
+ * index of the level, or -1 if none is in range.
+ */
+int LODNode::
+do_compute_budget_child(const CData *cdata, PN_stdfloat dist2,
+                        CullTraverser *trav, CullTraverserData &data) {
+  Thread *current_thread = trav->get_current_thread();
+  LODBudgetManager *manager = LODBudgetManager::get_global_ptr();
+  PN_stdfloat scale = manager->begin_cull(current_thread);
+  dist2 *= scale * scale;
+
+  int num_switches = (int)cdata->_switch_vector.size();
+  PN_stdfloat factor = 1.0f + manager->get_hysteresis();
+
+  // Each instance of the node is at its own distance from each camera, so
+  // the level is remembered per instance on the camera, as the FadeLODNode
+  // does; a FadeLODNode keeps it in its own FadeLODNodeData.
+  Camera *camera = trav->get_scene()->get_camera_node();
+  NodePath this_np = data.get_node_path();
+  AuxSceneData *aux = camera->get_aux_scene_data(this_np);
+  LODNodeData *ldata = nullptr;
+  if (aux != nullptr && aux->is_of_type(LODNodeData::get_class_type())) {
+    ldata = DCAST(LODNodeData, aux);
+  } else {
+    ldata = new LODNodeData;
+    camera->set_aux_scene_data(this_np, ldata);
+  }
+
+  double now = ClockObject::get_global_clock()->get_frame_time(current_thread);
+  if (now > ldata->get_expiration_time()) {
+    // We haven't drawn this instance in a while, so start over.
+    ldata->_budget_child = -1;
+  }
+  if (!ldata->is_of_type(FadeLODNodeData::get_class_type())) {
+    // The level is forgotten once the instance has gone unrendered for a
+    // second.  A FadeLODNode manages the lifetime of its own data.
+    ldata->set_last_render_time(now);
+    ldata->set_duration(1.0);
+  }
+
+  int index = ldata->_budget_child;
+  if (index < 0 || index >= num_switches ||
+      !cdata->_switch_vector[index].in_widened_range_2(dist2, factor)) {
+    index = -1;
+    for (int i = 0; i < num_switches; ++i) {
+      if (cdata->_switch_vector[i].in_range_2(dist2)) {
+        index = i;
+        break;
+      }
+    }
+    ldata->_budget_child = index;
+  }
+
+  if (index >= 0 && index < get_num_children()) {
+    manager->add_vertices(get_child(index, current_thread)->get_nested_vertices(current_thread));
+  }
+  return index;
+}
+
 /**
  * The private implementation of show_switch().
  */
@@ -37,6 +37,7 @@ public:
   virtual PandaNode *make_copy() const;
   virtual bool safe_to_combine() const;
   virtual bool safe_to_combine_children() const;
+  virtual bool safe_to_share() const;
   virtual void xform(const LMatrix4 &mat);
   virtual bool cull_callback(CullTraverser *trav, CullTraverserData &data);
 
@@ -75,12 +76,17 @@ PUBLISHED:
   INLINE void set_center(const LPoint3 &center);
   INLINE const LPoint3 &get_center() const;
 
+  INLINE void set_budget_controlled(bool budget_controlled);
+  INLINE bool is_budget_controlled() const;
+
   MAKE_SEQ_PROPERTY(ins, get_num_switches, get_in);
   MAKE_SEQ_PROPERTY(outs, get_num_switches, get_out);
   MAKE_PROPERTY(lowest_switch, get_lowest_switch);
   MAKE_PROPERTY(highest_switch, get_highest_switch);
   MAKE_PROPERTY(lod_scale, get_lod_scale, set_lod_scale);
   MAKE_PROPERTY(center, get_center, set_center);
+  MAKE_PROPERTY(budget_controlled, is_budget_controlled,
+                                   set_budget_controlled);
 
   void show_switch(int index);
   void show_switch(int index, const LColor &color);
@@ -111,6 +117,8 @@ private:
   bool do_verify_child_bounds(const CData *cdata, int index,
                               PN_stdfloat &suggested_radius) const;
   void do_auto_verify_lods(CullTraverser *trav, CullTraverserData &data);
+  int do_compute_budget_child(const CData *cdata, PN_stdfloat dist2,
+                              CullTraverser *trav, CullTraverserData &data);
 
   static const LColor &get_default_show_color(int index);
 
@@ -124,6 +132,7 @@ protected:
     INLINE void set_range(PN_stdfloat in, PN_stdfloat out);
     INLINE bool in_range(PN_stdfloat dist) const;
     INLINE bool in_range_2(PN_stdfloat dist2) const;
+    INLINE bool in_widened_range_2(PN_stdfloat dist2, PN_stdfloat factor) const;
 
     INLINE void rescale(PN_stdfloat factor);
 
@@ -184,6 +193,7 @@ private:
     int _force_switch;
     int _num_shown;
     PN_stdfloat _lod_scale;
+    bool _budget_controlled;
   };
 
   PipelineCycler<CData> _cycler;
@@ -0,0 +1,25 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file lodNodeData.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "lodNodeData.h"
+
+TypeHandle LODNodeData::_type_handle;
+
+/**
+ *
+ */
+void LODNodeData::
+output(std::ostream &out) const {
+  AuxSceneData::output(out);
+  out << " budget level " << _budget_child;
+}
@@ -0,0 +1,54 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file lodNodeData.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef LODNODEDATA_H
+#define LODNODEDATA_H
+
+#include "pandabase.h"
+
+#include "auxSceneData.h"
+
+/**
+ * This is the data that is associated with a particular instance of a
+ * budget-controlled LODNode for each camera: the level that was chosen for
+ * it last, which is kept while it remains within its widened range.
+ */
+class EXPCL_PANDA_PGRAPHNODES LODNodeData : public AuxSceneData {
+public:
+  INLINE LODNodeData();
+
+  int _budget_child;
+
+  virtual void output(std::ostream &out) const;
+
+public:
+  static TypeHandle get_class_type() {
+    return _type_handle;
+  }
+  static void init_type() {
+    AuxSceneData::init_type();
+    register_type(_type_handle, "LODNodeData",
+                  AuxSceneData::get_class_type());
+  }
+  virtual TypeHandle get_type() const {
+    return get_class_type();
+  }
+  virtual TypeHandle force_init_type() {init_type(); return get_class_type();}
+
+private:
+  static TypeHandle _type_handle;
+};
+
+#include "lodNodeData.I"
+
+#endif
@@ -7,5 +7,7 @@
 #include "fadeLodNodeData.cxx"
 #include "lightLensNode.cxx"
 #include "lightNode.cxx"
+#include "lodBudgetManager.cxx"
 #include "lodNode.cxx"
+#include "lodNodeData.cxx"
 #include "lodNodeType.cxx"
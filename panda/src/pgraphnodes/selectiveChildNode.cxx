@@ -15,6 +15,17 @@
 
 TypeHandle SelectiveChildNode::_type_handle;
 
+/**
+ * Returns true if it is safe for share_subgraph() to share this node between
+ * all of the copies of a model.  A SelectiveChildNode is never shared, since
+ * the child it selects is changed as it is rendered, and by methods such as
+ * SwitchNode::set_visible_child() and SequenceNode::play(), which are called
+ * on the node directly; each copy must make its own selection.
+ */
+bool SelectiveChildNode::
+safe_to_share() const {
+  return false;
+}
 
 /**
  * Should be overridden by derived classes to return true if this kind of node
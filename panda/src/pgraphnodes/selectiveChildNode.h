@@ -30,6 +30,7 @@ protected:
   INLINE SelectiveChildNode(const SelectiveChildNode &copy);
 
 public:
+  virtual bool safe_to_share() const;
   virtual bool has_selective_visibility() const;
   virtual int get_first_visible_child() const;
   virtual int get_next_visible_child(int n) const;
@@ -51,6 +51,13 @@ ConfigVariableDouble scroll_continued_delay
           "scrolled while the user is continuing to hold down the scrollbar "
           "button."));
 
+ConfigVariableInt pgui_frame_cache_size
+("pgui-frame-cache-size", 1024,
+ PRC_DESC("This is the maximum number of distinct frames whose generated "
+          "geometry is kept by PGFrameStyle, so that items with the same "
+          "frame style and size can share it rather than generating it "
+          "again.  Set this to 0 to generate the geometry for every frame."));
+
 /**
  * Initializes the library.  This must be called at least once before any of
  * the functions or classes in this library can be used.  Normally it will be
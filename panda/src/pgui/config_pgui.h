@@ -17,12 +17,14 @@
 #include "pandabase.h"
 #include "notifyCategoryProxy.h"
 #include "configVariableDouble.h"
+#include "configVariableInt.h"
 
 NotifyCategoryDecl(pgui, EXPCL_PANDA_PGUI, EXPTP_PANDA_PGUI);
 
 // Configure variables for pgui package.
 extern ConfigVariableDouble scroll_initial_delay;
 extern ConfigVariableDouble scroll_continued_delay;
+extern ConfigVariableInt pgui_frame_cache_size;
 
 extern EXPCL_PANDA_PGUI void init_libpgui();
 
@@ -24,6 +24,9 @@
 #include "geom.h"
 #include "geomTristrips.h"
 #include "geomVertexWriter.h"
+#include "config_pgui.h"
+#include "clockObject.h"
+#include "lightMutexHolder.h"
 
 using std::max;
 using std::min;
@@ -33,6 +36,36 @@ using std::min;
 // it's hardcoded to fit the entire texture over the rectangular frame.
 static const LVecBase4 uv_range = LVecBase4(0.0f, 1.0f, 0.0f, 1.0f);
 
+/**
+ * Sets the indicated texture on each of the Geoms of the node, which is a
+ * GeomNode generated by PGFrameStyle, or removes the texture if tex is NULL.
+ */
+static void
+set_geom_textures(PandaNode *node, Texture *tex) {
+  if (!node->is_geom_node()) {
+    return;
+  }
+  GeomNode *gnode = (GeomNode *)node;
+  int num_geoms = gnode->get_num_geoms();
+  for (int i = 0; i < num_geoms; ++i) {
+    CPT(RenderState) state = gnode->get_geom_state(i);
+    if (tex != nullptr) {
+      state = state->set_attrib(TextureAttrib::make(tex));
+    } else {
+      state = state->remove_attrib(TextureAttrib::get_class_slot());
+    }
+    gnode->set_geom_state(i, state);
+  }
+}
+
+PGFrameStyle::FrameCache PGFrameStyle::_frame_cache;
+PGFrameStyle::FrameLru PGFrameStyle::_frame_lru;
+LightMutex PGFrameStyle::_frame_cache_lock("PGFrameStyle::_frame_cache_lock");
+int PGFrameStyle::_counted_frame = -1;
+
+PStatCollector PGFrameStyle::_generated_pcollector("PGui frames:Generated");
+PStatCollector PGFrameStyle::_reused_pcollector("PGui frames:Reused");
+
 std::ostream &
 operator << (std::ostream &out, PGFrameStyle::Type type) {
   switch (type) {
@@ -146,13 +179,18 @@ xform(const LMatrix4 &mat) {
  * Generates geometry representing a frame of the indicated size, and parents
  * it to the indicated node, with the indicated scene graph sort order.
  *
+ * If a frame of the same style and size has been generated before, the new
+ * node shares its geometry rather than generating it again.
+ *
  * The return value is the generated NodePath, if any, or an empty NodePath if
  * nothing is generated.
  */
 NodePath PGFrameStyle::
 generate_into(const NodePath &parent, const LVecBase4 &frame,
               int sort) {
-  PT(PandaNode) new_node;
+  if (_type == T_none) {
+    return NodePath();
+  }
 
   LPoint2 center((frame[0] + frame[1]) / 2.0f,
                   (frame[2] + frame[3]) / 2.0f);
@@ -162,10 +200,44 @@ generate_into(const NodePath &parent, const LVecBase4 &frame,
      (frame[2] - center[1]) * _visible_scale[1] + center[1],
      (frame[3] - center[1]) * _visible_scale[1] + center[1]);
 
-  switch (_type) {
-  case T_none:
-    return NodePath();
+  FrameKey key;
+  key._type = _type;
+  key._color = _color;
+  key._texture = _texture;
+  key._width = _width;
+  key._uv_width = _uv_width;
+  key._frame = scaled_frame;
+
+  PT(PandaNode) new_node;
+  int cache_size = pgui_frame_cache_size;
+  if (cache_size > 0) {
+    LightMutexHolder holder(_frame_cache_lock);
+    FrameCache::iterator fi = _frame_cache.find(key);
+    if (fi != _frame_cache.end() && (*fi).first._texture.was_deleted()) {
+      // This was made for a texture that has since been deleted, and whose
+      // address has been reused.
+      _frame_lru.erase((*fi).second._lru);
+      _frame_cache.erase(fi);
+      fi = _frame_cache.end();
+    }
+    if (fi != _frame_cache.end()) {
+      // The copy shares the Geoms of the cached node.
+      CachedFrame &cached = (*fi).second;
+      _frame_lru.splice(_frame_lru.end(), _frame_lru, cached._lru);
+      new_node = cached._node->make_copy();
+      do_count_frame();
+      _reused_pcollector.add_level(1);
+    }
+  }
+
+  if (new_node != nullptr) {
+    if (has_texture()) {
+      set_geom_textures(new_node, _texture);
+    }
+    return parent.attach_new_node(new_node, sort);
+  }
 
+  switch (_type) {
   case T_flat:
     new_node = generate_flat_geom(scaled_frame);
     break;
@@ -199,10 +271,120 @@ generate_into(const NodePath &parent, const LVecBase4 &frame,
     new_node->set_attrib(TransparencyAttrib::make(TransparencyAttrib::M_alpha));
   }
 
+  LightMutexHolder holder(_frame_cache_lock);
+  if (new_node != nullptr && cache_size > 0) {
+    // Keep a copy of the node we generated, so that any changes made to this
+    // one don't affect the next, and so that the copy doesn't keep the
+    // texture alive.
+    PT(PandaNode) cached_node = new_node->make_copy();
+    if (has_texture()) {
+      set_geom_textures(cached_node, nullptr);
+    }
+
+    FrameCache::iterator fi = _frame_cache.find(key);
+    if (fi != _frame_cache.end()) {
+      // Another thread got here first, or this entry was left over from a
+      // deleted texture.  Replace it.
+      _frame_lru.erase((*fi).second._lru);
+      _frame_cache.erase(fi);
+    }
+
+    // Make room by discarding the frames that have gone unused longest.
+    while (!_frame_lru.empty() && _frame_cache.size() >= (size_t)cache_size) {
+      FrameCache::iterator oldest = _frame_cache.find(*_frame_lru.front());
+      _frame_lru.pop_front();
+      if (oldest != _frame_cache.end()) {
+        _frame_cache.erase(oldest);
+      }
+    }
+
+    fi = _frame_cache.insert(FrameCache::value_type(key, CachedFrame())).first;
+    (*fi).second._node = cached_node;
+    (*fi).second._lru = _frame_lru.insert(_frame_lru.end(), &(*fi).first);
+  }
+  do_count_frame();
+  _generated_pcollector.add_level(1);
+
   // Adding the node to the parent keeps the reference count.
   return parent.attach_new_node(new_node, sort);
 }
 
+/**
+ * Empties the cache of generated frames, releasing their geometry and any
+ * textures they reference.  Frames generated after this call will be
+ * generated anew.
+ */
+void PGFrameStyle::
+clear_frame_cache() {
+  LightMutexHolder holder(_frame_cache_lock);
+  _frame_cache.clear();
+  _frame_lru.clear();
+}
+
+/**
+ * Returns the number of distinct frames whose geometry is currently kept in
+ * the cache.
+ */
+int PGFrameStyle::
+get_num_cached_frames() {
+  LightMutexHolder holder(_frame_cache_lock);
+  return (int)_frame_cache.size();
+}
+
+/**
+ * Resets the PStats counts of generated and reused frames, if nothing has
+ * been counted since a new frame began.  This is called by PGTop at cull
+ * time, so that a frame in which no frames were generated reports zero.
+ */
+void PGFrameStyle::
+update_frame_counters() {
+  LightMutexHolder holder(_frame_cache_lock);
+  do_count_frame();
+}
+
+/**
+ * Resets the PStats counts of generated and reused frames the first time
+ * this is called in each new frame, before anything is counted in it.  The
+ * counts are therefore those of the whole frame, including any frames
+ * generated by the application before the cull traversal.  Assumes the lock
+ * is held.
+ */
+void PGFrameStyle::
+do_count_frame() {
+  int frame = ClockObject::get_global_clock()->get_frame_count();
+  if (frame != _counted_frame) {
+    _counted_frame = frame;
+    _generated_pcollector.clear_level();
+    _reused_pcollector.clear_level();
+  }
+}
+
+/**
+ * Provides an ordering for the frame cache.
+ */
+bool PGFrameStyle::FrameKey::
+operator < (const FrameKey &other) const {
+  if (_type != other._type) {
+    return _type < other._type;
+  }
+  if (_texture.get_orig() != other._texture.get_orig()) {
+    return _texture.get_orig() < other._texture.get_orig();
+  }
+  int compare = _frame.compare_to(other._frame, 0.0f);
+  if (compare != 0) {
+    return compare < 0;
+  }
+  compare = _color.compare_to(other._color, 0.0f);
+  if (compare != 0) {
+    return compare < 0;
+  }
+  compare = _width.compare_to(other._width, 0.0f);
+  if (compare != 0) {
+    return compare < 0;
+  }
+  return _uv_width.compare_to(other._uv_width, 0.0f) < 0;
+}
+
 /**
  * Generates the GeomNode appropriate to a T_flat frame.
  */
@@ -19,6 +19,11 @@
 #include "luse.h"
 #include "texture.h"
 #include "pointerTo.h"
+#include "pmap.h"
+#include "plist.h"
+#include "weakPointerTo.h"
+#include "lightMutex.h"
+#include "pStatCollector.h"
 
 class PandaNode;
 class NodePath;
@@ -72,11 +77,16 @@ PUBLISHED:
 
   void output(std::ostream &out) const;
 
+  static void clear_frame_cache();
+  static int get_num_cached_frames();
+
 public:
   bool xform(const LMatrix4 &mat);
   NodePath generate_into(const NodePath &parent, const LVecBase4 &frame,
                          int sort = 0);
 
+  static void update_frame_counters();
+
 private:
   PT(PandaNode) generate_flat_geom(const LVecBase4 &frame);
   PT(PandaNode) generate_bevel_geom(const LVecBase4 &frame, bool in);
@@ -90,6 +100,42 @@ private:
   LVecBase2 _width;
   LVecBase2 _uv_width;
   LVecBase2 _visible_scale;
+
+  static void do_count_frame();
+
+  // Frames that have already been generated, keyed by everything that goes
+  // into generating them, so that items of the same style and size can share
+  // the same geometry.  The cache holds only a weak reference to the texture;
+  // the cached geometry is stored without it, and the texture is applied
+  // again to each copy that is handed out.
+  class FrameKey {
+  public:
+    bool operator < (const FrameKey &other) const;
+
+    Type _type;
+    LColor _color;
+    WPT(Texture) _texture;
+    LVecBase2 _width;
+    LVecBase2 _uv_width;
+    LVecBase4 _frame;
+  };
+
+  // The least recently used frame is at the front of the list.
+  typedef plist<const FrameKey *> FrameLru;
+
+  class CachedFrame {
+  public:
+    PT(PandaNode) _node;
+    FrameLru::iterator _lru;
+  };
+  typedef pmap<FrameKey, CachedFrame> FrameCache;
+  static FrameCache _frame_cache;
+  static FrameLru _frame_lru;
+  static LightMutex _frame_cache_lock;
+  static int _counted_frame;
+
+  static PStatCollector _generated_pcollector;
+  static PStatCollector _reused_pcollector;
 };
 
 INLINE std::ostream &operator << (std::ostream &out, const PGFrameStyle &pfs);
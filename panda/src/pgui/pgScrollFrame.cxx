@@ -350,11 +350,19 @@ recompute_clip() {
 
   set_clip_frame(clip);
 
+  // Only touch the slider bars if the page size really changed; otherwise
+  // they would recompute, and perhaps regenerate their thumbs, for nothing.
   if (_horizontal_slider != nullptr) {
-    _horizontal_slider->set_page_size((clip[1] - clip[0]) / (_virtual_frame[1] - _virtual_frame[0]));
+    PN_stdfloat page_size = (clip[1] - clip[0]) / (_virtual_frame[1] - _virtual_frame[0]);
+    if (_horizontal_slider->get_page_size() != page_size) {
+      _horizontal_slider->set_page_size(page_size);
+    }
   }
   if (_vertical_slider != nullptr) {
-    _vertical_slider->set_page_size((clip[3] - clip[2]) / (_virtual_frame[3] - _virtual_frame[2]));
+    PN_stdfloat page_size = (clip[3] - clip[2]) / (_virtual_frame[3] - _virtual_frame[2]);
+    if (_vertical_slider->get_page_size() != page_size) {
+      _vertical_slider->set_page_size(page_size);
+    }
   }
 }
 
@@ -382,7 +390,14 @@ recompute_canvas() {
                           _virtual_frame[3], _virtual_frame[2],
                           _vertical_slider);
 
-  _canvas_node->set_transform(TransformState::make_pos(LVector3::rfu(cx, 0, cy)));
+  // Scrolling only moves the canvas; nothing under it is regenerated.  Don't
+  // replace the transform if it hasn't changed, to avoid needlessly marking
+  // the bounds of the canvas stale.
+  CPT(TransformState) transform = TransformState::make_pos(LVector3::rfu(cx, 0, cy));
+  CPT(TransformState) orig_transform = _canvas_node->get_transform();
+  if (transform != orig_transform && *transform != *orig_transform) {
+    _canvas_node->set_transform(transform);
+  }
 }
 
 /**
@@ -14,6 +14,7 @@
 #include "pgTop.h"
 #include "pgMouseWatcherGroup.h"
 #include "pgCullTraverser.h"
+#include "pgFrameStyle.h"
 #include "cullBinAttrib.h"
 
 #include "omniBoundingVolume.h"
@@ -80,6 +81,8 @@ make_copy() const {
  */
 bool PGTop::
 cull_callback(CullTraverser *trav, CullTraverserData &data) {
+  PGFrameStyle::update_frame_counters();
+
   // We create a new MouseWatcherGroup for the purposes of collecting a new
   // set of regions visible onscreen.
   PT(PGMouseWatcherGroup) old_watcher_group;
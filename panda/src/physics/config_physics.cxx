@@ -33,6 +33,15 @@
 ConfigureDef(config_physics);
 NotifyCategoryDef(physics, "");
 
+ConfigVariableBool physics_batch_integrate
+("physics-batch-integrate", true,
+ PRC_DESC("Set this true to have the LinearEulerIntegrator evaluate the "
+          "forces on all of the objects in a physical at once, rather than "
+          "one object and one force at a time.  The PhysicsManager will "
+          "also integrate together the physicals that are subject to the "
+          "same set of forces.  Set it false to use the original "
+          "per-object code."));
+
 ConfigureFn(config_physics) {
   init_libphysics();
 }
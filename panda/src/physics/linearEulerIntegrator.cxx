@@ -16,6 +16,35 @@
 #include "physicalNode.h"
 #include "config_physics.h"
 
+#if !defined(STDFLOAT_DOUBLE) && (defined(__SSE2__) || (_M_IX86_FP >= 2) || defined(_M_X64) || defined(_M_AMD64))
+#include <emmintrin.h>
+#define LINEAR_EULER_SSE2
+#endif
+
+#ifdef LINEAR_EULER_SSE2
+/**
+ * Adds p * m to out, for the x, y and z components of four points at once.
+ * m holds the nine cells of a 3x3 matrix, each broadcast to all four lanes.
+ */
+static INLINE void
+mul_add4(__m128 out[3], const __m128 m[9], __m128 x, __m128 y, __m128 z) {
+  for (int j = 0; j < 3; ++j) {
+    out[j] = _mm_add_ps(out[j], _mm_add_ps(_mm_mul_ps(x, m[j]),
+      _mm_add_ps(_mm_mul_ps(y, m[3 + j]), _mm_mul_ps(z, m[6 + j]))));
+  }
+}
+
+/**
+ * Broadcasts each of the cells of the matrix to all four lanes.
+ */
+static INLINE void
+splat_matrix(__m128 out[9], const LMatrix3 &m) {
+  for (int j = 0; j < 9; ++j) {
+    out[j] = _mm_set1_ps(m.get_cell(j / 3, j % 3));
+  }
+}
+#endif  // LINEAR_EULER_SSE2
+
 /**
  * constructor
  */
@@ -30,6 +59,33 @@ LinearEulerIntegrator::
 ~LinearEulerIntegrator() {
 }
 
+/**
+ * Returns true, since this is the explicit Euler integrator.
+ */
+bool LinearEulerIntegrator::
+is_explicit_euler() const {
+  return true;
+}
+
+/**
+ * Integrates a group of physicals that are all subject to exactly the same
+ * forces.  When physics-batch-integrate is enabled, the objects of all of the
+ * physicals are integrated together in a single batch.
+ */
+void LinearEulerIntegrator::
+integrate_group(Physical *const *physicals, size_t num_physicals,
+                LinearForceVector &forces, PN_stdfloat dt) {
+  if (!physics_batch_integrate || num_physicals == 0) {
+    LinearIntegrator::integrate_group(physicals, num_physicals, forces, dt);
+    return;
+  }
+
+  for (size_t i = 0; i < num_physicals; ++i) {
+    store_last_positions(physicals[i]);
+  }
+  batch_integrate(physicals, num_physicals, forces, dt);
+}
+
 /**
  * Integrate a step of motion (based on dt) by applying every force in
  * force_vec to every object in obj_vec.
@@ -42,6 +98,11 @@ void LinearEulerIntegrator::
 child_integrate(Physical *physical,
                 LinearForceVector& forces,
                 PN_stdfloat dt) {
+  if (physics_batch_integrate) {
+    batch_integrate(&physical, 1, forces, dt);
+    return;
+  }
+
   // perform the precomputation.  Note that the vector returned by
   // get_precomputed_matrices() has the matrices loaded in order of force
   // type: first global, then local.  If you're using this as a guide to write
@@ -185,6 +246,289 @@ child_integrate(Physical *physical,
   }
 }
 
+/**
+ * Performs the same computation as the per-object loop in child_integrate(),
+ * for all of the objects in the given physicals at once.  The physicals must
+ * all be subject to the same forces; see integrate_group().
+ *
+ * Rather than asking each force for its vector once per object, the forces
+ * that are affine in the position and velocity of the object, which includes
+ * the vector, friction, sink and source forces, are first summed into a
+ * single set of matrices, which are then applied to four objects at a time
+ * where the hardware allows it.  Any other forces are still evaluated one
+ * object at a time.
+ */
+void LinearEulerIntegrator::
+batch_integrate(Physical *const *physicals, size_t num_physicals,
+                LinearForceVector &forces, PN_stdfloat dt) {
+  Physical *physical = physicals[0];
+
+  precompute_linear_matrices(physical, forces);
+  const MatrixVector &matrices = get_precomputed_linear_matrices();
+#ifndef NDEBUG
+  MatrixVector::const_iterator mi;
+  for (mi = matrices.begin(); mi != matrices.end(); ++mi) {
+    nassertv(!(*mi).is_nan());
+  }
+#endif  // NDEBUG
+
+  PN_stdfloat viscosity_damper = 1.0f - physical->get_viscosity();
+
+  // Sum up the forces.  The matrices are consumed in the same order as in
+  // child_integrate(): global forces first, then local, skipping inactive.
+  _affine.clear();
+  _general.clear();
+  size_t index = 0;
+
+  LinearForceVector::const_iterator fi;
+  for (fi = forces.begin(); fi != forces.end(); ++fi) {
+    if ((*fi)->get_active()) {
+      add_force(*fi, matrices[index++]);
+    }
+  }
+  const LinearForceVector &local_forces = physical->get_linear_forces();
+  for (fi = local_forces.begin(); fi != local_forces.end(); ++fi) {
+    if ((*fi)->get_active()) {
+      add_force(*fi, matrices[index++]);
+    }
+  }
+
+  // Gather the state of the objects into arrays.
+  _objects.clear();
+  for (size_t pi = 0; pi < num_physicals; ++pi) {
+    const PhysicsObject::Vector &objects = physicals[pi]->get_object_vector();
+    PhysicsObject::Vector::const_iterator oi;
+    for (oi = objects.begin(); oi != objects.end(); ++oi) {
+      PhysicsObject *object = *oi;
+      if (object != nullptr && object->get_active()) {
+        _objects.push_back(object);
+      }
+    }
+  }
+
+  size_t num_objects = _objects.size();
+  if (num_objects == 0) {
+    return;
+  }
+
+  for (int c = 0; c < 3; ++c) {
+    _pos[c].resize(num_objects);
+    _vel[c].resize(num_objects);
+  }
+  _inv_mass.resize(num_objects);
+
+  for (size_t i = 0; i < num_objects; ++i) {
+    PhysicsObject *object = _objects[i];
+    LPoint3 pos = object->get_position();
+    LVector3 vel = object->get_velocity();
+    PN_stdfloat mass = object->get_mass();
+    nassertv(mass != 0.0f);
+
+    for (int c = 0; c < 3; ++c) {
+      _pos[c][i] = pos[c];
+      _vel[c][i] = vel[c];
+    }
+    _inv_mass[i] = 1.0f / mass;
+  }
+
+  // The forces that aren't affine are accumulated one object at a time.
+  bool has_general = !_general.empty();
+  if (has_general) {
+    for (int c = 0; c < 3; ++c) {
+      _md_accum[c].assign(num_objects, 0.0f);
+      _accum[c].assign(num_objects, 0.0f);
+    }
+
+    for (size_t i = 0; i < num_objects; ++i) {
+      PhysicsObject *object = _objects[i];
+      GeneralForces::const_iterator gi;
+      for (gi = _general.begin(); gi != _general.end(); ++gi) {
+        LVector3 f = (*gi)._force->get_vector(object) * *(*gi)._xform;
+        physics_spam("batch_integrate "<<f);
+
+        FloatArray *accum = (*gi)._force->get_mass_dependent() ? _md_accum : _accum;
+        for (int c = 0; c < 3; ++c) {
+          accum[c][i] += f[c];
+        }
+      }
+    }
+  }
+
+  // Now step the position and velocity of each object, exactly as in
+  // child_integrate().
+  PN_stdfloat half_dt2 = 0.5f * dt * dt;
+  PN_stdfloat *px = _pos[0].data();
+  PN_stdfloat *py = _pos[1].data();
+  PN_stdfloat *pz = _pos[2].data();
+  PN_stdfloat *vx = _vel[0].data();
+  PN_stdfloat *vy = _vel[1].data();
+  PN_stdfloat *vz = _vel[2].data();
+  const PN_stdfloat *inv_mass = _inv_mass.data();
+  const AffineForces &af = _affine;
+
+  size_t i = 0;
+
+#ifdef LINEAR_EULER_SSE2
+  __m128 dt4 = _mm_set1_ps(dt);
+  __m128 half_dt24 = _mm_set1_ps(half_dt2);
+  __m128 damper4 = _mm_set1_ps(viscosity_damper);
+  __m128 md_constant[3], constant[3];
+  __m128 md_position[9], position[9], md_velocity[9], velocity[9];
+  for (int c = 0; c < 3; ++c) {
+    md_constant[c] = _mm_set1_ps(af._md_constant[c]);
+    constant[c] = _mm_set1_ps(af._constant[c]);
+  }
+  splat_matrix(md_position, af._md_position);
+  splat_matrix(position, af._position);
+  splat_matrix(md_velocity, af._md_velocity);
+  splat_matrix(velocity, af._velocity);
+
+  for (; i + 4 <= num_objects; i += 4) {
+    __m128 x = _mm_loadu_ps(px + i);
+    __m128 y = _mm_loadu_ps(py + i);
+    __m128 z = _mm_loadu_ps(pz + i);
+    __m128 u = _mm_loadu_ps(vx + i);
+    __m128 v = _mm_loadu_ps(vy + i);
+    __m128 w = _mm_loadu_ps(vz + i);
+
+    __m128 md[3] = { md_constant[0], md_constant[1], md_constant[2] };
+    __m128 nmd[3] = { constant[0], constant[1], constant[2] };
+    if (af._has_position) {
+      mul_add4(md, md_position, x, y, z);
+      mul_add4(nmd, position, x, y, z);
+    }
+    if (af._has_velocity) {
+      mul_add4(md, md_velocity, u, v, w);
+      mul_add4(nmd, velocity, u, v, w);
+    }
+    if (has_general) {
+      for (int c = 0; c < 3; ++c) {
+        md[c] = _mm_add_ps(md[c], _mm_loadu_ps(_md_accum[c].data() + i));
+        nmd[c] = _mm_add_ps(nmd[c], _mm_loadu_ps(_accum[c].data() + i));
+      }
+    }
+
+    __m128 im = _mm_loadu_ps(inv_mass + i);
+    __m128 ax = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(md[0], im), nmd[0]), damper4);
+    __m128 ay = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(md[1], im), nmd[1]), damper4);
+    __m128 az = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(md[2], im), nmd[2]), damper4);
+
+    _mm_storeu_ps(px + i, _mm_add_ps(x, _mm_add_ps(_mm_mul_ps(u, dt4), _mm_mul_ps(ax, half_dt24))));
+    _mm_storeu_ps(py + i, _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(v, dt4), _mm_mul_ps(ay, half_dt24))));
+    _mm_storeu_ps(pz + i, _mm_add_ps(z, _mm_add_ps(_mm_mul_ps(w, dt4), _mm_mul_ps(az, half_dt24))));
+    _mm_storeu_ps(vx + i, _mm_add_ps(u, _mm_mul_ps(ax, dt4)));
+    _mm_storeu_ps(vy + i, _mm_add_ps(v, _mm_mul_ps(ay, dt4)));
+    _mm_storeu_ps(vz + i, _mm_add_ps(w, _mm_mul_ps(az, dt4)));
+  }
+#endif  // LINEAR_EULER_SSE2
+
+  // The remainder, or all of them if we don't have SSE2.
+  for (; i < num_objects; ++i) {
+    LPoint3 pos(px[i], py[i], pz[i]);
+    LVector3 vel(vx[i], vy[i], vz[i]);
+
+    LVector3 md_accum_vec = af._md_constant;
+    LVector3 non_md_accum_vec = af._constant;
+    if (af._has_position) {
+      md_accum_vec += pos * af._md_position;
+      non_md_accum_vec += pos * af._position;
+    }
+    if (af._has_velocity) {
+      md_accum_vec += vel * af._md_velocity;
+      non_md_accum_vec += vel * af._velocity;
+    }
+    if (has_general) {
+      md_accum_vec += LVector3(_md_accum[0][i], _md_accum[1][i], _md_accum[2][i]);
+      non_md_accum_vec += LVector3(_accum[0][i], _accum[1][i], _accum[2][i]);
+    }
+
+    LVector3 accel_vec = md_accum_vec * inv_mass[i] + non_md_accum_vec;
+    accel_vec *= viscosity_damper;
+
+    pos += vel * dt + accel_vec * half_dt2;
+    vel += accel_vec * dt;
+
+    for (int c = 0; c < 3; ++c) {
+      _pos[c][i] = pos[c];
+      _vel[c][i] = vel[c];
+    }
+  }
+
+  // And store them back.
+  for (i = 0; i < num_objects; ++i) {
+    PhysicsObject *object = _objects[i];
+    LPoint3 pos(px[i], py[i], pz[i]);
+    LVector3 vel(vx[i], vy[i], vz[i]);
+    if (!pos.is_nan()) {
+      object->set_position(pos);
+    }
+    if (!vel.is_nan()) {
+      object->set_velocity(vel);
+    }
+  }
+}
+
+/**
+ * Adds the indicated force, whose coordinate space is related to that of the
+ * objects by the given matrix, to the forces for batch_integrate().
+ */
+void LinearEulerIntegrator::
+add_force(LinearForce *force, const LMatrix4 &xform) {
+  LVector3 constant;
+  PN_stdfloat position_scale, velocity_scale;
+  if (!force->get_affine_terms(constant, position_scale, velocity_scale)) {
+    GeneralForce general;
+    general._force = force;
+    general._xform = &xform;
+    _general.push_back(general);
+    return;
+  }
+
+  // Apply the amplitude and the masks, as LinearForce::get_vector() does, and
+  // then transform the result into the space of the objects.  Only the upper
+  // 3x3 of the matrix applies to a vector.
+  LVector3 masks = force->get_vector_masks();
+  LMatrix3 xform3 = xform.get_upper_3();
+  LMatrix3 masked_xform3 = xform3;
+  for (int r = 0; r < 3; ++r) {
+    if (masks[r] == 0.0f) {
+      constant[r] = 0.0f;
+      masked_xform3.set_row(r, LVector3::zero());
+    }
+  }
+  PN_stdfloat amplitude = force->get_amplitude();
+  constant = (constant * amplitude) * xform3;
+
+  bool md = force->get_mass_dependent();
+  (md ? _affine._md_constant : _affine._constant) += constant;
+
+  if (position_scale != 0.0f) {
+    (md ? _affine._md_position : _affine._position) +=
+      masked_xform3 * (position_scale * amplitude);
+    _affine._has_position = true;
+  }
+  if (velocity_scale != 0.0f) {
+    (md ? _affine._md_velocity : _affine._velocity) +=
+      masked_xform3 * (velocity_scale * amplitude);
+    _affine._has_velocity = true;
+  }
+}
+
+/**
+ * Resets the sums to no force at all.
+ */
+void LinearEulerIntegrator::AffineForces::
+clear() {
+  _md_constant = LVector3::zero();
+  _constant = LVector3::zero();
+  _md_position.fill(0.0f);
+  _position.fill(0.0f);
+  _md_velocity.fill(0.0f);
+  _velocity.fill(0.0f);
+  _has_position = false;
+  _has_velocity = false;
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
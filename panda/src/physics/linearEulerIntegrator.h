@@ -15,6 +15,7 @@
 #define LINEAREULERINTEGRATOR_H
 
 #include "linearIntegrator.h"
+#include "pvector.h"
 
 /**
  * Performs Euler integration on a vector of physically modelable objects
@@ -28,10 +29,55 @@ PUBLISHED:
   virtual void output(std::ostream &out) const;
   virtual void write(std::ostream &out, int indent=0) const;
 
+public:
+  virtual bool is_explicit_euler() const;
+  virtual void integrate_group(Physical *const *physicals,
+                               size_t num_physicals,
+                               LinearForceVector &forces, PN_stdfloat dt);
+
 private:
   virtual void child_integrate(Physical *physical,
                                LinearForceVector& forces,
                                PN_stdfloat dt);
+  void batch_integrate(Physical *const *physicals, size_t num_physicals,
+                       LinearForceVector &forces, PN_stdfloat dt);
+  void add_force(LinearForce *force, const LMatrix4 &xform);
+
+  // The sum of the forces whose vectors are an affine function of the
+  // position and velocity of the object, transformed into the object's space.
+  // As in child_integrate(), the mass-dependent forces are kept apart.
+  class AffineForces {
+  public:
+    void clear();
+
+    LVector3 _md_constant;
+    LVector3 _constant;
+    LMatrix3 _md_position;
+    LMatrix3 _position;
+    LMatrix3 _md_velocity;
+    LMatrix3 _velocity;
+    bool _has_position;
+    bool _has_velocity;
+  };
+
+  // A force that has to be evaluated one object at a time.
+  class GeneralForce {
+  public:
+    LinearForce *_force;
+    const LMatrix4 *_xform;
+  };
+  typedef pvector<GeneralForce> GeneralForces;
+  typedef pvector<PN_stdfloat> FloatArray;
+
+  // Scratch space for batch_integrate(), kept to avoid reallocating it.
+  AffineForces _affine;
+  GeneralForces _general;
+  pvector<PhysicsObject *> _objects;
+  FloatArray _pos[3];
+  FloatArray _vel[3];
+  FloatArray _inv_mass;
+  FloatArray _md_accum[3];
+  FloatArray _accum[3];
 };
 
 #endif // EULERINTEGRATOR_H
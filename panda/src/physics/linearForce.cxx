@@ -70,6 +70,18 @@ get_vector(const PhysicsObject *po) {
   return child_vector;
 }
 
+/**
+ * If the vector returned by get_child_vector() is an affine function of the
+ * object's position and velocity, that is, constant + position *
+ * position_scale + velocity * velocity_scale, fills in the terms and returns
+ * true.  This allows an integrator to evaluate the force for many objects at
+ * once.  Returns false if the force is not of this form.
+ */
+bool LinearForce::
+get_affine_terms(LVector3 &, PN_stdfloat &, PN_stdfloat &) const {
+  return false;
+}
+
 /**
 
  */
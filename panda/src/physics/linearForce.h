@@ -42,6 +42,11 @@ PUBLISHED:
   virtual void output(std::ostream &out) const;
   virtual void write(std::ostream &out, int indent=0) const;
 
+public:
+  virtual bool get_affine_terms(LVector3 &constant,
+                                PN_stdfloat &position_scale,
+                                PN_stdfloat &velocity_scale) const;
+
 protected:
   LinearForce(PN_stdfloat a, bool mass);
   LinearForce(const LinearForce& copy);
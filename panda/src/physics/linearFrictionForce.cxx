@@ -69,6 +69,19 @@ get_child_vector(const PhysicsObject* po) {
   return friction;
 }
 
+/**
+ * Fills in the affine terms of the force, which opposes the velocity of the
+ * object in proportion to it.
+ */
+bool LinearFrictionForce::
+get_affine_terms(LVector3 &constant, PN_stdfloat &position_scale,
+                 PN_stdfloat &velocity_scale) const {
+  constant = LVector3::zero();
+  position_scale = 0.0f;
+  velocity_scale = -_coef;
+  return true;
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
@@ -46,6 +46,31 @@ integrate(Physical *physical, LinearForceVector &forces,
     dt = _max_linear_dt;
 */
 
+  store_last_positions(physical);
+  child_integrate(physical, forces, dt);
+}
+
+/**
+ * Integrates a group of physicals that are all subject to exactly the same
+ * forces: they must share the same parent node and viscosity, and the same
+ * local linear forces (in practice, none at all).  The default implementation
+ * simply integrates each one in turn; an integrator may override this to
+ * process the whole group at once.
+ */
+void LinearIntegrator::
+integrate_group(Physical *const *physicals, size_t num_physicals,
+                LinearForceVector &forces, PN_stdfloat dt) {
+  for (size_t i = 0; i < num_physicals; ++i) {
+    integrate(physicals[i], forces, dt);
+  }
+}
+
+/**
+ * Sets the last position of each of the physical's objects to its current
+ * position, before the objects are moved.
+ */
+void LinearIntegrator::
+store_last_positions(Physical *physical) {
   PhysicsObject::Vector::const_iterator current_object_iter;
   current_object_iter = physical->get_object_vector().begin();
   for (; current_object_iter != physical->get_object_vector().end();
@@ -61,7 +86,17 @@ integrate(Physical *physical, LinearForceVector &forces,
     // it
     current_object->set_last_position(current_object->get_position());
   }
-  child_integrate(physical, forces, dt);
+}
+
+/**
+ * Returns true if this integrator steps each object with the same explicit
+ * Euler formula as LinearEulerIntegrator, so that a client holding its
+ * objects in some other form may safely perform the equivalent integration
+ * itself.
+ */
+bool LinearIntegrator::
+is_explicit_euler() const {
+  return false;
 }
 
 /**
@@ -30,6 +30,11 @@ public:
 
   void integrate(Physical *physical, LinearForceVector &forces,
                  PN_stdfloat dt);
+  virtual void integrate_group(Physical *const *physicals,
+                               size_t num_physicals,
+                               LinearForceVector &forces, PN_stdfloat dt);
+
+  virtual bool is_explicit_euler() const;
 
 PUBLISHED:
   virtual void output(std::ostream &out) const;
@@ -38,6 +43,8 @@ PUBLISHED:
 protected:
   LinearIntegrator();
 
+  static void store_last_positions(Physical *physical);
+
 private:
   static ConfigVariableDouble _max_linear_dt;
 
@@ -64,6 +64,20 @@ get_child_vector(const PhysicsObject *po) {
   return (get_force_center() - po->get_position()) * get_scalar_term();
 }
 
+/**
+ * Fills in the affine terms of the force, which pulls the object toward the
+ * force center in proportion to its distance from it.
+ */
+bool LinearSinkForce::
+get_affine_terms(LVector3 &constant, PN_stdfloat &position_scale,
+                 PN_stdfloat &velocity_scale) const {
+  PN_stdfloat scalar = get_scalar_term();
+  constant = (get_force_center() - LPoint3::origin()) * scalar;
+  position_scale = -scalar;
+  velocity_scale = 0.0f;
+  return true;
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
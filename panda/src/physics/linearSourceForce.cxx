@@ -64,6 +64,20 @@ get_child_vector(const PhysicsObject *po) {
   return (po->get_position() - get_force_center()) * get_scalar_term();
 }
 
+/**
+ * Fills in the affine terms of the force, which pushes the object away from
+ * the force center in proportion to its distance from it.
+ */
+bool LinearSourceForce::
+get_affine_terms(LVector3 &constant, PN_stdfloat &position_scale,
+                 PN_stdfloat &velocity_scale) const {
+  PN_stdfloat scalar = get_scalar_term();
+  constant = (LPoint3::origin() - get_force_center()) * scalar;
+  position_scale = scalar;
+  velocity_scale = 0.0f;
+  return true;
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
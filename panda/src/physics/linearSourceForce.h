@@ -30,6 +30,11 @@ PUBLISHED:
   virtual void output(std::ostream &out) const;
   virtual void write(std::ostream &out, int indent=0) const;
 
+public:
+  virtual bool get_affine_terms(LVector3 &constant,
+                                PN_stdfloat &position_scale,
+                                PN_stdfloat &velocity_scale) const;
+
 private:
   virtual LVector3 get_child_vector(const PhysicsObject *po);
   virtual LinearForce *make_copy();
@@ -70,6 +70,19 @@ get_child_vector(const PhysicsObject *) {
   return _fvec;
 }
 
+/**
+ * Fills in the affine terms of the force, which is the same constant vector
+ * for every object.
+ */
+bool LinearVectorForce::
+get_affine_terms(LVector3 &constant, PN_stdfloat &position_scale,
+                 PN_stdfloat &velocity_scale) const {
+  constant = _fvec;
+  position_scale = 0.0f;
+  velocity_scale = 0.0f;
+  return true;
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
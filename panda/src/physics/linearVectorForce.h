@@ -39,6 +39,10 @@ PUBLISHED:
 public:
   INLINE LinearVectorForce& operator += (const LinearVectorForce &other);
 
+  virtual bool get_affine_terms(LVector3 &constant,
+                                PN_stdfloat &position_scale,
+                                PN_stdfloat &velocity_scale) const;
+
 private:
   LVector3 _fvec;
 
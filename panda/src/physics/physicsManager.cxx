@@ -13,6 +13,7 @@
 
 #include "physicsManager.h"
 #include "actorNode.h"
+#include "config_physics.h"
 
 #include <algorithm>
 #include "pvector.h"
@@ -123,6 +124,12 @@ remove_physical_node(PhysicalNode *p) {
  */
 void PhysicsManager::
 do_physics(PN_stdfloat dt) {
+  if (_linear_integrator && _linear_integrator->is_explicit_euler() &&
+      physics_batch_integrate) {
+    do_physics_grouped(dt);
+    return;
+  }
+
   // now, run through each physics object in the set.
   PhysicalsVector::iterator p_cur = _physicals.begin();
   for (; p_cur != _physicals.end(); ++p_cur) {
@@ -174,6 +181,81 @@ do_physics(PN_stdfloat dt, Physical *physical) {
   }
 }
 
+/**
+ * The implementation of do_physics() when physics-batch-integrate is set.
+ * Consecutive physicals that hang from the same parent node, with the same
+ * viscosity and no linear forces of their own, are subject to exactly the
+ * same forces, so they are handed to the linear integrator together.  This
+ * lets it compute the force transforms once per group, rather than once per
+ * physical, and integrate all of their objects in a single batch.
+ *
+ * Only consecutive physicals are grouped, so that each one is still
+ * integrated and updated in the same order as by the per-physical code; a
+ * physical parented below another one's ActorNode sees the same parent
+ * transform either way.
+ */
+void PhysicsManager::
+do_physics_grouped(PN_stdfloat dt) {
+  _group.clear();
+  GroupKey group_key;
+
+  PhysicalsVector::const_iterator p_cur;
+  for (p_cur = _physicals.begin(); p_cur != _physicals.end(); ++p_cur) {
+    Physical *physical = *p_cur;
+    nassertv(physical);
+
+    GroupKey key;
+    key._parent = nullptr;
+    key._viscosity = physical->get_viscosity();
+    key._physical = nullptr;
+    if (physical->get_physical_node() == nullptr ||
+        !physical->get_linear_forces().empty()) {
+      key._physical = physical;
+    } else {
+      key._parent = physical->get_physical_node_path().get_parent().node();
+    }
+
+    if (!_group.empty() && !(key == group_key)) {
+      do_physics_group(dt);
+    }
+    group_key = key;
+    _group.push_back(physical);
+  }
+
+  if (!_group.empty()) {
+    do_physics_group(dt);
+  }
+}
+
+/**
+ * Integrates the physicals collected in _group by do_physics_grouped(), and
+ * empties it.  Since they all share the same parent node, none of them can
+ * affect the forces on the others.
+ */
+void PhysicsManager::
+do_physics_group(PN_stdfloat dt) {
+  _linear_integrator->integrate_group(_group.data(), _group.size(),
+                                      _linear_forces, dt);
+
+  PhysicalsVector::const_iterator p_cur;
+  for (p_cur = _group.begin(); p_cur != _group.end(); ++p_cur) {
+    Physical *physical = *p_cur;
+
+    if (_angular_integrator) {
+      _angular_integrator->integrate(physical, _angular_forces, dt);
+    }
+
+    // if it's an actor node, tell it to update itself.
+    PhysicalNode *pn = physical->get_physical_node();
+    if (pn && pn->is_of_type(ActorNode::get_class_type())) {
+      ActorNode *an = (ActorNode *) pn;
+      an->update_transform();
+    }
+  }
+
+  _group.clear();
+}
+
 /**
  * Write a string representation of this instance to <out>.
  */
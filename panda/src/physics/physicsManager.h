@@ -80,10 +80,27 @@ PUBLISHED:
   virtual void debug_output(std::ostream &out, int indent=0) const;
 
 public:
+  INLINE const LinearForceVector &get_linear_forces() const;
+  INLINE LinearIntegrator *get_linear_integrator() const;
+
   friend class Physical;
   static ConfigVariableInt _random_seed;
 
 private:
+  void do_physics_grouped(PN_stdfloat dt);
+  void do_physics_group(PN_stdfloat dt);
+
+  // Identifies a set of physicals that are subject to exactly the same
+  // forces.  A physical with forces of its own is in a group by itself.
+  class GroupKey {
+  public:
+    INLINE bool operator == (const GroupKey &other) const;
+
+    PandaNode *_parent;
+    PN_stdfloat _viscosity;
+    Physical *_physical;
+  };
+
   PN_stdfloat _viscosity;
   PhysicalsVector _physicals;
   LinearForceVector _linear_forces;
@@ -91,6 +108,9 @@ private:
 
   PT(LinearIntegrator) _linear_integrator;
   PT(AngularIntegrator) _angular_integrator;
+
+  // Scratch space for do_physics_grouped(), kept to avoid reallocating it.
+  PhysicalsVector _group;
 };
 
 #include "physicsManager.I"
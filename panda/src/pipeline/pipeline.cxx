@@ -18,6 +18,12 @@
 
 Pipeline *Pipeline::_render_pipeline = nullptr;
 
+#ifdef THREADED_PIPELINE
+// The maximum number of cyclers that are locked and cycled together by
+// cycle() while holding the pipeline lock.
+static const size_t cycle_batch_size = 64;
+#endif
+
 /**
  *
  */
@@ -126,120 +132,68 @@ cycle() {
       _num_dirty_cyclers = 0;
     }
 
-    // This is duplicated for different number of stages, as an optimization.
-    switch (_num_stages) {
-    case 2:
-      while (prev_dirty._next != &prev_dirty) {
-        PipelineCyclerLinks *link = prev_dirty._next;
-        while (link != &prev_dirty) {
-          PipelineCyclerTrueImpl *cycler = (PipelineCyclerTrueImpl *)link;
-
-          if (!cycler->_lock.try_lock()) {
-            // No big deal, just move on to the next one for now, and we'll
-            // come back around to it.  It's important not to block here in
-            // order to prevent one cycler from deadlocking another.
-            if (link->_prev != &prev_dirty || link->_next != &prev_dirty) {
-              link = cycler->_next;
-              continue;
-            } else {
-              // Well, we are the last cycler left, so we might as well wait.
-              // This is necessary to trigger the deadlock detection code.
-              cycler->_lock.lock();
-            }
-          }
-
-          MutexHolder holder(_lock);
-          cycler->remove_from_list();
-
-          // We save the result of cycle(), so that we can defer the side-
-          // effects that might occur when CycleDatas destruct, at least until
-          // the end of this loop.
-          saved_cdatas.push_back(cycler->cycle_2());
-
-          // cycle_2() won't leave a cycler dirty.  Add it to the clean list.
-          nassertd(!cycler->_dirty) break;
-          cycler->insert_before(&_clean);
-#ifdef DEBUG_THREADS
-          inc_cycler_type(_dirty_cycler_types, cycler->get_parent_type(), -1);
-#endif
-          cycler->_lock.unlock();
-          break;
+    // We cycle the dirty cyclers in batches.  For each batch, we first grab
+    // as many of the cycler locks as we can without blocking, and then hold
+    // our own lock just once while we cycle all of them and move them to the
+    // appropriate list.  With many modified cyclers, this is considerably
+    // cheaper than locking the pipeline once per cycler.
+    PipelineCyclerTrueImpl *batch[cycle_batch_size];
+
+    while (prev_dirty._next != &prev_dirty) {
+      size_t num_locked = 0;
+      PipelineCyclerLinks *link = prev_dirty._next;
+      while (link != &prev_dirty && num_locked < cycle_batch_size) {
+        PipelineCyclerTrueImpl *cycler = (PipelineCyclerTrueImpl *)link;
+        link = cycler->_next;
+
+        // It's important not to block here in order to prevent one cycler
+        // from deadlocking another.  If we can't get a lock, no big deal;
+        // we'll come back around to it in the next batch.
+        if (cycler->_lock.try_lock()) {
+          batch[num_locked++] = cycler;
         }
       }
-      break;
-
-    case 3:
-      while (prev_dirty._next != &prev_dirty) {
-        PipelineCyclerLinks *link = prev_dirty._next;
-        while (link != &prev_dirty) {
-          PipelineCyclerTrueImpl *cycler = (PipelineCyclerTrueImpl *)link;
-
-          if (!cycler->_lock.try_lock()) {
-            // No big deal, just move on to the next one for now, and we'll
-            // come back around to it.  It's important not to block here in
-            // order to prevent one cycler from deadlocking another.
-            if (link->_prev != &prev_dirty || link->_next != &prev_dirty) {
-              link = cycler->_next;
-              continue;
-            } else {
-              // Well, we are the last cycler left, so we might as well wait.
-              // This is necessary to trigger the deadlock detection code.
-              cycler->_lock.lock();
-            }
-          }
 
-          MutexHolder holder(_lock);
-          cycler->remove_from_list();
-
-          saved_cdatas.push_back(cycler->cycle_3());
-
-          if (cycler->_dirty) {
-            // The cycler is still dirty.  Add it back to the dirty list.
-            nassertd(cycler->_dirty == prev_seq) break;
-            cycler->insert_before(&_dirty);
-            cycler->_dirty = next_seq;
-            ++_num_dirty_cyclers;
-          } else {
-            // The cycler is now clean.  Add it back to the clean list.
-            cycler->insert_before(&_clean);
-#ifdef DEBUG_THREADS
-            inc_cycler_type(_dirty_cycler_types, cycler->get_parent_type(), -1);
-#endif
-          }
-          cycler->_lock.unlock();
-          break;
+      if (num_locked == 0) {
+        link = prev_dirty._next;
+        if (link->_next != &prev_dirty) {
+          // Someone else is holding all of them.  Try again.
+          continue;
         }
+        // Well, this is the last cycler left, so we might as well wait.  This
+        // is necessary to trigger the deadlock detection code.
+        PipelineCyclerTrueImpl *cycler = (PipelineCyclerTrueImpl *)link;
+        cycler->_lock.lock();
+        batch[num_locked++] = cycler;
       }
-      break;
-
-    default:
-      while (prev_dirty._next != &prev_dirty) {
-        PipelineCyclerLinks *link = prev_dirty._next;
-        while (link != &prev_dirty) {
-          PipelineCyclerTrueImpl *cycler = (PipelineCyclerTrueImpl *)link;
-
-          if (!cycler->_lock.try_lock()) {
-            // No big deal, just move on to the next one for now, and we'll
-            // come back around to it.  It's important not to block here in
-            // order to prevent one cycler from deadlocking another.
-            if (link->_prev != &prev_dirty || link->_next != &prev_dirty) {
-              link = cycler->_next;
-              continue;
-            } else {
-              // Well, we are the last cycler left, so we might as well wait.
-              // This is necessary to trigger the deadlock detection code.
-              cycler->_lock.lock();
-            }
-          }
 
-          MutexHolder holder(_lock);
+      {
+        MutexHolder holder(_lock);
+        for (size_t i = 0; i < num_locked; ++i) {
+          PipelineCyclerTrueImpl *cycler = batch[i];
           cycler->remove_from_list();
 
-          saved_cdatas.push_back(cycler->cycle());
+          // We save the result of cycle(), so that we can defer the side-
+          // effects that might occur when CycleDatas destruct, at least until
+          // the end of this loop.  This is duplicated for different number
+          // of stages, as an optimization.
+          switch (_num_stages) {
+          case 2:
+            saved_cdatas.push_back(cycler->cycle_2());
+            break;
+
+          case 3:
+            saved_cdatas.push_back(cycler->cycle_3());
+            break;
+
+          default:
+            saved_cdatas.push_back(cycler->cycle());
+            break;
+          }
 
           if (cycler->_dirty) {
             // The cycler is still dirty.  Add it back to the dirty list.
-            nassertd(cycler->_dirty == prev_seq) break;
+            nassertd(cycler->_dirty == prev_seq) continue;
             cycler->insert_before(&_dirty);
             cycler->_dirty = next_seq;
             ++_num_dirty_cyclers;
@@ -250,11 +204,12 @@ cycle() {
             inc_cycler_type(_dirty_cycler_types, cycler->get_parent_type(), -1);
 #endif
           }
-          cycler->_lock.unlock();
-          break;
         }
       }
-      break;
+
+      for (size_t i = 0; i < num_locked; ++i) {
+        batch[i]->_lock.unlock();
+      }
     }
 
     // Now we're ready for the next frame.
@@ -0,0 +1,101 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file test_pipeline_cycle.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "pandabase.h"
+#include "pipeline.h"
+#include "pipelineCycler.h"
+#include "cycleData.h"
+#include "cycleDataWriter.h"
+#include "thread.h"
+#include "trueClock.h"
+#include "pvector.h"
+
+// The total number of cyclers in the pipeline.
+static const int num_cyclers = 200000;
+
+// The number of times to repeat each measurement.
+static const int num_iterations = 20;
+
+class TestData : public CycleData {
+public:
+  virtual CycleData *make_copy() const {
+    return new TestData(*this);
+  }
+
+  int _value = 0;
+};
+
+typedef PipelineCycler<TestData> TestCycler;
+
+/**
+ * Measures the time taken by Pipeline::cycle() with a varying number of
+ * modified cyclers, out of a fixed total number of cyclers.
+ */
+int
+main(int argc, char *argv[]) {
+#ifndef THREADED_PIPELINE
+  nout << "This program requires a build with true threading and pipelining.\n";
+  return 1;
+#else
+  int num_stages = 2;
+  if (argc > 1) {
+    num_stages = atoi(argv[1]);
+  }
+
+  Pipeline pipeline("benchmark", num_stages);
+  Thread *current_thread = Thread::get_current_thread();
+  TrueClock *clock = TrueClock::get_global_ptr();
+
+  pvector<TestCycler *> cyclers;
+  cyclers.reserve(num_cyclers);
+  for (int i = 0; i < num_cyclers; ++i) {
+    cyclers.push_back(new TestCycler(&pipeline));
+  }
+
+  nout << num_cyclers << " cyclers, " << num_stages << " stages\n";
+
+  static const int num_modified[] = { 0, 100, 1000, 10000, 50000, 200000 };
+  for (int m : num_modified) {
+    double total = 0.0;
+    for (int it = 0; it < num_iterations; ++it) {
+      // Modify every nth cycler, so that the dirty ones are spread out.
+      int step = (m > 0) ? num_cyclers / m : num_cyclers;
+      for (int i = 0; i < m; ++i) {
+        CycleDataWriter<TestData> cdata(*cyclers[i * step], current_thread);
+        cdata->_value = it;
+      }
+
+      double start = clock->get_short_time();
+      pipeline.cycle();
+      total += clock->get_short_time() - start;
+
+      // Flush the remaining stages, so that each iteration begins clean.
+      for (int s = 2; s < num_stages; ++s) {
+        pipeline.cycle();
+      }
+    }
+
+    double avg = total / num_iterations;
+    nout << m << " modified: " << avg * 1000.0 << " ms";
+    if (m > 0) {
+      nout << " (" << avg * 1.0e9 / m << " ns per cycler)";
+    }
+    nout << "\n";
+  }
+
+  for (TestCycler *cycler : cyclers) {
+    delete cycler;
+  }
+  return 0;
+#endif  // THREADED_PIPELINE
+}
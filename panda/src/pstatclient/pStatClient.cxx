@@ -58,6 +58,13 @@ public:
 typedef pvector<TypeHandleCollector> TypeHandleCols;
 static TypeHandleCols type_handle_cols;
 
+// These are used to report the memory counted against each
+// MemoryHook::MemoryTag.  Unlike the above, these are available even without
+// DO_MEMORY_USAGE.
+static PStatCollector tag_usage_cols[MemoryHook::MT_limit];
+static PStatCollector tag_allocs_cols[MemoryHook::MT_limit];
+static size_t tag_last_num_allocs[MemoryHook::MT_limit];
+
 
 /**
  *
@@ -378,6 +385,22 @@ main_tick() {
   }
 #endif  // DO_MEMORY_USAGE
 
+  if (is_connected()) {
+    for (int ti = 0; ti < (int)MemoryHook::MT_limit; ++ti) {
+      MemoryHook::MemoryTag tag = (MemoryHook::MemoryTag)ti;
+      size_t num_allocs = memory_hook->get_tag_num_allocs(tag);
+      if (!tag_usage_cols[ti].is_valid()) {
+        string name = MemoryHook::get_tag_name(tag);
+        tag_usage_cols[ti] = PStatCollector("Tagged memory:" + name);
+        tag_allocs_cols[ti] = PStatCollector("Tagged allocs:" + name);
+        tag_last_num_allocs[ti] = num_allocs;
+      }
+      tag_usage_cols[ti].set_level(memory_hook->get_tag_usage(tag));
+      tag_allocs_cols[ti].set_level(num_allocs - tag_last_num_allocs[ti]);
+      tag_last_num_allocs[ti] = num_allocs;
+    }
+  }
+
   get_global_pstats()->client_main_tick();
 }
 
@@ -119,6 +119,8 @@ static TimeCollectorProperties time_properties[] = {
   { 1, "Cull",                             { 0.21, 0.68, 0.37 },  1.0 / 30.0 },
   { 1, "Cull:Setup",                       { 0.7, 0.4, 0.5 } },
   { 1, "Cull:Sort",                        { 0.3, 0.3, 0.6 } },
+  { 1, "Cull:Bounds",                      { 0.5, 0.7, 0.3 } },
+  { 1, "Cull:Rigid body combiner",         { 0.8, 0.5, 0.2 } },
   { 1, "*",                                { 0.1, 0.1, 0.5 } },
   { 1, "*:Show fps",                       { 0.5, 0.8, 1.0 } },
   { 1, "*:Munge",                          { 0.3, 0.3, 0.9 } },
@@ -169,7 +171,14 @@ static LevelCollectorProperties level_properties[] = {
   { 1, "Primitive batches:Triangle fans",  { 0.8, 0.5, 0.2 } },
   { 1, "Primitive batches:Triangle strips",{ 0.2, 0.5, 0.8 } },
   { 1, "Primitive batches:Display lists",  { 0.8, 0.5, 1.0 } },
+  { 1, "Instanced objects",                { 0.9, 0.3, 0.5 },  "", 500 },
+  { 1, "Instanced draws",                  { 0.3, 0.9, 0.5 },  "", 500 },
+  { 1, "LOD budget vertices",              { 0.7, 0.4, 0.1 },  "K", 10, 1000 },
+  { 1, "LOD budget scale",                 { 0.4, 0.7, 0.1 },  "", 2 },
   { 1, "SW Sprites",                       { 0.2, 0.7, 0.3 },  "K", 10, 1000 },
+  { 1, "Particles",                        { 0.9, 0.5, 0.1 },  "K", 10, 1000 },
+  { 1, "Particles per second",             { 0.6, 0.9, 0.1 },  "K", 600, 1000 },
+  { 1, "Particle system time",             { 0.1, 0.6, 0.9 },  "ms", 1 },
   { 1, "Vertices",                         { 0.5, 0.2, 0.0 },  "K", 10, 1000 },
   { 1, "Vertices:Other",                   { 0.2, 0.2, 0.2 } },
   { 1, "Vertices:Triangles",               { 0.8, 0.8, 0.8 } },
@@ -184,6 +193,7 @@ static LevelCollectorProperties level_properties[] = {
   { 1, "Geoms",                            { 0.4, 0.8, 0.3 },  "", 500.0 },
   { 1, "Cull volumes",                     { 0.7, 0.6, 0.9 },  "", 500.0 },
   { 1, "Cull volumes:Transforms",          { 0.9, 0.6, 0.0 } },
+  { 1, "Cull arena",                       { 0.3, 0.7, 0.5 },  "K", 256, 1024 },
   { 1, "State changes",                    { 1.0, 0.5, 0.2 },  "", 500.0 },
   { 1, "State changes:Other",              { 0.2, 0.2, 0.2 } },
   { 1, "State changes:Transforms",         { 0.2, 0.2, 0.8 } },
@@ -198,6 +208,22 @@ static LevelCollectorProperties level_properties[] = {
   { 1, "System memory:Heap:Overhead",      { 0.9, 0.7, 0.8 } },
   { 1, "System memory:Heap:External",      { 0.2, 0.2, 0.5 } },
   { 1, "System memory:MMap",               { 0.9, 0.4, 0.7 } },
+  { 1, "Tagged memory",                    { 0.7, 0.9, 0.3 },  "MB", 64, 1048576 },
+  { 1, "Tagged memory:Geometry",           { 1.0, 0.4, 0.0 } },
+  { 1, "Tagged memory:Textures",           { 0.8, 0.2, 0.2 } },
+  { 1, "Tagged memory:Animation",          { 0.2, 0.8, 0.4 } },
+  { 1, "Tagged memory:Collision",          { 1.0, 0.8, 0.5 } },
+  { 1, "Tagged memory:Networking",         { 0.3, 0.5, 0.9 } },
+  { 1, "Tagged memory:Python objects",     { 0.9, 0.9, 0.2 } },
+  { 1, "Tagged memory:DNA",                { 0.6, 0.3, 0.8 } },
+  { 1, "Tagged allocs",                    { 0.9, 0.6, 0.3 },  "", 1000 },
+  { 1, "Tagged allocs:Geometry",           { 1.0, 0.4, 0.0 } },
+  { 1, "Tagged allocs:Textures",           { 0.8, 0.2, 0.2 } },
+  { 1, "Tagged allocs:Animation",          { 0.2, 0.8, 0.4 } },
+  { 1, "Tagged allocs:Collision",          { 1.0, 0.8, 0.5 } },
+  { 1, "Tagged allocs:Networking",         { 0.3, 0.5, 0.9 } },
+  { 1, "Tagged allocs:Python objects",     { 0.9, 0.9, 0.2 } },
+  { 1, "Tagged allocs:DNA",                { 0.6, 0.3, 0.8 } },
   { 1, "Vertex Data",                      { 1.0, 0.4, 0.0 },  "MB", 64, 1048576 },
   { 1, "Vertex Data:Independent",          { 0.9, 0.1, 0.9 } },
   { 1, "Vertex Data:Small",                { 0.2, 0.3, 0.4 } },
@@ -65,6 +65,14 @@ ConfigVariableBool trackball_use_alt_keys
           "the second and third mouse buttons in trackball mode.  Particularly "
           "useful for Macs, or laptops with limited mouse buttons."));
 
+ConfigVariableInt mouse_watcher_grid_size
+("mouse-watcher-grid-size", 0,
+ PRC_DESC("The number of cells along each side of the grid that a MouseWatcher "
+          "uses to find the regions under the mouse without testing every "
+          "one of them.  This is worth enabling, with a value such as 16, "
+          "for interfaces with many regions.  The default, 0, disables the "
+          "grid and tests every region each time the mouse moves."));
+
 ConfigureFn(config_tform) {
   DriveInterface::init_type();
   ButtonThrower::init_type();
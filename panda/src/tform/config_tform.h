@@ -18,6 +18,7 @@
 #include "notifyCategoryProxy.h"
 #include "configVariableDouble.h"
 #include "configVariableBool.h"
+#include "configVariableInt.h"
 
 NotifyCategoryDecl(tform, EXPCL_PANDA_TFORM, EXPTP_PANDA_TFORM);
 
@@ -38,4 +39,6 @@ extern EXPCL_PANDA_TFORM ConfigVariableDouble inactivity_timeout;
 
 extern EXPCL_PANDA_TFORM ConfigVariableBool trackball_use_alt_keys;
 
+extern EXPCL_PANDA_TFORM ConfigVariableInt mouse_watcher_grid_size;
+
 #endif
@@ -72,6 +72,7 @@ MouseWatcher(const string &name) :
   _button_down_display_region = nullptr;
 
   _frame.set(-1.0f, 1.0f, -1.0f, 1.0f);
+  _indexed_frame_seq = 0;
 
   _inactivity_timeout = inactivity_timeout;
   _has_inactivity_timeout = !IS_NEARLY_ZERO(_inactivity_timeout);
@@ -213,6 +214,7 @@ remove_group(MouseWatcherGroup *group) {
     find(_groups.begin(), _groups.end(), pt);
   if (gi != _groups.end()) {
     // Found it, now erase it
+    remove_indexed_source(group);
     _groups.erase(gi);
     return true;
   }
@@ -316,6 +318,21 @@ replace_group(MouseWatcherGroup *old_group, MouseWatcherGroup *new_group) {
   }
 #endif  // NDEBUG
 
+  // The index can move from the old group's regions to the new group's by
+  // applying the difference between them, which is usually small, rather
+  // than removing and re-adding every region.
+  IndexedSources::iterator si = _indexed_sources.find(old_group);
+  if (si != _indexed_sources.end()) {
+    if (_indexed_sources.find(new_group) == _indexed_sources.end()) {
+      IndexedSource &source = _indexed_sources[new_group];
+      source._regions.swap((*si).second._regions);
+      source._seq = UpdateSeq::old();
+      _indexed_sources.erase(si);
+    } else {
+      remove_indexed_source(old_group);
+    }
+  }
+
   // Remove the old group, if it is already there.
   pt = old_group;
   gi = find(_groups.begin(), _groups.end(), pt);
@@ -540,6 +557,21 @@ get_over_regions(MouseWatcher::Regions &regions, const LPoint2 &pos) const {
   // Ensure the vector is empty before we begin.
   regions.clear();
 
+  if (mouse_watcher_grid_size > 0) {
+    // Look up the regions in the index, which is brought up-to-date with any
+    // changes to the regions first.
+    ((MouseWatcher *)this)->update_index();
+
+    pvector<MouseWatcherRegion *> found;
+    _index.find_regions(found, mx, my);
+    for (MouseWatcherRegion *region : found) {
+      regions.push_back(region);
+    }
+
+    sort(regions.begin(), regions.end());
+    return;
+  }
+
   // Make sure there are no duplicates in the regions vector.
   if (!_sorted) {
     ((MouseWatcher *)this)->do_sort_regions();
@@ -578,6 +610,92 @@ get_over_regions(MouseWatcher::Regions &regions, const LPoint2 &pos) const {
   sort(regions.begin(), regions.end());
 }
 
+/**
+ * Brings the index of regions up-to-date with the regions of this
+ * MouseWatcher and its groups, and their frames.  Assumes the lock is held.
+ */
+void MouseWatcher::
+update_index() {
+  nassertv(_lock.debug_is_locked());
+
+  int grid_size = mouse_watcher_grid_size;
+  if (grid_size != _index.get_grid_size() || _frame != _index.get_bounds()) {
+    // Start over.  Everything will be added again below.
+    _index.reset(_frame, grid_size);
+    _indexed_sources.clear();
+    _indexed_frame_seq = MouseWatcherRegion::get_frame_seq();
+  }
+
+  // If any region anywhere has changed its frame since we last looked, the
+  // regions we have already filed must be checked.
+  AtomicAdjust::Integer frame_seq = MouseWatcherRegion::get_frame_seq();
+  if (frame_seq != _indexed_frame_seq) {
+    _index.update_frames();
+    _indexed_frame_seq = frame_seq;
+  }
+
+  do_sort_regions();
+  update_indexed_source(this, _regions, _regions_seq);
+
+  for (MouseWatcherGroup *group : _groups) {
+    LightMutexHolder holder(group->_lock);
+    group->do_sort_regions();
+    update_indexed_source(group, group->_regions, group->_regions_seq);
+  }
+}
+
+/**
+ * Adds to and removes from the index whatever regions have been added to or
+ * removed from the indicated source since it was last indexed.  The regions
+ * must be sorted.  Assumes the lock is held, as well as the source's lock.
+ */
+void MouseWatcher::
+update_indexed_source(const MouseWatcherBase *source,
+                      const Regions &regions, UpdateSeq seq) {
+  IndexedSource &indexed = _indexed_sources[source];
+  if (indexed._seq == seq) {
+    return;
+  }
+
+  // Both lists are sorted in pointer order, so we can walk them together.
+  Regions::const_iterator a_ri = indexed._regions.begin();
+  Regions::const_iterator b_ri = regions.begin();
+
+  while (a_ri != indexed._regions.end() || b_ri != regions.end()) {
+    if (b_ri == regions.end() ||
+        (a_ri != indexed._regions.end() && (*a_ri) < (*b_ri))) {
+      _index.remove_region(*a_ri);
+      ++a_ri;
+
+    } else if (a_ri == indexed._regions.end() || (*b_ri) < (*a_ri)) {
+      _index.add_region(*b_ri);
+      ++b_ri;
+
+    } else {
+      ++a_ri;
+      ++b_ri;
+    }
+  }
+
+  indexed._regions = regions;
+  indexed._seq = seq;
+}
+
+/**
+ * Removes from the index all of the regions that were indexed from the
+ * indicated source.  Assumes the lock is held.
+ */
+void MouseWatcher::
+remove_indexed_source(const MouseWatcherBase *source) {
+  IndexedSources::iterator si = _indexed_sources.find(source);
+  if (si != _indexed_sources.end()) {
+    for (MouseWatcherRegion *region : (*si).second._regions) {
+      _index.remove_region(region);
+    }
+    _indexed_sources.erase(si);
+  }
+}
+
 /**
  * Returns the innermost region of all the regions indicated in the given
  * vector (usually, the regions the mouse is over).  This is the "preferred"
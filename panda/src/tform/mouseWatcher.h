@@ -32,6 +32,9 @@
 #include "clockObject.h"
 #include "pvector.h"
 #include "displayRegion.h"
+#include "mouseWatcherRegionIndex.h"
+#include "updateSeq.h"
+#include "pmap.h"
 
 class MouseWatcherParameter;
 class DisplayRegion;
@@ -204,6 +207,11 @@ private:
                                 LVecBase2 &f, LVecBase2 &p,
                                 Thread *current_thread);
 
+  void update_index();
+  void update_indexed_source(const MouseWatcherBase *source,
+                             const Regions &regions, UpdateSeq seq);
+  void remove_indexed_source(const MouseWatcherBase *source);
+
 private:
   // This wants to be a set, but because you cannot export sets across dlls in
   // windows, we will make it a vector instead
@@ -219,6 +227,20 @@ private:
 
   LVecBase4 _frame;
 
+  // The regions of this MouseWatcher and all of its groups, filed by their
+  // frames so that we need not test each one every time the mouse moves.  We
+  // keep a copy of the list of regions we last indexed from each group, so
+  // that we can apply just the difference when the group changes.
+  class IndexedSource {
+  public:
+    UpdateSeq _seq;
+    Regions _regions;
+  };
+  typedef pmap<const MouseWatcherBase *, IndexedSource> IndexedSources;
+  IndexedSources _indexed_sources;
+  MouseWatcherRegionIndex _index;
+  AtomicAdjust::Integer _indexed_frame_seq;
+
   PT(PointerEventList) _trail_log;
   size_t _num_trail_recent;
   double _trail_log_duration;
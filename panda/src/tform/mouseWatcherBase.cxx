@@ -66,6 +66,7 @@ add_region(PT(MouseWatcherRegion) region) {
 
   _regions.push_back(std::move(region));
   _sorted = false;
+  ++_regions_seq;
 }
 
 /**
@@ -126,6 +127,7 @@ clear_regions() {
 
   _regions.clear();
   _sorted = true;
+  ++_regions_seq;
 
 #ifndef NDEBUG
   if (_show_regions) {
@@ -287,6 +289,7 @@ do_remove_region(MouseWatcherRegion *region) {
 #endif  // NDEBUG
 
     _regions.erase(ri);
+    ++_regions_seq;
     return true;
   }
 
@@ -22,6 +22,7 @@
 #include "nodePath.h"
 #include "lightMutex.h"
 #include "ordered_vector.h"
+#include "updateSeq.h"
 
 /**
  * This represents a collection of MouseWatcherRegions that may be managed as
@@ -78,6 +79,10 @@ protected:
   Regions _regions;
   bool _sorted;
 
+  // This is incremented whenever a region is added to or removed from the
+  // above list, so that MouseWatcher can tell when to update its index.
+  UpdateSeq _regions_seq;
+
   // This mutex protects the above list of regions, as well as the below list
   // of vizzes.  It is also referenced directly by MouseWatcher, a derived
   // class.
@@ -18,6 +18,8 @@
 
 TypeHandle MouseWatcherRegion::_type_handle;
 
+AtomicAdjust::Integer MouseWatcherRegion::_frame_seq = 0;
+
 /**
  *
  */
@@ -21,6 +21,7 @@
 #include "luse.h"
 #include "buttonHandle.h"
 #include "modifierButtons.h"
+#include "atomicAdjust.h"
 
 class MouseWatcherParameter;
 
@@ -73,6 +74,8 @@ PUBLISHED:
 public:
   INLINE bool operator < (const MouseWatcherRegion &other) const;
 
+  INLINE static AtomicAdjust::Integer get_frame_seq();
+
   virtual void enter_region(const MouseWatcherParameter &param);
   virtual void exit_region(const MouseWatcherParameter &param);
   virtual void within_region(const MouseWatcherParameter &param);
@@ -97,6 +100,8 @@ private:
   };
   int _flags;
 
+  static AtomicAdjust::Integer _frame_seq;
+
 public:
   static TypeHandle get_class_type() {
     return _type_handle;
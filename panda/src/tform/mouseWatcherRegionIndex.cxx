@@ -0,0 +1,213 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file mouseWatcherRegionIndex.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "mouseWatcherRegionIndex.h"
+
+/**
+ *
+ */
+MouseWatcherRegionIndex::
+MouseWatcherRegionIndex() {
+  reset(LVecBase4(-1.0f, 1.0f, -1.0f, 1.0f), 1);
+}
+
+/**
+ * Removes all of the regions, and changes the frame covered by the grid and
+ * the number of cells along each side of it.  Points and regions outside of
+ * the frame are still handled correctly, but are filed in the cells along the
+ * edge of the grid.
+ */
+void MouseWatcherRegionIndex::
+reset(const LVecBase4 &bounds, int grid_size) {
+  _bounds = bounds;
+  _grid_size = std::max(grid_size, 1);
+
+  // A degenerate frame puts everything in the first cell.
+  _x_scale = 0.0f;
+  _y_scale = 0.0f;
+  if (_bounds[1] > _bounds[0]) {
+    _x_scale = (PN_stdfloat)_grid_size / (_bounds[1] - _bounds[0]);
+  }
+  if (_bounds[3] > _bounds[2]) {
+    _y_scale = (PN_stdfloat)_grid_size / (_bounds[3] - _bounds[2]);
+  }
+
+  // A region that would be listed in more than a quarter of the cells is
+  // cheaper to keep on the large list.
+  _max_cells = std::max(_grid_size * _grid_size / 4, 1);
+
+  clear();
+}
+
+/**
+ * Removes all of the regions from the index.
+ */
+void MouseWatcherRegionIndex::
+clear() {
+  _entries.clear();
+  _cells.clear();
+  _cells.resize(_grid_size * _grid_size);
+  _large.clear();
+}
+
+/**
+ * Adds the indicated region to the index, filed according to its current
+ * frame.  If it is already in the index, its count is incremented instead.
+ */
+void MouseWatcherRegionIndex::
+add_region(MouseWatcherRegion *region) {
+  std::pair<Entries::iterator, bool> result =
+    _entries.insert(Entries::value_type(region, Entry()));
+  Entry &entry = (*result.first).second;
+  if (!result.second) {
+    ++entry._count;
+    return;
+  }
+
+  entry._region = region;
+  entry._count = 1;
+  entry._frame = region->get_frame();
+  entry._cells = get_cells(entry._frame);
+  file_region(region, entry._cells);
+}
+
+/**
+ * Decrements the count of the indicated region, and removes it from the index
+ * when it reaches zero.
+ */
+void MouseWatcherRegionIndex::
+remove_region(MouseWatcherRegion *region) {
+  Entries::iterator ei = _entries.find(region);
+  nassertv(ei != _entries.end());
+
+  Entry &entry = (*ei).second;
+  if (--entry._count <= 0) {
+    unfile_region(region, entry._cells);
+    _entries.erase(ei);
+  }
+}
+
+/**
+ * Checks each region in the index for a change in its frame since it was
+ * filed, and re-files the ones that have moved to a different set of cells.
+ */
+void MouseWatcherRegionIndex::
+update_frames() {
+  Entries::iterator ei;
+  for (ei = _entries.begin(); ei != _entries.end(); ++ei) {
+    Entry &entry = (*ei).second;
+    const LVecBase4 &frame = entry._region->get_frame();
+    if (frame != entry._frame) {
+      entry._frame = frame;
+      Cells cells = get_cells(frame);
+      if (cells != entry._cells) {
+        unfile_region((*ei).first, entry._cells);
+        file_region((*ei).first, cells);
+        entry._cells = cells;
+      }
+    }
+  }
+}
+
+/**
+ * Appends to the indicated vector each active region whose frame contains the
+ * indicated point, once for each time it was added to the index.  The regions
+ * are not sorted.
+ */
+void MouseWatcherRegionIndex::
+find_regions(pvector<MouseWatcherRegion *> &regions,
+             PN_stdfloat x, PN_stdfloat y) const {
+  const RegionList &cell = _cells[get_cell_y(y) * _grid_size + get_cell_x(x)];
+
+  for (int li = 0; li < 2; ++li) {
+    const RegionList &list = (li == 0) ? cell : _large;
+
+    RegionList::const_iterator ri;
+    for (ri = list.begin(); ri != list.end(); ++ri) {
+      MouseWatcherRegion *region = (*ri);
+      const LVecBase4 &frame = region->get_frame();
+
+      if (region->get_active() &&
+          x >= frame[0] && x <= frame[1] &&
+          y >= frame[2] && y <= frame[3]) {
+        Entries::const_iterator ei = _entries.find(region);
+        nassertd(ei != _entries.end()) continue;
+        regions.insert(regions.end(), (*ei).second._count, region);
+      }
+    }
+  }
+}
+
+/**
+ * Returns the range of cells that the indicated frame overlaps.
+ */
+MouseWatcherRegionIndex::Cells MouseWatcherRegionIndex::
+get_cells(const LVecBase4 &frame) const {
+  Cells cells;
+  cells._x0 = cells._x1 = cells._y0 = cells._y1 = 0;
+  cells._large = true;
+
+  // This also catches a frame with NaN in it.
+  if (!(frame[0] <= frame[1] && frame[2] <= frame[3])) {
+    return cells;
+  }
+
+  cells._x0 = get_cell_x(frame[0]);
+  cells._x1 = get_cell_x(frame[1]);
+  cells._y0 = get_cell_y(frame[2]);
+  cells._y1 = get_cell_y(frame[3]);
+  cells._large =
+    (cells._x1 - cells._x0 + 1) * (cells._y1 - cells._y0 + 1) > _max_cells;
+  return cells;
+}
+
+/**
+ * Lists the region in each of the indicated cells.
+ */
+void MouseWatcherRegionIndex::
+file_region(MouseWatcherRegion *region, const Cells &cells) {
+  if (cells._large) {
+    _large.push_back(region);
+    return;
+  }
+
+  for (int y = cells._y0; y <= cells._y1; ++y) {
+    for (int x = cells._x0; x <= cells._x1; ++x) {
+      _cells[y * _grid_size + x].push_back(region);
+    }
+  }
+}
+
+/**
+ * Removes the region from each of the indicated cells.
+ */
+void MouseWatcherRegionIndex::
+unfile_region(MouseWatcherRegion *region, const Cells &cells) {
+  if (cells._large) {
+    RegionList::iterator ri = std::find(_large.begin(), _large.end(), region);
+    nassertv(ri != _large.end());
+    (*ri) = _large.back();
+    _large.pop_back();
+    return;
+  }
+
+  for (int y = cells._y0; y <= cells._y1; ++y) {
+    for (int x = cells._x0; x <= cells._x1; ++x) {
+      RegionList &list = _cells[y * _grid_size + x];
+      RegionList::iterator ri = std::find(list.begin(), list.end(), region);
+      nassertd(ri != list.end()) continue;
+      (*ri) = list.back();
+      list.pop_back();
+    }
+  }
+}
@@ -0,0 +1,95 @@
+/**
+ * PANDA 3D SOFTWARE
+ * Copyright (c) Carnegie Mellon University.  All rights reserved.
+ *
+ * All use of this software is subject to the terms of the revised BSD
+ * license.  You should have received a copy of this license along
+ * with this source code in a file named "LICENSE."
+ *
+ * @file mouseWatcherRegionIndex.h
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#ifndef MOUSEWATCHERREGIONINDEX_H
+#define MOUSEWATCHERREGIONINDEX_H
+
+#include "pandabase.h"
+#include "mouseWatcherRegion.h"
+#include "pointerTo.h"
+#include "pvector.h"
+#include "pmap.h"
+#include "luse.h"
+
+/**
+ * A uniform grid over the frame of a MouseWatcher, used to quickly find the
+ * MouseWatcherRegions that contain a given point without testing every
+ * region.  Each region is listed in each of the cells its frame overlaps;
+ * regions that cover a large part of the grid are kept on a separate list
+ * instead, which is always searched.
+ *
+ * A region may be added more than once, in which case it is reported as many
+ * times, to match a linear scan over several overlapping sets of regions.
+ *
+ * The index does not know when a region's frame changes; update_frames() must
+ * be called to re-file any regions that have moved.
+ */
+class EXPCL_PANDA_TFORM MouseWatcherRegionIndex {
+public:
+  MouseWatcherRegionIndex();
+
+  void reset(const LVecBase4 &bounds, int grid_size);
+  void clear();
+
+  void add_region(MouseWatcherRegion *region);
+  void remove_region(MouseWatcherRegion *region);
+  void update_frames();
+
+  INLINE const LVecBase4 &get_bounds() const;
+  INLINE int get_grid_size() const;
+  INLINE size_t get_num_regions() const;
+
+  void find_regions(pvector<MouseWatcherRegion *> &regions,
+                    PN_stdfloat x, PN_stdfloat y) const;
+
+private:
+  class Cells {
+  public:
+    INLINE bool operator != (const Cells &other) const;
+
+    // The range of cells covered, inclusive, or _large if the region is kept
+    // on the large list.
+    int _x0, _x1, _y0, _y1;
+    bool _large;
+  };
+
+  class Entry {
+  public:
+    PT(MouseWatcherRegion) _region;
+    int _count;
+    LVecBase4 _frame;
+    Cells _cells;
+  };
+
+  INLINE int get_cell_x(PN_stdfloat x) const;
+  INLINE int get_cell_y(PN_stdfloat y) const;
+  Cells get_cells(const LVecBase4 &frame) const;
+  void file_region(MouseWatcherRegion *region, const Cells &cells);
+  void unfile_region(MouseWatcherRegion *region, const Cells &cells);
+
+  typedef pvector<MouseWatcherRegion *> RegionList;
+  typedef pmap<MouseWatcherRegion *, Entry> Entries;
+
+  LVecBase4 _bounds;
+  int _grid_size;
+  PN_stdfloat _x_scale, _y_scale;
+  int _max_cells;
+
+  Entries _entries;
+  pvector<RegionList> _cells;
+  RegionList _large;
+};
+
+#include "mouseWatcherRegionIndex.I"
+
+#endif
@@ -3,6 +3,7 @@
 #include "mouseWatcherGroup.cxx"
 #include "mouseWatcherParameter.cxx"
 #include "mouseWatcherRegion.cxx"
+#include "mouseWatcherRegionIndex.cxx"
 #include "trackball.cxx"
 #include "transform2sg.cxx"
 
@@ -1337,6 +1337,32 @@ end_draw_primitives() {
   GraphicsStateGuardian::end_draw_primitives();
 }
 
+/**
+ * Draws the same Geom several times in the same state, once with each of the
+ * indicated transforms.  The state is only set up once; since the vertices
+ * are transformed in software, each instance is then transformed and drawn
+ * in turn with its own matrix.
+ */
+void TinyGraphicsStateGuardian::
+draw_instances(const GeomPipelineReader *geom_reader,
+               const GeomVertexDataPipelineReader *data_reader,
+               const RenderState *state,
+               const TransformState * const *transforms,
+               size_t num_instances, bool force) {
+  _instanced_objects_pcollector.add_level(num_instances);
+  _instanced_draws_pcollector.add_level(num_instances);
+
+  set_state_and_transform(state, transforms[0]);
+
+  for (size_t i = 0; i < num_instances; ++i) {
+    if (transforms[i] != _internal_transform) {
+      _internal_transform = transforms[i];
+      do_issue_transform();
+    }
+    geom_reader->draw(this, data_reader, force);
+  }
+}
+
 /**
  * Copy the pixels within the indicated display region from the framebuffer
  * into texture memory.
@@ -75,6 +75,12 @@ public:
                            bool force);
   virtual void end_draw_primitives();
 
+  virtual void draw_instances(const GeomPipelineReader *geom_reader,
+                              const GeomVertexDataPipelineReader *data_reader,
+                              const RenderState *state,
+                              const TransformState * const *transforms,
+                              size_t num_instances, bool force);
+
   virtual bool framebuffer_copy_to_texture
   (Texture *tex, int view, int z, const DisplayRegion *dr, const RenderBuffer &rb);
   virtual bool framebuffer_copy_to_ram
@@ -1,6 +1,8 @@
 #include "DNAFlatBuilding.h"
 #include "DNAWall.h"
+#include "config_toontown.h"
 
+#include "config_pgraph.h"
 #include "decalEffect.h"
 #include "nodePathCollection.h"
 
@@ -157,6 +159,10 @@ void DNAFlatBuilding::traverse(NodePath& np, DNAStorage* store)
         holder_child_0.reparent_to(internal_node);
         holder_child_0.set_effect(DecalEffect::make());
 
+        // The walls are large and opaque, which makes them good occluders.
+        if (dna_tag_occluders)
+            holder_child_0.set_tag(software_occlusion_tag, "1");
+
         wall_holder.remove_node();
         wall_decal.remove_node();
         
@@ -14,6 +14,9 @@ typedef std::vector<PT(DNAGroup)> dna_group_vec_t;
 
 class EXPCL_DNA DNAGroup : public TypedReferenceCount
 {
+    public:
+        ALLOC_MEMORY_TAG(MemoryHook::MT_dna);
+
     PUBLISHED:
         DNAGroup(const std::string& name);
         ~DNAGroup();
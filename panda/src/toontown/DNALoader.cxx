@@ -46,6 +46,11 @@ NodePath DNALoader::load_DNA_file(DNAStorage* store, const Filename& file)
     NodePath np = NodePath("dna");
     m_cur_comp->traverse(np, m_cur_store);
 
+    // Now that the visgroups have their nodes, work out which of them can be
+    // seen from where, for the CullTraverser.
+    if (dna_cell_visibility && m_cur_store->get_num_DNA_vis_groups() != 0)
+        m_cur_store->build_cell_visibility(np);
+
     m_cur_store = nullptr;
     m_cur_comp = nullptr;
 
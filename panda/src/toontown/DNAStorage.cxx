@@ -51,6 +51,7 @@ std::string DNAStorage::get_DNA_vis_group_name(size_t index)
 void DNAStorage::reset_DNA_vis_groups()
 {
     m_vis_groups.clear();
+    m_cell_visibility = nullptr;
 }
 
 void DNAStorage::reset_DNA_vis_groups_AI()
@@ -58,6 +59,68 @@ void DNAStorage::reset_DNA_vis_groups_AI()
     reset_DNA_vis_groups();
 }
 
+// Builds a CellVisibility table with a cell for each visgroup below root: the
+// cell is drawn through the visgroup's node, the camera is located by the
+// visgroup's suit edges, and the visgroup's visibles list says which other
+// cells can be seen from it.  The suit points are given relative to root.
+// Visgroups stored by other files that were loaded into this storage are
+// left out.
+PT(CellVisibility) DNAStorage::build_cell_visibility(const NodePath& root)
+{
+    PT(CellVisibility) vis = new CellVisibility;
+    vis->set_root(root);
+    vis->set_max_distance(dna_cell_max_distance);
+
+    visgroup_vec_t groups;
+    for (visgroup_vec_t::iterator it = m_vis_groups.begin(); it != m_vis_groups.end(); ++it)
+    {
+        DNAVisGroup* group = *it;
+        if (group->get_node() == nullptr || root.find_path_to(group->get_node()).is_empty())
+            continue;
+
+        groups.push_back(group);
+        int cell = vis->add_cell(group->get_name());
+        vis->add_cell_node(cell, group->get_node());
+
+        for (size_t i = 0; i < group->get_num_suit_edges(); ++i)
+        {
+            PT(DNASuitEdge) edge = group->get_suit_edge(i);
+            if (edge == nullptr || edge->get_start_point() == nullptr || edge->get_end_point() == nullptr)
+                continue;
+
+            vis->add_cell_segment(cell, LCAST(PN_stdfloat, edge->get_start_point()->get_pos()),
+                                  LCAST(PN_stdfloat, edge->get_end_point()->get_pos()));
+        }
+    }
+
+    // The cells were added in the same order as the visgroups in groups.
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+        DNAVisGroup* group = groups[i];
+        for (size_t j = 0; j < group->get_num_visibles(); ++j)
+        {
+            int visible = vis->find_cell(group->get_visible(j));
+            if (visible != -1)
+                vis->add_visible((int)i, visible);
+        }
+    }
+
+    if (dna_cat.is_debug())
+    {
+        dna_cat.debug() << *vis << std::endl;
+    }
+
+    m_cell_visibility = vis;
+    return vis;
+}
+
+// Returns the table made by the most recent call to build_cell_visibility(),
+// or nullptr if there is none.
+PT(CellVisibility) DNAStorage::get_cell_visibility()
+{
+    return m_cell_visibility;
+}
+
 void DNAStorage::store_texture(const std::string& name, PT(Texture) texture)
 {
     m_textures[name] = texture;
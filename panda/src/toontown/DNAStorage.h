@@ -10,6 +10,7 @@
 #include "textFont.h"
 #include "texture.h"
 #include "nodePath.h"
+#include "cellVisibility.h"
 
 #ifndef CPPPARSER
 typedef struct {
@@ -60,6 +61,9 @@ class EXPCL_DNA DNAStorage
         void reset_DNA_vis_groups();
         void reset_DNA_vis_groups_AI();
 
+        PT(CellVisibility) build_cell_visibility(const NodePath& root);
+        PT(CellVisibility) get_cell_visibility();
+
         void store_texture(const std::string& name, PT(Texture) texture);
         PT(Texture) find_texture(const std::string& name);
         void reset_textures();
@@ -163,6 +167,7 @@ class EXPCL_DNA DNAStorage
         texture_map_t m_textures;
         catalog_codes_map_t m_catalog_codes;
         transform_map_t m_block_transforms;
+        PT(CellVisibility) m_cell_visibility;
 #endif
 };
 #endif
@@ -121,5 +121,7 @@ void DNAVisGroup::make_from_dgi(DatagramIterator& dgi, DNAStorage* store)
 
 void DNAVisGroup::traverse(NodePath& np, DNAStorage* store)
 {
-    DNAGroup::traverse(np, store);
+    NodePath _np = np.attach_new_node(m_name);
+    m_node = _np.node();
+    traverse_children(_np, store);
 }
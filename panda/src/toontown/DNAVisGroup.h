@@ -110,6 +110,9 @@ class EXPCL_DNA DNAVisGroup : public DNAGroup
         suit_edge_vec_t m_suit_edges;
         battle_cell_vec_t m_battle_cells;
 
+    // The node that was made for this visgroup by traverse().
+    PROPERTY(PT(PandaNode), node);
+
     TYPE_HANDLE(DNAVisGroup, DNAGroup);
 };
 
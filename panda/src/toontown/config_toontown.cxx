@@ -44,6 +44,26 @@
 Configure(config_toontown);
 NotifyCategoryDef(dna, "");
 
+ConfigVariableBool dna_tag_occluders
+("dna-tag-occluders", true,
+ PRC_DESC("Set this true to tag the walls of each flat building with the "
+          "software-occlusion-tag as they are loaded, so that they may be "
+          "passed to SoftwareOcclusionCuller::add_occluders()."));
+
+ConfigVariableBool dna_cell_visibility
+("dna-cell-visibility", true,
+ PRC_DESC("Set this true to build a CellVisibility table from the visgroups "
+          "of each DNA file that has them, as it is loaded.  The table is "
+          "available from DNAStorage::get_cell_visibility(), and may be "
+          "passed to CullTraverser::set_cell_visibility() so that visgroups "
+          "which cannot be seen from the camera's visgroup are culled."));
+
+ConfigVariableDouble dna_cell_max_distance
+("dna-cell-max-distance", 150.0,
+ PRC_DESC("The farthest the camera may be from the nearest suit edge and "
+          "still be considered to be within that edge's visgroup.  Beyond "
+          "this, no visgroups are culled.  Set this to 0 for no limit."));
+
 ConfigureFn(config_toontown) {
   init_libtoontown();
 }
@@ -16,9 +16,15 @@
 #include "pandabase.h"
 #include "dconfig.h"
 #include "notifyCategoryProxy.h"
+#include "configVariableBool.h"
+#include "configVariableDouble.h"
 
 NotifyCategoryDecl(dna, EXPCL_DNA, EXPTP_DNA);
 
+extern EXPCL_DNA ConfigVariableBool dna_tag_occluders;
+extern EXPCL_DNA ConfigVariableBool dna_cell_visibility;
+extern EXPCL_DNA ConfigVariableDouble dna_cell_max_distance;
+
 extern EXPCL_DNA void init_libtoontown();
 
 #endif /* __CONFIG_TOONTOWN_H__ */
@@ -0,0 +1,212 @@
+/**
+ * TOONTOWN OFFLINE SOFTWARE
+ * Copyright (c) The Toontown Offline Team.  All rights reserved.
+ *
+ * Use of this software by anyone other than those of the Toontown Offline team
+ * is strictly prohibited without explicit permission from the Toontown Offline team.
+ *
+ * @file test_dna_cell_visibility.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "DNAStorage.h"
+#include "DNASuitEdge.h"
+#include "DNASuitPoint.h"
+#include "DNAVisGroup.h"
+#include "config_toontown.h"
+
+#include "config_display.h"
+#include "graphicsStateGuardian.h"
+#include "cullTraverser.h"
+#include "cullHandler.h"
+#include "cullableObject.h"
+#include "sceneSetup.h"
+#include "camera.h"
+#include "geomNode.h"
+#include "geom.h"
+#include "geomPoints.h"
+#include "geomVertexData.h"
+#include "geomVertexWriter.h"
+
+#include <set>
+
+using std::cerr;
+
+static int num_failures = 0;
+
+#define CHECK(condition) \
+    if (!(condition)) { \
+        cerr << "FAILED: " #condition " (line " << __LINE__ << ")\n"; \
+        ++num_failures; \
+    }
+
+typedef std::set<std::string> Names;
+
+/**
+ * A CullHandler that records the name of the vertex data of each Geom it is
+ * given, instead of drawing it.
+ */
+class RecordingCullHandler : public CullHandler
+{
+    public:
+        virtual void record_object(CullableObject* object, const CullTraverser* traverser)
+        {
+            m_drawn.insert(object->_geom->get_vertex_data()->get_name());
+            delete object;
+        }
+
+        Names m_drawn;
+};
+
+/**
+ * Returns a GeomNode holding a single point, in vertex data of the indicated
+ * name.
+ */
+static PT(GeomNode) make_point(const std::string& name)
+{
+    PT(GeomVertexData) vdata = new GeomVertexData(name, GeomVertexFormat::get_v3(), Geom::UH_static);
+    GeomVertexWriter vertex(vdata, InternalName::get_vertex());
+    vertex.add_data3(0, 0, 0);
+
+    PT(GeomPoints) prim = new GeomPoints(Geom::UH_static);
+    prim->add_vertex(0);
+
+    PT(Geom) geom = new Geom(vdata);
+    geom->add_primitive(prim);
+
+    PT(GeomNode) node = new GeomNode(name);
+    node->add_geom(geom);
+    return node;
+}
+
+/**
+ * Makes a visgroup with a single suit edge from x0 to x1 along the X axis,
+ * traverses it below the indicated node, and stores it.  A GeomNode with the
+ * visgroup's name is put below the visgroup's node.
+ */
+static PT(DNAVisGroup) make_vis_group(DNAStorage& store, NodePath& parent, const std::string& name,
+                                      float x0, float x1)
+{
+    PT(DNAVisGroup) group = new DNAVisGroup(name);
+    PT(DNASuitPoint) start = new DNASuitPoint(0, DNASuitPoint::STREET_POINT, LPoint3f(x0, 0, 0));
+    PT(DNASuitPoint) end = new DNASuitPoint(1, DNASuitPoint::STREET_POINT, LPoint3f(x1, 0, 0));
+    group->add_suit_edge(new DNASuitEdge(start, end, 0));
+    group->add_visible(name);
+
+    group->traverse(parent, &store);
+    NodePath(group->get_node()).attach_new_node(make_point(name));
+    store.store_DNA_vis_group(group);
+    return group;
+}
+
+/**
+ * Culls the scene below render from a camera at the indicated position,
+ * with the indicated table, and returns the names of the Geoms that were
+ * drawn.  The camera's cell is stored in camera_cell.
+ */
+static Names cull(const NodePath& render, CellVisibility* vis, const LPoint3& pos, int& camera_cell)
+{
+    PT(Camera) camera_node = new Camera("camera");
+    NodePath camera = render.attach_new_node(camera_node);
+    camera.set_pos(pos);
+
+    PT(SceneSetup) scene_setup = new SceneSetup;
+    scene_setup->set_scene_root(render);
+    scene_setup->set_camera_path(camera);
+    scene_setup->set_camera_node(camera_node);
+    scene_setup->set_lens(camera_node->get_lens());
+    scene_setup->set_initial_state(RenderState::make_empty());
+    scene_setup->set_camera_transform(camera.get_net_transform());
+    scene_setup->set_world_transform(camera.get_net_transform()->get_inverse());
+    scene_setup->set_cs_transform(TransformState::make_identity());
+    scene_setup->set_cs_world_transform(scene_setup->get_world_transform());
+
+    PT(GraphicsStateGuardian) gsg = new GraphicsStateGuardian(CS_zup_right, nullptr, nullptr);
+    RecordingCullHandler handler;
+
+    PT(CullTraverser) trav = new CullTraverser;
+    trav->set_scene(scene_setup, gsg, false);
+    trav->set_cull_handler(&handler);
+    trav->set_cell_visibility(vis);
+    trav->traverse(render);
+    camera_cell = trav->get_camera_cell();
+
+    camera.remove_node();
+    return handler.m_drawn;
+}
+
+/**
+ * Builds a street of three visgroups in a row, each of which sees only its
+ * neighbours, after another file has stored a visgroup of its own in the
+ * same storage.  Checks that the table leaves out the other file's
+ * visgroup, and that the CullTraverser prunes the visgroups that cannot be
+ * seen from the camera's.
+ */
+int main(int argc, char *argv[])
+{
+    init_libtoontown();
+    init_libdisplay();
+
+    DNAStorage store;
+
+    // A visgroup from a file loaded earlier, far from the street, which
+    // claims to see the street's first visgroup.
+    NodePath other("other");
+    PT(DNAVisGroup) other_group = make_vis_group(store, other, "2000", 1000, 1010);
+    other_group->add_visible("1000");
+
+    NodePath render("render");
+    NodePath street = render.attach_new_node("street");
+    static const char* const names[] = {"1000", "1001", "1002"};
+    PT(DNAVisGroup) groups[3];
+    for (int i = 0; i < 3; ++i)
+        groups[i] = make_vis_group(store, street, names[i], i * 10.0f, i * 10.0f + 10.0f);
+
+    for (int i = 0; i < 2; ++i)
+    {
+        groups[i]->add_visible(names[i + 1]);
+        groups[i + 1]->add_visible(names[i]);
+    }
+    groups[0]->add_visible("2000");
+
+    // Something that is in no visgroup is always drawn.
+    street.attach_new_node(make_point("sky"));
+
+    PT(CellVisibility) vis = store.build_cell_visibility(street);
+    CHECK(store.get_cell_visibility() == vis);
+    CHECK(vis->get_num_cells() == 3);
+    CHECK(vis->find_cell("2000") == -1);
+    for (int i = 0; i < 3; ++i)
+        CHECK(vis->find_cell(names[i]) == i);
+    CHECK(vis->is_visible(0, 1));
+    CHECK(!vis->is_visible(0, 2));
+
+    int camera_cell = -1;
+    Names drawn = cull(render, vis, LPoint3(5, 0, 5), camera_cell);
+    CHECK(camera_cell == 0);
+    CHECK(drawn == Names({"1000", "1001", "sky"}));
+
+    drawn = cull(render, vis, LPoint3(25, 0, 5), camera_cell);
+    CHECK(camera_cell == 2);
+    CHECK(drawn == Names({"1001", "1002", "sky"}));
+
+    // The other file's visgroup doesn't locate the camera, so nothing is
+    // pruned when the camera is out there.
+    drawn = cull(render, vis, LPoint3(1005, 0, 5), camera_cell);
+    CHECK(camera_cell == -1);
+    CHECK(drawn == Names({"1000", "1001", "1002", "sky"}));
+
+    // Without a table, nothing is pruned either.
+    drawn = cull(render, nullptr, LPoint3(5, 0, 5), camera_cell);
+    CHECK(camera_cell == -1);
+    CHECK(drawn == Names({"1000", "1001", "1002", "sky"}));
+
+    if (num_failures != 0)
+    {
+        cerr << num_failures << " checks failed.\n";
+        return 1;
+    }
+    cerr << "All checks passed.\n";
+    return 0;
+}
@@ -0,0 +1,132 @@
+/**
+ * TOONTOWN OFFLINE SOFTWARE
+ * Copyright (c) The Toontown Offline Team.  All rights reserved.
+ *
+ * Use of this software by anyone other than those of the Toontown Offline team
+ * is strictly prohibited without explicit permission from the Toontown Offline team.
+ *
+ * @file test_dna_occlusion.cxx
+ * @author rocketprogrammer
+ * @date 2026-10-18
+ */
+
+#include "DNALoader.h"
+#include "DNAStorage.h"
+#include "DNASuitPoint.h"
+#include "config_toontown.h"
+
+#include "softwareOcclusionCuller.h"
+#include "perspectiveLens.h"
+#include "camera.h"
+#include "nodePathCollection.h"
+#include "boundingHexahedron.h"
+
+#include <chrono>
+
+using std::cerr;
+using std::endl;
+
+typedef std::chrono::steady_clock Clock;
+
+/**
+ * Loads a street, along with the storage files it needs, and views it from
+ * each of its suit points in four directions.  For each view, reports how
+ * many of the GeomNodes within the viewing frustum are hidden behind the
+ * walls of the flat buildings, and how long it took to find out.
+ *
+ * Usage: test_dna_occlusion storage.dna [storage.dna ...] street.dna
+ */
+int
+main(int argc, char *argv[]) {
+    if (argc < 3)
+    {
+        cerr << "Usage: test_dna_occlusion storage.dna [storage.dna ...] street.dna\n";
+        return 1;
+    }
+
+    init_libtoontown();
+
+    DNAStorage store;
+    DNALoader loader;
+    for (int i = 1; i < argc - 1; ++i)
+        loader.load_DNA_file(&store, Filename::from_os_specific(argv[i]));
+
+    NodePath render("render");
+    NodePath street = loader.load_DNA_file(&store, Filename::from_os_specific(argv[argc - 1]));
+    if (street.is_empty())
+    {
+        cerr << "Could not load " << argv[argc - 1] << "\n";
+        return 1;
+    }
+    street.reparent_to(render);
+
+    PT(PerspectiveLens) lens = new PerspectiveLens;
+    lens->set_fov(52.0f);
+    lens->set_near_far(1.0f, 1000.0f);
+    lens->set_aspect_ratio(4.0f / 3.0f);
+    NodePath camera = render.attach_new_node(new Camera("camera", lens));
+
+    PT(SoftwareOcclusionCuller) culler = new SoftwareOcclusionCuller;
+    culler->add_occluders(render);
+
+    NodePathCollection geom_nodes = render.find_all_matches("**/+GeomNode");
+    int num_geom_nodes = geom_nodes.get_num_paths();
+    cerr << num_geom_nodes << " GeomNodes, " << culler->get_num_occluders()
+         << " occluders\n";
+
+    size_t num_points = store.get_num_suit_points();
+    if (num_points == 0)
+    {
+        cerr << "The street has no suit points to view it from.\n";
+        return 1;
+    }
+
+    int total_in_frustum = 0;
+    int total_occluded = 0;
+    std::chrono::duration<double, std::micro> prepare_time(0);
+    std::chrono::duration<double, std::micro> test_time(0);
+    int num_views = 0;
+
+    for (size_t pi = 0; pi < num_points; ++pi)
+    {
+        LPoint3 pos = LCAST(PN_stdfloat, store.get_suit_point_at_index(pi)->get_pos());
+        for (int h = 0; h < 360; h += 90)
+        {
+            camera.set_pos_hpr(pos + LVector3(0.0f, 0.0f, 4.0f), LVecBase3(h, 0.0f, 0.0f));
+
+            PT(BoundingVolume) frustum = lens->make_bounds();
+            frustum->as_geometric_bounding_volume()->xform(camera.get_mat(render));
+
+            Clock::time_point start = Clock::now();
+            culler->prepare(camera, lens);
+            prepare_time += Clock::now() - start;
+
+            for (int i = 0; i < num_geom_nodes; ++i)
+            {
+                NodePath np = geom_nodes.get_path(i);
+                PT(BoundingVolume) bounds = np.get_bounds();
+                bounds->as_geometric_bounding_volume()->xform(np.get_parent().get_mat(render));
+                if (frustum->contains(bounds) == BoundingVolume::IF_no_intersection)
+                    continue;
+
+                ++total_in_frustum;
+                start = Clock::now();
+                if (culler->is_occluded(np))
+                    ++total_occluded;
+                test_time += Clock::now() - start;
+            }
+            ++num_views;
+        }
+    }
+
+    cerr << num_views << " views, " << culler->get_buffer_width() << "x"
+         << culler->get_buffer_height() << " depth buffer\n";
+    cerr << "in frustum: " << (double)total_in_frustum / num_views << " GeomNodes/view\n";
+    cerr << "occluded:   " << (double)total_occluded / num_views << " GeomNodes/view ("
+         << 100.0 * total_occluded / std::max(total_in_frustum, 1) << "%)\n";
+    cerr << "rasterize:  " << prepare_time.count() / num_views << " us/view\n";
+    cerr << "test:       " << test_time.count() / std::max(total_in_frustum, 1)
+         << " us/GeomNode\n";
+
+    return 0;
+}
@@ -195,6 +195,13 @@ EggPalettize() : EggMultiFilter(true) {
      "of keeping every texture as a separate image (which is convenient for "
      "development).",
      &EggPalettize::dispatch_none, &_omitall);
+  add_option
+    ("j", "threads", 0,
+     "Read, scale and write the texture and palette images on this many "
+     "threads at once.  Palette images that share a source texture are "
+     "still generated one at a time.  The default is 0, which does all of "
+     "the work on the main thread.",
+     &EggPalettize::dispatch_int, nullptr, &_num_threads);
 
   // This isn't even implemented yet.  Presently, we never lock anyway.
   // Dangerous, but hard to implement reliable file locking across NFSSamba
@@ -215,6 +222,7 @@ EggPalettize() : EggMultiFilter(true) {
      &EggPalettize::dispatch_none, &_describe_input_file);
 
   _txa_filename = "textures.txa";
+  _num_threads = 0;
 }
 
 
@@ -682,6 +690,7 @@ run() {
   }
 
   pal->set_noabs(_noabs);
+  pal->set_num_threads(_num_threads);
 
   if (_report_pi) {
     pal->report_pi();
@@ -19,6 +19,7 @@
 #include "filename.h"
 
 #include "pmap.h"
+#include "lightMutex.h"
 
 /**
  * This static class does the job of converting filenames from relative to
@@ -46,6 +47,7 @@ private:
 
   typedef pmap<std::string, std::string> CanonicalFilenames;
   static CanonicalFilenames _canonical_filenames;
+  static LightMutex _canonical_lock;
 };
 
 #endif
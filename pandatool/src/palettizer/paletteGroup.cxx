@@ -554,6 +554,19 @@ update_images(bool redo_all) {
   }
 }
 
+/**
+ * Determines which PaletteImages on this group need to be regenerated, and
+ * appends them to the indicated vector.  See PaletteImage::check_update().
+ */
+void PaletteGroup::
+check_images(bool redo_all, pvector<PaletteImage *> &pending) {
+  Pages::iterator pai;
+  for (pai = _pages.begin(); pai != _pages.end(); ++pai) {
+    PalettePage *page = (*pai).second;
+    page->check_images(redo_all, pending);
+  }
+}
+
 /**
  * Registers the current object as something that can be read from a Bam file.
  */
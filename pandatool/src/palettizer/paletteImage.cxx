@@ -134,6 +134,7 @@ PaletteImage() {
   _index = 0;
   _new_image = false;
   _got_image = false;
+  _update_master = false;
 
   _swapped_image = 0;
 }
@@ -152,6 +153,7 @@ PaletteImage(PalettePage *page, int index) :
   _y_size = pal->_pal_y_size;
   _new_image = true;
   _got_image = false;
+  _update_master = false;
   _swapped_image = 0;
 
   setup_filename();
@@ -172,6 +174,7 @@ PaletteImage(PalettePage *page, int index, unsigned swapIndex) :
   _y_size = pal->_pal_y_size;
   _new_image = true;
   _got_image = false;
+  _update_master = false;
 
   setup_filename();
 }
@@ -526,11 +529,31 @@ setup_shadow_image() {
  */
 void PaletteImage::
 update_image(bool redo_all) {
+  if (check_update(redo_all)) {
+    generate_image();
+  }
+}
+
+/**
+ * The first half of update_image(): determines which of this palette image
+ * and its swapped images are out of date, and returns true if any of them
+ * are, in which case generate_image() must be called to bring them up to
+ * date.
+ *
+ * This may mark egg files stale and rename or remove image files, so it must
+ * be called on the main thread.
+ */
+bool PaletteImage::
+check_update(bool redo_all) {
+  _update_master = false;
+  _stale_swaps.clear();
+  _swapped_stale.assign(_swappedImages.size(), false);
+
   if (is_empty() && pal->_aggressively_clean_mapdir) {
     // If the palette image is 'empty', ensure that it doesn't exist.  No need
     // to clutter up the map directory.
     remove_image();
-    return;
+    return false;
   }
 
   if (redo_all) {
@@ -541,8 +564,17 @@ update_image(bool redo_all) {
   // Check the filename too.
   update_filename();
 
+  SwappedImages::iterator si;
+  for (si = _swappedImages.begin(); si != _swappedImages.end(); ++si) {
+    PaletteImage *swappedImage = (*si);
+    swappedImage->update_filename();
+    if (swappedImage->_new_image || !swappedImage->exists()) {
+      _swapped_stale[si - _swappedImages.begin()] = true;
+    }
+  }
+
   // Do we need to update?
-  bool needs_update =
+  _update_master =
     _new_image || !exists() ||
     !_cleared_regions.empty();
 
@@ -554,7 +586,7 @@ update_image(bool redo_all) {
     TexturePlacement *placement = (*pi);
 
     if (!placement->is_filled()) {
-      needs_update = true;
+      _update_master = true;
 
     } else {
       TextureImage *texture = placement->get_texture();
@@ -569,24 +601,34 @@ update_image(bool redo_all) {
           // The source image is newer than the palette image; we need to
           // regenerate.
           placement->mark_unfilled();
-          needs_update = true;
+          _update_master = true;
         }
       }
 
-      // [gjeon] to find out all of the swappable textures is up to date
+      // [gjeon] to find out all of the swappable textures is up to date.  A
+      // swappable texture only appears on its own swapped image, so only
+      // that image needs to be regenerated when it changes.
       TexturePlacement::TextureSwaps::iterator tsi;
       for (tsi = placement->_textureSwaps.begin(); tsi != placement->_textureSwaps.end(); ++tsi) {
         TextureImage *swapTexture = (*tsi);
+        int index = tsi - placement->_textureSwaps.begin();
 
         if (swapTexture->is_texture_named()) {
           SourceTextureImage *sourceSwapTexture = swapTexture->get_preferred_source();
+          if (sourceSwapTexture == nullptr) {
+            continue;
+          }
 
-          if (sourceSwapTexture != nullptr &&
-              sourceSwapTexture->get_filename().compare_timestamps(get_filename()) > 0) {
-            // The source image is newer than the palette image; we need to
-            // regenerate.
+          if (index < (int)_swappedImages.size()) {
+            PaletteImage *swappedImage = _swappedImages[index];
+            if (sourceSwapTexture->get_filename().compare_timestamps(swappedImage->get_filename()) > 0) {
+              _stale_swaps.push_back(StaleSwap(placement, index));
+              _swapped_stale[index] = true;
+            }
+
+          } else if (sourceSwapTexture->get_filename().compare_timestamps(get_filename()) > 0) {
             placement->mark_unfilled();
-            needs_update = true;
+            _update_master = true;
           }
         }
       }
@@ -594,8 +636,59 @@ update_image(bool redo_all) {
     }
   }
 
-  if (!needs_update) {
-    // No sweat; nothing has changed.
+  if (_update_master) {
+    return true;
+  }
+
+  for (size_t i = 0; i < _swapped_stale.size(); ++i) {
+    if (_swapped_stale[i]) {
+      return true;
+    }
+  }
+
+  // No sweat; nothing has changed.
+  return false;
+}
+
+/**
+ * The second half of update_image(): reads, fills in and writes out the
+ * images that check_update() found to be out of date.
+ *
+ * This reads the source images of the textures returned by get_textures(),
+ * but touches no other shared state, so palette images that have no textures
+ * in common may be generated on different threads at the same time.
+ */
+void PaletteImage::
+generate_image() {
+  SwappedImages::iterator si;
+  StaleSwaps::iterator ssi;
+
+  if (!_update_master) {
+    // Only some of the swapped images are out of date.  Leave this image, and
+    // the rest of the swapped images, alone.
+    for (si = _swappedImages.begin(); si != _swappedImages.end(); ++si) {
+      int index = si - _swappedImages.begin();
+      if (!_swapped_stale[index]) {
+        continue;
+      }
+
+      PaletteImage *swappedImage = (*si);
+      swappedImage->get_swapped_image(index);
+      for (ssi = _stale_swaps.begin(); ssi != _stale_swaps.end(); ++ssi) {
+        if ((*ssi).second == index) {
+          (*ssi).first->fill_swapped_image(swappedImage->_image, index);
+        }
+      }
+
+      swappedImage->write(swappedImage->_image);
+      if (pal->_shadow_color_type != nullptr) {
+        swappedImage->_shadow_image.write(swappedImage->_image);
+      }
+      swappedImage->release_image();
+    }
+
+    _stale_swaps.clear();
+    _swapped_stale.clear();
     return;
   }
 
@@ -610,7 +703,6 @@ update_image(bool redo_all) {
     region.clear(_image);
 
     // [gjeon] clear swapped images also
-    SwappedImages::iterator si;
     for (si = _swappedImages.begin(); si != _swappedImages.end(); ++si) {
       PaletteImage *swappedImage = (*si);
       region.clear(swappedImage->_image);
@@ -619,21 +711,26 @@ update_image(bool redo_all) {
   _cleared_regions.clear();
 
   // Now add the recent additions to the image.
+  Placements::iterator pi;
   for (pi = _placements.begin(); pi != _placements.end(); ++pi) {
     TexturePlacement *placement = (*pi);
     if (!placement->is_filled()) {
       placement->fill_image(_image);
 
       // [gjeon] fill swapped images
-      SwappedImages::iterator si;
       for (si = _swappedImages.begin(); si != _swappedImages.end(); ++si) {
         PaletteImage *swappedImage = (*si);
-        swappedImage->update_filename();
         placement->fill_swapped_image(swappedImage->_image, si - _swappedImages.begin());
       }
     }
   }
 
+  // And the swappable textures that changed on their own.
+  for (ssi = _stale_swaps.begin(); ssi != _stale_swaps.end(); ++ssi) {
+    int index = (*ssi).second;
+    (*ssi).first->fill_swapped_image(_swappedImages[index]->_image, index);
+  }
+
   write(_image);
 
   if (pal->_shadow_color_type != nullptr) {
@@ -643,7 +740,6 @@ update_image(bool redo_all) {
   release_image();
 
   // [gjeon] write and release swapped images
-  SwappedImages::iterator si;
   for (si = _swappedImages.begin(); si != _swappedImages.end(); ++si) {
     PaletteImage *swappedImage = (*si);
     swappedImage->write(swappedImage->_image);
@@ -652,6 +748,25 @@ update_image(bool redo_all) {
     }
     swappedImage->release_image();
   }
+
+  _update_master = false;
+  _stale_swaps.clear();
+  _swapped_stale.clear();
+}
+
+/**
+ * Appends to the indicated vector each of the textures, including the
+ * swappable textures, whose source images are read by generate_image().
+ */
+void PaletteImage::
+get_textures(pvector<TextureImage *> &textures) const {
+  Placements::const_iterator pi;
+  for (pi = _placements.begin(); pi != _placements.end(); ++pi) {
+    TexturePlacement *placement = (*pi);
+    textures.push_back(placement->get_texture());
+    textures.insert(textures.end(), placement->_textureSwaps.begin(),
+                    placement->_textureSwaps.end());
+  }
 }
 
 /**
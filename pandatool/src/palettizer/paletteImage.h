@@ -22,6 +22,7 @@
 
 class PalettePage;
 class TexturePlacement;
+class TextureImage;
 
 /**
  * This is a single palette image, one of several within a PalettePage, which
@@ -55,6 +56,9 @@ public:
   void reset_image();
   void setup_shadow_image();
   void update_image(bool redo_all);
+  bool check_update(bool redo_all);
+  void generate_image();
+  void get_textures(pvector<TextureImage *> &textures) const;
 
   bool update_filename();
 
@@ -109,6 +113,15 @@ private:
   typedef pvector<PaletteImage *> SwappedImages;
   SwappedImages _swappedImages;
 
+  // These are filled in by check_update() for the benefit of
+  // generate_image(), and are not written to the bam file.  _stale_swaps
+  // lists the swappable textures that are newer than their swapped images.
+  bool _update_master;
+  typedef std::pair<TexturePlacement *, int> StaleSwap;
+  typedef pvector<StaleSwap> StaleSwaps;
+  StaleSwaps _stale_swaps;
+  pvector<bool> _swapped_stale;
+
   // The TypedWritable interface follows.
 public:
   static void register_with_read_factory();
@@ -208,6 +208,21 @@ update_images(bool redo_all) {
   }
 }
 
+/**
+ * Determines which PaletteImages on this page need to be regenerated, and
+ * appends them to the indicated vector.  See PaletteImage::check_update().
+ */
+void PalettePage::
+check_images(bool redo_all, pvector<PaletteImage *> &pending) {
+  Images::iterator ii;
+  for (ii = _images.begin(); ii != _images.end(); ++ii) {
+    PaletteImage *image = (*ii);
+    if (image->check_update(redo_all)) {
+      pending.push_back(image);
+    }
+  }
+}
+
 /**
  * Registers the current object as something that can be read from a Bam file.
  */
@@ -50,6 +50,7 @@ public:
   void reset_images();
   void setup_shadow_images();
   void update_images(bool redo_all);
+  void check_images(bool redo_all, pvector<PaletteImage *> &pending);
 
 private:
   PaletteGroup *_group;
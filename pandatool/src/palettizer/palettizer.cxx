@@ -18,6 +18,7 @@
 #include "paletteGroup.h"
 #include "filenameUnifier.h"
 #include "textureMemoryCounter.h"
+#include "paletteImage.h"
 
 #include "pnmImage.h"
 #include "pnmFileTypeRegistry.h"
@@ -28,6 +29,10 @@
 #include "bamReader.h"
 #include "bamWriter.h"
 #include "indent.h"
+#include "genericAsyncTask.h"
+#include "asyncTaskManager.h"
+#include "thread.h"
+#include "vector_int.h"
 
 using std::cout;
 using std::string;
@@ -93,6 +98,27 @@ public:
   }
 };
 
+// A texture whose image is read by read_texture_job(): the complete image if
+// _full is true, or just the header otherwise.
+class TextureRead {
+public:
+  TextureImage *_texture;
+  bool _full;
+};
+typedef pvector<TextureRead> TextureReads;
+
+// The palette images to be generated by update_images_job().  Each job
+// generates one set of images, which have no textures in common with any
+// other set.
+typedef pvector<pvector<PaletteImage *> > ImageSets;
+
+// The textures to be copied by copy_unplaced_job().
+class UnplacedCopies {
+public:
+  pvector<TextureImage *> _textures;
+  bool _redo_all;
+};
+
 // And this one is used in report_pi().
 class SortGroupsByPreference {
 public:
@@ -108,6 +134,7 @@ Palettizer::
 Palettizer() {
   _is_valid = true;
   _noabs = false;
+  _num_threads = 0;
 
   _generated_image_pattern = "%g_palette_%p_%i";
   _map_dirname = "%g";
@@ -159,6 +186,25 @@ set_noabs(bool noabs) {
   _noabs = noabs;
 }
 
+/**
+ * Returns the number of threads used to read and write images.  See
+ * set_num_threads().
+ */
+int Palettizer::
+get_num_threads() const {
+  return _num_threads;
+}
+
+/**
+ * Changes the number of threads that are used to read the source images and
+ * to generate and write the palette images and unplaced textures.  If this is
+ * 0 or 1, all of the work is done on the main thread.
+ */
+void Palettizer::
+set_num_threads(int num_threads) {
+  _num_threads = num_threads;
+}
+
 /**
  * Returns true if the palette information file was read correctly, or false
  * if there was some error and the palettization can't continue.
@@ -448,6 +494,21 @@ process_command_line_eggs(bool force_texture_read, const Filename &state_filenam
   // Now match each of the textures mentioned in those egg files against a
   // line in the .txa file.
   CommandLineTextures::iterator ti;
+  if (_num_threads > 1) {
+    // Start by reading the images we need on the worker threads.  These are
+    // kept until the palettes are generated anyway.
+    TextureReads reads;
+    for (ti = _command_line_textures.begin();
+         ti != _command_line_textures.end();
+         ++ti) {
+      TextureRead read;
+      read._texture = *ti;
+      read._full = force_texture_read || read._texture->is_newer_than(state_filename);
+      reads.push_back(read);
+    }
+    run_jobs(reads.size(), &read_texture_job, &reads);
+  }
+
   for (ti = _command_line_textures.begin();
        ti != _command_line_textures.end();
        ++ti) {
@@ -552,9 +613,27 @@ process_all(bool force_texture_read, const Filename &state_filename) {
   }
 
   // Now match each of the textures in the world against a line in the .txa
-  // file.
+  // file.  If we have worker threads, the images that need to be read are
+  // read a few at a time ahead of the loop; only a few, since we release
+  // each one again once it has been matched.
+  TextureReads reads;
+  Textures::iterator read_ti = _textures.begin();
   for (ti = _textures.begin(); ti != _textures.end(); ++ti) {
     TextureImage *texture = (*ti).second;
+    if (_num_threads > 1 && ti == read_ti) {
+      reads.clear();
+      while (read_ti != _textures.end() && (int)reads.size() < _num_threads * 2) {
+        TextureRead read;
+        read._texture = (*read_ti).second;
+        read._full = true;
+        if (force_texture_read || read._texture->is_newer_than(state_filename)) {
+          reads.push_back(read);
+        }
+        ++read_ti;
+      }
+      run_jobs(reads.size(), &read_texture_job, &reads);
+    }
+
     if (force_texture_read || texture->is_newer_than(state_filename)) {
       texture->read_source_image();
     }
@@ -631,17 +710,85 @@ reset_images() {
  */
 void Palettizer::
 generate_images(bool redo_all) {
+  if (_num_threads <= 1) {
+    Groups::iterator gi;
+    for (gi = _groups.begin(); gi != _groups.end(); ++gi) {
+      PaletteGroup *group = (*gi).second;
+      group->update_images(redo_all);
+    }
+
+    Textures::iterator ti;
+    for (ti = _textures.begin(); ti != _textures.end(); ++ti) {
+      TextureImage *texture = (*ti).second;
+      texture->copy_unplaced(redo_all);
+    }
+    return;
+  }
+
+  // First, find out which palette images need to be regenerated.  This may
+  // mark egg files stale, so it is done here on the main thread.
+  pvector<PaletteImage *> pending;
   Groups::iterator gi;
   for (gi = _groups.begin(); gi != _groups.end(); ++gi) {
     PaletteGroup *group = (*gi).second;
-    group->update_images(redo_all);
+    group->check_images(redo_all, pending);
+  }
+
+  // A TextureImage only holds one copy of its source image at a time, so two
+  // palette images that share a texture can't be generated at the same time.
+  // Gather the images into sets that are connected by their textures; the
+  // sets can then be generated independently.
+  vector_int set_of(pending.size());
+  pmap<TextureImage *, int> first_user;
+  for (size_t i = 0; i < pending.size(); ++i) {
+    set_of[i] = (int)i;
+
+    pvector<TextureImage *> textures;
+    pending[i]->get_textures(textures);
+    pvector<TextureImage *>::const_iterator ti;
+    for (ti = textures.begin(); ti != textures.end(); ++ti) {
+      std::pair<pmap<TextureImage *, int>::iterator, bool> result =
+        first_user.insert(pmap<TextureImage *, int>::value_type(*ti, (int)i));
+      if (!result.second) {
+        // Merge the two sets.
+        int a = (int)i;
+        while (set_of[a] != a) {
+          a = set_of[a];
+        }
+        int b = (*result.first).second;
+        while (set_of[b] != b) {
+          b = set_of[b];
+        }
+        set_of[std::max(a, b)] = std::min(a, b);
+      }
+    }
+  }
+
+  ImageSets image_sets;
+  vector_int set_index(pending.size(), -1);
+  for (size_t i = 0; i < pending.size(); ++i) {
+    int root = (int)i;
+    while (set_of[root] != root) {
+      root = set_of[root];
+    }
+    if (set_index[root] < 0) {
+      set_index[root] = (int)image_sets.size();
+      image_sets.push_back(pvector<PaletteImage *>());
+    }
+    image_sets[set_index[root]].push_back(pending[i]);
   }
 
+  run_jobs(image_sets.size(), &update_images_job, &image_sets);
+
+  // Now copy the textures that weren't placed.  Each texture writes only its
+  // own files.
+  UnplacedCopies copies;
+  copies._redo_all = redo_all;
   Textures::iterator ti;
   for (ti = _textures.begin(); ti != _textures.end(); ++ti) {
-    TextureImage *texture = (*ti).second;
-    texture->copy_unplaced(redo_all);
+    copies._textures.push_back((*ti).second);
   }
+  run_jobs(copies._textures.size(), &copy_unplaced_job, &copies);
 }
 
 /**
@@ -888,6 +1035,101 @@ string_remap(const string &str) {
   }
 }
 
+/**
+ * Calls func(data, n) for each n from 0 to num_jobs - 1, spreading the calls
+ * across the threads of the "palettizer" task chain.  The calling thread does
+ * its share as well.  Returns when all of the jobs have been done.
+ */
+void Palettizer::
+run_jobs(int num_jobs, JobFunc *func, void *data) {
+  JobBatch batch;
+  batch._func = func;
+  batch._data = data;
+  batch._num_jobs = num_jobs;
+  batch._next_job = 0;
+
+  int num_threads = std::min(_num_threads, num_jobs);
+  if (num_threads <= 1 || !Thread::is_threading_supported()) {
+    st_run_jobs(nullptr, &batch);
+    return;
+  }
+
+  // Make sure the image file types are sorted now, rather than leaving the
+  // worker threads to race to do it.
+  PNMFileTypeRegistry::get_global_ptr()->get_num_types();
+
+  AsyncTaskManager *task_mgr = AsyncTaskManager::get_global_ptr();
+  PT(AsyncTaskChain) chain = task_mgr->make_task_chain("palettizer");
+  if (chain->get_num_threads() < num_threads - 1) {
+    chain->set_num_threads(num_threads - 1);
+  }
+
+  pvector< PT(AsyncTask) > tasks;
+  for (int i = 1; i < num_threads; ++i) {
+    PT(GenericAsyncTask) task =
+      new GenericAsyncTask("palettizer", &st_run_jobs, &batch);
+    task->set_task_chain(chain->get_name());
+    task_mgr->add(task);
+    tasks.push_back(task);
+  }
+
+  st_run_jobs(nullptr, &batch);
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    tasks[i]->wait();
+  }
+}
+
+/**
+ * The task function for run_jobs().  Takes jobs from the batch until there
+ * are none left.
+ */
+AsyncTask::DoneStatus Palettizer::
+st_run_jobs(GenericAsyncTask *, void *data) {
+  JobBatch *batch = (JobBatch *)data;
+  while (true) {
+    int n = (int)AtomicAdjust::add(batch->_next_job, 1) - 1;
+    if (n >= batch->_num_jobs) {
+      break;
+    }
+    (*batch->_func)(batch->_data, n);
+  }
+  return AsyncTask::DS_done;
+}
+
+/**
+ * Reads the nth image of a TextureReads vector.
+ */
+void Palettizer::
+read_texture_job(void *data, int n) {
+  const TextureRead &read = (*(TextureReads *)data)[n];
+  if (read._full) {
+    read._texture->read_source_image();
+  } else {
+    read._texture->read_header();
+  }
+}
+
+/**
+ * Generates the nth set of palette images of an ImageSets vector.
+ */
+void Palettizer::
+update_images_job(void *data, int n) {
+  const pvector<PaletteImage *> &images = (*(ImageSets *)data)[n];
+  pvector<PaletteImage *>::const_iterator ii;
+  for (ii = images.begin(); ii != images.end(); ++ii) {
+    (*ii)->generate_image();
+  }
+}
+
+/**
+ * Copies the nth texture of an UnplacedCopies object, if it is unplaced.
+ */
+void Palettizer::
+copy_unplaced_job(void *data, int n) {
+  UnplacedCopies *copies = (UnplacedCopies *)data;
+  copies->_textures[n]->copy_unplaced(copies->_redo_all);
+}
+
 /**
  * Determines how much memory, etc.  is required by the indicated set of
  * texture placements, and reports this to the indicated output stream.
@@ -23,6 +23,8 @@
 #include "pvector.h"
 #include "pset.h"
 #include "pmap.h"
+#include "asyncTask.h"
+#include "atomicAdjust.h"
 
 class PNMFileType;
 class EggFile;
@@ -30,6 +32,7 @@ class PaletteGroup;
 class TextureImage;
 class TexturePlacement;
 class FactoryParams;
+class GenericAsyncTask;
 
 /**
  * This is the main engine behind egg-palettize.  It contains all of the
@@ -43,6 +46,9 @@ public:
   bool get_noabs() const;
   void set_noabs(bool noabs);
 
+  int get_num_threads() const;
+  void set_num_threads(int num_threads);
+
   bool is_valid() const;
   void report_pi() const;
   void report_statistics() const;
@@ -92,6 +98,7 @@ public:
   std::string _default_groupname;
   std::string _default_groupdir;
   bool _noabs;
+  int _num_threads;
 
   // The following parameter values specifically relate to textures and
   // palettes.  These values are stored in the textures.boo file for future
@@ -120,6 +127,24 @@ public:
   double _cutout_ratio;
 
 private:
+  typedef void JobFunc(void *data, int n);
+
+  // The state shared by the threads running the jobs of run_jobs().
+  class JobBatch {
+  public:
+    JobFunc *_func;
+    void *_data;
+    int _num_jobs;
+    AtomicAdjust::Integer _next_job;
+  };
+
+  void run_jobs(int num_jobs, JobFunc *func, void *data);
+  static AsyncTask::DoneStatus st_run_jobs(GenericAsyncTask *task, void *data);
+
+  static void read_texture_job(void *data, int n);
+  static void update_images_job(void *data, int n);
+  static void copy_unplaced_job(void *data, int n);
+
   typedef pvector<TexturePlacement *> Placements;
   void compute_statistics(std::ostream &out, int indent_level,
                           const Placements &placements) const;
@@ -62,3 +62,76 @@ def test_friction(world, scene):
         else:
             # No friction means the Y axis should be unaffected
             assert abs(ball.get_y()) < 0.1
+
+def test_async_step(world, scene):
+    ball = scene.find('**/ball')
+    world.async_step = True
+    assert world.async_step
+
+    # The scene graph lags one step behind while a step is pending.
+    world.do_physics(1.0 / 60)
+    world.wait_step()
+    z = ball.get_z()
+    assert z < 7.0
+
+    # Waiting again does nothing.
+    world.wait_step()
+    assert ball.get_z() == z
+
+    assert simulate_until(world, lambda: ball.get_x() >= 0)
+
+    world.async_step = False
+    assert not world.async_step
+
+def test_async_step_matches_sync():
+    bullet = pytest.importorskip("panda3d.bullet")
+
+    def run(async_step):
+        world = bullet.BulletWorld()
+        world.set_gravity(core.Vec3(0, 0, -9.8))
+        world.async_step = async_step
+
+        body = bullet.BulletRigidBodyNode('box')
+        body.add_shape(bullet.BulletBoxShape(core.Vec3(0.5)))
+        body.set_mass(1)
+        np = core.NodePath(body)
+        np.set_z(10)
+        world.attach(body)
+
+        for i in range(30):
+            world.do_physics(1.0 / 60)
+        world.wait_step()
+
+        world.remove(body)
+        return np.get_z()
+
+    assert run(True) == pytest.approx(run(False))
+
+def test_async_step_teleport():
+    world = bullet.BulletWorld()
+    world.set_gravity(core.Vec3(0, 0, -9.8))
+    world.async_step = True
+
+    body = bullet.BulletRigidBodyNode('box')
+    body.add_shape(bullet.BulletBoxShape(core.Vec3(0.5)))
+    body.set_mass(1)
+    np = core.NodePath(body)
+    np.set_z(10)
+    world.attach(body)
+
+    for i in range(10):
+        world.do_physics(1.0 / 60)
+
+    # Moving the body while a step is pending must not be undone by the
+    # result of that step.
+    np.set_pos(5, 0, 100)
+    world.wait_step()
+    assert np.get_pos() == core.Point3(5, 0, 100)
+
+    # The next step carries on from the new position.
+    world.do_physics(1.0 / 60)
+    world.wait_step()
+    assert np.get_x() == pytest.approx(5)
+    assert 99 < np.get_z() < 100
+
+    world.remove(body)
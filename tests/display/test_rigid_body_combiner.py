@@ -0,0 +1,128 @@
+from panda3d import core
+import pytest
+
+
+@pytest.fixture(scope='module')
+def scene_region(graphics_pipe):
+    """Creates and returns a DisplayRegion with a camera to render with."""
+
+    engine = core.GraphicsEngine()
+    engine.set_threading_model("")
+
+    fbprops = core.FrameBufferProperties()
+    fbprops.force_hardware = True
+
+    buffer = engine.make_output(
+        graphics_pipe,
+        'buffer',
+        0,
+        fbprops,
+        core.WindowProperties.size(32, 32),
+        core.GraphicsPipe.BF_refuse_window,
+    )
+    engine.open_windows()
+
+    if buffer is None:
+        pytest.skip("GraphicsPipe cannot make offscreen buffers")
+
+    region = buffer.make_display_region()
+    camera = core.NodePath(core.Camera("camera"))
+    camera.set_y(-50)
+    region.camera = camera
+
+    yield region
+
+    if buffer is not None:
+        engine.remove_window(buffer)
+
+
+def make_combiner(scene, direct):
+    direct_var = core.ConfigVariableBool("rigid-body-combiner-direct")
+    old_value = direct_var.value
+    direct_var.value = direct
+    try:
+        rbc = scene.attach_new_node(core.RigidBodyCombiner("rbc"))
+
+        cm = core.CardMaker("card")
+        cm.set_frame(-1, 1, -1, 1)
+        cards = []
+        for i in range(4):
+            card = rbc.attach_new_node(cm.generate())
+            card.set_pos(i * 3, 0, 0)
+            cards.append(card)
+
+        rbc.node().collect()
+    finally:
+        direct_var.value = old_value
+
+    return rbc, cards
+
+
+def get_vertices(rbc):
+    # Returns the vertices of the internal scene, as they will be rendered.
+    vertices = []
+    gnode = rbc.node().get_internal_scene().node()
+    for geom in gnode.get_geoms():
+        vdata = geom.get_animated_vertex_data(True)
+        reader = core.GeomVertexReader(vdata, "vertex")
+        while not reader.is_at_end():
+            vertices.append(tuple(reader.get_data3()))
+    return sorted(vertices)
+
+
+def assert_vertices_equal(a, b):
+    assert len(a) == len(b)
+    for va, vb in zip(a, b):
+        assert va == pytest.approx(vb, abs=1e-4)
+
+
+def move_cards(cards, frame):
+    for i, card in enumerate(cards):
+        card.set_pos(i * 3, frame, i - frame)
+        card.set_hpr(frame * 30 + i * 10, i * 5, 0)
+        card.set_scale(1 + i * 0.5)
+
+
+def test_rigid_body_combiner_direct(scene_region):
+    # The direct path must produce the same vertices as the vertex animation
+    # path that it replaces, frame after frame.
+    scene = core.NodePath("scene")
+    scene_region.camera.reparent_to(scene)
+
+    direct, direct_cards = make_combiner(scene, True)
+    animated, animated_cards = make_combiner(scene, False)
+
+    for frame in range(3):
+        move_cards(direct_cards, frame)
+        move_cards(animated_cards, frame)
+        scene_region.window.engine.render_frame()
+
+        assert_vertices_equal(get_vertices(direct), get_vertices(animated))
+
+    # Moving only one of the cards updates only that card.
+    direct_cards[2].set_z(10)
+    animated_cards[2].set_z(10)
+    scene_region.window.engine.render_frame()
+    assert_vertices_equal(get_vertices(direct), get_vertices(animated))
+
+    scene_region.camera.reparent_to(core.NodePath())
+
+
+def test_rigid_body_combiner_direct_copy(scene_region):
+    # A copy shares the internal scene with the original; culling both of
+    # them must still produce the right vertices.
+    scene = core.NodePath("scene")
+    scene_region.camera.reparent_to(scene)
+
+    direct, direct_cards = make_combiner(scene, True)
+    animated, animated_cards = make_combiner(core.NodePath("other"), False)
+    direct.copy_to(scene)
+
+    for frame in range(3):
+        move_cards(direct_cards, frame)
+        move_cards(animated_cards, frame)
+        scene_region.window.engine.render_frame()
+
+        assert_vertices_equal(get_vertices(direct), get_vertices(animated))
+
+    scene_region.camera.reparent_to(core.NodePath())
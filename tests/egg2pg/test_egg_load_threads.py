@@ -0,0 +1,93 @@
+import pytest
+from panda3d import core
+
+# Skip these tests if we can't import egg.
+egg = pytest.importorskip("panda3d.egg")
+
+
+def make_egg_data():
+    # Builds an egg with many polysets: each group holds polygons in several
+    # different colors, some of which share a vertex pool with other groups.
+    data = egg.EggData()
+    shared_pool = egg.EggVertexPool("shared")
+    data.add_child(shared_pool)
+
+    colors = [(1, 0, 0, 1), (0, 1, 0, 1), (0, 0, 1, 0.5)]
+    for gi in range(12):
+        group = egg.EggGroup("group%d" % gi)
+        group.add_translate3d((gi * 3, 0, 0))
+        data.add_child(group)
+
+        pool = egg.EggVertexPool("pool%d" % gi)
+        data.add_child(pool)
+
+        for pi in range(9):
+            poly = egg.EggPolygon()
+            poly.set_color(colors[pi % len(colors)])
+            vpool = shared_pool if pi % 2 else pool
+            for x, z in ((0, 0), (1, 0), (1, 1), (0, 1)):
+                vertex = egg.EggVertex()
+                vertex.set_pos((x + pi, gi, z))
+                vertex.set_normal((0, -1, 0))
+                poly.add_vertex(vpool.add_vertex(vertex))
+            group.add_child(poly)
+
+        if gi % 4 == 0:
+            child = egg.EggGroup("child%d" % gi)
+            group.add_child(child)
+            poly = egg.EggPolygon()
+            for x, z in ((0, 0), (1, 0), (0, 1)):
+                poly.add_vertex(pool.make_new_vertex(core.Point3D(x, -1, z)))
+            child.add_child(poly)
+
+    return data
+
+
+def describe(node, lines, indent=0):
+    # Returns a description of the node and everything below it, in enough
+    # detail that any difference in the scene graph shows up.
+    lines.append("%s%s %s %s %s" % (" " * indent, node.get_type().name,
+                                    node.name, node.transform, node.state))
+    if isinstance(node, core.GeomNode):
+        for geom, state in zip(node.get_geoms(), node.get_geom_states()):
+            vdata = geom.get_vertex_data()
+            lines.append("%s  geom %s %s" % (" " * indent, state,
+                                             vdata.get_format()))
+            reader = core.GeomVertexReader(vdata, "vertex")
+            while not reader.is_at_end():
+                lines.append("%s    %s" % (" " * indent, reader.get_data3()))
+            for prim in geom.get_primitives():
+                prim = prim.decompose()
+                lines.append("%s    %s %s" % (" " * indent, prim.get_type().name,
+                                              list(prim.get_vertex_list())))
+
+    for child in node.get_stashed():
+        lines.append("%s stashed:" % (" " * indent))
+        describe(child, lines, indent + 2)
+    for child in node.get_children():
+        describe(child, lines, indent + 2)
+    return lines
+
+
+def load_with_threads(num_threads):
+    threads_var = core.ConfigVariableInt("egg-load-threads")
+    old_value = threads_var.value
+    threads_var.value = num_threads
+    try:
+        root = egg.load_egg_data(make_egg_data())
+    finally:
+        threads_var.value = old_value
+
+    assert root
+    return describe(root, [])
+
+
+def test_egg_load_threads_identical():
+    if not core.Thread.is_threading_supported():
+        pytest.skip("threading not supported")
+
+    serial = load_with_threads(0)
+    assert len(serial) > 12
+
+    threaded = load_with_threads(4)
+    assert threaded == serial
@@ -0,0 +1,170 @@
+from panda3d import core
+from panda3d.core import GeoMipTerrain, PNMImage
+import math
+import pytest
+
+
+SIZE = 65
+
+
+def make_heightfield(func):
+    image = PNMImage(SIZE, SIZE, 1)
+    for x in range(SIZE):
+        for y in range(SIZE):
+            image.set_gray(x, y, func(x, y))
+    return image
+
+
+def bumpy(x, y):
+    return 0.5 + 0.25 * math.sin(x * 0.3) * math.cos(y * 0.2)
+
+
+def peak(x, y):
+    # A single bump in the middle of otherwise flat ground.
+    d2 = (x - 32) ** 2 + (y - 32) ** 2
+    return math.exp(-d2 / 32.0)
+
+
+def make_terrain(num_threads, async_update=False):
+    terrain = GeoMipTerrain("terrain")
+    assert terrain.set_heightfield(make_heightfield(bumpy))
+    terrain.set_block_size(16)
+    terrain.set_near_far(8, 64)
+    terrain.set_min_level(0)
+    terrain.set_auto_flatten(GeoMipTerrain.AFM_off)
+    terrain.set_focal_point(0, 0)
+    terrain.set_num_threads(num_threads)
+    terrain.set_async_update(async_update)
+    return terrain
+
+
+def describe(terrain):
+    # Returns the vertices and triangles of each of the blocks, in order.
+    blocks = []
+    for mx in range(4):
+        for my in range(4):
+            path = terrain.get_block_node_path(mx, my)
+            assert not path.is_empty()
+            for np in [path] + list(path.find_all_matches("**")):
+                node = np.node()
+                if not isinstance(node, core.GeomNode):
+                    continue
+                for geom in node.get_geoms():
+                    reader = core.GeomVertexReader(geom.get_vertex_data(), "vertex")
+                    vertices = []
+                    while not reader.is_at_end():
+                        vertices.append(tuple(reader.get_data3()))
+                    indices = []
+                    for prim in geom.get_primitives():
+                        indices.append([prim.get_vertex(i) for i in range(prim.get_num_vertices())])
+                    blocks.append((mx, my, vertices, indices))
+    return blocks
+
+
+def test_generate_threads():
+    serial = make_terrain(0)
+    serial.generate()
+
+    threaded = make_terrain(4)
+    threaded.generate()
+
+    assert describe(threaded) == describe(serial)
+
+
+def test_update_sync():
+    # A threaded update that isn't asynchronous swaps in the new blocks
+    # right away.
+    serial = make_terrain(0)
+    serial.generate()
+    threaded = make_terrain(4)
+    threaded.generate()
+
+    for terrain in (serial, threaded):
+        terrain.set_focal_point(64, 64)
+        assert terrain.update()
+        assert not terrain.is_update_pending()
+
+    assert describe(threaded) == describe(serial)
+
+
+def test_update_async():
+    if not core.Thread.is_threading_supported():
+        pytest.skip("threading not supported")
+
+    serial = make_terrain(0)
+    serial.generate()
+    before = describe(serial)
+    serial.set_focal_point(64, 64)
+    assert serial.update()
+    after = describe(serial)
+    assert after != before
+
+    terrain = make_terrain(2, async_update=True)
+    terrain.generate()
+    assert describe(terrain) == before
+
+    # The old blocks stay in place until all of the new ones are swapped in
+    # together.
+    terrain.set_focal_point(64, 64)
+    terrain.update()
+    if terrain.is_update_pending():
+        assert describe(terrain) == before
+    terrain.finish_update()
+    assert not terrain.is_update_pending()
+    assert describe(terrain) == after
+
+    # Nothing changed, so nothing more is done.
+    assert not terrain.update()
+    assert describe(terrain) == after
+
+
+def calc_ao(func, num_threads, radius=8):
+    terrain = GeoMipTerrain("terrain")
+    assert terrain.set_heightfield(make_heightfield(func))
+    terrain.set_num_threads(num_threads)
+    terrain.calc_ambient_occlusion(radius, 2.0, 0.75)
+    assert terrain.has_color_map()
+    image = PNMImage(terrain.color_map())
+    assert image.get_x_size() == SIZE
+    assert image.get_y_size() == SIZE
+    return image
+
+
+def test_ambient_occlusion_flat():
+    # Flat ground is neither lit up nor shadowed, even at the edges.
+    image = calc_ao(lambda x, y: 0.5, 0, radius=32)
+    tolerance = 1.0 / image.get_maxval()
+    for x in range(SIZE):
+        for y in range(SIZE):
+            assert image.get_gray(x, y) == pytest.approx(0.75, abs=tolerance)
+
+
+def test_ambient_occlusion_peak():
+    image = calc_ao(peak, 0)
+    tolerance = 1.0 / image.get_maxval()
+
+    # The top of the bump stands out above its surroundings, while the ground
+    # at its foot lies in its shadow.  Far away, the ground is flat.
+    assert image.get_gray(32, 32) > 0.75 + 0.1
+    assert image.get_gray(32, 40) < 0.75 - tolerance
+    assert image.get_gray(0, 0) == pytest.approx(0.75, abs=tolerance)
+    assert image.get_gray(SIZE - 1, SIZE - 1) == pytest.approx(0.75, abs=tolerance)
+
+    # The bump is symmetrical, and so is its shading, give or take a rounding
+    # step.
+    tolerance *= 1.5
+    for x in range(SIZE):
+        for y in range(SIZE):
+            value = image.get_gray(x, y)
+            assert 0 <= value <= 1
+            assert value == pytest.approx(image.get_gray(SIZE - 1 - x, y), abs=tolerance)
+            assert value == pytest.approx(image.get_gray(y, x), abs=tolerance)
+
+
+def test_ambient_occlusion_threads():
+    # Splitting the rows among threads gives exactly the same result.
+    serial = calc_ao(bumpy, 0)
+    threaded = calc_ao(bumpy, 4)
+    for x in range(SIZE):
+        for y in range(SIZE):
+            assert threaded.get_gray_val(x, y) == serial.get_gray_val(x, y)
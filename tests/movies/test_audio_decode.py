@@ -0,0 +1,122 @@
+import struct
+import wave
+
+from panda3d.core import Filename, MovieAudio
+from panda3d.core import PCMAudio, ReadAheadAudioCursor, AudioDecodeCache
+
+
+def write_wav(path, rate=8000, channels=2, num_samples=4000):
+    data = b''.join(struct.pack('<h', (i * 37) % 65536 - 32768)
+                    for i in range(num_samples * channels))
+    with wave.open(str(path), 'wb') as out:
+        out.setnchannels(channels)
+        out.setsampwidth(2)
+        out.setframerate(rate)
+        out.writeframes(data)
+    return data
+
+
+def test_pcm_audio_decode(tmp_path):
+    data = write_wav(tmp_path / "tone.wav")
+    audio = MovieAudio.get(Filename.from_os_specific(str(tmp_path / "tone.wav")))
+
+    pcm = PCMAudio.decode(audio.open())
+    assert pcm is not None
+    assert pcm.audio_rate == 8000
+    assert pcm.audio_channels == 2
+    assert pcm.num_samples == 4000
+    assert pcm.data_size == len(data)
+
+    cursor = pcm.open()
+    assert cursor.read_samples(4000) == data
+
+    cursor.seek(0.25)
+    assert cursor.read_samples(10) == data[2000 * 4:2010 * 4]
+
+
+def test_read_ahead_audio_cursor(tmp_path):
+    data = write_wav(tmp_path / "tone.wav")
+    audio = MovieAudio.get(Filename.from_os_specific(str(tmp_path / "tone.wav")))
+
+    cursor = ReadAheadAudioCursor(audio.open(), 0.1)
+    assert cursor.audio_rate == 8000
+    assert cursor.audio_channels == 2
+
+    result = b''
+    while True:
+        chunk = cursor.read_samples(300)
+        if not chunk:
+            break
+        result += chunk
+    assert result == data
+
+    cursor.seek(0.25)
+    assert cursor.read_samples(10) == data[2000 * 4:2010 * 4]
+
+
+def test_read_ahead_audio_cursor_wrap(tmp_path):
+    # A read-ahead buffer much smaller than the sound wraps around many times;
+    # reads of assorted sizes must still return every sample in order.
+    data = write_wav(tmp_path / "tone.wav")
+    audio = MovieAudio.get(Filename.from_os_specific(str(tmp_path / "tone.wav")))
+
+    cursor = ReadAheadAudioCursor(audio.open(), 0.01)
+    sizes = [1, 7, 33, 80, 150, 3]
+
+    result = b''
+    i = 0
+    while True:
+        assert cursor.get_num_buffered() <= 80
+        chunk = cursor.read_samples(sizes[i % len(sizes)])
+        if not chunk:
+            break
+        result += chunk
+        i += 1
+    assert result == data
+
+
+def test_audio_decode_cache_off(tmp_path):
+    write_wav(tmp_path / "tone.wav")
+    fn = Filename.from_os_specific(str(tmp_path / "tone.wav"))
+
+    # By default, the cache keeps nothing, but still decodes.
+    cache = AudioDecodeCache.get_global_ptr()
+    cache.clear()
+    assert cache.max_size == 0
+
+    pcm = cache.decode(MovieAudio.get(fn))
+    assert pcm is not None
+    assert pcm.num_samples > 0
+    assert not cache.has_audio(fn)
+    assert cache.num_sounds == 0
+
+
+def test_audio_decode_cache(tmp_path):
+    write_wav(tmp_path / "tone.wav")
+    fn = Filename.from_os_specific(str(tmp_path / "tone.wav"))
+    audio = MovieAudio.get(fn)
+
+    cache = AudioDecodeCache.get_global_ptr()
+    cache.clear()
+    old_max_size = cache.max_size
+    cache.max_size = 1 << 20
+    try:
+        assert not cache.has_audio(fn)
+
+        pcm1 = cache.decode(audio)
+        assert pcm1 is not None
+        assert cache.has_audio(fn)
+        assert cache.num_sounds == 1
+        assert cache.total_size == pcm1.data_size
+
+        # The second request is served from the cache.
+        pcm2 = cache.decode(MovieAudio.get(fn))
+        assert pcm2 == pcm1
+
+        cache.uncache(fn)
+        assert not cache.has_audio(fn)
+        assert cache.num_sounds == 0
+        assert cache.total_size == 0
+    finally:
+        cache.max_size = old_max_size
+        cache.clear()
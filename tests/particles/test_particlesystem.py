@@ -1,4 +1,9 @@
 from panda3d.core import NodePath, PandaNode
+from panda3d.physics import ParticleSystem, PhysicalNode, PhysicsManager
+from panda3d.physics import LinearEulerIntegrator, LinearVectorForce
+from panda3d.physics import LinearFrictionForce, ForceNode
+from panda3d.physics import PointEmitter, BaseParticleEmitter
+from panda3d.physics import ParticleSystemManager
 from direct.particles.ParticleEffect import ParticleEffect
 from direct.particles.Particles import Particles
 
@@ -101,3 +106,96 @@ def test_particle_soft_start():
     system.update(1)
 
     assert system.get_living_particles() == 1
+
+
+def make_physics_system(root, manager, soa_pool):
+    system = ParticleSystem(8)
+    system.set_soa_pool_flag(soa_pool)
+    system.set_birth_rate(0.1)
+    system.set_render_parent(NodePath(PandaNode("render")))
+    system.get_factory().set_lifespan_base(100)
+
+    emitter = PointEmitter()
+    emitter.set_emission_type(BaseParticleEmitter.ET_EXPLICIT)
+    emitter.set_explicit_launch_vector((1, 2, 5))
+    system.set_emitter(emitter)
+
+    node = PhysicalNode("system")
+    node.add_physical(system)
+    root.attach_new_node(node)
+    manager.attach_physical(system)
+    return system
+
+
+def test_particle_soa_pool():
+    # Runs the same system with and without the structure-of-arrays pool,
+    # and checks that the particles end up in the same place.
+    root = NodePath("root")
+    force_np = root.attach_new_node(ForceNode("forces"))
+    force_np.set_h(30)
+    gravity = LinearVectorForce(0, 0, -9.81)
+    friction = LinearFrictionForce(0.2)
+    force_np.node().add_force(gravity)
+    force_np.node().add_force(friction)
+
+    objects_mgr = PhysicsManager()
+    pool_mgr = PhysicsManager()
+    for mgr in (objects_mgr, pool_mgr):
+        mgr.attach_linear_integrator(LinearEulerIntegrator())
+        mgr.add_linear_force(gravity)
+        mgr.add_linear_force(friction)
+
+    objects = make_physics_system(root, objects_mgr, False)
+    pool = make_physics_system(root, pool_mgr, True)
+
+    for i in range(30):
+        for mgr, system in ((objects_mgr, objects), (pool_mgr, pool)):
+            mgr.do_physics(0.05)
+            system.update(0.05)
+
+    assert not objects.is_using_soa_pool()
+    assert pool.is_using_soa_pool()
+    assert pool.get_living_particles() == objects.get_living_particles() == 8
+
+    # Turning off the pool copies the particles back into their objects.
+    pool.set_soa_pool_flag(False)
+    assert not pool.is_using_soa_pool()
+
+    for a, b in zip(objects.get_objects(), pool.get_objects()):
+        assert a.get_position().almost_equal(b.get_position(), 0.001)
+        assert a.get_velocity().almost_equal(b.get_velocity(), 0.001)
+
+
+def test_particle_manager_threads():
+    # Steps the same set of systems serially and on worker threads, and
+    # checks that they come out the same.
+    results = []
+    for num_threads in (0, 2):
+        manager = ParticleSystemManager()
+        manager.set_num_threads(num_threads)
+        assert manager.get_num_threads() == num_threads
+
+        systems = []
+        for i in range(5):
+            system = ParticleSystem(4 + i)
+            system.set_birth_rate(0.1)
+            system.set_render_parent(NodePath(PandaNode("render")))
+            system.get_factory().set_lifespan_base(100)
+            manager.attach_particlesystem(system)
+            systems.append(system)
+
+        # This one dies partway through, and should not be stepped after.
+        systems[-1].set_system_grows_older_flag(True)
+        systems[-1].set_system_lifespan(0.5)
+
+        for i in range(20):
+            manager.do_particles(0.05)
+
+        assert manager.get_particles_per_second() > 0
+        assert manager.get_time_per_system() > 0
+        results.append([(system.get_living_particles(),
+                         round(system.get_system_age(), 3))
+                        for system in systems])
+
+    assert results[0] == results[1]
+    assert results[0][-1][1] < 0.6
@@ -0,0 +1,63 @@
+from panda3d.core import PandaNode, NodePath, BoundingSphere, BoundingBox
+from panda3d.core import Point3
+import pytest
+
+
+def expected_sphere(spheres):
+    # Mirrors the sphere-around-spheres computation in BoundingSphere.
+    lo = [min(c[i] - r for c, r in spheres) for i in range(3)]
+    hi = [max(c[i] + r for c, r in spheres) for i in range(3)]
+    center = Point3(*((lo[i] + hi[i]) * 0.5 for i in range(3)))
+    radius = max((Point3(*c) - center).length() + r for c, r in spheres)
+    return center, radius
+
+
+@pytest.mark.parametrize("num_children", [1, 3, 4, 7, 16])
+def test_bounds_around_child_spheres(num_children):
+    root = NodePath("root")
+
+    spheres = []
+    for i in range(num_children):
+        center = (i * 1.5 - 3.0, (i % 3) * 2.0, -(i % 5) * 0.5)
+        radius = 0.25 + (i % 4) * 0.5
+        child = root.attach_new_node(PandaNode("child%d" % i))
+        child.node().set_bounds(BoundingSphere(center, radius))
+        spheres.append((center, radius))
+
+    bounds = root.node().get_bounds()
+    assert isinstance(bounds, BoundingSphere)
+
+    center, radius = expected_sphere(spheres)
+    assert bounds.center.almost_equal(center, 0.001)
+    assert bounds.radius == pytest.approx(radius, abs=0.001)
+
+
+def test_bounds_around_child_boxes():
+    root = NodePath("root")
+    root.node().set_bounds_type(BoundingBox.BT_box)
+
+    for i in range(5):
+        child = root.attach_new_node(PandaNode("child%d" % i))
+        child.node().set_bounds_type(BoundingBox.BT_box)
+        child.node().set_bounds(BoundingBox((i, -i, 0), (i + 1, 0, i * 2)))
+
+    bounds = root.node().get_bounds()
+    assert isinstance(bounds, BoundingBox)
+    assert bounds.min.almost_equal((0, -4, 0))
+    assert bounds.max.almost_equal((5, 0, 8))
+
+
+def test_bounds_stale_after_move():
+    root = NodePath("root")
+    child = root.attach_new_node(PandaNode("child"))
+    child.node().set_bounds(BoundingSphere((0, 0, 0), 1))
+
+    assert root.node().get_bounds().center.almost_equal((0, 0, 0))
+
+    child.set_pos(10, 0, 0)
+    assert root.node().is_bounds_stale()
+
+    bounds = root.node().get_bounds()
+    assert not root.node().is_bounds_stale()
+    assert bounds.center.almost_equal((10, 0, 0))
+    assert bounds.radius == pytest.approx(1.0)
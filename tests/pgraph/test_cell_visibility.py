@@ -0,0 +1,51 @@
+from panda3d.core import CellVisibility, NodePath, PandaNode, LPoint3
+
+
+def make_street():
+    # Three cells in a row along the X axis; each one sees only its
+    # neighbours.
+    root = NodePath("street")
+    vis = CellVisibility()
+    vis.set_root(root)
+    for i in range(3):
+        cell = vis.add_cell("cell%d" % i)
+        assert cell == i
+        vis.add_cell_node(cell, root.attach_new_node("cell%d" % i).node())
+        vis.add_cell_segment(cell, LPoint3(i * 10, 0, 0), LPoint3(i * 10 + 10, 0, 0))
+
+    for i in range(2):
+        vis.add_visible(i, i + 1)
+        vis.add_visible(i + 1, i)
+    return root, vis
+
+
+def test_cell_visibility():
+    root, vis = make_street()
+    assert vis.get_num_cells() == 3
+    assert vis.get_num_segments() == 3
+    assert vis.find_cell("cell1") == 1
+    assert vis.find_cell("nowhere") == -1
+
+    assert vis.is_visible(0, 0)
+    assert vis.is_visible(0, 1)
+    assert not vis.is_visible(0, 2)
+    assert vis.get_num_visible(1) == 3
+
+
+def test_cell_at():
+    root, vis = make_street()
+    assert vis.get_cell_at(LPoint3(5, 3, 20)) == 0
+    assert vis.get_cell_at(LPoint3(25, -4, 0)) == 2
+
+    # Past the end of the street, the nearest segment still counts, unless it
+    # is too far away.
+    assert vis.get_cell_at(LPoint3(40, 0, 0)) == 2
+    vis.set_max_distance(5)
+    assert vis.get_cell_at(LPoint3(40, 0, 0)) == -1
+
+    # The camera is located relative to the root.
+    camera = NodePath(PandaNode("camera"))
+    camera.set_pos(15, 0, 5)
+    assert vis.get_camera_cell(camera) == 1
+    root.set_x(-10)
+    assert vis.get_camera_cell(camera) == 2
@@ -0,0 +1,229 @@
+from panda3d.core import NodePath, ModelRoot, CollisionNode, CollisionSphere
+from panda3d.core import CollisionSegment, CollisionTraverser
+from panda3d.core import CollisionHandlerQueue
+from panda3d.core import LODNode, FadeLODNode, SwitchNode, SequenceNode
+import pytest
+
+
+def make_model():
+    model = NodePath(ModelRoot("model"))
+    body = model.attach_new_node("body")
+    body.attach_new_node("arm").set_tag("side", "left")
+    body.attach_new_node("arm").set_tag("side", "right")
+    model.attach_new_node("hat")
+    assert model.node().share_subgraph() == 4
+    return model
+
+
+def test_share_subgraph():
+    model = make_model()
+    assert not model.node().is_copy_on_write()
+
+    copy1 = NodePath(model.node().copy_subgraph())
+    copy2 = NodePath(model.node().copy_subgraph())
+    assert copy1.node() != model.node()
+
+    # The copies share all of the nodes below the root.
+    assert copy1.node().get_child(0) == model.node().get_child(0)
+    assert copy2.node().get_child(1) == model.node().get_child(1)
+
+
+def test_read_does_not_unshare():
+    model = make_model()
+    copy1 = NodePath(model.node().copy_subgraph())
+    copy2 = NodePath(model.node().copy_subgraph())
+
+    # Merely looking at the nodes leaves the graph alone.
+    assert copy1.find("**/=side=right").node().is_copy_on_write()
+    assert copy1.get_child(1).node().is_copy_on_write()
+    for child in copy1.get_children():
+        assert child.node().is_copy_on_write()
+    assert copy1.node().get_child(0) == copy2.node().get_child(0)
+    assert copy1.node().get_child(1) == copy2.node().get_child(1)
+
+
+def test_unshare_on_find():
+    model = make_model()
+    copy1 = NodePath(model.node().copy_subgraph())
+    copy2 = NodePath(model.node().copy_subgraph())
+
+    arm = copy1.find("**/=side=right")
+    assert not arm.is_empty()
+    arm.set_pos(1, 2, 3)
+    assert not arm.node().is_copy_on_write()
+    assert not arm.get_parent().node().is_copy_on_write()
+    assert arm.get_top() == copy1
+
+    # The other copies are unaffected, and so are the untouched parts.
+    assert copy2.find("**/=side=right").get_pos() == (0, 0, 0)
+    assert model.find("**/=side=right").get_pos() == (0, 0, 0)
+    assert copy1.node().get_child(1) == copy2.node().get_child(1)
+    assert copy1.find("**/=side=left").node() == copy2.find("**/=side=left").node()
+
+    # Paths that pass through the same nodes come out the same.
+    arms = copy1.find_all_matches("**/arm")
+    assert arms.get_num_paths() == 2
+    assert arms[0].get_parent() == arms[1].get_parent()
+    assert arm in list(arms)
+
+
+def test_unshare_on_get_child():
+    model = make_model()
+    copy1 = NodePath(model.node().copy_subgraph())
+    copy2 = NodePath(model.node().copy_subgraph())
+
+    hat = copy1.get_child(1)
+    hat.set_name("cap")
+    assert not hat.node().is_copy_on_write()
+    assert copy1.get_child(1).get_name() == "cap"
+    assert copy2.get_child(1).get_name() == "hat"
+    assert model.get_child(1).get_name() == "hat"
+
+
+def test_unshare_keeps_held_paths():
+    model = make_model()
+    copy1 = NodePath(model.node().copy_subgraph())
+    copy2 = NodePath(model.node().copy_subgraph())
+
+    # Paths taken before an ancestor is unshared stay attached, and now pass
+    # through the private copy of that ancestor.
+    arm = copy1.find("**/=side=right")
+    other_arm = copy1.find("**/=side=right")
+    body = copy1.get_child(0)
+    body.set_pos(1, 0, 0)
+
+    assert copy2.get_child(0).get_pos() == (0, 0, 0)
+    assert not body.node().is_copy_on_write()
+    assert arm.verify_complete()
+    assert arm.get_top() == copy1
+    assert arm.get_parent().node() == copy1.node().get_child(0)
+    assert arm.get_pos(copy1) == (1, 0, 0)
+
+    # Unsharing the node itself updates every path that reached it.
+    arm.set_tag("moved", "1")
+    assert other_arm.node() == arm.node()
+    assert other_arm.has_tag("moved")
+    assert not copy2.find("**/=side=right").has_tag("moved")
+
+
+def test_unshare_any_path():
+    model = make_model()
+    copy1 = NodePath(model.node().copy_subgraph())
+    copy2 = NodePath(model.node().copy_subgraph())
+
+    # The hat is shared by all three roots; any_path() picks one of them,
+    # and only that one sees the change.
+    hat = NodePath.any_path(model.node().get_child(1))
+    hat.set_name("cap")
+    assert hat.verify_complete()
+
+    roots = [model, copy1, copy2]
+    names = [root.get_child(1).get_name() for root in roots]
+    assert sorted(names) == ["cap", "hat", "hat"]
+    assert hat.get_parent() == roots[names.index("cap")]
+
+
+def test_unshare_collision_entry():
+    model = NodePath(ModelRoot("model"))
+    solid = model.attach_new_node(CollisionNode("solid"))
+    solid.node().add_solid(CollisionSphere(0, 0, 0, 1))
+    assert model.node().share_subgraph() == 1
+
+    scene = NodePath("scene")
+    copy1 = scene.attach_new_node(model.node().copy_subgraph())
+    copy2 = scene.attach_new_node(model.node().copy_subgraph())
+    copy2.set_x(10)
+
+    ray = scene.attach_new_node(CollisionNode("ray"))
+    ray.node().add_solid(CollisionSegment((0, -5, 0), (0, 5, 0)))
+    ray.node().set_into_collide_mask(0)
+
+    queue = CollisionHandlerQueue()
+    traverser = CollisionTraverser()
+    traverser.add_collider(ray, queue)
+    traverser.traverse(scene)
+    assert queue.get_num_entries() == 1
+
+    # Modifying the node that was hit changes only the copy that was hit.
+    into = queue.get_entry(0).get_into_node_path()
+    assert into.get_parent() == copy1
+    into.set_tag("hit", "1")
+    assert not into.node().is_copy_on_write()
+    assert into.verify_complete()
+
+    assert copy1.find("**/solid").has_tag("hit")
+    assert not copy2.find("**/solid").has_tag("hit")
+    assert not model.find("**/solid").has_tag("hit")
+
+
+def test_unshare_on_reparent():
+    model = make_model()
+    copy1 = NodePath(model.node().copy_subgraph())
+    copy2 = NodePath(model.node().copy_subgraph())
+
+    # Moving a shared node out of one copy leaves it in the others.
+    arm = copy1.find("**/=side=left")
+    arm.reparent_to(copy1)
+    assert copy1.get_child(0).get_num_children() == 1
+    assert copy2.get_child(0).get_num_children() == 2
+    assert model.get_child(0).get_num_children() == 2
+
+    # Likewise for adding a node below a shared node.
+    copy2.get_child(1).attach_new_node("feather")
+    assert copy2.get_child(1).get_num_children() == 1
+    assert copy1.get_child(1).get_num_children() == 0
+
+    copy1.get_child(1).detach_node()
+    assert copy1.get_num_children() == 2
+    assert copy2.get_num_children() == 2
+
+
+def count_shared(node):
+    count = int(node.is_copy_on_write())
+    for i in range(node.get_num_children()):
+        count += count_shared(node.get_child(i))
+    return count
+
+
+def test_unshare_subgraph():
+    model = make_model()
+    copy = NodePath(model.node().copy_subgraph())
+    assert count_shared(copy.node()) == 4
+
+    copy.unshare_subgraph()
+    assert count_shared(copy.node()) == 0
+    assert count_shared(model.node()) == 4
+
+    # Flattening the copy leaves the model alone.
+    copy.flatten_strong()
+    assert model.node().get_child(0).get_num_children() == 2
+
+
+def test_share_selective_nodes():
+    # Nodes that choose which child to draw keep that choice per copy, so
+    # they aren't shared, nor is anything below them.
+    model = NodePath(ModelRoot("model"))
+    nodes = [LODNode("lod"), FadeLODNode("fade"), SwitchNode("switch"),
+             SequenceNode("sequence")]
+    for node in nodes:
+        model.attach_new_node(node).attach_new_node("child")
+    model.attach_new_node("plain")
+    assert model.node().share_subgraph() == 1
+
+    copy = NodePath(model.node().copy_subgraph())
+    for node in nodes:
+        assert not node.is_copy_on_write()
+        assert not node.get_child(0).is_copy_on_write()
+        assert copy.find(node.name).node() != node
+    assert copy.find("plain").node() == model.find("plain").node()
+
+
+def test_modify_shared_top_node():
+    model = make_model()
+    copy = NodePath(model.node().copy_subgraph())
+
+    # A path that begins at a shared node has no parent to unshare it from.
+    hat = NodePath(copy.node().get_child(1))
+    assert hat.node().is_copy_on_write()
+    with pytest.raises(AssertionError):
+        hat.set_tag("top", "1")
@@ -0,0 +1,112 @@
+from panda3d.core import NodePath, ModelRoot
+import random
+
+
+def make_tree(seed=1):
+    rng = random.Random(seed)
+    root = NodePath(ModelRoot("root"))
+
+    def grow(parent, depth):
+        for i in range(rng.randint(1, 3)):
+            child = parent.attach_new_node(rng.choice(("wall", "door", "sign")))
+            if rng.random() < 0.3:
+                child.set_tag("occluder", rng.choice(("1", "2")))
+            if rng.random() < 0.2:
+                child.stash()
+            if depth < 5:
+                grow(child, depth + 1)
+
+    grow(root, 0)
+
+    # Add an instance, which is reachable by more than one path.
+    root.find("**/door").instance_to(root)
+    return root
+
+
+def find_both(root, path):
+    root.node().find_index = False
+    expected = list(root.find_all_matches(path))
+    root.node().find_index = True
+    assert list(root.find_all_matches(path)) == expected
+    assert root.find(path) == (expected[0] if expected else NodePath())
+    return expected
+
+
+def test_find_index_matches_search():
+    root = make_tree()
+
+    for path in ("**/door", "**/wall;+s", "**/d*", "**/DOOR;+i",
+                 "**/=occluder", "**/=occluder=2", "**/=occluder;+s",
+                 "**/missing"):
+        find_both(root, path)
+
+    root.find("**/sign").hide()
+    find_both(root, "**/sign;-h")
+
+
+def test_find_index_invalidate():
+    root = NodePath(ModelRoot("root"))
+    root.node().find_index = True
+    street = root.attach_new_node("street")
+    building = street.attach_new_node("building")
+    building.attach_new_node("door")
+
+    assert root.find_all_matches("**/door").get_num_paths() == 1
+    door = building.attach_new_node("door")
+    assert root.find_all_matches("**/door").get_num_paths() == 2
+
+    door.set_name("renamed")
+    assert find_both(root, "**/renamed") == [door]
+
+    door.set_tag("marker", "1")
+    assert root.find("**/=marker") == door
+
+    door.stash()
+    assert root.find("**/renamed").is_empty()
+    assert root.find("**/renamed;+s") == door
+
+    door.remove_node()
+    assert root.find("**/renamed;+s").is_empty()
+    assert root.find("**/=marker;+s").is_empty()
+
+
+def test_find_index_rename_node():
+    root = NodePath(ModelRoot("root"))
+    root.node().find_index = True
+    door = root.attach_new_node("street").attach_new_node("door")
+    assert root.find("**/door") == door
+
+    # Renaming the PandaNode directly also discards the index, every time.
+    door.node().set_name("gate")
+    assert root.find("**/door").is_empty()
+    assert root.find("**/gate") == door
+
+    door.node().name = "arch"
+    assert root.find("**/gate").is_empty()
+    assert root.find("**/arch") == door
+
+
+def test_find_index_shared():
+    # A node that is below two indexed roots invalidates both of them.
+    root1 = NodePath(ModelRoot("root1"))
+    root2 = NodePath(ModelRoot("root2"))
+    root1.node().find_index = True
+    root2.node().find_index = True
+
+    shared = root1.attach_new_node("shared")
+    shared.instance_to(root2)
+    inner = NodePath(ModelRoot("inner"))
+    inner.node().find_index = True
+    inner.reparent_to(shared)
+    inner.attach_new_node("door")
+
+    for root in (root1, root2, inner):
+        assert root.find_all_matches("**/door").get_num_paths() == 1
+
+    inner.attach_new_node("door")
+    for root in (root1, root2, inner):
+        assert root.find_all_matches("**/door").get_num_paths() == 2
+
+    inner.find("door").node().set_tag("marker", "1")
+    for root in (root1, root2, inner):
+        assert not root.find("**/=marker").is_empty()
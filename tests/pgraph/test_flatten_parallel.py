@@ -0,0 +1,119 @@
+from panda3d import core
+import pytest
+
+
+def make_card(name, size):
+    # Builds a GeomNode holding a single square made of two triangles.
+    vdata = core.GeomVertexData(name, core.GeomVertexFormat.get_v3n3(),
+                                core.Geom.UH_static)
+    vertex = core.GeomVertexWriter(vdata, "vertex")
+    normal = core.GeomVertexWriter(vdata, "normal")
+    for x, z in ((0, 0), (size, 0), (size, size), (0, size)):
+        vertex.add_data3(x, 0, z)
+        normal.add_data3(0, -1, 0)
+
+    prim = core.GeomTriangles(core.Geom.UH_static)
+    prim.add_vertices(0, 1, 2)
+    prim.add_vertices(0, 2, 3)
+
+    geom = core.Geom(vdata)
+    geom.add_primitive(prim)
+
+    node = core.GeomNode(name)
+    node.add_geom(geom)
+    return node
+
+
+def make_scene():
+    root = core.NodePath("root")
+    for b in range(8):
+        block = root.attach_new_node("block")
+        block.set_pos(b * 10, 0, 0)
+        for i in range(4):
+            piece = block.attach_new_node("piece")
+            piece.set_h(i * 90)
+            piece.set_scale(1 + b * 0.25)
+            card = piece.attach_new_node(make_card("card", i + 1))
+            card.set_color(i / 3.0, 0, 0, 1)
+
+        # A piece that must stay separate, so that some transforms survive.
+        keep = block.attach_new_node(core.ModelNode("keep"))
+        keep.set_pos(0, b, 1)
+        keep.attach_new_node(make_card("kept", 2))
+
+    # An instanced subgraph is flattened in order on the calling thread.
+    root.find("**/piece").instance_to(root)
+    return root
+
+
+def describe(np):
+    # Returns the node names, transforms, and Geom contents of the scene, in
+    # order, along with the total number of Geoms and vertices.
+    lines = []
+    num_geoms = 0
+    num_vertices = 0
+    for path in [np] + list(np.find_all_matches("**")):
+        node = path.node()
+        lines.append((node.name, path.get_transform(np).get_mat()))
+        if isinstance(node, core.GeomNode):
+            for geom, state in zip(node.get_geoms(), node.get_geom_states()):
+                num_geoms += 1
+                vdata = geom.get_vertex_data()
+                num_vertices += vdata.get_num_rows()
+                reader = core.GeomVertexReader(vdata, "vertex")
+                vertices = []
+                while not reader.is_at_end():
+                    vertices.append(tuple(reader.get_data3()))
+                lines.append((state, vdata.get_format(),
+                              geom.get_num_primitives(), sorted(vertices)))
+    return lines, num_geoms, num_vertices
+
+
+def flatten_strong(num_threads):
+    threads_var = core.ConfigVariableInt("flatten-num-threads")
+    old_value = threads_var.value
+    threads_var.value = num_threads
+    try:
+        root = make_scene()
+        root.flatten_strong()
+    finally:
+        threads_var.value = old_value
+    return root
+
+
+def test_flatten_strong_parallel():
+    if not core.Thread.is_threading_supported():
+        pytest.skip("threading not supported")
+
+    before, geoms_before, vertices_before = describe(make_scene())
+
+    serial, serial_geoms, serial_vertices = describe(flatten_strong(0))
+    assert serial_geoms < geoms_before
+    assert serial_vertices >= vertices_before
+
+    threaded, threaded_geoms, threaded_vertices = describe(flatten_strong(4))
+    assert threaded_geoms == serial_geoms
+    assert threaded_vertices == serial_vertices
+    assert len(threaded) == len(serial)
+    for a, b in zip(threaded, serial):
+        assert a == b
+
+
+def test_flatten_reducer_parallel():
+    if not core.Thread.is_threading_supported():
+        pytest.skip("threading not supported")
+
+    results = []
+    for num_threads in (0, 4):
+        root = make_scene()
+        gr = core.SceneGraphReducer()
+        gr.set_num_threads(num_threads)
+        assert gr.get_num_threads() == num_threads
+        gr.apply_attribs(root.node())
+        count = gr.flatten(root.node(), ~0)
+        gr.collect_vertex_data(root.node(), 0)
+        gr.unify(root.node(), False)
+        results.append((count, describe(root)))
+
+    assert results[0][0] > 0
+    assert results[0] == results[1]
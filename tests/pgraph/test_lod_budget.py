@@ -0,0 +1,220 @@
+from panda3d import core
+from panda3d.core import LODNode, LODBudgetManager
+import pytest
+
+
+def test_lod_budget_controlled():
+    lod = LODNode("lod")
+    lod.add_switch(50, 0)
+    lod.add_switch(100, 50)
+    assert not lod.is_budget_controlled()
+
+    lod.set_budget_controlled(True)
+    assert lod.budget_controlled
+    assert lod.make_copy().is_budget_controlled()
+
+    lod.budget_controlled = False
+    assert not lod.is_budget_controlled()
+
+
+def test_lod_budget_manager():
+    manager = LODBudgetManager.get_global_ptr()
+
+    manager.set_vertex_budget(100000)
+    manager.set_frame_time_budget(1.0 / 60.0)
+    manager.set_hysteresis(0.25)
+    assert manager.vertex_budget == 100000
+    assert manager.hysteresis == 0.25
+
+    # The scale always stays within the range.
+    manager.set_scale_range(2, 3)
+    assert manager.min_scale == 2
+    assert manager.max_scale == 3
+    assert manager.scale == 2
+
+    manager.set_scale_range(0.5, 4)
+    manager.reset()
+    assert manager.scale == 1
+    assert manager.measured_vertices == 0
+
+    manager.set_vertex_budget(0)
+    manager.set_frame_time_budget(0)
+
+
+@pytest.fixture(scope='module')
+def engine():
+    """Creates and returns a GraphicsEngine with an offscreen buffer."""
+
+    pipe = core.GraphicsPipeSelection.get_global_ptr().make_default_pipe()
+    if pipe is None or not pipe.is_valid():
+        pytest.skip("GraphicsPipe is invalid")
+
+    engine = core.GraphicsEngine()
+    engine.set_threading_model("")
+
+    buffer = engine.make_output(
+        pipe,
+        'buffer',
+        0,
+        core.FrameBufferProperties(),
+        core.WindowProperties.size(32, 32),
+        core.GraphicsPipe.BF_refuse_window,
+    )
+    engine.open_windows()
+
+    if buffer is None:
+        pytest.skip("GraphicsPipe cannot make offscreen buffers")
+
+    yield engine
+
+    engine.remove_all_windows()
+
+
+@pytest.fixture
+def manager():
+    # Counts vertices only, and doubles or halves the scale each frame.
+    manager = LODBudgetManager.get_global_ptr()
+    manager.set_vertex_budget(100)
+    manager.set_frame_time_budget(0)
+    manager.set_hysteresis(0.25)
+    manager.set_adjust_rate(1)
+    manager.set_scale_range(1, 4)
+    manager.reset()
+
+    yield manager
+
+    manager.set_vertex_budget(core.ConfigVariableInt("lod-budget-vertices").value)
+    manager.set_frame_time_budget(core.ConfigVariableDouble("lod-budget-frame-time").value)
+    manager.set_hysteresis(core.ConfigVariableDouble("lod-budget-hysteresis").value)
+    manager.set_adjust_rate(core.ConfigVariableDouble("lod-budget-adjust-rate").value)
+    manager.set_scale_range(core.ConfigVariableDouble("lod-budget-min-scale").value,
+                            core.ConfigVariableDouble("lod-budget-max-scale").value)
+    manager.reset()
+
+
+def make_points(num_vertices):
+    vdata = core.GeomVertexData("points", core.GeomVertexFormat.get_v3(),
+                                core.Geom.UH_static)
+    vertex = core.GeomVertexWriter(vdata, "vertex")
+    for i in range(num_vertices):
+        vertex.add_data3(0, 0, 0)
+
+    prim = core.GeomPoints(core.Geom.UH_static)
+    prim.add_next_vertices(num_vertices)
+
+    geom = core.Geom(vdata)
+    geom.add_primitive(prim)
+    node = core.GeomNode("points")
+    node.add_geom(geom)
+    return node
+
+
+def make_scene(engine, camera_ys):
+    # A budget-controlled LODNode with a 300-vertex level up to a distance of
+    # 50, and a 3-vertex level beyond, viewed by a camera at each of the
+    # indicated positions.
+    scene = core.NodePath("scene")
+    lod = scene.attach_new_node(LODNode("lod"))
+    lod.node().set_budget_controlled(True)
+    lod.node().add_switch(50, 0)
+    lod.node().add_switch(1000, 50)
+    lod.attach_new_node(make_points(300))
+    lod.attach_new_node(make_points(3))
+    lod.set_y(45)
+
+    buffer = engine.get_window(0)
+    for y in camera_ys:
+        camera = scene.attach_new_node(core.Camera("camera"))
+        camera.set_y(y)
+        buffer.make_display_region().camera = camera
+
+    return scene, lod
+
+
+def clear_scene(engine):
+    buffer = engine.get_window(0)
+    buffer.remove_all_display_regions()
+
+
+def render(engine, manager):
+    # Returns the scale used for this frame, and the vertices that were
+    # measured in the frame before.
+    engine.render_frame()
+    return manager.scale, manager.measured_vertices
+
+
+def test_lod_budget_scale(engine, manager):
+    scene, lod = make_scene(engine, [0])
+    try:
+        # Under budget, the scale stays at its minimum.  The near level is
+        # drawn, which is over budget, so the scale doubles, which moves the
+        # node past the switch.
+        assert render(engine, manager) == (1, 0)
+        assert render(engine, manager) == (2, 300)
+
+        # Now well under budget, the scale comes back down; but the far level
+        # is kept, since the node is still within its widened range.
+        assert render(engine, manager) == (1, 3)
+        assert render(engine, manager) == (1, 3)
+
+        # Once the node leaves the widened range, the near level comes back.
+        lod.set_y(30)
+        assert render(engine, manager) == (1, 3)
+
+        # Over budget again.  The first doubling of the scale isn't enough to
+        # leave the widened range, but the second one is.
+        assert render(engine, manager) == (2, 300)
+        assert render(engine, manager) == (4, 300)
+        assert render(engine, manager) == (2, 3)
+    finally:
+        clear_scene(engine)
+
+
+def test_lod_budget_hold(engine, manager):
+    manager.set_scale_range(0.5, 4)
+    manager.set_vertex_budget(350)
+    scene, lod = make_scene(engine, [0])
+    try:
+        assert render(engine, manager) == (0.5, 0)
+
+        # Within the hysteresis fraction of the budget, the scale is held.
+        assert render(engine, manager) == (0.5, 300)
+        assert render(engine, manager) == (0.5, 300)
+
+        # It goes up again once the load is over budget.
+        manager.set_vertex_budget(200)
+        assert render(engine, manager) == (1, 300)
+    finally:
+        clear_scene(engine)
+
+
+def test_lod_budget_per_camera(engine, manager):
+    # Each camera keeps its own level, so that the hysteresis of one doesn't
+    # affect what the other sees.
+    scene, lod = make_scene(engine, [0, 25])
+    try:
+        assert render(engine, manager) == (1, 0)
+        assert render(engine, manager) == (2, 600)
+
+        # The far camera switched to the far level; the near camera kept the
+        # near level, since it is still within its widened range.
+        assert render(engine, manager) == (4, 303)
+        assert render(engine, manager) == (2, 6)
+    finally:
+        clear_scene(engine)
+
+
+def test_lod_budget_per_instance(engine, manager):
+    # Each instance of the node keeps its own level too.  The second instance
+    # is nearer, and keeps the near level for longer.
+    scene, lod = make_scene(engine, [0])
+    other = scene.attach_new_node("other")
+    other.set_y(-23)
+    lod.instance_to(other)
+    try:
+        assert render(engine, manager) == (1, 0)
+        assert render(engine, manager) == (2, 600)
+        assert render(engine, manager) == (4, 303)
+        assert render(engine, manager) == (2, 6)
+    finally:
+        clear_scene(engine)
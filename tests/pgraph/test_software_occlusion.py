@@ -0,0 +1,83 @@
+from panda3d.core import NodePath, Camera, PerspectiveLens, CardMaker
+from panda3d.core import SoftwareOcclusionCuller
+
+
+def make_scene():
+    root = NodePath("root")
+
+    lens = PerspectiveLens()
+    lens.fov = 60
+    camera = root.attach_new_node(Camera("camera", lens))
+
+    # A large wall, facing the camera.
+    cm = CardMaker("wall")
+    cm.set_frame(-20, 20, -20, 20)
+    wall = root.attach_new_node(cm.generate())
+    wall.set_y(10)
+
+    cm = CardMaker("box")
+    cm.set_frame(-1, 1, -1, 1)
+    behind = root.attach_new_node(cm.generate())
+    behind.set_y(20)
+    front = root.attach_new_node(cm.generate())
+    front.set_y(5)
+    beside = root.attach_new_node(cm.generate())
+    beside.set_pos(40, 50, 0)
+
+    return root, camera, lens, wall, behind, front, beside
+
+
+def test_software_occlusion():
+    root, camera, lens, wall, behind, front, beside = make_scene()
+
+    culler = SoftwareOcclusionCuller()
+    culler.add_occluder(wall)
+    assert culler.get_num_occluders() == 1
+
+    culler.prepare(camera, lens)
+    assert culler.num_triangles > 0
+
+    assert culler.is_occluded(behind)
+    assert not culler.is_occluded(front)
+    assert not culler.is_occluded(beside)
+    assert not culler.is_occluded(wall)
+    assert culler.num_occluded == 1
+
+
+def test_software_occlusion_back_face():
+    root, camera, lens, wall, behind, front, beside = make_scene()
+
+    culler = SoftwareOcclusionCuller()
+    culler.add_occluder(wall)
+
+    # Seen from behind, the wall is invisible, and so occludes nothing.
+    wall.set_h(180)
+    culler.prepare(camera, lens)
+    assert not culler.is_occluded(behind)
+
+
+def test_software_occlusion_tag():
+    root, camera, lens, wall, behind, front, beside = make_scene()
+    wall.set_tag("occluder", "1")
+
+    culler = SoftwareOcclusionCuller()
+    culler.add_occluders(root)
+    assert list(culler.occluders) == [wall]
+
+    assert culler.remove_occluder(wall)
+    assert culler.get_num_occluders() == 0
+
+
+def test_software_occlusion_buffer_size():
+    root, camera, lens, wall, behind, front, beside = make_scene()
+
+    culler = SoftwareOcclusionCuller()
+    culler.add_occluder(wall)
+    culler.prepare(camera, lens)
+    assert culler.is_occluded(behind)
+
+    # Changing the buffer size takes effect at the next prepare().
+    culler.set_buffer_size(16, 8)
+    culler.prepare(camera, lens)
+    assert culler.is_occluded(behind)
+    assert not culler.is_occluded(front)
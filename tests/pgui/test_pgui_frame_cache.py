@@ -0,0 +1,76 @@
+from panda3d.core import PGItem, PGFrameStyle, Texture, TextureAttrib
+from panda3d.core import ConfigVariableInt
+import pytest
+
+
+@pytest.fixture
+def frame_cache():
+    cache_var = ConfigVariableInt("pgui-frame-cache-size")
+    old_value = cache_var.value
+    cache_var.value = 2
+    PGFrameStyle.clear_frame_cache()
+    yield cache_var
+    PGFrameStyle.clear_frame_cache()
+    cache_var.value = old_value
+
+
+def make_frame(color, texture=None, size=1):
+    # Generates the frame of a new PGItem, and returns its Geom and state.
+    style = PGFrameStyle()
+    style.set_type(PGFrameStyle.T_flat)
+    style.set_color(color)
+    if texture is not None:
+        style.set_texture(texture)
+
+    item = PGItem("item")
+    item.set_frame(-size, size, -size, size)
+    item.set_frame_style(0, style)
+    frame = item.get_state_def(0).get_child(0)
+    return frame.node().get_geom(0), frame.node().get_geom_state(0)
+
+
+def test_frame_cache_reuse(frame_cache):
+    geom1, state1 = make_frame((1, 0, 0, 1))
+    assert PGFrameStyle.get_num_cached_frames() == 1
+
+    # The same style and size shares the same Geom.
+    geom2, state2 = make_frame((1, 0, 0, 1))
+    assert geom2.this == geom1.this
+    assert PGFrameStyle.get_num_cached_frames() == 1
+
+    # A different color or size does not.
+    geom3, state3 = make_frame((0, 1, 0, 1))
+    assert geom3.this != geom1.this
+    geom4, state4 = make_frame((1, 0, 0, 1), size=2)
+    assert geom4.this != geom1.this
+
+
+def test_frame_cache_lru(frame_cache):
+    red, _ = make_frame((1, 0, 0, 1))
+    green, _ = make_frame((0, 1, 0, 1))
+
+    # Touch red, so that green is the one evicted to make room for blue.
+    assert make_frame((1, 0, 0, 1))[0].this == red.this
+    make_frame((0, 0, 1, 1))
+    assert PGFrameStyle.get_num_cached_frames() == 2
+
+    assert make_frame((1, 0, 0, 1))[0].this == red.this
+    assert make_frame((0, 1, 0, 1))[0].this != green.this
+
+
+def test_frame_cache_texture(frame_cache):
+    tex = Texture("tex")
+    geom1, state1 = make_frame((1, 1, 1, 1), tex)
+    assert state1.get_attrib(TextureAttrib).get_texture() == tex
+
+    # A copy handed out from the cache still gets the texture.
+    geom2, state2 = make_frame((1, 1, 1, 1), tex)
+    assert geom2.this == geom1.this
+    assert state2.get_attrib(TextureAttrib).get_texture() == tex
+
+    # The cache itself does not hold on to the texture: emptying it releases
+    # no references.
+    refs = tex.get_ref_count()
+    PGFrameStyle.clear_frame_cache()
+    assert tex.get_ref_count() == refs
+
@@ -0,0 +1,99 @@
+from panda3d.core import NodePath, ConfigVariableBool
+from panda3d.physics import ActorNode, ForceNode, PhysicsManager
+from panda3d.physics import LinearEulerIntegrator, LinearVectorForce
+from panda3d.physics import LinearFrictionForce, LinearSinkForce
+from panda3d.physics import LinearCylinderVortexForce, LinearDistanceForce
+
+
+def run_actors(batch):
+    batch_var = ConfigVariableBool("physics-batch-integrate")
+    old_value = batch_var.value
+    batch_var.value = batch
+    try:
+        root = NodePath("root")
+        force_np = root.attach_new_node(ForceNode("forces"))
+        force_np.set_hpr(30, 10, 0)
+
+        gravity = LinearVectorForce(0, 0, -9.81)
+        friction = LinearFrictionForce(0.2)
+        friction.set_vector_masks(True, True, False)
+        sink = LinearSinkForce((1, 2, 3), LinearDistanceForce.FT_ONE_OVER_R, 2.0, 1.0, True)
+        vortex = LinearCylinderVortexForce(5.0, 10.0, 0.5)
+        forces = (gravity, friction, sink, vortex)
+
+        manager = PhysicsManager()
+        manager.attach_linear_integrator(LinearEulerIntegrator())
+        for force in forces:
+            force_np.node().add_force(force)
+            manager.add_linear_force(force)
+
+        actors = []
+        for i in range(7):
+            actor = ActorNode("actor%d" % i)
+            actor.get_physics_object().set_mass(1.0 + i)
+            actor.get_physics_object().set_velocity((i, 1, 0))
+            np = root.attach_new_node(actor)
+            np.set_pos(i * 0.5, -i, i * 0.25)
+            manager.attach_physical_node(actor)
+            actors.append(np)
+
+        for i in range(20):
+            manager.do_physics(0.05)
+
+        return [np.get_pos() for np in actors]
+    finally:
+        batch_var.value = old_value
+
+
+def test_physics_batch_integrate():
+    # Integrating the actors together in a batch should move them exactly as
+    # integrating them one at a time does.
+    for a, b in zip(run_actors(False), run_actors(True)):
+        assert a.almost_equal(b, 0.001)
+
+
+def run_nested(batch):
+    batch_var = ConfigVariableBool("physics-batch-integrate")
+    old_value = batch_var.value
+    batch_var.value = batch
+    try:
+        root = NodePath("root")
+        force_np = root.attach_new_node(ForceNode("forces"))
+        force_np.set_hpr(30, 10, 0)
+
+        gravity = LinearVectorForce(0, 0, -9.81)
+        sink = LinearSinkForce((1, 2, 3), LinearDistanceForce.FT_ONE_OVER_R, 2.0, 1.0, True)
+        manager = PhysicsManager()
+        manager.attach_linear_integrator(LinearEulerIntegrator())
+        for force in (gravity, sink):
+            force_np.node().add_force(force)
+            manager.add_linear_force(force)
+
+        # The rider hangs below the moving carrier, and sits between two
+        # physicals that share the carrier's parent, so it must see the
+        # carrier's transform after the carrier has been moved this step.
+        def add_actor(parent, name, velocity):
+            actor = ActorNode(name)
+            actor.get_physics_object().set_velocity(velocity)
+            np = parent.attach_new_node(actor)
+            manager.attach_physical_node(actor)
+            return np
+
+        first = add_actor(root, "first", (0, 1, 0))
+        carrier = add_actor(root, "carrier", (3, 0, 1))
+        rider = add_actor(carrier, "rider", (0, 0, 0))
+        last = add_actor(root, "last", (1, 0, 0))
+
+        for i in range(20):
+            manager.do_physics(0.05)
+
+        return [np.get_pos(root) for np in (first, carrier, rider, last)]
+    finally:
+        batch_var.value = old_value
+
+
+def test_physics_batch_integrate_nested():
+    # Each physical is still integrated and updated in turn, so one below
+    # another's ActorNode moves as it does without batching.
+    for a, b in zip(run_nested(False), run_nested(True)):
+        assert a.almost_equal(b, 0.001)
@@ -1,4 +1,5 @@
-from panda3d.core import MouseWatcher, MouseWatcherRegion
+from panda3d.core import MouseWatcher, MouseWatcherRegion, ConfigVariableInt
+import random
 
 
 def test_mousewatcher_region_add():
@@ -16,3 +17,53 @@ def test_mousewatcher_region_add():
 
     mw.add_region(region1)
     assert len(mw.regions) == 2
+
+
+def test_mousewatcher_grid():
+    # The regions found under the mouse must be the same with the grid as
+    # without it, including after regions are moved, deactivated or removed.
+    rand = random.Random(42)
+    mw = MouseWatcher()
+    regions = []
+    for i in range(200):
+        left = rand.uniform(-1.2, 1.0)
+        bottom = rand.uniform(-1.2, 1.0)
+        width = rand.choice((0.02, 0.1, 0.5, 2.0))
+        region = MouseWatcherRegion("r%d" % i, left, left + width,
+                                    bottom, bottom + width)
+        region.sort = i
+        mw.add_region(region)
+        regions.append(region)
+
+    points = [(x * 0.13 - 1.0, y * 0.11 - 1.0)
+              for x in range(16) for y in range(19)]
+
+    grid_var = ConfigVariableInt("mouse-watcher-grid-size")
+    old_value = grid_var.value
+
+    def find_all(grid_size):
+        grid_var.value = grid_size
+        result = []
+        for x, y in points:
+            region = mw.get_over_region(x, y)
+            result.append(region.name if region else None)
+        return result
+
+    try:
+        expected = find_all(0)
+        assert any(expected)
+        assert find_all(8) == expected
+
+        for region in regions[::7]:
+            region.set_frame(region.frame[0] + 0.3, region.frame[1] + 0.3,
+                             region.frame[2] - 0.2, region.frame[3] - 0.2)
+        for region in regions[::11]:
+            region.active = False
+        for region in regions[::13]:
+            mw.remove_region(region)
+
+        expected = find_all(0)
+        assert find_all(8) == expected
+        assert find_all(3) == expected
+    finally:
+        grid_var.value = old_value